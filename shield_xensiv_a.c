@@ -23,7 +23,11 @@
  *****************************************************************************/
 
 
+#include <stddef.h>
+#include <string.h>
 #include "shield_xensiv_a.h"
+#include "shield_xensiv_a_i2c_sched.h"
+#include "shield_xensiv_a_metrics.h"
 #ifdef EMWIN_ENABLED
 #include "GUI.h"
 #include "LCDConf.h"
@@ -37,10 +41,45 @@ extern "C"
 /******************************************************************************
 * Macros
 ******************************************************************************/
-/* SPI baud rate in Hz */
-#define SPI_FREQ_HZ                (1200000UL)
 /* SPI transfer bits per frame */
 #define BITS_PER_FRAME             (8)
+/* Frequency of the timestamp counter in Hz */
+#define TIMESTAMP_FREQ_HZ          (1000000UL)
+/* Delay between polls of the staged initialization in blocking mode */
+#define INIT_POLL_INTERVAL_MS      (10UL)
+/* Conversion factor between the timestamp counter and milliseconds */
+#define US_PER_MS                  (1000UL)
+/* Peripherals on the shared I2C bus */
+#define I2C_DEVICES                (SHIELD_XENSIV_A_READY_HUMIDITY | SHIELD_XENSIV_A_READY_MOTION | \
+                                    SHIELD_XENSIV_A_READY_MAGNETOMETER |                          \
+                                    SHIELD_XENSIV_A_READY_PRESSURE | SHIELD_XENSIV_A_READY_CO2)
+/* Identifies a saved warm state ("SXAW") and its layout */
+#define WARM_STATE_MAGIC           (0x53584157UL)
+#define WARM_STATE_VERSION         (1U)
+/* Peripherals which can be restored from a warm state */
+#define WARM_DEVICES               (SHIELD_XENSIV_A_READY_MOTION | \
+                                    SHIELD_XENSIV_A_READY_MAGNETOMETER | SHIELD_XENSIV_A_READY_CO2)
+/* Registers checked before a Bosch sensor is restored */
+#define BMI270_REG_CHIP_ID         (0x00U)
+#define BMI270_REG_INTERNAL_STATUS (0x21U)
+#define BMI270_STATUS_MESSAGE_MASK (0x0FU)
+#define BMI270_STATUS_INIT_OK      (0x01U)
+#define BMM350_REG_CHIP_ID         (0x00U)
+/* Timeout of a register access of a Bosch sensor */
+#define BOSCH_I2C_TIMEOUT_MS       (10UL)
+/* Return value of the Bosch interface functions on a failed transfer */
+#define BOSCH_INTF_FAIL            (-1)
+/* Longest burst of a Bosch register access, as set by the ModusToolbox wrappers */
+#define BOSCH_READ_WRITE_LEN       (46U)
+/* SCL pulses which release any device in the middle of a byte */
+#define I2C_RECOVERY_CLOCKS        (9U)
+/* Half period of the SCL pulses of the bus recovery, about 100 kHz */
+#define I2C_RECOVERY_HALF_US       (5U)
+/* Timeout for the SHT35 transfers in ms */
+#define SHT35_I2C_TIMEOUT_MS       (10U)
+/* SHT35 CRC-8 polynomial x^8 + x^5 + x^4 + 1 and initial value */
+#define SHT35_CRC_POLYNOMIAL       (0x31U)
+#define SHT35_CRC_INIT             (0xFFU)
 
 /******************************************************************************
 * Global variables
@@ -48,253 +87,1540 @@ extern "C"
 typedef enum
 {
     _SHIELD_XENSIV_A_INITIALIZED_NONE             = 0x00,
-    _SHIELD_XENSIV_A_INITIALIZED_HUMIDITY         = 0x01,
-    _SHIELD_XENSIV_A_INITIALIZED_MOTION           = 0x02,
-    _SHIELD_XENSIV_A_INITIALIZED_MAGNETOMETER     = 0x04,
-    _SHIELD_XENSIV_A_INITIALIZED_PRESSURE         = 0x08,
-    _SHIELD_XENSIV_A_INITIALIZED_PDM              = 0x10,
-    _SHIELD_XENSIV_A_INITIALIZED_DISPLAY          = 0x20
+    _SHIELD_XENSIV_A_INITIALIZED_HUMIDITY         = SHIELD_XENSIV_A_READY_HUMIDITY,
+    _SHIELD_XENSIV_A_INITIALIZED_MOTION           = SHIELD_XENSIV_A_READY_MOTION,
+    _SHIELD_XENSIV_A_INITIALIZED_MAGNETOMETER     = SHIELD_XENSIV_A_READY_MAGNETOMETER,
+    _SHIELD_XENSIV_A_INITIALIZED_PRESSURE         = SHIELD_XENSIV_A_READY_PRESSURE,
+    _SHIELD_XENSIV_A_INITIALIZED_PDM              = SHIELD_XENSIV_A_READY_PDM,
+    _SHIELD_XENSIV_A_INITIALIZED_DISPLAY          = SHIELD_XENSIV_A_READY_DISPLAY,
+    _SHIELD_XENSIV_A_INITIALIZED_CO2              = SHIELD_XENSIV_A_READY_CO2,
+    _SHIELD_XENSIV_A_INITIALIZED_CO2_POWER        = 0x80,
+    _SHIELD_XENSIV_A_INITIALIZED_TIMER            = 0x100,
+    _SHIELD_XENSIV_A_INITIALIZED_SPI_SEL          = 0x200
 } shield_xensiv_a_initialized_t;
 
-static cyhal_i2c_t                      _shield_i2c;
-static cyhal_spi_t                      _shield_spi;
-static cyhal_pdm_pcm_t                  _shield_pdm_pcm;
-static cyhal_i2c_t*                     _shield_i2c_ptr;
-static cyhal_spi_t*                     _shield_spi_ptr;
-static mtb_bmi270_t                     motion_sensor;
-static mtb_bmm350_t                     mag_sensor;
-static xensiv_dps3xx_t                  pressure_sensor;
-static xensiv_pasco2_t                  co2_sensor;
-static shield_xensiv_a_initialized_t    _shield_initialized = _SHIELD_XENSIV_A_INITIALIZED_NONE;
-
-const mtb_st7735s_pins_t tft_pins =
-{
-    .dc       = SHIELD_XENSIV_A_PIN_SPI_DC_DS,
-    .rst      = SHIELD_XENSIV_A_PIN_MAIN_RST
+static shield_xensiv_a_t                _shield_default =
+{
+    .init_result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED
 };
+#if SHIELD_XENSIV_A_USE_DISPLAY
+/* The display driver supports a single display */
+static shield_xensiv_a_t*               _shield_display_owner;
+#endif
+
+
+/******************************************************************************
+* _shield_xensiv_a_init_timer
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_init_timer(shield_xensiv_a_t* shield)
+{
+    static const cyhal_timer_cfg_t timer_cfg =
+    {
+        .is_continuous = true,
+        .direction     = CYHAL_TIMER_DIR_UP,
+        .is_compare    = false,
+        .period        = 0xFFFFFFFFUL,
+        .compare_value = 0,
+        .value         = 0
+    };
+
+    cy_rslt_t result = cyhal_timer_init(&shield->timer, NC, NULL);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        shield->initialized |= _SHIELD_XENSIV_A_INITIALIZED_TIMER;
+        result = cyhal_timer_configure(&shield->timer, &timer_cfg);
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cyhal_timer_set_frequency(&shield->timer, TIMESTAMP_FREQ_HZ);
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cyhal_timer_start(&shield->timer);
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_init_wanted
+******************************************************************************/
+/* Whether a device is selected and no earlier step has failed */
+static inline bool _shield_xensiv_a_init_wanted(const shield_xensiv_a_t* shield,
+                                                cy_rslt_t result, uint32_t device)
+{
+    return (CY_RSLT_SUCCESS == result) && ((shield->devices & device) != 0);
+}
+
+
+#if SHIELD_XENSIV_A_USE_HUMIDITY || SHIELD_XENSIV_A_USE_MOTION || \
+    SHIELD_XENSIV_A_USE_MAGNETOMETER || SHIELD_XENSIV_A_USE_PRESSURE || SHIELD_XENSIV_A_USE_PDM || \
+    SHIELD_XENSIV_A_USE_DISPLAY || SHIELD_XENSIV_A_USE_CO2
+/******************************************************************************
+* _shield_xensiv_a_init_step
+******************************************************************************/
+/* Records the outcome of initializing a device. A failure is only passed on
+   for a required device, other devices are just left out of the ready mask. */
+static cy_rslt_t _shield_xensiv_a_init_step(shield_xensiv_a_t* shield, uint32_t device,
+                                            cy_rslt_t result)
+{
+    if (CY_RSLT_SUCCESS == result)
+    {
+        shield->initialized |= device;
+    }
+    else if ((shield->required & device) == 0)
+    {
+        result = CY_RSLT_SUCCESS;
+    }
+    return result;
+}
+#endif
+
+
+/******************************************************************************
+* _shield_xensiv_a_crc32
+******************************************************************************/
+static uint32_t _shield_xensiv_a_crc32(const void* data, size_t size)
+{
+    const uint8_t* bytes = data;
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= bytes[i];
+        for (uint32_t bit = 0; bit < 8U; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1UL)));
+        }
+    }
+    return ~crc;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_warm_devices
+******************************************************************************/
+/* Devices which may be restored from a warm state, none if the state was not
+   saved by this image and layout or is corrupted */
+static uint32_t _shield_xensiv_a_warm_devices(const shield_xensiv_a_cfg_t* cfg)
+{
+    const shield_xensiv_a_warm_state_t* state = cfg->warm_state;
+    uint32_t devices = 0;
+
+    if ((NULL != state) && (WARM_STATE_MAGIC == state->magic) &&
+        (WARM_STATE_VERSION == state->version) && (sizeof(*state) == state->size) &&
+        (cfg->warm_image_id == state->image_id) &&
+        (_shield_xensiv_a_crc32(state, offsetof(shield_xensiv_a_warm_state_t, checksum)) ==
+         state->checksum))
+    {
+        devices = state->devices & WARM_DEVICES;
+    }
+    return devices;
+}
+
+
+#if SHIELD_XENSIV_A_USE_MOTION || SHIELD_XENSIV_A_USE_MAGNETOMETER
+/******************************************************************************
+* _shield_xensiv_a_bosch_read
+******************************************************************************/
+/* Register access of the Bosch drivers. The ModusToolbox wrappers keep the
+   bus of their sensor in a single file scope variable, which a second shield
+   would overwrite and which is lost on a reset, so the drivers of every
+   shield are bound to these with the bus of their own shield instead. */
+static int8_t _shield_xensiv_a_bosch_read(uint8_t reg_addr, uint8_t* data, uint32_t len,
+                                          void* intf_ptr)
+{
+    const shield_xensiv_a_bosch_intf_t* intf = intf_ptr;
+    cy_rslt_t result = cyhal_i2c_master_mem_read(intf->i2c, intf->address, reg_addr, 1,
+                                                 data, (uint16_t)len, BOSCH_I2C_TIMEOUT_MS);
+    return (CY_RSLT_SUCCESS == result) ? 0 : BOSCH_INTF_FAIL;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_bosch_write
+******************************************************************************/
+static int8_t _shield_xensiv_a_bosch_write(uint8_t reg_addr, const uint8_t* data, uint32_t len,
+                                           void* intf_ptr)
+{
+    const shield_xensiv_a_bosch_intf_t* intf = intf_ptr;
+    cy_rslt_t result = cyhal_i2c_master_mem_write(intf->i2c, intf->address, reg_addr, 1,
+                                                  data, (uint16_t)len, BOSCH_I2C_TIMEOUT_MS);
+    return (CY_RSLT_SUCCESS == result) ? 0 : BOSCH_INTF_FAIL;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_bosch_delay_us
+******************************************************************************/
+static void _shield_xensiv_a_bosch_delay_us(uint32_t period, void* intf_ptr)
+{
+    (void)intf_ptr;
+    while (period > UINT16_MAX)
+    {
+        cyhal_system_delay_us(UINT16_MAX);
+        period -= UINT16_MAX;
+    }
+    cyhal_system_delay_us((uint16_t)period);
+}
+
+
+#endif // SHIELD_XENSIV_A_USE_MOTION || SHIELD_XENSIV_A_USE_MAGNETOMETER
+#if SHIELD_XENSIV_A_USE_MOTION
+/******************************************************************************
+* _shield_xensiv_a_bind_motion
+******************************************************************************/
+static void _shield_xensiv_a_bind_motion(shield_xensiv_a_t* shield)
+{
+    struct bmi2_dev* dev = &shield->motion_sensor.sensor;
+
+    shield->motion_sensor.intpin1 = NC;
+    shield->motion_sensor.intpin2 = NC;
+    shield->motion_intf.i2c       = shield->i2c_ptr;
+    shield->motion_intf.address   = MTB_BMI270_ADDRESS_SEC;
+    dev->intf           = BMI2_I2C_INTF;
+    dev->intf_ptr       = &shield->motion_intf;
+    dev->read           = _shield_xensiv_a_bosch_read;
+    dev->write          = _shield_xensiv_a_bosch_write;
+    dev->delay_us       = _shield_xensiv_a_bosch_delay_us;
+    dev->read_write_len = BOSCH_READ_WRITE_LEN;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_restore_motion
+******************************************************************************/
+/* Restores the BMI270 if it still holds its configuration, which saves the
+   upload of its 8 kB feature configuration */
+static bool _shield_xensiv_a_restore_motion(shield_xensiv_a_t* shield,
+                                            const shield_xensiv_a_warm_state_t* state)
+{
+    struct bmi2_dev* dev = &shield->motion_sensor.sensor;
+    uint8_t chip_id = 0;
+    uint8_t status  = 0;
+
+    shield->motion_sensor = state->motion_sensor;
+    _shield_xensiv_a_bind_motion(shield);
+
+    return (BMI2_OK == bmi2_get_regs(BMI270_REG_CHIP_ID, &chip_id, 1, dev)) &&
+           (chip_id == dev->chip_id) &&
+           (BMI2_OK == bmi2_get_regs(BMI270_REG_INTERNAL_STATUS, &status, 1, dev)) &&
+           ((status & BMI270_STATUS_MESSAGE_MASK) == BMI270_STATUS_INIT_OK);
+}
+
+
+#endif // SHIELD_XENSIV_A_USE_MOTION
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+/******************************************************************************
+* _shield_xensiv_a_bind_mag
+******************************************************************************/
+static void _shield_xensiv_a_bind_mag(shield_xensiv_a_t* shield)
+{
+    struct bmm350_dev* dev = &shield->mag_sensor.sensor;
+
+    shield->mag_intf.i2c     = shield->i2c_ptr;
+    shield->mag_intf.address = MTB_BMM350_ADDRESS_DEFAULT;
+    dev->intf_ptr = &shield->mag_intf;
+    dev->read     = _shield_xensiv_a_bosch_read;
+    dev->write    = _shield_xensiv_a_bosch_write;
+    dev->delay_us = _shield_xensiv_a_bosch_delay_us;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_init_mag
+******************************************************************************/
+/* Brings up the BMM350 with the configuration applied by mtb_bmm350_init_i2c() */
+static cy_rslt_t _shield_xensiv_a_init_mag(shield_xensiv_a_t* shield)
+{
+    struct bmm350_dev* dev = &shield->mag_sensor.sensor;
+    int8_t rslt;
+
+    _shield_xensiv_a_bind_mag(shield);
+    rslt = bmm350_init(dev);
+    if (BMM350_OK == rslt)
+    {
+        rslt = bmm350_set_odr_performance(BMM350_DATA_RATE_100HZ, BMM350_AVERAGING_4, dev);
+    }
+    if (BMM350_OK == rslt)
+    {
+        rslt = bmm350_enable_axes(BMM350_X_EN, BMM350_Y_EN, BMM350_Z_EN, dev);
+    }
+    if (BMM350_OK == rslt)
+    {
+        rslt = bmm350_set_powermode(BMM350_NORMAL_MODE, dev);
+    }
+    return (BMM350_OK == rslt) ? CY_RSLT_SUCCESS : SHIELD_XENSIV_A_RSLT_ERR_SENSOR;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_restore_mag
+******************************************************************************/
+/* Restores the BMM350 with the OTP compensation data read at its previous
+   initialization */
+static bool _shield_xensiv_a_restore_mag(shield_xensiv_a_t* shield,
+                                         const shield_xensiv_a_warm_state_t* state)
+{
+    struct bmm350_dev* dev = &shield->mag_sensor.sensor;
+    uint8_t chip_id = 0;
+
+    shield->mag_sensor = state->mag_sensor;
+    _shield_xensiv_a_bind_mag(shield);
+
+    return (BMM350_OK == bmm350_get_regs(BMM350_REG_CHIP_ID, &chip_id, 1, dev)) &&
+           (chip_id == dev->chip_id);
+}
+
+
+#endif // SHIELD_XENSIV_A_USE_MAGNETOMETER
+/******************************************************************************
+* _shield_xensiv_a_finish_init
+******************************************************************************/
+static void _shield_xensiv_a_finish_init(shield_xensiv_a_t* shield, cy_rslt_t result)
+{
+    shield->init_pending = false;
+    shield->init_result  = result;
+    if (NULL != shield->init_callback)
+    {
+        shield->init_callback(result, shield_xensiv_a_ctx_get_ready_mask(shield),
+                              shield->init_callback_arg);
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_make_cfg
+******************************************************************************/
+/* Configuration of the initialization functions taking individual arguments,
+   which initialize and require every compiled in peripheral */
+static void _shield_xensiv_a_make_cfg(shield_xensiv_a_cfg_t* cfg,
+                                      cyhal_i2c_t* i2c_instance,
+                                      cyhal_spi_t* spi_instance,
+                                      const cyhal_pdm_pcm_cfg_t* pdm_pcm_cfg,
+                                      cyhal_clock_t* audio_clock_inst,
+                                      shield_xensiv_a_init_callback_t callback,
+                                      void* callback_arg)
+{
+    static const shield_xensiv_a_cfg_t default_cfg = SHIELD_XENSIV_A_CFG_DEFAULT;
+
+    *cfg = default_cfg;
+    cfg->i2c_instance     = i2c_instance;
+    cfg->spi_instance     = spi_instance;
+    cfg->pdm_pcm_cfg      = pdm_pcm_cfg;
+    cfg->audio_clock_inst = audio_clock_inst;
+    cfg->callback         = callback;
+    cfg->callback_arg     = callback_arg;
+    if ((NULL != pdm_pcm_cfg) && (NULL != audio_clock_inst))
+    {
+        cfg->devices  |= (SHIELD_XENSIV_A_READY_AVAILABLE & SHIELD_XENSIV_A_READY_PDM);
+        cfg->required |= (SHIELD_XENSIV_A_READY_AVAILABLE & SHIELD_XENSIV_A_READY_PDM);
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_init_i2c
+******************************************************************************/
+/* Sets up the I2C bus owned by the shield */
+static cy_rslt_t _shield_xensiv_a_init_i2c(shield_xensiv_a_t* shield)
+{
+    static const cyhal_i2c_cfg_t i2c_cfg =
+    {
+        .is_slave        = false,
+        .address         = 0,
+        .frequencyhal_hz = 400000
+    };
+
+    cy_rslt_t result = cyhal_i2c_init(&shield->i2c, shield->pins.i2c_sda, shield->pins.i2c_scl,
+                                      NULL);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        shield->i2c_ptr = &shield->i2c;
+        result  = cyhal_i2c_configure(&shield->i2c, &i2c_cfg);
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_clear_i2c_bus
+******************************************************************************/
+/* Releases a device which holds SDA low because a transfer was interrupted,
+   by clocking SCL until it lets go and then generating a STOP condition */
+static cy_rslt_t _shield_xensiv_a_clear_i2c_bus(const shield_xensiv_a_pins_t* pins)
+{
+    cy_rslt_t result = cyhal_gpio_init(pins->i2c_scl, CYHAL_GPIO_DIR_BIDIRECTIONAL,
+                                       CYHAL_GPIO_DRIVE_OPENDRAINDRIVESLOW, true);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cyhal_gpio_init(pins->i2c_sda, CYHAL_GPIO_DIR_BIDIRECTIONAL,
+                                 CYHAL_GPIO_DRIVE_OPENDRAINDRIVESLOW, true);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            cyhal_system_delay_us(I2C_RECOVERY_HALF_US);
+            for (uint32_t i = 0; (i < I2C_RECOVERY_CLOCKS) && !cyhal_gpio_read(pins->i2c_sda); i++)
+            {
+                cyhal_gpio_write(pins->i2c_scl, false);
+                cyhal_system_delay_us(I2C_RECOVERY_HALF_US);
+                cyhal_gpio_write(pins->i2c_scl, true);
+                cyhal_system_delay_us(I2C_RECOVERY_HALF_US);
+            }
+
+            /* STOP: SDA rises while SCL is high */
+            cyhal_gpio_write(pins->i2c_scl, false);
+            cyhal_system_delay_us(I2C_RECOVERY_HALF_US);
+            cyhal_gpio_write(pins->i2c_sda, false);
+            cyhal_system_delay_us(I2C_RECOVERY_HALF_US);
+            cyhal_gpio_write(pins->i2c_scl, true);
+            cyhal_system_delay_us(I2C_RECOVERY_HALF_US);
+            cyhal_gpio_write(pins->i2c_sda, true);
+            cyhal_system_delay_us(I2C_RECOVERY_HALF_US);
+
+            if (!cyhal_gpio_read(pins->i2c_sda) || !cyhal_gpio_read(pins->i2c_scl))
+            {
+                result = SHIELD_XENSIV_A_RSLT_ERR_BUS_STUCK;
+            }
+            cyhal_gpio_free(pins->i2c_sda);
+        }
+        cyhal_gpio_free(pins->i2c_scl);
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_init_sensor
+******************************************************************************/
+/* Initializes the driver of one sensor on the I2C bus from scratch. The CO2
+   sensor is handled by the staged initialization instead. */
+static cy_rslt_t _shield_xensiv_a_init_sensor(shield_xensiv_a_t* shield, uint32_t device)
+{
+    cy_rslt_t result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+
+    (void)shield;
+
+    switch (device)
+    {
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+        case SHIELD_XENSIV_A_READY_HUMIDITY:
+            result = mtb_sht3x_init(shield->i2c_ptr, MTB_SHT35_ADDRESS_DEFAULT);
+            break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_MOTION
+        case SHIELD_XENSIV_A_READY_MOTION:
+            _shield_xensiv_a_bind_motion(shield);
+            shield->motion_sensor.sensor.config_file_ptr = NULL;
+            result = (BMI2_OK == bmi270_init(&shield->motion_sensor.sensor))
+                     ? mtb_bmi270_config_default(&shield->motion_sensor)
+                     : SHIELD_XENSIV_A_RSLT_ERR_SENSOR;
+            break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+        case SHIELD_XENSIV_A_READY_MAGNETOMETER:
+            result = _shield_xensiv_a_init_mag(shield);
+            break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+        case SHIELD_XENSIV_A_READY_PRESSURE:
+            result = xensiv_dps3xx_mtb_init_i2c(&shield->pressure_sensor, shield->i2c_ptr,
+                                                XENSIV_DPS3XX_I2C_ADDR_ALT);
+            break;
+#endif
+
+        default:
+            break;
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_free_sensor
+******************************************************************************/
+/* Releases the driver of one sensor on the I2C bus and drops it from the
+   ready mask */
+static void _shield_xensiv_a_free_sensor(shield_xensiv_a_t* shield, uint32_t device)
+{
+    if ((shield->initialized & device) > 0)
+    {
+        switch (device)
+        {
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+            case SHIELD_XENSIV_A_READY_HUMIDITY:
+                mtb_sht3x_free(shield->i2c_ptr);
+                break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_MOTION
+            case SHIELD_XENSIV_A_READY_MOTION:
+                mtb_bmi270_free_pin(&shield->motion_sensor);
+                break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+            case SHIELD_XENSIV_A_READY_MAGNETOMETER:
+                mtb_bmm350_free_pin(&shield->mag_sensor);
+                break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+            case SHIELD_XENSIV_A_READY_PRESSURE:
+                xensiv_dps3xx_free(&shield->pressure_sensor);
+                break;
+#endif
+
+            default:
+                break;
+        }
+        shield->initialized &= ~device;
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_init_buses
+******************************************************************************/
+/* The timer and the buses are needed by all selected devices, so their
+   failures are always passed on */
+static cy_rslt_t _shield_xensiv_a_init_buses(shield_xensiv_a_t* shield,
+                                             const shield_xensiv_a_cfg_t* cfg)
+{
+    cy_rslt_t result = _shield_xensiv_a_init_timer(shield);
+
+#if SHIELD_XENSIV_A_USE_CO2
+    /* Power the CO2 sensor first, so that its warm-up overlaps with the
+       initialization of everything else */
+    if (_shield_xensiv_a_init_wanted(shield, result, SHIELD_XENSIV_A_READY_CO2))
+    {
+        result = cyhal_gpio_init(shield->pins.co2_pwr_en, CYHAL_GPIO_DIR_OUTPUT,
+                                 CYHAL_GPIO_DRIVE_STRONG, true);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            shield->initialized |= _SHIELD_XENSIV_A_INITIALIZED_CO2_POWER;
+            shield->co2_power_on_us = shield_xensiv_a_ctx_get_timestamp_us(shield);
+            /* A sensor which kept its supply across the reset needs no
+               warm-up, so it is tried right away */
+            shield->co2_next_attempt_ms =
+                ((shield->warm_devices & SHIELD_XENSIV_A_READY_CO2) != 0)
+                ? 0UL : SHIELD_XENSIV_A_CO2_WARMUP_MS;
+        }
+    }
+#endif
+
+    if (_shield_xensiv_a_init_wanted(shield, result, I2C_DEVICES))
+    {
+        if (NULL == cfg->i2c_instance)
+        {
+            result = _shield_xensiv_a_init_i2c(shield);
+        }
+        else
+        {
+            shield->i2c_ptr = cfg->i2c_instance;
+        }
+    }
+
+    /* The radar sensor is not part of the ready mask, so it is selected by a
+       configuration member of its own */
+    if ((CY_RSLT_SUCCESS == result) &&
+        ((SHIELD_XENSIV_A_USE_RADAR && cfg->radar) ||
+         ((shield->devices & SHIELD_XENSIV_A_READY_DISPLAY) != 0)))
+    {
+        if (NULL == cfg->spi_instance)
+        {
+            result = cyhal_spi_init(&shield->spi, shield->pins.spi_mosi,
+                                    shield->pins.spi_miso,
+                                    shield->pins.spi_sck,
+                                    shield->pins.spi_cs,
+                                    NULL, BITS_PER_FRAME,
+                                    CYHAL_SPI_MODE_00_MSB, false);
+            if (CY_RSLT_SUCCESS == result)
+            {
+                shield->spi_ptr = &shield->spi;
+                result = cyhal_spi_set_frequency(&shield->spi,
+                                                 (0UL != cfg->spi_frequency_hz)
+                                                 ? cfg->spi_frequency_hz
+                                                 : SHIELD_XENSIV_A_SPI_FREQ_HZ);
+            }
+        }
+        else
+        {
+            shield->spi_ptr = cfg->spi_instance;
+        }
+
+        if (CY_RSLT_SUCCESS == result)
+        {
+            result = cyhal_gpio_init(shield->pins.spi_cs_sel0, CYHAL_GPIO_DIR_OUTPUT,
+                                     CYHAL_GPIO_DRIVE_STRONG, SHIELD_XENSIV_A_SPI_SEL0_DISPLAY);
+            if (CY_RSLT_SUCCESS == result)
+            {
+                shield->initialized |= _SHIELD_XENSIV_A_INITIALIZED_SPI_SEL;
+                shield->spi_owner = SHIELD_XENSIV_A_SPI_DEVICE_NONE;
+            }
+        }
+    }
+
+    return result;
+}
+
+
+#if SHIELD_XENSIV_A_USE_DISPLAY
+/******************************************************************************
+* _shield_xensiv_a_init_display
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_init_display(shield_xensiv_a_t* shield)
+{
+    cy_rslt_t result = SHIELD_XENSIV_A_RSLT_ERR_BUSY;
+
+    if (NULL == _shield_display_owner)
+    {
+        shield->display_pins.dc  = shield->pins.spi_dc_ds;
+        shield->display_pins.rst = shield->pins.main_rst;
+        result = mtb_st7735s_init_spi(shield->spi_ptr, &shield->display_pins);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            _shield_display_owner = shield;
+        }
+    }
+
+    return result;
+}
+#endif
+
+
+/******************************************************************************
+* _shield_xensiv_a_init_devices
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_init_devices(shield_xensiv_a_t* shield,
+                                               const shield_xensiv_a_cfg_t* cfg)
+{
+    cy_rslt_t result = _shield_xensiv_a_init_buses(shield, cfg);
+
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+    if (_shield_xensiv_a_init_wanted(shield, result, SHIELD_XENSIV_A_READY_HUMIDITY))
+    {
+        result = _shield_xensiv_a_init_step(shield, SHIELD_XENSIV_A_READY_HUMIDITY,
+                                            _shield_xensiv_a_init_sensor(shield,
+                                                SHIELD_XENSIV_A_READY_HUMIDITY));
+    }
+#endif
+
+#if SHIELD_XENSIV_A_USE_MOTION
+    if (_shield_xensiv_a_init_wanted(shield, result, SHIELD_XENSIV_A_READY_MOTION))
+    {
+        cy_rslt_t motion_result = CY_RSLT_SUCCESS;
+        if (((shield->warm_devices & SHIELD_XENSIV_A_READY_MOTION) != 0) &&
+            _shield_xensiv_a_restore_motion(shield, cfg->warm_state))
+        {
+            shield->restored |= SHIELD_XENSIV_A_READY_MOTION;
+        }
+        else
+        {
+            motion_result = _shield_xensiv_a_init_sensor(shield, SHIELD_XENSIV_A_READY_MOTION);
+        }
+        result = _shield_xensiv_a_init_step(shield, SHIELD_XENSIV_A_READY_MOTION, motion_result);
+    }
+#endif
+
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+    if (_shield_xensiv_a_init_wanted(shield, result, SHIELD_XENSIV_A_READY_MAGNETOMETER))
+    {
+        cy_rslt_t mag_result = CY_RSLT_SUCCESS;
+        if (((shield->warm_devices & SHIELD_XENSIV_A_READY_MAGNETOMETER) != 0) &&
+            _shield_xensiv_a_restore_mag(shield, cfg->warm_state))
+        {
+            shield->restored |= SHIELD_XENSIV_A_READY_MAGNETOMETER;
+        }
+        else
+        {
+            mag_result = _shield_xensiv_a_init_sensor(shield,
+                                                      SHIELD_XENSIV_A_READY_MAGNETOMETER);
+        }
+        result = _shield_xensiv_a_init_step(shield, SHIELD_XENSIV_A_READY_MAGNETOMETER,
+                                            mag_result);
+    }
+#endif
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+    if (_shield_xensiv_a_init_wanted(shield, result, SHIELD_XENSIV_A_READY_PRESSURE))
+    {
+        result = _shield_xensiv_a_init_step(shield, SHIELD_XENSIV_A_READY_PRESSURE,
+                                            _shield_xensiv_a_init_sensor(shield,
+                                                SHIELD_XENSIV_A_READY_PRESSURE));
+    }
+#endif
+
+#if SHIELD_XENSIV_A_USE_PDM
+    if (_shield_xensiv_a_init_wanted(shield, result, SHIELD_XENSIV_A_READY_PDM) &&
+        (NULL != cfg->audio_clock_inst) && (NULL != cfg->pdm_pcm_cfg))
+    {
+        result = _shield_xensiv_a_init_step(shield, SHIELD_XENSIV_A_READY_PDM,
+                                            cyhal_pdm_pcm_init(&shield->pdm_pcm,
+                                                               shield->pins.pdm_data,
+                                                               shield->pins.pdm_clk,
+                                                               cfg->audio_clock_inst,
+                                                               cfg->pdm_pcm_cfg));
+    }
+#endif
+
+#if SHIELD_XENSIV_A_USE_DISPLAY
+    if (_shield_xensiv_a_init_wanted(shield, result, SHIELD_XENSIV_A_READY_DISPLAY))
+    {
+        result = _shield_xensiv_a_init_step(shield, SHIELD_XENSIV_A_READY_DISPLAY,
+                                            _shield_xensiv_a_init_display(shield));
+    }
+#endif
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_init
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_init(cyhal_i2c_t* i2c_instance,
+                               cyhal_spi_t* spi_instance,
+                               const cyhal_pdm_pcm_cfg_t* pdm_pcm_cfg,
+                               cyhal_clock_t* audio_clock_inst)
+{
+    shield_xensiv_a_cfg_t cfg;
+
+    _shield_xensiv_a_make_cfg(&cfg, i2c_instance, spi_instance, pdm_pcm_cfg, audio_clock_inst,
+                              NULL, NULL);
+
+    return shield_xensiv_a_init_cfg(&cfg);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_init_start
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_init_start(cyhal_i2c_t* i2c_instance,
+                                     cyhal_spi_t* spi_instance,
+                                     const cyhal_pdm_pcm_cfg_t* pdm_pcm_cfg,
+                                     cyhal_clock_t* audio_clock_inst,
+                                     shield_xensiv_a_init_callback_t callback,
+                                     void* callback_arg)
+{
+    shield_xensiv_a_cfg_t cfg;
+
+    _shield_xensiv_a_make_cfg(&cfg, i2c_instance, spi_instance, pdm_pcm_cfg, audio_clock_inst,
+                              callback, callback_arg);
+
+    return shield_xensiv_a_init_start_cfg(&cfg);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_init_cfg
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_init_cfg(const shield_xensiv_a_cfg_t* cfg)
+{
+    return shield_xensiv_a_ctx_init_cfg(&_shield_default, cfg);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_init_start_cfg
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_init_start_cfg(const shield_xensiv_a_cfg_t* cfg)
+{
+    return shield_xensiv_a_ctx_init_start_cfg(&_shield_default, cfg);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_init_poll
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_init_poll(void)
+{
+    return shield_xensiv_a_ctx_init_poll(&_shield_default);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_get_ready_mask
+******************************************************************************/
+uint32_t shield_xensiv_a_get_ready_mask(void)
+{
+    return shield_xensiv_a_ctx_get_ready_mask(&_shield_default);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_get_restored_mask
+******************************************************************************/
+uint32_t shield_xensiv_a_get_restored_mask(void)
+{
+    return shield_xensiv_a_ctx_get_restored_mask(&_shield_default);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_save_warm_state
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_save_warm_state(uint32_t image_id,
+                                          shield_xensiv_a_warm_state_t* state)
+{
+    return shield_xensiv_a_ctx_save_warm_state(&_shield_default, image_id, state);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_reinit
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_reinit(uint32_t device)
+{
+    return shield_xensiv_a_ctx_reinit(&_shield_default, device);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_recover_i2c
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_recover_i2c(void)
+{
+    return shield_xensiv_a_ctx_recover_i2c(&_shield_default);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_get_timestamp_us
+******************************************************************************/
+uint32_t shield_xensiv_a_get_timestamp_us(void)
+{
+    return shield_xensiv_a_ctx_get_timestamp_us(&_shield_default);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_get_i2c
+******************************************************************************/
+cyhal_i2c_t* shield_xensiv_a_get_i2c(void)
+{
+    return shield_xensiv_a_ctx_get_i2c(&_shield_default);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_get_spi
+******************************************************************************/
+cyhal_spi_t* shield_xensiv_a_get_spi(void)
+{
+    return shield_xensiv_a_ctx_get_spi(&_shield_default);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_set_spi_frequency
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_set_spi_frequency(uint32_t frequency_hz)
+{
+    return shield_xensiv_a_ctx_set_spi_frequency(&_shield_default, frequency_hz);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_spi_acquire
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_spi_acquire(shield_xensiv_a_spi_device_t device)
+{
+    return shield_xensiv_a_ctx_spi_acquire(&_shield_default, device);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_spi_release
+******************************************************************************/
+void shield_xensiv_a_spi_release(shield_xensiv_a_spi_device_t device)
+{
+    shield_xensiv_a_ctx_spi_release(&_shield_default, device);
+}
+
+
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+/******************************************************************************
+* shield_xensiv_a_get_humidity_sensor
+******************************************************************************/
+cyhal_i2c_t* shield_xensiv_a_get_humidity_sensor(void)
+{
+    return shield_xensiv_a_ctx_get_humidity_sensor(&_shield_default);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_sht35_crc
+******************************************************************************/
+static uint8_t _shield_xensiv_a_sht35_crc(const uint8_t* data)
+{
+    uint8_t crc = SHT35_CRC_INIT;
+
+    for (uint8_t i = 0; i < 2U; i++)
+    {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8U; bit++)
+        {
+            crc = ((crc & 0x80U) != 0) ? (uint8_t)((crc << 1) ^ SHT35_CRC_POLYNOMIAL)
+                                       : (uint8_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_sht35_command
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_sht35_command(uint16_t command)
+{
+    uint8_t data[2] = { (uint8_t)(command >> 8), (uint8_t)command };
+
+    SHIELD_XENSIV_A_METRICS_BEGIN(start_us);
+    cy_rslt_t result = cyhal_i2c_master_write(shield_xensiv_a_get_humidity_sensor(),
+                                              MTB_SHT35_ADDRESS_DEFAULT, data, sizeof(data),
+                                              SHT35_I2C_TIMEOUT_MS, true);
+    SHIELD_XENSIV_A_METRICS_END(SHIELD_XENSIV_A_METRICS_HUMIDITY, start_us, sizeof(data), result);
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_sht35_read
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_sht35_read(float* temperature, float* humidity)
+{
+    uint8_t data[6];
+
+    SHIELD_XENSIV_A_METRICS_BEGIN(start_us);
+    cy_rslt_t result = cyhal_i2c_master_read(shield_xensiv_a_get_humidity_sensor(),
+                                             MTB_SHT35_ADDRESS_DEFAULT, data, sizeof(data),
+                                             SHT35_I2C_TIMEOUT_MS, true);
+    SHIELD_XENSIV_A_METRICS_END(SHIELD_XENSIV_A_METRICS_HUMIDITY, start_us, sizeof(data), result);
+    if ((CY_RSLT_SUCCESS == result) &&
+        ((_shield_xensiv_a_sht35_crc(&data[0]) != data[2]) ||
+         (_shield_xensiv_a_sht35_crc(&data[3]) != data[5])))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_SENSOR;
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        uint16_t raw_temperature = (uint16_t)(((uint16_t)data[0] << 8) | data[1]);
+        uint16_t raw_humidity = (uint16_t)(((uint16_t)data[3] << 8) | data[4]);
+
+        *temperature = -45.0f + ((175.0f * (float)raw_temperature) / 65535.0f);
+        *humidity = (100.0f * (float)raw_humidity) / 65535.0f;
+    }
+
+    return result;
+}
+#endif
+
+
+#if SHIELD_XENSIV_A_USE_MOTION
+/******************************************************************************
+* shield_xensiv_a_get_motion_sensor
+******************************************************************************/
+mtb_bmi270_t* shield_xensiv_a_get_motion_sensor(void)
+{
+    return shield_xensiv_a_ctx_get_motion_sensor(&_shield_default);
+}
+#endif
+
+
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+/******************************************************************************
+* shield_xensiv_a_get_mag_sensor
+******************************************************************************/
+mtb_bmm350_t* shield_xensiv_a_get_mag_sensor(void)
+{
+    return shield_xensiv_a_ctx_get_mag_sensor(&_shield_default);
+}
+#endif
 
 
+#if SHIELD_XENSIV_A_USE_PRESSURE
 /******************************************************************************
-* shield_xensiv_a_init
+* shield_xensiv_a_get_pressure_sensor
 ******************************************************************************/
-cy_rslt_t shield_xensiv_a_init(cyhal_i2c_t* i2c_instance,
-                               cyhal_spi_t* spi_instance,
-                               const cyhal_pdm_pcm_cfg_t* pdm_pcm_cfg,
-                               cyhal_clock_t* audio_clock_inst)
+xensiv_dps3xx_t* shield_xensiv_a_get_pressure_sensor(void)
 {
-    cy_rslt_t result = CY_RSLT_SUCCESS;
+    return shield_xensiv_a_ctx_get_pressure_sensor(&_shield_default);
+}
+#endif
+
+
+/******************************************************************************
+* shield_xensiv_a_get_pdm
+******************************************************************************/
+cyhal_pdm_pcm_t* shield_xensiv_a_get_pdm(void)
+{
+    return shield_xensiv_a_ctx_get_pdm(&_shield_default);
+}
+
+
+#if SHIELD_XENSIV_A_USE_CO2
+/******************************************************************************
+* shield_xensiv_a_get_co2_sensor
+******************************************************************************/
+xensiv_pasco2_t* shield_xensiv_a_get_co2_sensor(void)
+{
+    return shield_xensiv_a_ctx_get_co2_sensor(&_shield_default);
+}
+#endif
+
+
+/******************************************************************************
+* shield_xensiv_a_free
+******************************************************************************/
+void shield_xensiv_a_free(void)
+{
+    shield_xensiv_a_ctx_free(&_shield_default);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_get_default
+******************************************************************************/
+shield_xensiv_a_t* shield_xensiv_a_get_default(void)
+{
+    return &_shield_default;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_get_pins
+******************************************************************************/
+const shield_xensiv_a_pins_t* shield_xensiv_a_get_pins(void)
+{
+    return &_shield_default.pins;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_ctx_init_cfg
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_init_cfg(shield_xensiv_a_t* shield,
+                                       const shield_xensiv_a_cfg_t* cfg)
+{
+    cy_rslt_t result = shield_xensiv_a_ctx_init_start_cfg(shield, cfg);
 
-    if (NULL == i2c_instance)
+    if (CY_RSLT_SUCCESS == result)
     {
-        static const cyhal_i2c_cfg_t i2c_cfg =
+        result = shield_xensiv_a_ctx_init_poll(shield);
+        while (SHIELD_XENSIV_A_RSLT_PENDING == result)
         {
-            .is_slave        = false,
-            .address         = 0,
-            .frequencyhal_hz = 400000
-        };
-        result = cyhal_i2c_init(&_shield_i2c, SHIELD_XENSIV_A_PIN_I2C_SDA,
-                                SHIELD_XENSIV_A_PIN_I2C_SCL, NULL);
-        if (CY_RSLT_SUCCESS == result)
+            cyhal_system_delay_ms(INIT_POLL_INTERVAL_MS);
+            result = shield_xensiv_a_ctx_init_poll(shield);
+        }
+
+        if (CY_RSLT_SUCCESS != result)
         {
-            _shield_i2c_ptr = &_shield_i2c;
-            result  = cyhal_i2c_configure(&_shield_i2c, &i2c_cfg);
+            shield_xensiv_a_ctx_free(shield);
         }
     }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_ctx_init_start_cfg
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_init_start_cfg(shield_xensiv_a_t* shield,
+                                             const shield_xensiv_a_cfg_t* cfg)
+{
+    static const shield_xensiv_a_pins_t default_pins = SHIELD_XENSIV_A_PINS_DEFAULT;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((NULL == shield) || (NULL == cfg) ||
+        ((cfg->required & ~(cfg->devices & SHIELD_XENSIV_A_READY_AVAILABLE)) != 0) ||
+        (((cfg->required & SHIELD_XENSIV_A_READY_PDM) != 0) &&
+         ((NULL == cfg->pdm_pcm_cfg) || (NULL == cfg->audio_clock_inst))))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
     else
     {
-        _shield_i2c_ptr = i2c_instance;
+        memset(shield, 0, sizeof(*shield));
+        shield->pins              = (NULL != cfg->pins) ? *cfg->pins : default_pins;
+        shield->devices           = cfg->devices & SHIELD_XENSIV_A_READY_AVAILABLE;
+        shield->required          = cfg->required;
+        shield->init_callback     = cfg->callback;
+        shield->init_callback_arg = cfg->callback_arg;
+        shield->warm_devices      = _shield_xensiv_a_warm_devices(cfg) & shield->devices;
+
+        result = _shield_xensiv_a_init_devices(shield, cfg);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            shield->init_pending = true;
+            shield->init_result  = SHIELD_XENSIV_A_RSLT_PENDING;
+        }
+        else
+        {
+            shield_xensiv_a_ctx_free(shield);
+        }
     }
 
-    if (CY_RSLT_SUCCESS == result)
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_ctx_init_poll
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_init_poll(shield_xensiv_a_t* shield)
+{
+#if SHIELD_XENSIV_A_USE_CO2
+    if (shield->init_pending && ((shield->initialized & _SHIELD_XENSIV_A_INITIALIZED_CO2_POWER) > 0))
     {
-        if (NULL == spi_instance)
+        uint32_t elapsed_ms = (shield_xensiv_a_ctx_get_timestamp_us(shield) -
+                               shield->co2_power_on_us) / US_PER_MS;
+
+        if (shield->co2_power_off)
         {
-            result = cyhal_spi_init(&_shield_spi, SHIELD_XENSIV_A_PIN_SPI_MOSI,
-                                    SHIELD_XENSIV_A_PIN_SPI_MISO,
-                                    SHIELD_XENSIV_A_PIN_SPI_SCK,
-                                    SHIELD_XENSIV_A_PIN_SPI_CS,
-                                    NULL, BITS_PER_FRAME,
-                                    CYHAL_SPI_MODE_00_MSB, false);
-            if (CY_RSLT_SUCCESS == result)
+            /* The power cycle of a reinitialization is over */
+            if (elapsed_ms >= SHIELD_XENSIV_A_CO2_POWER_OFF_MS)
             {
-                _shield_spi_ptr = &_shield_spi;
-                result = cyhal_spi_set_frequency(&_shield_spi, SPI_FREQ_HZ);
+                cyhal_gpio_write(shield->pins.co2_pwr_en, true);
+                shield->co2_power_on_us = shield_xensiv_a_ctx_get_timestamp_us(shield);
+                shield->co2_power_off   = false;
             }
         }
-        else
+        else if (elapsed_ms >= shield->co2_next_attempt_ms)
         {
-            _shield_spi_ptr = spi_instance;
+            cy_rslt_t result = xensiv_pasco2_mtb_init_i2c(&shield->co2_sensor, shield->i2c_ptr);
+            if (CY_RSLT_SUCCESS == result)
+            {
+                if (elapsed_ms < SHIELD_XENSIV_A_CO2_WARMUP_MS)
+                {
+                    /* Only reachable when the sensor was restored warm */
+                    shield->restored |= SHIELD_XENSIV_A_READY_CO2;
+                }
+                _shield_xensiv_a_finish_init(shield,
+                    _shield_xensiv_a_init_step(shield, SHIELD_XENSIV_A_READY_CO2, result));
+            }
+            else if (elapsed_ms >= SHIELD_XENSIV_A_CO2_READY_TIMEOUT_MS)
+            {
+                /* Leave the remaining sensors running, only drop the CO2 sensor */
+                cyhal_gpio_write(shield->pins.co2_pwr_en, false);
+                _shield_xensiv_a_finish_init(shield,
+                    _shield_xensiv_a_init_step(shield, SHIELD_XENSIV_A_READY_CO2,
+                                               SHIELD_XENSIV_A_RSLT_ERR_CO2_TIMEOUT));
+            }
+            else
+            {
+                SHIELD_XENSIV_A_METRICS_RETRY(SHIELD_XENSIV_A_METRICS_CO2);
+                shield->co2_next_attempt_ms = elapsed_ms + SHIELD_XENSIV_A_CO2_RETRY_MS;
+            }
         }
     }
+#endif
 
-    if (CY_RSLT_SUCCESS == result)
+    /* Without the CO2 sensor there is nothing to wait for */
+    if (shield->init_pending && ((shield->initialized & _SHIELD_XENSIV_A_INITIALIZED_CO2_POWER) == 0))
     {
-        result = mtb_sht3x_init(_shield_i2c_ptr, MTB_SHT35_ADDRESS_DEFAULT);
+        _shield_xensiv_a_finish_init(shield, CY_RSLT_SUCCESS);
     }
 
-    if (CY_RSLT_SUCCESS == result)
+    return shield->init_result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_ctx_get_ready_mask
+******************************************************************************/
+uint32_t shield_xensiv_a_ctx_get_ready_mask(const shield_xensiv_a_t* shield)
+{
+    return shield->initialized & SHIELD_XENSIV_A_READY_ALL;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_ctx_get_restored_mask
+******************************************************************************/
+uint32_t shield_xensiv_a_ctx_get_restored_mask(const shield_xensiv_a_t* shield)
+{
+    return shield->restored & shield_xensiv_a_ctx_get_ready_mask(shield);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_ctx_save_warm_state
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_save_warm_state(const shield_xensiv_a_t* shield,
+                                              uint32_t image_id,
+                                              shield_xensiv_a_warm_state_t* state)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((NULL == shield) || (NULL == state))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if (CY_RSLT_SUCCESS != shield->init_result)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        /* Cleared first, so that padding does not change the checksum */
+        memset(state, 0, sizeof(*state));
+        state->magic    = WARM_STATE_MAGIC;
+        state->version  = WARM_STATE_VERSION;
+        state->size     = (uint16_t)sizeof(*state);
+        state->image_id = image_id;
+        state->devices  = shield_xensiv_a_ctx_get_ready_mask(shield) & WARM_DEVICES;
+#if SHIELD_XENSIV_A_USE_MOTION
+        state->motion_sensor = shield->motion_sensor;
+#endif
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+        state->mag_sensor    = shield->mag_sensor;
+#endif
+        state->checksum = _shield_xensiv_a_crc32(state,
+                                                 offsetof(shield_xensiv_a_warm_state_t, checksum));
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_ctx_reinit
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_reinit(shield_xensiv_a_t* shield, uint32_t device)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((NULL == shield) || ((device & I2C_DEVICES) != device) ||
+        ((device & (device - 1U)) != 0) || ((shield->devices & device) == 0))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if (NULL == shield->i2c_ptr)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else if (shield->init_pending)
     {
-        _shield_initialized |= _SHIELD_XENSIV_A_INITIALIZED_HUMIDITY;
-        result = mtb_bmi270_init_i2c(&motion_sensor, _shield_i2c_ptr, MTB_BMI270_ADDRESS_SEC);
+        result = SHIELD_XENSIV_A_RSLT_ERR_BUSY;
+    }
+#if SHIELD_XENSIV_A_USE_CO2
+    else if (SHIELD_XENSIV_A_READY_CO2 == device)
+    {
+        if ((shield->initialized & _SHIELD_XENSIV_A_INITIALIZED_CO2_POWER) == 0)
+        {
+            result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+        }
+        else
+        {
+            /* Power cycle the sensor and let the staged initialization wait
+               for it, the other sensors keep running meanwhile. Until the
+               supply is switched on again, co2_power_on_us holds the time it
+               was switched off. */
+            shield->initialized &= ~SHIELD_XENSIV_A_READY_CO2;
+            shield->restored    &= ~SHIELD_XENSIV_A_READY_CO2;
+            cyhal_gpio_write(shield->pins.co2_pwr_en, false);
+            shield->co2_power_off       = true;
+            shield->co2_power_on_us     = shield_xensiv_a_ctx_get_timestamp_us(shield);
+            shield->co2_next_attempt_ms = SHIELD_XENSIV_A_CO2_WARMUP_MS;
+            shield->init_pending        = true;
+            shield->init_result         = SHIELD_XENSIV_A_RSLT_PENDING;
+            result = SHIELD_XENSIV_A_RSLT_PENDING;
+        }
+    }
+#endif
+    else
+    {
+        _shield_xensiv_a_free_sensor(shield, device);
+        shield->restored &= ~device;
+        result = _shield_xensiv_a_init_sensor(shield, device);
         if (CY_RSLT_SUCCESS == result)
         {
-            result = mtb_bmi270_config_default(&motion_sensor);
+            shield->initialized |= device;
         }
     }
 
-    if (CY_RSLT_SUCCESS == result)
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_ctx_recover_i2c
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_recover_i2c(shield_xensiv_a_t* shield)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == shield)
     {
-        _shield_initialized |= _SHIELD_XENSIV_A_INITIALIZED_MOTION;
-        result = mtb_bmm350_init_i2c(&mag_sensor, _shield_i2c_ptr, MTB_BMM350_ADDRESS_DEFAULT);
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
     }
-
-    if (CY_RSLT_SUCCESS == result)
+    else if (shield->i2c_ptr != &shield->i2c)
     {
-        _shield_initialized |= _SHIELD_XENSIV_A_INITIALIZED_MAGNETOMETER;
-        result = xensiv_dps3xx_mtb_init_i2c(&pressure_sensor, _shield_i2c_ptr,
-                                            XENSIV_DPS3XX_I2C_ADDR_ALT);
+        /* Only a bus set up by the shield can be taken over and restored */
+        result = (NULL == shield->i2c_ptr)
+                 ? SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED
+                 : SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
     }
-
-    if (CY_RSLT_SUCCESS == result)
+    else if (shield_xensiv_a_i2c_sched_uses(shield->i2c_ptr))
+    {
+        /* The scheduler owns the callback and events of the I2C object and
+           may have a transfer in progress */
+        result = SHIELD_XENSIV_A_RSLT_ERR_BUSY;
+    }
+    else
     {
-        _shield_initialized |= _SHIELD_XENSIV_A_INITIALIZED_PRESSURE;
-        if ((NULL != audio_clock_inst) && (NULL != pdm_pcm_cfg))
+        cyhal_i2c_free(&shield->i2c);
+        shield->i2c_ptr = NULL;
+
+        result = _shield_xensiv_a_clear_i2c_bus(&shield->pins);
+        cy_rslt_t i2c_result = _shield_xensiv_a_init_i2c(shield);
+        if (CY_RSLT_SUCCESS != i2c_result)
         {
-            result = cyhal_pdm_pcm_init(&_shield_pdm_pcm, SHIELD_XENSIV_A_PIN_PDM_DATA,
-                                        SHIELD_XENSIV_A_PIN_PDM_CLK, audio_clock_inst,
-                                        pdm_pcm_cfg);
-            if (CY_RSLT_SUCCESS == result)
+            /* The sensors cannot be reached anymore */
+            if (NULL != shield->i2c_ptr)
+            {
+                cyhal_i2c_free(shield->i2c_ptr);
+                shield->i2c_ptr = NULL;
+            }
+            shield->initialized &= ~I2C_DEVICES;
+            if (shield->init_pending)
             {
-                _shield_initialized |= _SHIELD_XENSIV_A_INITIALIZED_PDM;
+                _shield_xensiv_a_finish_init(shield, i2c_result);
             }
+            result = i2c_result;
         }
     }
 
-    if (CY_RSLT_SUCCESS == result)
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_ctx_get_timestamp_us
+******************************************************************************/
+uint32_t shield_xensiv_a_ctx_get_timestamp_us(shield_xensiv_a_t* shield)
+{
+    return ((shield->initialized & _SHIELD_XENSIV_A_INITIALIZED_TIMER) > 0)
+        ? cyhal_timer_read(&shield->timer)
+        : 0;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_ctx_get_i2c
+******************************************************************************/
+cyhal_i2c_t* shield_xensiv_a_ctx_get_i2c(const shield_xensiv_a_t* shield)
+{
+    return shield->i2c_ptr;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_ctx_get_spi
+******************************************************************************/
+cyhal_spi_t* shield_xensiv_a_ctx_get_spi(const shield_xensiv_a_t* shield)
+{
+    return shield->spi_ptr;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_ctx_set_spi_frequency
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_set_spi_frequency(shield_xensiv_a_t* shield, uint32_t frequency_hz)
+{
+    return (NULL != shield->spi_ptr)
+        ? cyhal_spi_set_frequency(shield->spi_ptr, frequency_hz)
+        : SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_ctx_spi_acquire
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_spi_acquire(shield_xensiv_a_t* shield,
+                                          shield_xensiv_a_spi_device_t device)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY != device) &&
+        (SHIELD_XENSIV_A_SPI_DEVICE_RADAR != device))
     {
-        result = mtb_st7735s_init_spi(_shield_spi_ptr, &tft_pins);
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
     }
-
-    if (CY_RSLT_SUCCESS == result)
+    else if ((shield->initialized & _SHIELD_XENSIV_A_INITIALIZED_SPI_SEL) == 0)
     {
-        _shield_initialized |= _SHIELD_XENSIV_A_INITIALIZED_DISPLAY;
-        result = cyhal_gpio_init(SHIELD_XENSIV_A_PIN_CO2_PWR_EN, CYHAL_GPIO_DIR_OUTPUT,
-                                 CYHAL_GPIO_DRIVE_STRONG, true);
-        if (CY_RSLT_SUCCESS == result)
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        uint32_t state = cyhal_system_critical_section_enter();
+        if (SHIELD_XENSIV_A_SPI_DEVICE_NONE == shield->spi_owner)
+        {
+            shield->spi_owner = device;
+            cyhal_gpio_write(shield->pins.spi_cs_sel0,
+                             (SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY == device)
+                             ? SHIELD_XENSIV_A_SPI_SEL0_DISPLAY
+                             : !SHIELD_XENSIV_A_SPI_SEL0_DISPLAY);
+        }
+        else
         {
-            result = xensiv_pasco2_mtb_init_i2c(&co2_sensor, _shield_i2c_ptr);
+            result = SHIELD_XENSIV_A_RSLT_ERR_BUSY;
         }
+        cyhal_system_critical_section_exit(state);
     }
 
-    if (CY_RSLT_SUCCESS != result)
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_ctx_spi_release
+******************************************************************************/
+void shield_xensiv_a_ctx_spi_release(shield_xensiv_a_t* shield,
+                                     shield_xensiv_a_spi_device_t device)
+{
+    uint32_t state = cyhal_system_critical_section_enter();
+    if ((SHIELD_XENSIV_A_SPI_DEVICE_NONE != device) && (device == shield->spi_owner))
     {
-        shield_xensiv_a_free();
+        shield->spi_owner = SHIELD_XENSIV_A_SPI_DEVICE_NONE;
+        cyhal_gpio_write(shield->pins.spi_cs_sel0, SHIELD_XENSIV_A_SPI_SEL0_DISPLAY);
     }
-
-    return result;
+    cyhal_system_critical_section_exit(state);
 }
 
 
+#if SHIELD_XENSIV_A_USE_HUMIDITY
 /******************************************************************************
-* shield_xensiv_a_get_humidity_sensor
+* shield_xensiv_a_ctx_get_humidity_sensor
 ******************************************************************************/
-cyhal_i2c_t* shield_xensiv_a_get_humidity_sensor(void)
+cyhal_i2c_t* shield_xensiv_a_ctx_get_humidity_sensor(const shield_xensiv_a_t* shield)
 {
-    return _shield_i2c_ptr;
+    return shield->i2c_ptr;
 }
+#endif
 
 
+#if SHIELD_XENSIV_A_USE_MOTION
 /******************************************************************************
-* shield_xensiv_a_get_motion_sensor
+* shield_xensiv_a_ctx_get_motion_sensor
 ******************************************************************************/
-mtb_bmi270_t* shield_xensiv_a_get_motion_sensor(void)
+mtb_bmi270_t* shield_xensiv_a_ctx_get_motion_sensor(shield_xensiv_a_t* shield)
 {
-    return &motion_sensor;
+    return &shield->motion_sensor;
 }
+#endif
 
 
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
 /******************************************************************************
-* shield_xensiv_a_get_mag_sensor
+* shield_xensiv_a_ctx_get_mag_sensor
 ******************************************************************************/
-mtb_bmm350_t* shield_xensiv_a_get_mag_sensor(void)
+mtb_bmm350_t* shield_xensiv_a_ctx_get_mag_sensor(shield_xensiv_a_t* shield)
 {
-    return &mag_sensor;
+    return &shield->mag_sensor;
 }
+#endif
 
 
+#if SHIELD_XENSIV_A_USE_PRESSURE
 /******************************************************************************
-* shield_xensiv_a_get_pressure_sensor
+* shield_xensiv_a_ctx_get_pressure_sensor
 ******************************************************************************/
-xensiv_dps3xx_t* shield_xensiv_a_get_pressure_sensor(void)
+xensiv_dps3xx_t* shield_xensiv_a_ctx_get_pressure_sensor(shield_xensiv_a_t* shield)
 {
-    return &pressure_sensor;
+    return &shield->pressure_sensor;
 }
+#endif
 
 
 /******************************************************************************
-* shield_xensiv_a_get_pdm
+* shield_xensiv_a_ctx_get_pdm
 ******************************************************************************/
-cyhal_pdm_pcm_t* shield_xensiv_a_get_pdm(void)
+cyhal_pdm_pcm_t* shield_xensiv_a_ctx_get_pdm(shield_xensiv_a_t* shield)
 {
-    return ((_shield_initialized & _SHIELD_XENSIV_A_INITIALIZED_PDM) > 0)
-        ? &_shield_pdm_pcm
+#if SHIELD_XENSIV_A_USE_PDM
+    return ((shield->initialized & _SHIELD_XENSIV_A_INITIALIZED_PDM) > 0)
+        ? &shield->pdm_pcm
         : NULL;
+#else
+    (void)shield;
+    return NULL;
+#endif
 }
 
 
+#if SHIELD_XENSIV_A_USE_CO2
 /******************************************************************************
-* shield_xensiv_a_get_co2_sensor
+* shield_xensiv_a_ctx_get_co2_sensor
 ******************************************************************************/
-xensiv_pasco2_t* shield_xensiv_a_get_co2_sensor(void)
+xensiv_pasco2_t* shield_xensiv_a_ctx_get_co2_sensor(shield_xensiv_a_t* shield)
 {
-    return &co2_sensor;
+    return &shield->co2_sensor;
 }
+#endif
 
 
 /******************************************************************************
-* shield_xensiv_a_free
+* shield_xensiv_a_ctx_free
 ******************************************************************************/
-void shield_xensiv_a_free(void)
+void shield_xensiv_a_ctx_free(shield_xensiv_a_t* shield)
 {
-    if ((_shield_initialized & _SHIELD_XENSIV_A_INITIALIZED_HUMIDITY) > 0)
-    {
-        mtb_sht3x_free(_shield_i2c_ptr);
-    }
-
-    if ((_shield_initialized & _SHIELD_XENSIV_A_INITIALIZED_MOTION) > 0)
+    _shield_xensiv_a_free_sensor(shield, SHIELD_XENSIV_A_READY_HUMIDITY);
+    _shield_xensiv_a_free_sensor(shield, SHIELD_XENSIV_A_READY_MOTION);
+    _shield_xensiv_a_free_sensor(shield, SHIELD_XENSIV_A_READY_MAGNETOMETER);
+    _shield_xensiv_a_free_sensor(shield, SHIELD_XENSIV_A_READY_PRESSURE);
+#if SHIELD_XENSIV_A_USE_PDM
+    if ((shield->initialized & _SHIELD_XENSIV_A_INITIALIZED_PDM) > 0)
     {
-        mtb_bmi270_free_pin(&motion_sensor);
+        cyhal_pdm_pcm_free(&shield->pdm_pcm);
     }
-    if ((_shield_initialized & _SHIELD_XENSIV_A_INITIALIZED_MAGNETOMETER) > 0)
+#endif
+#if SHIELD_XENSIV_A_USE_DISPLAY
+    if ((shield->initialized & _SHIELD_XENSIV_A_INITIALIZED_DISPLAY) > 0)
     {
-        mtb_bmm350_free_pin(&mag_sensor);
+        mtb_st7735s_free();
+        _shield_display_owner = NULL;
     }
-    if ((_shield_initialized & _SHIELD_XENSIV_A_INITIALIZED_PRESSURE) > 0)
+#endif
+    if ((shield->initialized & _SHIELD_XENSIV_A_INITIALIZED_CO2_POWER) > 0)
     {
-        xensiv_dps3xx_free(&pressure_sensor);
+        cyhal_gpio_write(shield->pins.co2_pwr_en, false);
+        cyhal_gpio_free(shield->pins.co2_pwr_en);
     }
-    if ((_shield_initialized & _SHIELD_XENSIV_A_INITIALIZED_PDM) > 0)
+    if ((shield->initialized & _SHIELD_XENSIV_A_INITIALIZED_SPI_SEL) > 0)
     {
-        cyhal_pdm_pcm_free(&_shield_pdm_pcm);
+        cyhal_gpio_free(shield->pins.spi_cs_sel0);
     }
-    if ((_shield_initialized & _SHIELD_XENSIV_A_INITIALIZED_DISPLAY) > 0)
+    if ((shield->initialized & _SHIELD_XENSIV_A_INITIALIZED_TIMER) > 0)
     {
-        mtb_st7735s_free();
+        cyhal_timer_free(&shield->timer);
     }
 
-    _shield_initialized = _SHIELD_XENSIV_A_INITIALIZED_NONE;
+    shield->initialized   = _SHIELD_XENSIV_A_INITIALIZED_NONE;
+    shield->init_pending  = false;
+    shield->co2_power_off = false;
+    shield->init_result   = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
 
-    if (_shield_i2c_ptr == &_shield_i2c)
+    if (shield->i2c_ptr == &shield->i2c)
     {
-        cyhal_i2c_free(_shield_i2c_ptr);
+        cyhal_i2c_free(shield->i2c_ptr);
     }
-    _shield_i2c_ptr = NULL;
+    shield->i2c_ptr = NULL;
 
-    if (_shield_spi_ptr == &_shield_spi)
+    if (shield->spi_ptr == &shield->spi)
     {
-        cyhal_spi_free(_shield_spi_ptr);
+        cyhal_spi_free(shield->spi_ptr);
     }
-    _shield_spi_ptr = NULL;
+    shield->spi_ptr = NULL;
 }
 
 
@@ -27,26 +27,399 @@
 
 #include "shield_xensiv_a_pins.h"
 #include "cyhal.h"
+#include "cyhal_pdmpcm.h"
+
+/* Support of the peripherals can be compiled out individually by defining
+   the corresponding switch to 0, so that their drivers are not linked */
+#ifndef SHIELD_XENSIV_A_USE_HUMIDITY
+/** Support of the SHT35 humidity sensor */
+#define SHIELD_XENSIV_A_USE_HUMIDITY            (1)
+#endif
+#ifndef SHIELD_XENSIV_A_USE_MOTION
+/** Support of the BMI270 motion sensor */
+#define SHIELD_XENSIV_A_USE_MOTION              (1)
+#endif
+#ifndef SHIELD_XENSIV_A_USE_MAGNETOMETER
+/** Support of the BMM350 magnetometer sensor */
+#define SHIELD_XENSIV_A_USE_MAGNETOMETER        (1)
+#endif
+#ifndef SHIELD_XENSIV_A_USE_PRESSURE
+/** Support of the DPS368 pressure sensor */
+#define SHIELD_XENSIV_A_USE_PRESSURE            (1)
+#endif
+#ifndef SHIELD_XENSIV_A_USE_PDM
+/** Support of the PDM microphone */
+#define SHIELD_XENSIV_A_USE_PDM                 (1)
+#endif
+#ifndef SHIELD_XENSIV_A_USE_DISPLAY
+/** Support of the ST7735S display */
+#define SHIELD_XENSIV_A_USE_DISPLAY             (1)
+#endif
+#ifndef SHIELD_XENSIV_A_USE_CO2
+/** Support of the PAS CO2 sensor */
+#define SHIELD_XENSIV_A_USE_CO2                 (1)
+#endif
+#ifndef SHIELD_XENSIV_A_USE_RADAR
+/** Support of the BGT60LTR11 radar sensor */
+#define SHIELD_XENSIV_A_USE_RADAR               (1)
+#endif
+
+#if SHIELD_XENSIV_A_USE_HUMIDITY
 #include "mtb_sht3x.h"
+#endif
+#if SHIELD_XENSIV_A_USE_MOTION
 #include "mtb_bmi270.h"
+#endif
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
 #include "mtb_bmm350.h"
+#endif
+#if SHIELD_XENSIV_A_USE_PRESSURE
 #include "xensiv_dps3xx_mtb.h"
+#endif
+#if SHIELD_XENSIV_A_USE_DISPLAY
 #include "mtb_st7735s.h"
-#include "cyhal_pdmpcm.h"
+#endif
+#if SHIELD_XENSIV_A_USE_CO2
 #include "xensiv_pasco2_mtb.h"
+#endif
 
 #if defined(__cplusplus)
 extern "C"
 {
 #endif
 
+/******************************************************************************
+* Macros
+******************************************************************************/
+/** Result code module used by the shield library */
+#define SHIELD_XENSIV_A_RSLT_MODULE             (CY_RSLT_MODULE_BOARD_SHIELD_BASE)
+/** The staged initialization is still waiting for a sensor to become ready */
+#define SHIELD_XENSIV_A_RSLT_PENDING            \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_INFO, SHIELD_XENSIV_A_RSLT_MODULE, 0))
+/** An invalid argument was passed to a shield function */
+#define SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG        \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, SHIELD_XENSIV_A_RSLT_MODULE, 1))
+/** The shield, or the required part of it, has not been initialized */
+#define SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, SHIELD_XENSIV_A_RSLT_MODULE, 2))
+/** The CO2 sensor did not respond within SHIELD_XENSIV_A_CO2_READY_TIMEOUT_MS */
+#define SHIELD_XENSIV_A_RSLT_ERR_CO2_TIMEOUT    \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, SHIELD_XENSIV_A_RSLT_MODULE, 3))
+/** A sensor driver reported an error while configuring the sensor */
+#define SHIELD_XENSIV_A_RSLT_ERR_SENSOR         \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, SHIELD_XENSIV_A_RSLT_MODULE, 4))
+/** The resource is in use by another operation */
+#define SHIELD_XENSIV_A_RSLT_ERR_BUSY           \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, SHIELD_XENSIV_A_RSLT_MODULE, 5))
+/** An operation could not be started before its deadline */
+#define SHIELD_XENSIV_A_RSLT_ERR_DEADLINE       \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, SHIELD_XENSIV_A_RSLT_MODULE, 6))
+/** A queued operation was aborted before it completed */
+#define SHIELD_XENSIV_A_RSLT_ERR_ABORTED        \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, SHIELD_XENSIV_A_RSLT_MODULE, 7))
+/** A bus transfer failed */
+#define SHIELD_XENSIV_A_RSLT_ERR_TRANSFER       \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, SHIELD_XENSIV_A_RSLT_MODULE, 8))
+/** A sensor did not deliver its data in time */
+#define SHIELD_XENSIV_A_RSLT_ERR_TIMEOUT        \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, SHIELD_XENSIV_A_RSLT_MODULE, 9))
+/** Data does not have the expected format */
+#define SHIELD_XENSIV_A_RSLT_ERR_FORMAT         \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, SHIELD_XENSIV_A_RSLT_MODULE, 10))
+/** A device still holds the I2C bus low after the bus recovery */
+#define SHIELD_XENSIV_A_RSLT_ERR_BUS_STUCK      \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, SHIELD_XENSIV_A_RSLT_MODULE, 11))
+
+/** Ready mask bit for the SHT35 humidity sensor */
+#define SHIELD_XENSIV_A_READY_HUMIDITY          (0x01UL)
+/** Ready mask bit for the BMI270 motion sensor */
+#define SHIELD_XENSIV_A_READY_MOTION            (0x02UL)
+/** Ready mask bit for the BMM350 magnetometer sensor */
+#define SHIELD_XENSIV_A_READY_MAGNETOMETER      (0x04UL)
+/** Ready mask bit for the DPS368 pressure sensor */
+#define SHIELD_XENSIV_A_READY_PRESSURE          (0x08UL)
+/** Ready mask bit for the PDM microphone */
+#define SHIELD_XENSIV_A_READY_PDM               (0x10UL)
+/** Ready mask bit for the ST7735S display */
+#define SHIELD_XENSIV_A_READY_DISPLAY           (0x20UL)
+/** Ready mask bit for the PAS CO2 sensor */
+#define SHIELD_XENSIV_A_READY_CO2               (0x40UL)
+/** All ready mask bits */
+#define SHIELD_XENSIV_A_READY_ALL               (0x7FUL)
+/** Ready mask bits of the peripherals whose support is compiled in */
+#define SHIELD_XENSIV_A_READY_AVAILABLE                                              \
+    (((SHIELD_XENSIV_A_USE_HUMIDITY) ? SHIELD_XENSIV_A_READY_HUMIDITY : 0UL) |         \
+     ((SHIELD_XENSIV_A_USE_MOTION) ? SHIELD_XENSIV_A_READY_MOTION : 0UL) |             \
+     ((SHIELD_XENSIV_A_USE_MAGNETOMETER) ? SHIELD_XENSIV_A_READY_MAGNETOMETER : 0UL) | \
+     ((SHIELD_XENSIV_A_USE_PRESSURE) ? SHIELD_XENSIV_A_READY_PRESSURE : 0UL) |         \
+     ((SHIELD_XENSIV_A_USE_PDM) ? SHIELD_XENSIV_A_READY_PDM : 0UL) |                   \
+     ((SHIELD_XENSIV_A_USE_DISPLAY) ? SHIELD_XENSIV_A_READY_DISPLAY : 0UL) |           \
+     ((SHIELD_XENSIV_A_USE_CO2) ? SHIELD_XENSIV_A_READY_CO2 : 0UL))
+
+#ifndef SHIELD_XENSIV_A_SPI_FREQ_HZ
+/** Default SPI clock of an internally allocated SPI instance. The ST7735S
+ * display accepts writes up to 15 MHz.
+ */
+#define SHIELD_XENSIV_A_SPI_FREQ_HZ             (1200000UL)
+#endif
+
+#ifndef SHIELD_XENSIV_A_SPI_SEL0_DISPLAY
+/** Level of SHIELD_XENSIV_A_PIN_SPI_CS_SEL0 which routes the SPI chip select
+ * to the display, the other level routes it to the radar sensor
+ */
+#define SHIELD_XENSIV_A_SPI_SEL0_DISPLAY        (true)
+#endif
+
+#ifndef SHIELD_XENSIV_A_CO2_WARMUP_MS
+/** Time after powering the CO2 sensor before the first attempt to talk to it */
+#define SHIELD_XENSIV_A_CO2_WARMUP_MS           (1000UL)
+#endif
+
+#ifndef SHIELD_XENSIV_A_CO2_READY_TIMEOUT_MS
+/** Time after powering the CO2 sensor after which it is reported as failed */
+#define SHIELD_XENSIV_A_CO2_READY_TIMEOUT_MS    (3000UL)
+#endif
+
+#ifndef SHIELD_XENSIV_A_CO2_RETRY_MS
+/** Interval between attempts to initialize the CO2 sensor after the warm-up */
+#define SHIELD_XENSIV_A_CO2_RETRY_MS            (100UL)
+#endif
+
+#ifndef SHIELD_XENSIV_A_CO2_POWER_OFF_MS
+/** Time the CO2 sensor is kept unpowered when it is reinitialized */
+#define SHIELD_XENSIV_A_CO2_POWER_OFF_MS        (20UL)
+#endif
+
+/** SHT35 command stopping the periodic measurement */
+#define SHIELD_XENSIV_A_SHT35_CMD_BREAK         (0x3093U)
+/** SHT35 command for a high repeatability single shot without clock stretching */
+#define SHIELD_XENSIV_A_SHT35_CMD_SINGLE_HIGH   (0x2400U)
+/** Time the SHT35 needs to accept a command after a break */
+#define SHIELD_XENSIV_A_SHT35_BREAK_MS          (1U)
+/** Time of an SHT35 high repeatability measurement */
+#define SHIELD_XENSIV_A_SHT35_MEAS_MS           (16U)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Callback invoked by shield_xensiv_a_init_poll() once the staged
+ * initialization has completed. The result is CY_RSLT_SUCCESS if every required
+ * sensor became ready, otherwise the error of the sensor which did not. The ready mask
+ * is a combination of the SHIELD_XENSIV_A_READY_* bits.
+ */
+typedef void (*shield_xensiv_a_init_callback_t)(cy_rslt_t result, uint32_t ready_mask,
+                                                void* callback_arg);
+
+/** Pins of a shield. A second shield on other headers of the kit needs its
+ * own assignment, see shield_xensiv_a_pins.h for the default one.
+ */
+typedef struct
+{
+    cyhal_gpio_t    i2c_sda;        /**< I2C data, if the I2C instance is allocated */
+    cyhal_gpio_t    i2c_scl;        /**< I2C clock, if the I2C instance is allocated */
+    cyhal_gpio_t    spi_mosi;       /**< SPI MOSI, if the SPI instance is allocated */
+    cyhal_gpio_t    spi_miso;       /**< SPI MISO, if the SPI instance is allocated */
+    cyhal_gpio_t    spi_sck;        /**< SPI clock, if the SPI instance is allocated */
+    cyhal_gpio_t    spi_cs;         /**< SPI chip select, if the SPI instance is allocated */
+    cyhal_gpio_t    spi_cs_sel0;    /**< Routing of the chip select to display or radar */
+    cyhal_gpio_t    spi_dc_ds;      /**< Display data / command select */
+    cyhal_gpio_t    main_rst;       /**< Display reset */
+    cyhal_gpio_t    co2_pwr_en;     /**< CO2 sensor supply enable */
+    cyhal_gpio_t    pdm_data;       /**< Microphone data */
+    cyhal_gpio_t    pdm_clk;        /**< Microphone clock */
+    cyhal_gpio_t    imu_int_1;      /**< Motion sensor interrupt 1 */
+    cyhal_gpio_t    imu_int_2;      /**< Motion sensor interrupt 2 */
+    cyhal_gpio_t    mag_int;        /**< Magnetometer interrupt */
+    cyhal_gpio_t    sen_int;        /**< Pressure sensor interrupt */
+    cyhal_gpio_t    radar_gpio1;    /**< Radar GPIO1 or P_DET */
+    cyhal_gpio_t    radar_gpio2;    /**< Radar GPIO2 or T_DET */
+    cyhal_gpio_t    radar_rst;      /**< Radar reset */
+    cyhal_gpio_t    radar_adc1;     /**< Radar ADC1, I IF signal */
+    cyhal_gpio_t    radar_adc2;     /**< Radar ADC2, Q IF signal */
+} shield_xensiv_a_pins_t;
+
+/** Pin assignment of a shield on the Arduino header of the kit */
+#define SHIELD_XENSIV_A_PINS_DEFAULT                                    \
+    {                                                                   \
+        .i2c_sda     = SHIELD_XENSIV_A_PIN_I2C_SDA,                     \
+        .i2c_scl     = SHIELD_XENSIV_A_PIN_I2C_SCL,                     \
+        .spi_mosi    = SHIELD_XENSIV_A_PIN_SPI_MOSI,                    \
+        .spi_miso    = SHIELD_XENSIV_A_PIN_SPI_MISO,                    \
+        .spi_sck     = SHIELD_XENSIV_A_PIN_SPI_SCK,                     \
+        .spi_cs      = SHIELD_XENSIV_A_PIN_SPI_CS,                      \
+        .spi_cs_sel0 = SHIELD_XENSIV_A_PIN_SPI_CS_SEL0,                 \
+        .spi_dc_ds   = SHIELD_XENSIV_A_PIN_SPI_DC_DS,                   \
+        .main_rst    = SHIELD_XENSIV_A_PIN_MAIN_RST,                    \
+        .co2_pwr_en  = SHIELD_XENSIV_A_PIN_CO2_PWR_EN,                  \
+        .pdm_data    = SHIELD_XENSIV_A_PIN_PDM_DATA,                    \
+        .pdm_clk     = SHIELD_XENSIV_A_PIN_PDM_CLK,                     \
+        .imu_int_1   = SHIELD_XENSIV_A_PIN_IMU_INT_1,                   \
+        .imu_int_2   = SHIELD_XENSIV_A_PIN_IMU_INT_2,                   \
+        .mag_int     = SHIELD_XENSIV_A_PIN_MAG_INT,                     \
+        .sen_int     = SHIELD_XENSIV_A_PIN_SEN_INT,                     \
+        .radar_gpio1 = SHIELD_XENSIV_A_PIN_RADAR_GPIO1,                 \
+        .radar_gpio2 = SHIELD_XENSIV_A_PIN_RADAR_GPIO2,                 \
+        .radar_rst   = SHIELD_XENSIV_A_PIN_RADAR_RST,                   \
+        .radar_adc1  = SHIELD_XENSIV_A_PIN_RADAR_ADC1,                  \
+        .radar_adc2  = SHIELD_XENSIV_A_PIN_RADAR_ADC2                   \
+    }
+
+/** Sensor state saved by shield_xensiv_a_save_warm_state() for a warm
+ * restart. It holds the driver objects of the BMI270 and the BMM350, with the
+ * configuration and calibration read at initialization, and may be kept in
+ * retained RAM or copied to flash as a plain block of bytes. It can only be
+ * restored by the firmware image which saved it.
+ */
+typedef struct
+{
+    uint32_t                        magic;      /**< Identifies a saved state */
+    uint16_t                        version;    /**< Layout version of the state */
+    uint16_t                        size;       /**< Size of the state in bytes */
+    uint32_t                        image_id;   /**< Firmware image which saved it */
+    uint32_t                        devices;    /**< SHIELD_XENSIV_A_READY_* bits saved */
+#if SHIELD_XENSIV_A_USE_MOTION
+    mtb_bmi270_t                    motion_sensor;  /**< BMI270 driver object */
+#endif
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+    mtb_bmm350_t                    mag_sensor;     /**< BMM350 driver object */
+#endif
+    uint32_t                        checksum;   /**< CRC-32 of the preceding bytes */
+} shield_xensiv_a_warm_state_t;
+
+/** Configuration of shield_xensiv_a_init_cfg(),
+ * shield_xensiv_a_init_start_cfg() and their shield_xensiv_a_ctx_* forms
+ */
+typedef struct
+{
+    /** Optional I2C instance shared by the sensors, NULL to allocate one */
+    cyhal_i2c_t*                    i2c_instance;
+    /** Optional SPI instance shared by the display and the radar sensor, NULL
+     * to allocate one */
+    cyhal_spi_t*                    spi_instance;
+    /** Configuration of the PDM object used with the microphone */
+    const cyhal_pdm_pcm_cfg_t*      pdm_pcm_cfg;
+    /** Audio clock used with the microphone */
+    cyhal_clock_t*                  audio_clock_inst;
+    /** Clock of an internally allocated SPI instance in Hz, 0 for
+     * SHIELD_XENSIV_A_SPI_FREQ_HZ */
+    uint32_t                        spi_frequency_hz;
+    /** SHIELD_XENSIV_A_READY_* bits of the peripherals to initialize, all
+     * others are left untouched */
+    uint32_t                        devices;
+    /** Subset of devices whose failure fails the initialization. Other
+     * devices which fail are left out of the ready mask. */
+    uint32_t                        required;
+    /** Set up the SPI bus for the radar sensor, which is not part of the
+     * ready mask. Without it, the SPI bus is only set up for the display. */
+    bool                            radar;
+    /** Optional function called from shield_xensiv_a_init_poll() once the
+     * staged initialization has completed */
+    shield_xensiv_a_init_callback_t callback;
+    /** Argument passed to the callback */
+    void*                           callback_arg;
+    /** Optional pin assignment, NULL for SHIELD_XENSIV_A_PINS_DEFAULT */
+    const shield_xensiv_a_pins_t*   pins;
+    /** Optional state saved before a reset. Sensors which are still configured
+     * are restored from it instead of being initialized again. */
+    const shield_xensiv_a_warm_state_t* warm_state;
+    /** Identifies the firmware image, the warm state is only used if it was
+     * saved with the same value */
+    uint32_t                        warm_image_id;
+} shield_xensiv_a_cfg_t;
+
+/** Configuration which initializes and requires all compiled in peripherals
+ * except the microphone, which needs a PDM configuration and audio clock
+ */
+#define SHIELD_XENSIV_A_CFG_DEFAULT                                     \
+    {                                                                   \
+        .i2c_instance     = NULL,                                       \
+        .spi_instance     = NULL,                                       \
+        .pdm_pcm_cfg      = NULL,                                       \
+        .audio_clock_inst = NULL,                                       \
+        .spi_frequency_hz = 0UL,                                        \
+        .devices          = (SHIELD_XENSIV_A_READY_AVAILABLE & ~SHIELD_XENSIV_A_READY_PDM), \
+        .required         = (SHIELD_XENSIV_A_READY_AVAILABLE & ~SHIELD_XENSIV_A_READY_PDM), \
+        .radar            = (SHIELD_XENSIV_A_USE_RADAR != 0),          \
+        .callback         = NULL,                                       \
+        .callback_arg     = NULL,                                       \
+        .pins             = NULL,                                       \
+        .warm_state       = NULL,                                       \
+        .warm_image_id    = 0UL                                         \
+    }
+
+/** Devices sharing the SPI bus, selected with SHIELD_XENSIV_A_PIN_SPI_CS_SEL0 */
+typedef enum
+{
+    SHIELD_XENSIV_A_SPI_DEVICE_NONE,    /**< The bus is free, the display is selected */
+    SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY, /**< ST7735S display */
+    SHIELD_XENSIV_A_SPI_DEVICE_RADAR    /**< BGT60LTR11 radar sensor */
+} shield_xensiv_a_spi_device_t;
+
+/** Bus binding of the Bosch sensor drivers of a shield */
+typedef struct
+{
+    cyhal_i2c_t*    i2c;        /**< I2C bus of the sensor */
+    uint8_t         address;    /**< I2C address of the sensor */
+} shield_xensiv_a_bosch_intf_t;
+
+/** State of one shield. The functions without a shield argument operate on a
+ * default instance, those of the shield_xensiv_a_ctx_* family on the instance
+ * passed to them, so that several shields on separate buses can be used at
+ * the same time. The members are private to the library.
+ */
+typedef struct
+{
+    shield_xensiv_a_pins_t                  pins;
+    cyhal_i2c_t                             i2c;
+    cyhal_spi_t                             spi;
+#if SHIELD_XENSIV_A_USE_PDM
+    cyhal_pdm_pcm_t                         pdm_pcm;
+#endif
+    cyhal_timer_t                           timer;
+    cyhal_i2c_t*                            i2c_ptr;
+    cyhal_spi_t*                            spi_ptr;
+#if SHIELD_XENSIV_A_USE_MOTION
+    mtb_bmi270_t                            motion_sensor;
+    shield_xensiv_a_bosch_intf_t            motion_intf;
+#endif
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+    mtb_bmm350_t                            mag_sensor;
+    shield_xensiv_a_bosch_intf_t            mag_intf;
+#endif
+#if SHIELD_XENSIV_A_USE_PRESSURE
+    xensiv_dps3xx_t                         pressure_sensor;
+#endif
+#if SHIELD_XENSIV_A_USE_CO2
+    xensiv_pasco2_t                         co2_sensor;
+#endif
+#if SHIELD_XENSIV_A_USE_DISPLAY
+    mtb_st7735s_pins_t                      display_pins;
+#endif
+    uint32_t                                initialized;
+    volatile shield_xensiv_a_spi_device_t   spi_owner;
+
+    /* State of the staged initialization */
+    uint32_t                                devices;
+    uint32_t                                required;
+    bool                                    init_pending;
+    cy_rslt_t                               init_result;
+    uint32_t                                co2_power_on_us;
+    uint32_t                                co2_next_attempt_ms;
+    bool                                    co2_power_off;
+    shield_xensiv_a_init_callback_t         init_callback;
+    void*                                   init_callback_arg;
+    uint32_t                                warm_devices;
+    uint32_t                                restored;
+} shield_xensiv_a_t;
+
 
 /******************************************************************************
 * Function Name: shield_xensiv_a_init
 ******************************************************************************
 * Summary: Initializes the shield board and all peripherals present on it.
-*          The initialization of all the sensors takes 3 seconds, as it
-*          includes a waiting period for the CO2 sensor to become ready.
+*          The initialization of all the sensors takes up to 3 seconds, as it
+*          includes a waiting period for the CO2 sensor to become ready. Use
+*          shield_xensiv_a_init_start() to avoid blocking on the CO2 sensor.
 *
 * Parameters:
 *  i2c_instance      An optional I2C instance to use for communicating with
@@ -70,107 +443,873 @@ cy_rslt_t shield_xensiv_a_init(cyhal_i2c_t* i2c_instance,
 
 
 /******************************************************************************
-* Function Name: shield_xensiv_a_get_humidity_sensor
+* Function Name: shield_xensiv_a_init_start
 ******************************************************************************
-* Summary: Gives the user access to the I2C object used for the humidity sensor.
+* Summary: Starts a staged initialization of the shield. All sensors except the
+*          CO2 sensor are initialized before this function returns and can be
+*          used right away. The CO2 sensor is powered and completes its
+*          initialization in the background through shield_xensiv_a_init_poll().
+*          If any of the fast peripherals fails to initialize, everything is
+*          freed again and the error is returned.
+*
+* Parameters:
+*  i2c_instance      An optional I2C instance to use for communicating with
+*                    the sensors on the shield. If NULL, a new instance will
+*                    be allocated internally
+*  spi_instance      An optional SPI instance to use for communicating with
+*                    the display and sensors on the shield. If NULL, a new
+*                    instance will be allocated internally
+*  pdm_pcm_cfg       Configuration for the PDM object used with the microphone
+*  audio_clock_inst  Audio clock used with the microphone
+*  callback          An optional function called from shield_xensiv_a_init_poll()
+*                    when the CO2 sensor becomes ready or fails
+*  callback_arg      Argument passed to the callback
+*
+* Return:
+*  Status of the fast part of the initialization
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_init_start(cyhal_i2c_t* i2c_instance,
+                                     cyhal_spi_t* spi_instance,
+                                     const cyhal_pdm_pcm_cfg_t* pdm_pcm_cfg,
+                                     cyhal_clock_t* audio_clock_inst,
+                                     shield_xensiv_a_init_callback_t callback,
+                                     void* callback_arg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_init_cfg
+******************************************************************************
+* Summary: Initializes the peripherals selected by a configuration and waits
+*          for the CO2 sensor if it is one of them. A failure of a required
+*          peripheral frees everything again, other peripherals which fail
+*          are left out of the ready mask.
+*
+* Parameters:
+*  cfg               The configuration
+*
+* Return:
+*  Status of initialization, SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG if a required
+*  peripheral is not selected or not compiled in
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_init_cfg(const shield_xensiv_a_cfg_t* cfg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_init_start_cfg
+******************************************************************************
+* Summary: Starts a staged initialization of the peripherals selected by a
+*          configuration, see shield_xensiv_a_init_start(). The staged
+*          initialization completes in shield_xensiv_a_init_poll(), right
+*          away if the CO2 sensor is not selected.
+*
+* Parameters:
+*  cfg               The configuration
+*
+* Return:
+*  Status of the fast part of the initialization
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_init_start_cfg(const shield_xensiv_a_cfg_t* cfg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_init_poll
+******************************************************************************
+* Summary: Advances a staged initialization started with
+*          shield_xensiv_a_init_start(). This must be called periodically from
+*          thread context until it stops returning SHIELD_XENSIV_A_RSLT_PENDING.
+*          If the CO2 sensor does not become ready, it is powered down again
+*          while all other sensors stay usable.
 *
 * Parameters: None
 *
 * Return:
-*  A reference to the I2C object used for the humidity sensor.
+*  SHIELD_XENSIV_A_RSLT_PENDING while waiting for the CO2 sensor, otherwise the
+*  final status of the staged initialization
 *
 ******************************************************************************/
-cyhal_i2c_t* shield_xensiv_a_get_humidity_sensor(void);
+cy_rslt_t shield_xensiv_a_init_poll(void);
 
 
 
 /******************************************************************************
-* Function Name: shield_xensiv_a_get_motion_sensor
+* Function Name: shield_xensiv_a_get_ready_mask
 ******************************************************************************
-* Summary: Gives the user access to the BMI270 motion sensor object.
+* Summary: Reports which peripherals on the shield are initialized and ready
+*          to be used.
 *
 * Parameters: None
 *
 * Return:
-*  A reference to the motion sensor object on the shield
+*  A combination of the SHIELD_XENSIV_A_READY_* bits
 *
 ******************************************************************************/
-mtb_bmi270_t* shield_xensiv_a_get_motion_sensor(void);
+uint32_t shield_xensiv_a_get_ready_mask(void);
 
 
 
 /******************************************************************************
-* Function Name: shield_xensiv_a_get_mag_sensor
+* Function Name: shield_xensiv_a_get_restored_mask
 ******************************************************************************
-* Summary: Gives the user access to the BMM350 magnetometer sensor object.
+* Summary: Reports which peripherals were restored from the warm state passed
+*          in the configuration instead of being initialized again.
 *
 * Parameters: None
 *
 * Return:
-*  A reference to the magnetometer sensor object on the shield
+*  A combination of the SHIELD_XENSIV_A_READY_* bits
 *
 ******************************************************************************/
-mtb_bmm350_t* shield_xensiv_a_get_mag_sensor(void);
+uint32_t shield_xensiv_a_get_restored_mask(void);
 
 
 
 /******************************************************************************
-* Function Name: shield_xensiv_a_get_pressure_sensor
+* Function Name: shield_xensiv_a_save_warm_state
 ******************************************************************************
-* Summary: Gives the user access to the DPS368 pressure sensor object
+* Summary: Saves the state of the BMI270 and the BMM350 drivers and which of
+*          the BMI270, BMM350 and CO2 sensors are ready, so that a later
+*          initialization can pass it in the warm_state member of its
+*          configuration. The initialization then restores every sensor which
+*          reports that it is still configured and initializes the others as
+*          usual. The CO2 sensor is only reused if its supply was kept on
+*          across the reset. The state is checked with a CRC-32 and the chip
+*          IDs of the sensors.
+*
+* Parameters:
+*  image_id          Identifies the firmware image, the saved driver objects
+*                    refer to its code and constant data
+*  state             The state to fill in
+*
+* Return:
+*  Status of saving, SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED if the
+*  initialization has not completed successfully
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_save_warm_state(uint32_t image_id,
+                                          shield_xensiv_a_warm_state_t* state);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_reinit
+******************************************************************************
+* Summary: Reinitializes one sensor on the I2C bus while the other peripherals
+*          keep running, e.g. after it stopped responding. The driver of the
+*          sensor is released and initialized again, which resets its
+*          interrupt, FIFO and feature settings. The modules which set them up
+*          are not told and keep reporting them as enabled, so the caller has
+*          to stop them first with shield_xensiv_a_irq_disable(),
+*          shield_xensiv_a_motion_fifo_stop() or shield_xensiv_a_trigger_free()
+*          and enable or start them again afterwards. The CO2 sensor is
+*          switched off, and switched on again and waited for like in the
+*          staged initialization without blocking the caller:
+*          shield_xensiv_a_init_poll() has to be called until it stops
+*          returning SHIELD_XENSIV_A_RSLT_PENDING, and the initialization
+*          callback is called again.
+*
+* Parameters:
+*  device            A single SHIELD_XENSIV_A_READY_* bit of a sensor on the
+*                    I2C bus which was selected at initialization
+*
+* Return:
+*  Status of the reinitialization, SHIELD_XENSIV_A_RSLT_PENDING for the CO2
+*  sensor, SHIELD_XENSIV_A_RSLT_ERR_BUSY while the staged initialization is
+*  still waiting for the CO2 sensor
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_reinit(uint32_t device);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_recover_i2c
+******************************************************************************
+* Summary: Releases an I2C bus which a device holds low, e.g. after a transfer
+*          was interrupted by a reset or a glitch. The I2C block is released,
+*          SCL is clocked up to 9 times until SDA is let go and a STOP
+*          condition is generated, then the I2C block is set up again. The
+*          sensor drivers keep their state. Callbacks and events registered on
+*          the I2C object are lost, so the I2C scheduler has to be freed before
+*          and initialized again afterwards. Only a bus set up by the shield
+*          itself can be recovered.
 *
 * Parameters: None
 *
 * Return:
-*  A reference to the pressure sensor object on the shield
+*  Status of the recovery, SHIELD_XENSIV_A_RSLT_ERR_BUS_STUCK if the bus is
+*  still held low, SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG if the I2C object was
+*  passed in by the application, SHIELD_XENSIV_A_RSLT_ERR_BUSY while the I2C
+*  scheduler runs on the bus
 *
 ******************************************************************************/
-xensiv_dps3xx_t* shield_xensiv_a_get_pressure_sensor(void);
+cy_rslt_t shield_xensiv_a_recover_i2c(void);
 
 
 
 /******************************************************************************
-* Function Name: shield_xensiv_a_get_pdm
+* Function Name: shield_xensiv_a_get_timestamp_us
 ******************************************************************************
-* Summary: Gives the user access to the PDM object used with the microphone.
-*          This will return null if the arguments to setup the PDM interface
-*          were not provided.
+* Summary: Reads the free-running microsecond counter started by the shield
+*          initialization. The counter wraps around every 2^32 microseconds
+*          (about 71 minutes), so intervals must be computed with unsigned
+*          subtraction.
 *
 * Parameters: None
 *
-* Return: A reference to the PDM microphone object on the shield
+* Return:
+*  Current timestamp in microseconds, or 0 if the shield is not initialized
 *
 ******************************************************************************/
-cyhal_pdm_pcm_t* shield_xensiv_a_get_pdm(void);
+uint32_t shield_xensiv_a_get_timestamp_us(void);
 
 
 
 /******************************************************************************
-* Function Name: shield_xensiv_a_get_co2_sensor
+* Function Name: shield_xensiv_a_get_i2c
 ******************************************************************************
-* Summary: Gives the user access to the PAS CO2 sensor object.
+* Summary: Gives the user access to the I2C object shared by all sensors on
+*          the shield.
 *
 * Parameters: None
 *
 * Return:
-*  A reference to the CO2 sensor object on the shield
+*  A reference to the shared I2C object, or NULL if not initialized
 *
 ******************************************************************************/
-xensiv_pasco2_t* shield_xensiv_a_get_co2_sensor(void);
+cyhal_i2c_t* shield_xensiv_a_get_i2c(void);
 
 
 
 /******************************************************************************
-* Function Name: shield_xensiv_a_free
+* Function Name: shield_xensiv_a_get_spi
 ******************************************************************************
-* Summary: Frees up any resources allocated by shield_xensiv_a_init()
+* Summary: Gives the user access to the SPI object shared by the display and
+*          the radar sensor on the shield.
 *
 * Parameters: None
 *
+* Return:
+*  A reference to the shared SPI object, or NULL if not initialized
+*
+******************************************************************************/
+cyhal_spi_t* shield_xensiv_a_get_spi(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_set_spi_frequency
+******************************************************************************
+* Summary: Changes the clock of the shared SPI bus, e.g. to speed up display
+*          updates. No transfer may be in progress.
+*
+* Parameters:
+*  frequency_hz      The new SPI clock in Hz
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_set_spi_frequency(uint32_t frequency_hz);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_spi_acquire
+******************************************************************************
+* Summary: Reserves the shared SPI bus for a device and routes the chip select
+*          to it. The display is selected while the bus is free, so drawing
+*          through emWin works without acquiring the bus as long as the radar
+*          sensor is not accessed at the same time.
+*
+* Parameters:
+*  device            The device which is going to use the bus
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_BUSY if another device
+*  holds the bus
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_spi_acquire(shield_xensiv_a_spi_device_t device);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_spi_release
+******************************************************************************
+* Summary: Releases the shared SPI bus reserved with
+*          shield_xensiv_a_spi_acquire().
+*
+* Parameters:
+*  device            The device which holds the bus
+*
 * Return: None
 *
 ******************************************************************************/
-void shield_xensiv_a_free(void);
+void shield_xensiv_a_spi_release(shield_xensiv_a_spi_device_t device);
+
+
+
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+/******************************************************************************
+* Function Name: shield_xensiv_a_get_humidity_sensor
+******************************************************************************
+* Summary: Gives the user access to the I2C object used for the humidity sensor.
+*
+* Parameters: None
+*
+* Return:
+*  A reference to the I2C object used for the humidity sensor.
+*
+******************************************************************************/
+cyhal_i2c_t* shield_xensiv_a_get_humidity_sensor(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_sht35_command
+******************************************************************************
+* Summary: Sends a command to the SHT35 humidity sensor, bypassing the driver,
+*          e.g. SHIELD_XENSIV_A_SHT35_CMD_BREAK to stop its periodic
+*          measurement.
+*
+* Parameters:
+*  command           One of the SHIELD_XENSIV_A_SHT35_CMD_* commands
+*
+* Return:
+*  Status of the I2C transfer. A break is not acknowledged by an idle sensor.
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_sht35_command(uint16_t command);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_sht35_read
+******************************************************************************
+* Summary: Reads and checks the result of a single shot measurement started
+*          with SHIELD_XENSIV_A_SHT35_CMD_SINGLE_HIGH.
+*
+* Parameters:
+*  temperature       Temperature in degree Celsius
+*  humidity          Relative humidity in percent
+*
+* Return:
+*  Status of the I2C transfer, which is not acknowledged until the
+*  measurement has completed, or SHIELD_XENSIV_A_RSLT_ERR_SENSOR for a
+*  corrupted result
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_sht35_read(float* temperature, float* humidity);
+#endif
+
+
+
+#if SHIELD_XENSIV_A_USE_MOTION
+/******************************************************************************
+* Function Name: shield_xensiv_a_get_motion_sensor
+******************************************************************************
+* Summary: Gives the user access to the BMI270 motion sensor object.
+*
+* Parameters: None
+*
+* Return:
+*  A reference to the motion sensor object on the shield
+*
+******************************************************************************/
+mtb_bmi270_t* shield_xensiv_a_get_motion_sensor(void);
+#endif
+
+
+
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+/******************************************************************************
+* Function Name: shield_xensiv_a_get_mag_sensor
+******************************************************************************
+* Summary: Gives the user access to the BMM350 magnetometer sensor object.
+*
+* Parameters: None
+*
+* Return:
+*  A reference to the magnetometer sensor object on the shield
+*
+******************************************************************************/
+mtb_bmm350_t* shield_xensiv_a_get_mag_sensor(void);
+#endif
+
+
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+/******************************************************************************
+* Function Name: shield_xensiv_a_get_pressure_sensor
+******************************************************************************
+* Summary: Gives the user access to the DPS368 pressure sensor object
+*
+* Parameters: None
+*
+* Return:
+*  A reference to the pressure sensor object on the shield
+*
+******************************************************************************/
+xensiv_dps3xx_t* shield_xensiv_a_get_pressure_sensor(void);
+#endif
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_get_pdm
+******************************************************************************
+* Summary: Gives the user access to the PDM object used with the microphone.
+*          This will return null if the arguments to setup the PDM interface
+*          were not provided.
+*
+* Parameters: None
+*
+* Return: A reference to the PDM microphone object on the shield
+*
+******************************************************************************/
+cyhal_pdm_pcm_t* shield_xensiv_a_get_pdm(void);
+
+
+
+#if SHIELD_XENSIV_A_USE_CO2
+/******************************************************************************
+* Function Name: shield_xensiv_a_get_co2_sensor
+******************************************************************************
+* Summary: Gives the user access to the PAS CO2 sensor object.
+*
+* Parameters: None
+*
+* Return:
+*  A reference to the CO2 sensor object on the shield
+*
+******************************************************************************/
+xensiv_pasco2_t* shield_xensiv_a_get_co2_sensor(void);
+#endif
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_free
+******************************************************************************
+* Summary: Frees up any resources allocated by shield_xensiv_a_init()
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_free(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_get_default
+******************************************************************************
+* Summary: Returns the instance used by the functions without a shield
+*          argument, e.g. to pass it to the shield_xensiv_a_ctx_* functions.
+*
+* Parameters: None
+*
+* Return:
+*  The default shield instance
+*
+******************************************************************************/
+shield_xensiv_a_t* shield_xensiv_a_get_default(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_get_pins
+******************************************************************************
+* Summary: Returns the pin assignment of the default instance, which the other
+*          modules of the library use instead of the default pins, so that
+*          they follow a shield initialized with its own assignment.
+*
+* Parameters: None
+*
+* Return:
+*  The pins of the default shield instance, valid once it was initialized
+*
+******************************************************************************/
+const shield_xensiv_a_pins_t* shield_xensiv_a_get_pins(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_init_cfg
+******************************************************************************
+* Summary: Initializes a shield as selected by a configuration, see
+*          shield_xensiv_a_init_cfg(). Each shield needs its own buses and
+*          pins. The display driver supports a single display, so only one
+*          shield can initialize its display.
+*
+* Parameters:
+*  shield            The shield instance, its previous content is discarded
+*  cfg               Configuration of the initialization
+*
+* Return:
+*  Status of initialization
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_init_cfg(shield_xensiv_a_t* shield,
+                                       const shield_xensiv_a_cfg_t* cfg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_init_start_cfg
+******************************************************************************
+* Summary: Starts the staged initialization of a shield, see
+*          shield_xensiv_a_init_start_cfg().
+*
+* Parameters:
+*  shield            The shield instance, its previous content is discarded
+*  cfg               Configuration of the initialization
+*
+* Return:
+*  Status of the initialization of the buses and the sensors other than CO2
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_init_start_cfg(shield_xensiv_a_t* shield,
+                                             const shield_xensiv_a_cfg_t* cfg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_init_poll
+******************************************************************************
+* Summary: Advances the staged initialization of a shield, see
+*          shield_xensiv_a_init_poll().
+*
+* Parameters:
+*  shield            The shield instance
+*
+* Return:
+*  SHIELD_XENSIV_A_RSLT_PENDING while waiting for the CO2 sensor, otherwise the
+*  final status of the initialization
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_init_poll(shield_xensiv_a_t* shield);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_get_ready_mask
+******************************************************************************
+* Summary: Returns the peripherals of a shield which are ready, see
+*          shield_xensiv_a_get_ready_mask().
+*
+* Parameters:
+*  shield            The shield instance
+*
+* Return:
+*  A combination of the SHIELD_XENSIV_A_READY_* bits
+*
+******************************************************************************/
+uint32_t shield_xensiv_a_ctx_get_ready_mask(const shield_xensiv_a_t* shield);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_get_restored_mask
+******************************************************************************
+* Summary: Returns the peripherals of a shield which were restored from a warm
+*          state, see shield_xensiv_a_get_restored_mask().
+*
+* Parameters:
+*  shield            The shield instance
+*
+* Return:
+*  A combination of the SHIELD_XENSIV_A_READY_* bits
+*
+******************************************************************************/
+uint32_t shield_xensiv_a_ctx_get_restored_mask(const shield_xensiv_a_t* shield);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_save_warm_state
+******************************************************************************
+* Summary: Saves the sensor state of a shield for a warm restart, see
+*          shield_xensiv_a_save_warm_state().
+*
+* Parameters:
+*  shield            The shield instance
+*  image_id          Identifies the firmware image
+*  state             The state to fill in
+*
+* Return:
+*  Status of saving
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_save_warm_state(const shield_xensiv_a_t* shield,
+                                              uint32_t image_id,
+                                              shield_xensiv_a_warm_state_t* state);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_reinit
+******************************************************************************
+* Summary: Reinitializes one sensor of a shield, see shield_xensiv_a_reinit().
+*
+* Parameters:
+*  shield            The shield instance
+*  device            A single SHIELD_XENSIV_A_READY_* bit of a sensor on the
+*                    I2C bus
+*
+* Return:
+*  Status of the reinitialization
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_reinit(shield_xensiv_a_t* shield, uint32_t device);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_recover_i2c
+******************************************************************************
+* Summary: Releases the I2C bus of a shield, see shield_xensiv_a_recover_i2c().
+*
+* Parameters:
+*  shield            The shield instance
+*
+* Return:
+*  Status of the recovery
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_recover_i2c(shield_xensiv_a_t* shield);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_get_timestamp_us
+******************************************************************************
+* Summary: Returns the timestamp counter of a shield, see
+*          shield_xensiv_a_get_timestamp_us(). Every shield has its own
+*          counter.
+*
+* Parameters:
+*  shield            The shield instance
+*
+* Return:
+*  Microseconds since the initialization of the shield
+*
+******************************************************************************/
+uint32_t shield_xensiv_a_ctx_get_timestamp_us(shield_xensiv_a_t* shield);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_get_i2c
+******************************************************************************
+* Summary: Returns the I2C bus of a shield.
+*
+* Parameters:
+*  shield            The shield instance
+*
+* Return:
+*  The I2C object, NULL if the shield is not initialized
+*
+******************************************************************************/
+cyhal_i2c_t* shield_xensiv_a_ctx_get_i2c(const shield_xensiv_a_t* shield);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_get_spi
+******************************************************************************
+* Summary: Returns the SPI bus of a shield.
+*
+* Parameters:
+*  shield            The shield instance
+*
+* Return:
+*  The SPI object, NULL if the bus is not initialized
+*
+******************************************************************************/
+cyhal_spi_t* shield_xensiv_a_ctx_get_spi(const shield_xensiv_a_t* shield);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_set_spi_frequency
+******************************************************************************
+* Summary: Changes the SPI clock of a shield, see
+*          shield_xensiv_a_set_spi_frequency().
+*
+* Parameters:
+*  shield            The shield instance
+*  frequency_hz      The SPI clock in Hz
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_set_spi_frequency(shield_xensiv_a_t* shield, uint32_t frequency_hz);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_spi_acquire
+******************************************************************************
+* Summary: Reserves the SPI bus of a shield for a device, see
+*          shield_xensiv_a_spi_acquire().
+*
+* Parameters:
+*  shield            The shield instance
+*  device            The device to select
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_ctx_spi_acquire(shield_xensiv_a_t* shield,
+                                          shield_xensiv_a_spi_device_t device);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_spi_release
+******************************************************************************
+* Summary: Releases the SPI bus of a shield, see shield_xensiv_a_spi_release().
+*
+* Parameters:
+*  shield            The shield instance
+*  device            The device which holds the bus
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_ctx_spi_release(shield_xensiv_a_t* shield,
+                                     shield_xensiv_a_spi_device_t device);
+
+
+
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_get_humidity_sensor
+******************************************************************************
+* Summary: Returns the I2C object used for the humidity sensor of a shield.
+*
+* Parameters:
+*  shield            The shield instance
+*
+* Return:
+*  A reference to the I2C object used for the humidity sensor
+*
+******************************************************************************/
+cyhal_i2c_t* shield_xensiv_a_ctx_get_humidity_sensor(const shield_xensiv_a_t* shield);
+#endif
+
+
+
+#if SHIELD_XENSIV_A_USE_MOTION
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_get_motion_sensor
+******************************************************************************
+* Summary: Returns the motion sensor object of a shield.
+*
+* Parameters:
+*  shield            The shield instance
+*
+* Return:
+*  A reference to the motion sensor object
+*
+******************************************************************************/
+mtb_bmi270_t* shield_xensiv_a_ctx_get_motion_sensor(shield_xensiv_a_t* shield);
+#endif
+
+
+
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_get_mag_sensor
+******************************************************************************
+* Summary: Returns the magnetometer sensor object of a shield.
+*
+* Parameters:
+*  shield            The shield instance
+*
+* Return:
+*  A reference to the magnetometer sensor object
+*
+******************************************************************************/
+mtb_bmm350_t* shield_xensiv_a_ctx_get_mag_sensor(shield_xensiv_a_t* shield);
+#endif
+
+
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_get_pressure_sensor
+******************************************************************************
+* Summary: Returns the pressure sensor object of a shield.
+*
+* Parameters:
+*  shield            The shield instance
+*
+* Return:
+*  A reference to the pressure sensor object
+*
+******************************************************************************/
+xensiv_dps3xx_t* shield_xensiv_a_ctx_get_pressure_sensor(shield_xensiv_a_t* shield);
+#endif
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_get_pdm
+******************************************************************************
+* Summary: Returns the PDM/PCM object used for the microphone of a shield.
+*
+* Parameters:
+*  shield            The shield instance
+*
+* Return:
+*  A reference to the PDM/PCM object, NULL if the microphone is not ready
+*
+******************************************************************************/
+cyhal_pdm_pcm_t* shield_xensiv_a_ctx_get_pdm(shield_xensiv_a_t* shield);
+
+
+
+#if SHIELD_XENSIV_A_USE_CO2
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_get_co2_sensor
+******************************************************************************
+* Summary: Returns the CO2 sensor object of a shield.
+*
+* Parameters:
+*  shield            The shield instance
+*
+* Return:
+*  A reference to the CO2 sensor object
+*
+******************************************************************************/
+xensiv_pasco2_t* shield_xensiv_a_ctx_get_co2_sensor(shield_xensiv_a_t* shield);
+#endif
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_ctx_free
+******************************************************************************
+* Summary: Frees all resources of a shield, see shield_xensiv_a_free().
+*
+* Parameters:
+*  shield            The shield instance
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_ctx_free(shield_xensiv_a_t* shield);
 
 #if defined(__cplusplus)
 }
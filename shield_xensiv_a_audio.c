@@ -0,0 +1,252 @@
+/******************************************************************************
+ * \file shield_xensiv_a_audio.c
+ *
+ * Description: Implementation of the continuous PDM audio streaming of the
+ *              shield support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "shield_xensiv_a_audio.h"
+#include "shield_xensiv_a_metrics.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* PDM events handled by the streaming */
+#define AUDIO_EVENTS               ((cyhal_pdm_pcm_event_t)(CYHAL_PDM_PCM_ASYNC_COMPLETE | \
+                                                            CYHAL_PDM_PCM_RX_OVERFLOW))
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static int16_t                              _audio_blocks[SHIELD_XENSIV_A_AUDIO_BLOCK_COUNT]
+                                                         [SHIELD_XENSIV_A_AUDIO_BLOCK_SAMPLES];
+static uint32_t                             _audio_timestamps[SHIELD_XENSIV_A_AUDIO_BLOCK_COUNT];
+static uint32_t                             _audio_sequences[SHIELD_XENSIV_A_AUDIO_BLOCK_COUNT];
+static cyhal_pdm_pcm_t*                     _audio_pdm;
+static shield_xensiv_a_audio_callback_t     _audio_callback;
+static void*                                _audio_callback_arg;
+static uint8_t                              _audio_intr_priority;
+
+/* Blocks [read, write) are filled, block write is being filled. Each index
+   is only written by one side: write by the interrupt, read by the consumer. */
+static volatile uint32_t                    _audio_write;
+static volatile uint32_t                    _audio_read;
+static uint32_t                             _audio_sequence;
+static volatile uint32_t                    _audio_overruns;
+static volatile uint32_t                    _audio_hw_overflows;
+#if SHIELD_XENSIV_A_METRICS_ENABLED
+static uint32_t                             _audio_block_start_us;
+#endif
+
+
+/******************************************************************************
+* _shield_xensiv_a_audio_event
+******************************************************************************/
+static void _shield_xensiv_a_audio_event(void* callback_arg, cyhal_pdm_pcm_event_t event)
+{
+    (void)callback_arg;
+
+    if ((event & CYHAL_PDM_PCM_RX_OVERFLOW) != 0)
+    {
+        _audio_hw_overflows++;
+    }
+
+    if ((event & CYHAL_PDM_PCM_ASYNC_COMPLETE) != 0)
+    {
+        uint32_t write = _audio_write;
+        bool committed = false;
+#if SHIELD_XENSIV_A_METRICS_ENABLED
+        uint32_t now_us = shield_xensiv_a_get_timestamp_us();
+        uint32_t duration_us = now_us - _audio_block_start_us;
+        _audio_block_start_us = now_us;
+#endif
+
+        /* Only hand the block out if another free block remains to fill next,
+           otherwise drop it and fill it again */
+        if ((write - _audio_read) < (SHIELD_XENSIV_A_AUDIO_BLOCK_COUNT - 1U))
+        {
+            uint32_t index = write % SHIELD_XENSIV_A_AUDIO_BLOCK_COUNT;
+            _audio_timestamps[index] = shield_xensiv_a_get_timestamp_us();
+            _audio_sequences[index] = _audio_sequence;
+            __DMB();
+            _audio_write = ++write;
+            committed = true;
+        }
+        else
+        {
+            _audio_overruns++;
+        }
+        SHIELD_XENSIV_A_METRICS_RECORD(SHIELD_XENSIV_A_METRICS_PDM, duration_us,
+                                       SHIELD_XENSIV_A_AUDIO_BLOCK_SAMPLES * sizeof(int16_t),
+                                       committed
+                                       ? CY_RSLT_SUCCESS
+                                       : SHIELD_XENSIV_A_RSLT_ERR_BUSY);
+        _audio_sequence++;
+
+        (void)cyhal_pdm_pcm_read_async(_audio_pdm,
+                                       _audio_blocks[write % SHIELD_XENSIV_A_AUDIO_BLOCK_COUNT],
+                                       SHIELD_XENSIV_A_AUDIO_BLOCK_SAMPLES);
+
+        if (committed && (NULL != _audio_callback))
+        {
+            _audio_callback(_audio_callback_arg);
+        }
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_audio_start
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_audio_start(shield_xensiv_a_audio_callback_t callback,
+                                      void* callback_arg, uint8_t intr_priority)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL != _audio_pdm)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BUSY;
+    }
+    else if (NULL == shield_xensiv_a_get_pdm())
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        _audio_pdm = shield_xensiv_a_get_pdm();
+        _audio_callback = callback;
+        _audio_callback_arg = callback_arg;
+        _audio_intr_priority = intr_priority;
+        _audio_write = 0;
+        _audio_read = 0;
+        _audio_sequence = 0;
+        _audio_overruns = 0;
+        _audio_hw_overflows = 0;
+#if SHIELD_XENSIV_A_METRICS_ENABLED
+        _audio_block_start_us = shield_xensiv_a_get_timestamp_us();
+#endif
+
+        if (CY_RSLT_SUCCESS != cyhal_pdm_pcm_set_async_mode(_audio_pdm, CYHAL_ASYNC_DMA,
+                                                            CYHAL_DMA_PRIORITY_DEFAULT))
+        {
+            (void)cyhal_pdm_pcm_set_async_mode(_audio_pdm, CYHAL_ASYNC_SW,
+                                               CYHAL_DMA_PRIORITY_DEFAULT);
+        }
+        cyhal_pdm_pcm_register_callback(_audio_pdm, _shield_xensiv_a_audio_event, NULL);
+        cyhal_pdm_pcm_enable_event(_audio_pdm, AUDIO_EVENTS, intr_priority, true);
+
+        result = cyhal_pdm_pcm_clear(_audio_pdm);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            result = cyhal_pdm_pcm_start(_audio_pdm);
+        }
+        if (CY_RSLT_SUCCESS == result)
+        {
+            result = cyhal_pdm_pcm_read_async(_audio_pdm, _audio_blocks[0],
+                                              SHIELD_XENSIV_A_AUDIO_BLOCK_SAMPLES);
+        }
+        if (CY_RSLT_SUCCESS != result)
+        {
+            shield_xensiv_a_audio_stop();
+        }
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_audio_acquire_block
+******************************************************************************/
+bool shield_xensiv_a_audio_acquire_block(shield_xensiv_a_audio_block_t* block)
+{
+    bool available = (NULL != block) && (NULL != _audio_pdm) && (_audio_read != _audio_write);
+
+    if (available)
+    {
+        uint32_t index = _audio_read % SHIELD_XENSIV_A_AUDIO_BLOCK_COUNT;
+        __DMB();
+        block->samples = _audio_blocks[index];
+        block->num_samples = SHIELD_XENSIV_A_AUDIO_BLOCK_SAMPLES;
+        block->sequence = _audio_sequences[index];
+        block->timestamp_us = _audio_timestamps[index];
+    }
+
+    return available;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_audio_release_block
+******************************************************************************/
+void shield_xensiv_a_audio_release_block(void)
+{
+    if ((NULL != _audio_pdm) && (_audio_read != _audio_write))
+    {
+        __DMB();
+        _audio_read = _audio_read + 1U;
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_audio_get_stats
+******************************************************************************/
+void shield_xensiv_a_audio_get_stats(shield_xensiv_a_audio_stats_t* stats)
+{
+    if (NULL != stats)
+    {
+        stats->blocks = _audio_write;
+        stats->overruns = _audio_overruns;
+        stats->hw_overflows = _audio_hw_overflows;
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_audio_stop
+******************************************************************************/
+void shield_xensiv_a_audio_stop(void)
+{
+    if (NULL != _audio_pdm)
+    {
+        cyhal_pdm_pcm_enable_event(_audio_pdm, AUDIO_EVENTS, _audio_intr_priority, false);
+        (void)cyhal_pdm_pcm_abort_async(_audio_pdm);
+        (void)cyhal_pdm_pcm_stop(_audio_pdm);
+        cyhal_pdm_pcm_register_callback(_audio_pdm, NULL, NULL);
+        _audio_callback = NULL;
+        _audio_pdm = NULL;
+    }
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,171 @@
+/******************************************************************************
+ * \file shield_xensiv_a_audio.h
+ *
+ * Description: This file is the interface for the continuous audio streaming
+ *              from the PDM microphone on the SHIELD_XENSIV_A shield board.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#ifndef SHIELD_XENSIV_A_AUDIO_BLOCK_SAMPLES
+/** Number of PCM words in one audio block */
+#define SHIELD_XENSIV_A_AUDIO_BLOCK_SAMPLES     (256U)
+#endif
+
+#ifndef SHIELD_XENSIV_A_AUDIO_BLOCK_COUNT
+/** Number of audio blocks owned by the library. One block is always being
+ * filled, so up to SHIELD_XENSIV_A_AUDIO_BLOCK_COUNT - 1 blocks can be
+ * waiting for the consumer.
+ */
+#define SHIELD_XENSIV_A_AUDIO_BLOCK_COUNT       (4U)
+#endif
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** A filled audio block, handed out by reference */
+typedef struct
+{
+    /** PCM words of the block, in the layout configured for the PDM object */
+    const int16_t*  samples;
+    /** Number of PCM words in the block */
+    size_t          num_samples;
+    /** Running number of the block, gaps indicate dropped blocks */
+    uint32_t        sequence;
+    /** Time at which the last word of the block was received */
+    uint32_t        timestamp_us;
+} shield_xensiv_a_audio_block_t;
+
+/** Streaming statistics */
+typedef struct
+{
+    /** Number of blocks made available to the consumer */
+    uint32_t    blocks;
+    /** Number of blocks dropped because the consumer did not release blocks
+     * fast enough */
+    uint32_t    overruns;
+    /** Number of PDM hardware FIFO overflows */
+    uint32_t    hw_overflows;
+} shield_xensiv_a_audio_stats_t;
+
+/** Callback invoked from the PDM interrupt whenever a block was filled */
+typedef void (*shield_xensiv_a_audio_callback_t)(void* callback_arg);
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_audio_start
+******************************************************************************
+* Summary: Starts continuous capture from the PDM microphone into the blocks
+*          owned by the library. The shield must have been initialized with a
+*          PDM configuration using a word length of at most 16 bits.
+*
+* Parameters:
+*  callback          An optional function to call when a block was filled
+*  callback_arg      Argument passed to the callback
+*  intr_priority     Priority of the PDM interrupt
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_audio_start(shield_xensiv_a_audio_callback_t callback,
+                                      void* callback_arg, uint8_t intr_priority);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_audio_acquire_block
+******************************************************************************
+* Summary: Gives the consumer the oldest filled block without copying it. The
+*          block stays valid until shield_xensiv_a_audio_release_block(). Only
+*          one block can be acquired at a time, from a single consumer.
+*
+* Parameters:
+*  block             Receives the description of the block
+*
+* Return:
+*  true if a block was available
+*
+******************************************************************************/
+bool shield_xensiv_a_audio_acquire_block(shield_xensiv_a_audio_block_t* block);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_audio_release_block
+******************************************************************************
+* Summary: Returns the block obtained from shield_xensiv_a_audio_acquire_block()
+*          to the library.
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_audio_release_block(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_audio_get_stats
+******************************************************************************
+* Summary: Reads the streaming statistics.
+*
+* Parameters:
+*  stats             Receives the statistics
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_audio_get_stats(shield_xensiv_a_audio_stats_t* stats);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_audio_stop
+******************************************************************************
+* Summary: Stops the capture. Blocks which were not consumed are discarded.
+*          This must be called before shield_xensiv_a_free() if the capture
+*          was started.
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_audio_stop(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,392 @@
+/******************************************************************************
+ * \file shield_xensiv_a_audio_features.c
+ *
+ * Description: Implementation of the audio feature extraction of the shield
+ *              support library. The time domain features and the spectrum are
+ *              computed in fixed point, only the final levels use floating
+ *              point.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include <math.h>
+#include <string.h>
+#include "shield_xensiv_a_audio_features.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define FEATURES_MIN_FFT           (16U)
+#define FEATURES_PI                (3.14159265f)
+/* Full scale of a Q15 value */
+#define FEATURES_Q15_ONE           (32767)
+/* Fractional bits of the A-weighting power gains, which exceed 1 */
+#define FEATURES_WEIGHT_SHIFT      (14U)
+/* Power of a full scale bin, the reference of the band levels */
+#define FEATURES_FULL_SCALE_POWER  (32768.0f * 32768.0f)
+/* Added to energies before taking the logarithm */
+#define FEATURES_MIN_ENERGY        (1.0e-3f)
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static shield_xensiv_a_audio_features_cfg_t         _features_cfg;
+static shield_xensiv_a_audio_features_callback_t    _features_callback;
+static void*                                        _features_callback_arg;
+
+static int16_t      _features_window[SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_FFT];
+static int16_t      _features_cos[SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_FFT / 2U];
+static int16_t      _features_sin[SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_FFT / 2U];
+static uint16_t     _features_a_weight[SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_FFT / 2U];
+static uint16_t     _features_band_edges[SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_BANDS + 1U];
+
+/* Samples of the frame being assembled */
+static int16_t      _features_history[SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_FFT];
+static uint16_t     _features_filled;
+/* Interleaved real and imaginary parts of the spectrum */
+static int16_t      _features_work[2U * SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_FFT];
+
+
+/******************************************************************************
+* _shield_xensiv_a_audio_features_db
+******************************************************************************/
+static inline float _shield_xensiv_a_audio_features_db(float power_ratio)
+{
+    return 10.0f * log10f(power_ratio + (FEATURES_MIN_ENERGY / FEATURES_FULL_SCALE_POWER));
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_audio_features_a_weight
+******************************************************************************/
+/* Power gain of the A-weighting curve at a frequency */
+static float _shield_xensiv_a_audio_features_a_weight(float f)
+{
+    float f2 = f * f;
+    float ra = (148693636.0f * f2 * f2) /
+               ((f2 + 424.36f) * sqrtf((f2 + 11599.29f) * (f2 + 544496.41f)) *
+                (f2 + 148693636.0f));
+    /* +2.0 dB normalizes the gain to 1 at 1 kHz */
+    float gain = ra * 1.2589254f;
+
+    return gain * gain;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_audio_features_fft
+******************************************************************************/
+/* In place radix-2 FFT in Q15, scaled by 1/2 per stage to avoid overflow */
+static void _shield_xensiv_a_audio_features_fft(int16_t* data, uint16_t n)
+{
+    /* Bit reversed reordering */
+    for (uint16_t i = 1, j = 0; i < n; i++)
+    {
+        uint16_t bit = n >> 1;
+        while ((j & bit) != 0)
+        {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j ^= bit;
+
+        if (i < j)
+        {
+            int16_t re = data[2U * i];
+            int16_t im = data[(2U * i) + 1U];
+            data[2U * i] = data[2U * j];
+            data[(2U * i) + 1U] = data[(2U * j) + 1U];
+            data[2U * j] = re;
+            data[(2U * j) + 1U] = im;
+        }
+    }
+
+    for (uint16_t len = 2; len <= n; len <<= 1)
+    {
+        uint16_t half = len >> 1;
+        uint16_t stride = n / len;
+
+        for (uint16_t start = 0; start < n; start += len)
+        {
+            for (uint16_t k = 0; k < half; k++)
+            {
+                int32_t wr = _features_cos[k * stride];
+                int32_t wi = -_features_sin[k * stride];
+                int16_t* a = &data[2U * (start + k)];
+                int16_t* b = &data[2U * (start + k + half)];
+
+                int32_t tr = ((wr * b[0]) - (wi * b[1])) >> 15;
+                int32_t ti = ((wr * b[1]) + (wi * b[0])) >> 15;
+
+                b[0] = (int16_t)((a[0] - tr) >> 1);
+                b[1] = (int16_t)((a[1] - ti) >> 1);
+                a[0] = (int16_t)((a[0] + tr) >> 1);
+                a[1] = (int16_t)((a[1] + ti) >> 1);
+            }
+        }
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_audio_features_frame
+******************************************************************************/
+static void _shield_xensiv_a_audio_features_frame(const int16_t* frame, uint32_t timestamp_us)
+{
+    shield_xensiv_a_audio_features_t features;
+    uint16_t n = _features_cfg.frame_size;
+    uint64_t sum_squares = 0;
+    uint32_t crossings = 0;
+    uint16_t peak = 0;
+
+    /* Time domain features, and the windowed frame as FFT input */
+    for (uint16_t i = 0; i < n; i++)
+    {
+        int32_t sample = frame[i];
+        uint16_t magnitude = (uint16_t)((sample < 0) ? -sample : sample);
+
+        sum_squares += (uint64_t)(sample * sample);
+        if (magnitude > peak)
+        {
+            peak = magnitude;
+        }
+        if ((i > 0) && ((sample < 0) != (frame[i - 1U] < 0)))
+        {
+            crossings++;
+        }
+        _features_work[2U * i] = (int16_t)((sample * _features_window[i]) >> 15);
+        _features_work[(2U * i) + 1U] = 0;
+    }
+
+    features.timestamp_us = timestamp_us;
+    features.peak = peak;
+    features.rms = (uint16_t)sqrtf((float)sum_squares / (float)n);
+    features.level_dbfs = _shield_xensiv_a_audio_features_db(
+        ((float)sum_squares / (float)n) / FEATURES_FULL_SCALE_POWER);
+    features.zero_crossing_rate = (float)crossings / (float)(n - 1U);
+
+    _shield_xensiv_a_audio_features_fft(_features_work, n);
+
+    /* A-weighting as the ratio of the weighted to the unweighted spectral
+       power, applied to the broadband level */
+    uint64_t total = 0;
+    uint64_t weighted = 0;
+    uint8_t band = 0;
+    uint64_t band_energy = 0;
+
+    for (uint16_t bin = 1; bin < (n / 2U); bin++)
+    {
+        int32_t re = _features_work[2U * bin];
+        int32_t im = _features_work[(2U * bin) + 1U];
+        uint32_t power = (uint32_t)((re * re) + (im * im));
+
+        total += power;
+        weighted += ((uint64_t)power * _features_a_weight[bin]) >> FEATURES_WEIGHT_SHIFT;
+
+        if (band < _features_cfg.num_bands)
+        {
+            band_energy += power;
+            if ((bin + 1U) >= _features_band_edges[band + 1U])
+            {
+                features.band_db[band] = _shield_xensiv_a_audio_features_db(
+                    (float)band_energy / FEATURES_FULL_SCALE_POWER);
+                band_energy = 0;
+                band++;
+            }
+        }
+    }
+    for (; band < SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_BANDS; band++)
+    {
+        features.band_db[band] = _shield_xensiv_a_audio_features_db(0.0f);
+    }
+
+    features.level_dba = features.level_dbfs + SHIELD_XENSIV_A_AUDIO_FEATURES_SPL_OFFSET_DB +
+                         ((total > 0)
+                          ? (10.0f * log10f((float)weighted / (float)total))
+                          : 0.0f);
+
+    if (NULL != _features_callback)
+    {
+        _features_callback(&features, _features_callback_arg);
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_audio_features_init
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_audio_features_init(const shield_xensiv_a_audio_features_cfg_t* cfg,
+                                              shield_xensiv_a_audio_features_callback_t callback,
+                                              void* callback_arg)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((NULL == cfg) || (0 == cfg->sample_rate_hz) ||
+        (cfg->frame_size < FEATURES_MIN_FFT) ||
+        (cfg->frame_size > SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_FFT) ||
+        ((cfg->frame_size & (cfg->frame_size - 1U)) != 0) ||
+        (cfg->hop_size == 0) || (cfg->hop_size > cfg->frame_size) ||
+        (cfg->num_bands > SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_BANDS) ||
+        (cfg->num_bands >= (cfg->frame_size / 2U)))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else
+    {
+        uint16_t n = cfg->frame_size;
+        uint16_t bins = n / 2U;
+
+        _features_cfg = *cfg;
+        _features_callback = callback;
+        _features_callback_arg = callback_arg;
+        _features_filled = 0;
+
+        for (uint16_t i = 0; i < n; i++)
+        {
+            /* Hann window */
+            float w = 0.5f - (0.5f * cosf((2.0f * FEATURES_PI * (float)i) / (float)n));
+            _features_window[i] = (int16_t)(w * (float)FEATURES_Q15_ONE);
+        }
+
+        for (uint16_t k = 0; k < bins; k++)
+        {
+            float angle = (2.0f * FEATURES_PI * (float)k) / (float)n;
+            float f = ((float)k * (float)cfg->sample_rate_hz) / (float)n;
+            float weight = _shield_xensiv_a_audio_features_a_weight(f) *
+                           (float)(1UL << FEATURES_WEIGHT_SHIFT);
+
+            _features_cos[k] = (int16_t)(cosf(angle) * (float)FEATURES_Q15_ONE);
+            _features_sin[k] = (int16_t)(sinf(angle) * (float)FEATURES_Q15_ONE);
+            _features_a_weight[k] = (uint16_t)((weight < 65535.0f) ? weight : 65535.0f);
+        }
+
+        /* Logarithmically spaced band edges from bin 1 to the Nyquist bin,
+           each band at least one bin wide */
+        _features_band_edges[0] = 1;
+        for (uint8_t b = 1; b <= cfg->num_bands; b++)
+        {
+            float edge = powf((float)bins, (float)b / (float)cfg->num_bands);
+            uint16_t min_edge = (uint16_t)(_features_band_edges[b - 1U] + 1U);
+            uint16_t max_edge = (uint16_t)(bins - (cfg->num_bands - b));
+
+            _features_band_edges[b] = (uint16_t)(edge + 0.5f);
+            if (_features_band_edges[b] < min_edge)
+            {
+                _features_band_edges[b] = min_edge;
+            }
+            if (_features_band_edges[b] > max_edge)
+            {
+                _features_band_edges[b] = max_edge;
+            }
+        }
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_audio_features_frame_us
+******************************************************************************/
+/* Time of the sample before the remaining samples of a block */
+static uint32_t _shield_xensiv_a_audio_features_frame_us(uint32_t timestamp_us, size_t remaining)
+{
+    return timestamp_us - (uint32_t)(((uint64_t)remaining * 1000000U) /
+                                     _features_cfg.sample_rate_hz);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_audio_features_feed
+******************************************************************************/
+void shield_xensiv_a_audio_features_feed(const int16_t* samples, size_t num_samples,
+                                         uint32_t timestamp_us)
+{
+    uint16_t n = _features_cfg.frame_size;
+    size_t index = 0;
+
+    /* Without buffered samples, the frames within the block are processed
+       where they are. With the hop size equal to the frame size and blocks
+       of whole frames, nothing is ever copied. */
+    while ((NULL != samples) && (n > 0) && (0U == _features_filled) &&
+           ((num_samples - index) >= n))
+    {
+        _shield_xensiv_a_audio_features_frame(&samples[index],
+            _shield_xensiv_a_audio_features_frame_us(timestamp_us, num_samples - index - n));
+        index += _features_cfg.hop_size;
+    }
+
+    while ((NULL != samples) && (n > 0) && (index < num_samples))
+    {
+        size_t count = num_samples - index;
+        if (count > (size_t)(n - _features_filled))
+        {
+            count = n - _features_filled;
+        }
+
+        memcpy(&_features_history[_features_filled], &samples[index], count * sizeof(int16_t));
+        _features_filled += (uint16_t)count;
+        index += count;
+
+        if (_features_filled == n)
+        {
+            _shield_xensiv_a_audio_features_frame(_features_history,
+                _shield_xensiv_a_audio_features_frame_us(timestamp_us, num_samples - index));
+
+            /* Keep the overlap with the next frame */
+            _features_filled = (uint16_t)(n - _features_cfg.hop_size);
+            memmove(_features_history, &_features_history[_features_cfg.hop_size],
+                    _features_filled * sizeof(int16_t));
+        }
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_audio_features_process
+******************************************************************************/
+uint32_t shield_xensiv_a_audio_features_process(void)
+{
+    shield_xensiv_a_audio_block_t block;
+    uint32_t blocks = 0;
+
+    while (shield_xensiv_a_audio_acquire_block(&block))
+    {
+        shield_xensiv_a_audio_features_feed(block.samples, block.num_samples,
+                                            block.timestamp_us);
+        shield_xensiv_a_audio_release_block();
+        blocks++;
+    }
+
+    return blocks;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
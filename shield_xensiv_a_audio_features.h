@@ -0,0 +1,165 @@
+/******************************************************************************
+ * \file shield_xensiv_a_audio_features.h
+ *
+ * Description: This file is the interface for the audio feature extraction on
+ *              the PDM microphone stream of the SHIELD_XENSIV_A shield board.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a_audio.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#ifndef SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_FFT
+/** Largest supported frame size. This sizes the internal buffers, which take
+ * 11 bytes per sample.
+ */
+#define SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_FFT      (512U)
+#endif
+
+#ifndef SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_BANDS
+/** Largest supported number of spectral bands */
+#define SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_BANDS    (16U)
+#endif
+
+#ifndef SHIELD_XENSIV_A_AUDIO_FEATURES_SPL_OFFSET_DB
+/** Difference between the sound pressure level in dB SPL and the level in
+ * dBFS. The IM72D128 reaches 94 dB SPL at -26 dBFS.
+ */
+#define SHIELD_XENSIV_A_AUDIO_FEATURES_SPL_OFFSET_DB (120.0f)
+#endif
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Configuration of the feature extraction */
+typedef struct
+{
+    /** Sample rate of the PCM stream in Hz */
+    uint32_t    sample_rate_hz;
+    /** Number of samples per frame, a power of two from 16 to
+     * SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_FFT */
+    uint16_t    frame_size;
+    /** Number of samples between the starts of consecutive frames, 1 to
+     * frame_size */
+    uint16_t    hop_size;
+    /** Number of logarithmically spaced spectral bands, 0 to
+     * SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_BANDS */
+    uint8_t     num_bands;
+} shield_xensiv_a_audio_features_cfg_t;
+
+/** Features of one frame */
+typedef struct
+{
+    /** Time of the last sample of the frame */
+    uint32_t    timestamp_us;
+    /** Largest absolute sample value */
+    uint16_t    peak;
+    /** Root mean square of the samples */
+    uint16_t    rms;
+    /** RMS level relative to full scale in dBFS */
+    float       level_dbfs;
+    /** A-weighted sound level in dB SPL, see
+     * SHIELD_XENSIV_A_AUDIO_FEATURES_SPL_OFFSET_DB */
+    float       level_dba;
+    /** Fraction of consecutive samples with a sign change */
+    float       zero_crossing_rate;
+    /** Energy of each spectral band in dB relative to a full scale bin */
+    float       band_db[SHIELD_XENSIV_A_AUDIO_FEATURES_MAX_BANDS];
+} shield_xensiv_a_audio_features_t;
+
+/** Callback invoked for every completed frame */
+typedef void (*shield_xensiv_a_audio_features_callback_t)(
+    const shield_xensiv_a_audio_features_t* features, void* callback_arg);
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_audio_features_init
+******************************************************************************
+* Summary: Configures the feature extraction and computes its window, twiddle
+*          and weighting tables.
+*
+* Parameters:
+*  cfg               The configuration
+*  callback          The function to call for every frame
+*  callback_arg      Argument passed to the callback
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_audio_features_init(const shield_xensiv_a_audio_features_cfg_t* cfg,
+                                              shield_xensiv_a_audio_features_callback_t callback,
+                                              void* callback_arg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_audio_features_feed
+******************************************************************************
+* Summary: Adds mono PCM samples from any source and computes the features of
+*          every frame they complete. While no samples are buffered, frames
+*          which lie entirely within the samples are processed in place. The
+*          rest is copied into an internal frame buffer, whose overlap is moved
+*          after every frame. With the hop size equal to the frame size and
+*          blocks of whole frames, no samples are copied.
+*
+* Parameters:
+*  samples           The samples
+*  num_samples       Number of samples
+*  timestamp_us      Time of the last sample
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_audio_features_feed(const int16_t* samples, size_t num_samples,
+                                         uint32_t timestamp_us);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_audio_features_process
+******************************************************************************
+* Summary: Consumes all filled blocks of the audio streaming in place, see
+*          shield_xensiv_a_audio_start(), and computes their features. The PDM
+*          object must be configured for mono capture.
+*
+* Parameters: None
+*
+* Return:
+*  Number of blocks consumed
+*
+******************************************************************************/
+uint32_t shield_xensiv_a_audio_features_process(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,403 @@
+/******************************************************************************
+ * \file shield_xensiv_a_cache.c
+ *
+ * Description: Implementation of the cached sensor reads of the shield
+ *              support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include <string.h>
+#include "shield_xensiv_a_cache.h"
+#include "shield_xensiv_a_health.h"
+#include "shield_xensiv_a_i2c_sched.h"
+#include "shield_xensiv_a_metrics.h"
+
+#if defined(CY_RTOS_AWARE) || defined(COMPONENT_RTOS_AWARE)
+#include "cyabs_rtos.h"
+#define CACHE_USE_MUTEX            (1)
+#else
+#define CACHE_USE_MUTEX            (0)
+#endif
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define US_PER_MS                  (1000ULL)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+typedef struct
+{
+    /* Reads both values of the sensor from the bus */
+    cy_rslt_t           (*read)(float* values);
+    /* SHIELD_XENSIV_A_READY_* bit of the sensor */
+    uint32_t            device;
+    bool                valid;
+    uint32_t            timestamp_us;
+    float               values[2];
+    shield_xensiv_a_cache_stats_t stats;
+#if CACHE_USE_MUTEX
+    /* Held by the caller reading the sensor, later callers wait for it */
+    cy_mutex_t          mutex;
+#endif
+} _shield_xensiv_a_cache_entry_t;
+
+/******************************************************************************
+* Function prototypes
+******************************************************************************/
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+static cy_rslt_t _shield_xensiv_a_cache_read_humidity(float* values);
+#endif
+#if SHIELD_XENSIV_A_USE_PRESSURE
+static cy_rslt_t _shield_xensiv_a_cache_read_pressure(float* values);
+#endif
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static _shield_xensiv_a_cache_entry_t _cache_entries[SHIELD_XENSIV_A_CACHE_SENSOR_COUNT] =
+{
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+    [SHIELD_XENSIV_A_CACHE_HUMIDITY] =
+    {
+        .read   = _shield_xensiv_a_cache_read_humidity,
+        .device = SHIELD_XENSIV_A_READY_HUMIDITY
+    },
+#endif
+#if SHIELD_XENSIV_A_USE_PRESSURE
+    [SHIELD_XENSIV_A_CACHE_PRESSURE] =
+    {
+        .read   = _shield_xensiv_a_cache_read_pressure,
+        .device = SHIELD_XENSIV_A_READY_PRESSURE
+    },
+#endif
+};
+
+static bool _cache_initialized;
+
+
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+/******************************************************************************
+* _shield_xensiv_a_cache_read_humidity
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_cache_read_humidity(float* values)
+{
+    mtb_sht3x_value_t value;
+
+    SHIELD_XENSIV_A_METRICS_BEGIN(start_us);
+    cy_rslt_t result = mtb_sht3x_read(shield_xensiv_a_get_humidity_sensor(), &value);
+    SHIELD_XENSIV_A_METRICS_END(SHIELD_XENSIV_A_METRICS_HUMIDITY, start_us,
+                                SHIELD_XENSIV_A_METRICS_SHT35_BYTES, result);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        values[0] = value.temperature;
+        values[1] = value.humidity;
+    }
+
+    return result;
+}
+#endif
+
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+/******************************************************************************
+* _shield_xensiv_a_cache_read_pressure
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_cache_read_pressure(float* values)
+{
+    SHIELD_XENSIV_A_METRICS_BEGIN(start_us);
+    cy_rslt_t result = xensiv_dps3xx_read(shield_xensiv_a_get_pressure_sensor(), &values[0],
+                                          &values[1]);
+    SHIELD_XENSIV_A_METRICS_END(SHIELD_XENSIV_A_METRICS_PRESSURE, start_us,
+                                SHIELD_XENSIV_A_METRICS_DPS368_BYTES, result);
+
+    return result;
+}
+#endif
+
+
+#if SHIELD_XENSIV_A_USE_HUMIDITY || SHIELD_XENSIV_A_USE_PRESSURE
+/******************************************************************************
+* _shield_xensiv_a_cache_lookup
+******************************************************************************/
+/* Copies the cached values if they are younger than max_age_ms */
+static bool _shield_xensiv_a_cache_lookup(_shield_xensiv_a_cache_entry_t* entry,
+                                          uint32_t max_age_ms, float* values,
+                                          uint32_t* timestamp_us)
+{
+    bool fresh = false;
+
+    uint32_t state = cyhal_system_critical_section_enter();
+    if (entry->valid &&
+        ((uint64_t)(shield_xensiv_a_get_timestamp_us() - entry->timestamp_us) <
+         ((uint64_t)max_age_ms * US_PER_MS)))
+    {
+        fresh = true;
+        values[0] = entry->values[0];
+        values[1] = entry->values[1];
+        *timestamp_us = entry->timestamp_us;
+    }
+    cyhal_system_critical_section_exit(state);
+
+    return fresh;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_cache_read
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_cache_read(shield_xensiv_a_cache_sensor_t sensor,
+                                             uint32_t max_age_ms, float* values,
+                                             uint32_t* timestamp_us)
+{
+    _shield_xensiv_a_cache_entry_t* entry = &_cache_entries[sensor];
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t read_us = 0;
+
+    if (!_cache_initialized ||
+        ((shield_xensiv_a_get_ready_mask() & entry->device) == 0))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else if (_shield_xensiv_a_cache_lookup(entry, max_age_ms, values, &read_us))
+    {
+        uint32_t state = cyhal_system_critical_section_enter();
+        entry->stats.hits++;
+        cyhal_system_critical_section_exit(state);
+    }
+    else
+    {
+#if CACHE_USE_MUTEX
+        result = cy_rtos_get_mutex(&entry->mutex, CY_RTOS_NEVER_TIMEOUT);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            /* Another caller may have read the sensor while this one waited */
+            if (_shield_xensiv_a_cache_lookup(entry, max_age_ms, values, &read_us))
+            {
+                uint32_t state = cyhal_system_critical_section_enter();
+                entry->stats.hits++;
+                entry->stats.shared++;
+                cyhal_system_critical_section_exit(state);
+            }
+            else
+#endif
+            {
+                /* A scheduled transaction keeps the bus, the caller retries on ERR_BUSY */
+                result = shield_xensiv_a_i2c_sched_acquire();
+                if (CY_RSLT_SUCCESS == result)
+                {
+                    float read_values[2];
+                    result = entry->read(read_values);
+                    read_us = shield_xensiv_a_get_timestamp_us();
+                    shield_xensiv_a_i2c_sched_release();
+                    shield_xensiv_a_health_report(entry->device, result);
+
+                    uint32_t state = cyhal_system_critical_section_enter();
+                    entry->stats.misses++;
+                    if (CY_RSLT_SUCCESS == result)
+                    {
+                        entry->values[0] = read_values[0];
+                        entry->values[1] = read_values[1];
+                        entry->timestamp_us = read_us;
+                        entry->valid = true;
+                    }
+                    cyhal_system_critical_section_exit(state);
+
+                    values[0] = read_values[0];
+                    values[1] = read_values[1];
+                }
+            }
+#if CACHE_USE_MUTEX
+            (void)cy_rtos_set_mutex(&entry->mutex);
+        }
+#endif
+    }
+
+    if ((CY_RSLT_SUCCESS == result) && (NULL != timestamp_us))
+    {
+        *timestamp_us = read_us;
+    }
+
+    return result;
+}
+#endif
+
+
+/******************************************************************************
+* shield_xensiv_a_cache_init
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_cache_init(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (_cache_initialized)
+    {
+        shield_xensiv_a_cache_free();
+    }
+
+    for (uint8_t i = 0; i < SHIELD_XENSIV_A_CACHE_SENSOR_COUNT; i++)
+    {
+        _cache_entries[i].valid = false;
+        memset(&_cache_entries[i].stats, 0, sizeof(_cache_entries[i].stats));
+#if CACHE_USE_MUTEX
+        if (CY_RSLT_SUCCESS == result)
+        {
+            result = cy_rtos_init_mutex(&_cache_entries[i].mutex);
+            if (CY_RSLT_SUCCESS != result)
+            {
+                /* Release the mutexes created so far */
+                while (i > 0U)
+                {
+                    i--;
+                    (void)cy_rtos_deinit_mutex(&_cache_entries[i].mutex);
+                }
+                i = SHIELD_XENSIV_A_CACHE_SENSOR_COUNT;
+            }
+        }
+#endif
+    }
+
+    _cache_initialized = (CY_RSLT_SUCCESS == result);
+
+    return result;
+}
+
+
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+/******************************************************************************
+* shield_xensiv_a_cache_read_humidity
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_cache_read_humidity(uint32_t max_age_ms, mtb_sht3x_value_t* value,
+                                              uint32_t* timestamp_us)
+{
+    cy_rslt_t result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    float values[2];
+
+    if (NULL != value)
+    {
+        result = _shield_xensiv_a_cache_read(SHIELD_XENSIV_A_CACHE_HUMIDITY, max_age_ms, values,
+                                             timestamp_us);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            value->temperature = values[0];
+            value->humidity = values[1];
+        }
+    }
+
+    return result;
+}
+#endif
+
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+/******************************************************************************
+* shield_xensiv_a_cache_read_pressure
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_cache_read_pressure(uint32_t max_age_ms, float* pressure,
+                                              float* temperature, uint32_t* timestamp_us)
+{
+    cy_rslt_t result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    float values[2];
+
+    if ((NULL != pressure) && (NULL != temperature))
+    {
+        result = _shield_xensiv_a_cache_read(SHIELD_XENSIV_A_CACHE_PRESSURE, max_age_ms, values,
+                                             timestamp_us);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            *pressure = values[0];
+            *temperature = values[1];
+        }
+    }
+
+    return result;
+}
+#endif
+
+
+/******************************************************************************
+* shield_xensiv_a_cache_get_stats
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_cache_get_stats(shield_xensiv_a_cache_sensor_t sensor,
+                                          shield_xensiv_a_cache_stats_t* stats)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (((uint32_t)sensor >= SHIELD_XENSIV_A_CACHE_SENSOR_COUNT) || (NULL == stats))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else
+    {
+        uint32_t state = cyhal_system_critical_section_enter();
+        *stats = _cache_entries[sensor].stats;
+        cyhal_system_critical_section_exit(state);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_cache_invalidate
+******************************************************************************/
+void shield_xensiv_a_cache_invalidate(void)
+{
+    uint32_t state = cyhal_system_critical_section_enter();
+    for (uint8_t i = 0; i < SHIELD_XENSIV_A_CACHE_SENSOR_COUNT; i++)
+    {
+        _cache_entries[i].valid = false;
+    }
+    cyhal_system_critical_section_exit(state);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_cache_free
+******************************************************************************/
+void shield_xensiv_a_cache_free(void)
+{
+#if CACHE_USE_MUTEX
+    if (_cache_initialized)
+    {
+        for (uint8_t i = 0; i < SHIELD_XENSIV_A_CACHE_SENSOR_COUNT; i++)
+        {
+            (void)cy_rtos_deinit_mutex(&_cache_entries[i].mutex);
+        }
+    }
+#endif
+    _cache_initialized = false;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,186 @@
+/******************************************************************************
+ * \file shield_xensiv_a_cache.h
+ *
+ * Description: This file is the interface for the cached sensor reads of the
+ *              SHIELD_XENSIV_A shield board.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Sensors whose reads are cached */
+typedef enum
+{
+    SHIELD_XENSIV_A_CACHE_HUMIDITY,     /**< SHT35 temperature and humidity */
+    SHIELD_XENSIV_A_CACHE_PRESSURE,     /**< DPS368 pressure and temperature */
+    SHIELD_XENSIV_A_CACHE_SENSOR_COUNT  /**< Number of cached sensors */
+} shield_xensiv_a_cache_sensor_t;
+
+/** Usage counters of a cached sensor */
+typedef struct
+{
+    /** Reads answered from the cache */
+    uint32_t    hits;
+    /** Reads which accessed the sensor */
+    uint32_t    misses;
+    /** Reads which waited for the bus read of another caller and shared its
+     * result, also counted in hits */
+    uint32_t    shared;
+} shield_xensiv_a_cache_stats_t;
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_cache_init
+******************************************************************************
+* Summary: Empties the cache and resets its counters. When the library is
+*          built RTOS aware (CY_RTOS_AWARE or COMPONENT_RTOS_AWARE) a mutex is
+*          created per sensor, so that callers in different tasks which find
+*          a value too old share a single bus read. Must be called after the
+*          shield has been initialized and before any cached read.
+*
+* Parameters: None
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_cache_init(void);
+
+
+
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+/******************************************************************************
+* Function Name: shield_xensiv_a_cache_read_humidity
+******************************************************************************
+* Summary: Returns the SHT35 temperature and humidity. The last value is
+*          returned if it is younger than max_age_ms, otherwise the sensor is
+*          read and the cache updated. The sensor is read with the I2C bus
+*          reserved, so the function must not be called while the caller
+*          holds the reservation, e.g. from a sampler read function.
+*
+* Parameters:
+*  max_age_ms        Maximum acceptable age of the value, 0 always reads the
+*                    sensor
+*  value             Returns the temperature and humidity
+*  timestamp_us      Optional, returns the time at which the value was read
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED if the
+*  sensor is not in the ready mask, SHIELD_XENSIV_A_RSLT_ERR_BUSY if the value
+*  must be read while a scheduled transaction is on the bus
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_cache_read_humidity(uint32_t max_age_ms, mtb_sht3x_value_t* value,
+                                              uint32_t* timestamp_us);
+#endif
+
+
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+/******************************************************************************
+* Function Name: shield_xensiv_a_cache_read_pressure
+******************************************************************************
+* Summary: Returns the DPS368 pressure and temperature. The last value is
+*          returned if it is younger than max_age_ms, otherwise the sensor is
+*          read and the cache updated. The sensor is read with the I2C bus
+*          reserved, so the function must not be called while the caller
+*          holds the reservation, e.g. from a sampler read function.
+*
+* Parameters:
+*  max_age_ms        Maximum acceptable age of the value, 0 always reads the
+*                    sensor
+*  pressure          Returns the pressure in hPa
+*  temperature       Returns the temperature in °C
+*  timestamp_us      Optional, returns the time at which the value was read
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED if the
+*  sensor is not in the ready mask, SHIELD_XENSIV_A_RSLT_ERR_BUSY if the value
+*  must be read while a scheduled transaction is on the bus
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_cache_read_pressure(uint32_t max_age_ms, float* pressure,
+                                              float* temperature, uint32_t* timestamp_us);
+#endif
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_cache_get_stats
+******************************************************************************
+* Summary: Returns the usage counters of a cached sensor.
+*
+* Parameters:
+*  sensor            The sensor
+*  stats             Returns the counters
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_cache_get_stats(shield_xensiv_a_cache_sensor_t sensor,
+                                          shield_xensiv_a_cache_stats_t* stats);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_cache_invalidate
+******************************************************************************
+* Summary: Discards the cached values, e.g. after the sensor configuration was
+*          changed, so that the next read of every sensor accesses the bus.
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_cache_invalidate(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_cache_free
+******************************************************************************
+* Summary: Releases the mutexes created by shield_xensiv_a_cache_init().
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_cache_free(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,502 @@
+/******************************************************************************
+ * \file shield_xensiv_a_chart.c
+ *
+ * Description: Implementation of the scrolling strip chart and numeric tiles
+ *              on the display of the shield support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "shield_xensiv_a_chart.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* ST7735S vertical scrolling definition command */
+#define ST7735S_CMD_VSCRDEF        (0x33U)
+/* ST7735S vertical scrolling start address command */
+#define ST7735S_CMD_VSCSAD         (0x37U)
+/* Lines of the ST7735S memory along the scroll direction */
+#define ST7735S_LINES              (162U)
+/* Glyphs of the numeric tiles */
+#define CHART_GLYPH_MINUS          (10U)
+#define CHART_GLYPH_POINT          (11U)
+#define CHART_GLYPH_SPACE          (12U)
+#define CHART_GLYPH_COLUMNS        (5U)
+#define CHART_GLYPH_ROWS           (7U)
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+/* 5x7 glyphs, one byte per column with the top row in bit 0 */
+static const uint8_t _chart_font[][CHART_GLYPH_COLUMNS] =
+{
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E },   /* 0 */
+    { 0x00, 0x42, 0x7F, 0x40, 0x00 },   /* 1 */
+    { 0x42, 0x61, 0x51, 0x49, 0x46 },   /* 2 */
+    { 0x21, 0x41, 0x45, 0x4B, 0x31 },   /* 3 */
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 },   /* 4 */
+    { 0x27, 0x45, 0x45, 0x45, 0x39 },   /* 5 */
+    { 0x3C, 0x4A, 0x49, 0x49, 0x30 },   /* 6 */
+    { 0x01, 0x71, 0x09, 0x05, 0x03 },   /* 7 */
+    { 0x36, 0x49, 0x49, 0x49, 0x36 },   /* 8 */
+    { 0x06, 0x49, 0x49, 0x29, 0x1E },   /* 9 */
+    { 0x08, 0x08, 0x08, 0x08, 0x08 },   /* - */
+    { 0x00, 0x60, 0x60, 0x00, 0x00 },   /* . */
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }    /*   */
+};
+
+static shield_xensiv_a_chart_cfg_t  _chart_cfg;
+static bool                         _chart_active;
+/* First scroll line of the chart and position of the oldest column in it */
+static uint16_t                     _chart_top;
+static uint16_t                     _chart_start;
+/* Row of the previous sample of each trace, for drawing connected lines */
+static uint16_t                     _chart_prev_row[SHIELD_XENSIV_A_CHART_MAX_TRACES];
+static bool                         _chart_has_prev;
+/* Pixels of one row or column, in the byte order of the display */
+static uint16_t                     _chart_pixels[SHIELD_XENSIV_A_DISPLAY_WIDTH];
+
+
+/******************************************************************************
+* _shield_xensiv_a_chart_line
+******************************************************************************/
+/* Converts between a display column and a scroll line of the controller */
+static inline uint16_t _shield_xensiv_a_chart_line(uint16_t x)
+{
+    uint16_t address = x + SHIELD_XENSIV_A_DISPLAY_X_OFFSET;
+    return (SHIELD_XENSIV_A_CHART_SCROLL_REVERSED)
+           ? (uint16_t)(ST7735S_LINES - 1U - address)
+           : address;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_chart_column_of
+******************************************************************************/
+static inline uint16_t _shield_xensiv_a_chart_column_of(uint16_t line)
+{
+    uint16_t address = (SHIELD_XENSIV_A_CHART_SCROLL_REVERSED)
+                       ? (uint16_t)(ST7735S_LINES - 1U - line)
+                       : line;
+    return address - SHIELD_XENSIV_A_DISPLAY_X_OFFSET;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_chart_background
+******************************************************************************/
+static inline uint16_t _shield_xensiv_a_chart_background(uint16_t row)
+{
+    bool grid = (0U != _chart_cfg.grid_rows) &&
+                (((SHIELD_XENSIV_A_DISPLAY_HEIGHT - 1U - row) % _chart_cfg.grid_rows) == 0U);
+    return SHIELD_XENSIV_A_DISPLAY_SWAP(grid ? _chart_cfg.grid_color : _chart_cfg.background);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_chart_row
+******************************************************************************/
+/* Row of a value, the top row being the maximum */
+static uint16_t _shield_xensiv_a_chart_row(float value)
+{
+    float position = (value - _chart_cfg.min) / (_chart_cfg.max - _chart_cfg.min);
+
+    /* Written so that NaN ends up at the bottom */
+    if (!(position > 0.0f))
+    {
+        position = 0.0f;
+    }
+    else if (position > 1.0f)
+    {
+        position = 1.0f;
+    }
+    return (uint16_t)((SHIELD_XENSIV_A_DISPLAY_HEIGHT - 1U) -
+                      (uint16_t)((position * (float)(SHIELD_XENSIV_A_DISPLAY_HEIGHT - 1U)) +
+                                 0.5f));
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_chart_erase
+******************************************************************************/
+/* Fills the chart columns with the background and restarts the traces. The
+   scroll start is moved back so that memory and display columns match. */
+static cy_rslt_t _shield_xensiv_a_chart_erase(void)
+{
+    const shield_xensiv_a_display_rect_t area =
+    {
+        _chart_cfg.x0, 0, _chart_cfg.x0 + _chart_cfg.width - 1U, SHIELD_XENSIV_A_DISPLAY_HEIGHT - 1U
+    };
+    cy_rslt_t result = shield_xensiv_a_display_set_window(&area);
+
+    for (uint16_t row = 0; (CY_RSLT_SUCCESS == result) && (row < SHIELD_XENSIV_A_DISPLAY_HEIGHT);
+         row++)
+    {
+        uint16_t color = _shield_xensiv_a_chart_background(row);
+        for (uint16_t i = 0; i < _chart_cfg.width; i++)
+        {
+            _chart_pixels[i] = color;
+        }
+        result = shield_xensiv_a_display_write_pixels(_chart_pixels, _chart_cfg.width);
+    }
+
+    _chart_start = 0;
+    _chart_has_prev = false;
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = shield_xensiv_a_display_command(ST7735S_CMD_VSCSAD, &_chart_top, 1);
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_chart_init
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_chart_init(const shield_xensiv_a_chart_cfg_t* cfg)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((NULL == cfg) || (cfg->width < 2U) ||
+        ((cfg->x0 + cfg->width) > SHIELD_XENSIV_A_DISPLAY_WIDTH) || (0U == cfg->traces) ||
+        (cfg->traces > SHIELD_XENSIV_A_CHART_MAX_TRACES) || !(cfg->max > cfg->min))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if ((shield_xensiv_a_get_ready_mask() & SHIELD_XENSIV_A_READY_DISPLAY) == 0)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        result = shield_xensiv_a_spi_acquire(SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        uint16_t first = _shield_xensiv_a_chart_line(cfg->x0);
+        uint16_t last  = _shield_xensiv_a_chart_line(cfg->x0 + cfg->width - 1U);
+
+        _chart_cfg = *cfg;
+        _chart_top = (first < last) ? first : last;
+
+        const uint16_t areas[3] = { _chart_top, cfg->width,
+                                    ST7735S_LINES - _chart_top - cfg->width };
+        result = shield_xensiv_a_display_command(ST7735S_CMD_VSCRDEF, areas, 3);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            result = _shield_xensiv_a_chart_erase();
+        }
+        _chart_active = (CY_RSLT_SUCCESS == result);
+
+        shield_xensiv_a_spi_release(SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_chart_append
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_chart_append(const float* values)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == values)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if (!_chart_active)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        result = shield_xensiv_a_spi_acquire(SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        for (uint16_t row = 0; row < SHIELD_XENSIV_A_DISPLAY_HEIGHT; row++)
+        {
+            _chart_pixels[row] = _shield_xensiv_a_chart_background(row);
+        }
+        for (uint8_t trace = 0; trace < _chart_cfg.traces; trace++)
+        {
+            uint16_t row  = _shield_xensiv_a_chart_row(values[trace]);
+            uint16_t from = _chart_has_prev ? _chart_prev_row[trace] : row;
+            uint16_t top    = (from < row) ? from : row;
+            uint16_t bottom = (from < row) ? row : from;
+
+            for (uint16_t y = top; y <= bottom; y++)
+            {
+                _chart_pixels[y] = SHIELD_XENSIV_A_DISPLAY_SWAP(_chart_cfg.colors[trace]);
+            }
+            _chart_prev_row[trace] = row;
+        }
+        _chart_has_prev = true;
+
+        /* The oldest column is overwritten and becomes the newest one by
+           moving the scroll start past it */
+        uint16_t line;
+        if (SHIELD_XENSIV_A_CHART_SCROLL_REVERSED)
+        {
+            _chart_start = (_chart_start + _chart_cfg.width - 1U) % _chart_cfg.width;
+            line = _chart_top + _chart_start;
+        }
+        else
+        {
+            line = _chart_top + _chart_start;
+            _chart_start = (_chart_start + 1U) % _chart_cfg.width;
+        }
+
+        uint16_t x = _shield_xensiv_a_chart_column_of(line);
+        const shield_xensiv_a_display_rect_t column =
+        {
+            x, 0, x, SHIELD_XENSIV_A_DISPLAY_HEIGHT - 1U
+        };
+        result = shield_xensiv_a_display_set_window(&column);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            result = shield_xensiv_a_display_write_pixels(_chart_pixels,
+                                                          SHIELD_XENSIV_A_DISPLAY_HEIGHT);
+        }
+        if (CY_RSLT_SUCCESS == result)
+        {
+            const uint16_t start = _chart_top + _chart_start;
+            result = shield_xensiv_a_display_command(ST7735S_CMD_VSCSAD, &start, 1);
+        }
+
+        shield_xensiv_a_spi_release(SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_chart_clear
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_chart_clear(void)
+{
+    cy_rslt_t result = _chart_active
+                       ? shield_xensiv_a_spi_acquire(SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY)
+                       : SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = _shield_xensiv_a_chart_erase();
+        shield_xensiv_a_spi_release(SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_chart_format
+******************************************************************************/
+/* Right aligned text of a fixed point value, dashes if it does not fit */
+static void _shield_xensiv_a_chart_format(const shield_xensiv_a_chart_tile_t* tile,
+                                          int32_t value, char* text)
+{
+    /* Built from the right, with room for all digits of a 32-bit value */
+    char reversed[SHIELD_XENSIV_A_CHART_TILE_MAX_CHARS + 12U];
+    uint32_t magnitude = (value < 0) ? (0UL - (uint32_t)value) : (uint32_t)value;
+    uint8_t length = 0;
+    uint8_t digits = 0;
+
+    /* At least one digit before the decimal point */
+    do
+    {
+        if ((digits == tile->decimals) && (digits > 0U))
+        {
+            reversed[length++] = '.';
+        }
+        reversed[length++] = (char)('0' + (magnitude % 10U));
+        magnitude /= 10U;
+        digits++;
+    } while ((magnitude > 0U) || (digits <= tile->decimals));
+
+    if (value < 0)
+    {
+        reversed[length++] = '-';
+    }
+
+    for (uint8_t i = 0; i < tile->chars; i++)
+    {
+        text[tile->chars - 1U - i] = (length > tile->chars) ? '-'
+                                     : (i < length) ? reversed[i]
+                                     : ' ';
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_chart_draw_char
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_chart_draw_char(const shield_xensiv_a_chart_tile_t* tile,
+                                                  uint8_t index, char c)
+{
+    uint16_t width  = SHIELD_XENSIV_A_CHART_CHAR_WIDTH * tile->scale;
+    uint16_t height = SHIELD_XENSIV_A_CHART_CHAR_HEIGHT * tile->scale;
+    uint16_t x = tile->x + (index * width);
+    uint8_t glyph = ((c >= '0') && (c <= '9')) ? (uint8_t)(c - '0')
+                    : ('-' == c) ? CHART_GLYPH_MINUS
+                    : ('.' == c) ? CHART_GLYPH_POINT
+                    : CHART_GLYPH_SPACE;
+
+    const shield_xensiv_a_display_rect_t cell =
+    {
+        x, tile->y, x + width - 1U, tile->y + height - 1U
+    };
+
+    cy_rslt_t result = shield_xensiv_a_display_set_window(&cell);
+    for (uint16_t row = 0; (CY_RSLT_SUCCESS == result) && (row < height); row++)
+    {
+        uint8_t glyph_row = (uint8_t)(row / tile->scale);
+        for (uint16_t column = 0; column < width; column++)
+        {
+            uint8_t glyph_column = (uint8_t)(column / tile->scale);
+            bool on = (glyph_column < CHART_GLYPH_COLUMNS) && (glyph_row < CHART_GLYPH_ROWS) &&
+                      (((_chart_font[glyph][glyph_column] >> glyph_row) & 1U) != 0U);
+            _chart_pixels[column] = SHIELD_XENSIV_A_DISPLAY_SWAP(on ? tile->color
+                                                                    : tile->background);
+        }
+        result = shield_xensiv_a_display_write_pixels(_chart_pixels, width);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_chart_tile_update
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_chart_tile_update(shield_xensiv_a_chart_tile_t* tile, int32_t value)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    char text[SHIELD_XENSIV_A_CHART_TILE_MAX_CHARS];
+    uint16_t x1 = 0;
+
+    if (NULL != tile)
+    {
+        x1 = tile->x + ((uint16_t)tile->chars * SHIELD_XENSIV_A_CHART_CHAR_WIDTH * tile->scale) - 1U;
+    }
+
+    if ((NULL == tile) || (0U == tile->chars) ||
+        (tile->chars > SHIELD_XENSIV_A_CHART_TILE_MAX_CHARS) ||
+        (tile->decimals >= tile->chars) || (0U == tile->scale) ||
+        (tile->scale > SHIELD_XENSIV_A_CHART_MAX_SCALE) ||
+        (x1 >= SHIELD_XENSIV_A_DISPLAY_WIDTH) ||
+        ((tile->y + (SHIELD_XENSIV_A_CHART_CHAR_HEIGHT * tile->scale)) >
+         SHIELD_XENSIV_A_DISPLAY_HEIGHT) ||
+        (_chart_active && (x1 >= _chart_cfg.x0) &&
+         (tile->x < (_chart_cfg.x0 + _chart_cfg.width))))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if ((shield_xensiv_a_get_ready_mask() & SHIELD_XENSIV_A_READY_DISPLAY) == 0)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        uint8_t first = 0;
+
+        _shield_xensiv_a_chart_format(tile, value, text);
+        while ((first < tile->chars) && (text[first] == tile->shown[first]))
+        {
+            first++;
+        }
+
+        /* The bus is only taken if something changed */
+        if (first < tile->chars)
+        {
+            result = shield_xensiv_a_spi_acquire(SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY);
+            if (CY_RSLT_SUCCESS == result)
+            {
+                for (uint8_t i = first; (CY_RSLT_SUCCESS == result) && (i < tile->chars); i++)
+                {
+                    if (text[i] != tile->shown[i])
+                    {
+                        result = _shield_xensiv_a_chart_draw_char(tile, i, text[i]);
+                        if (CY_RSLT_SUCCESS == result)
+                        {
+                            tile->shown[i] = text[i];
+                        }
+                    }
+                }
+                shield_xensiv_a_spi_release(SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY);
+            }
+        }
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_chart_free
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_chart_free(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (_chart_active)
+    {
+        result = shield_xensiv_a_spi_acquire(SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            const uint16_t areas[3] = { 0, ST7735S_LINES, 0 };
+            const uint16_t start = 0;
+
+            result = _shield_xensiv_a_chart_erase();
+            if (CY_RSLT_SUCCESS == result)
+            {
+                result = shield_xensiv_a_display_command(ST7735S_CMD_VSCRDEF, areas, 3);
+            }
+            if (CY_RSLT_SUCCESS == result)
+            {
+                result = shield_xensiv_a_display_command(ST7735S_CMD_VSCSAD, &start, 1);
+            }
+            _chart_active = false;
+
+            shield_xensiv_a_spi_release(SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY);
+        }
+    }
+
+    return result;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
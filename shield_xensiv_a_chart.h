@@ -0,0 +1,209 @@
+/******************************************************************************
+ * \file shield_xensiv_a_chart.h
+ *
+ * Description: This file is the interface for the scrolling strip chart and
+ *              numeric tiles on the display of the SHIELD_XENSIV_A shield
+ *              board.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a_display.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#ifndef SHIELD_XENSIV_A_CHART_MAX_TRACES
+/** Number of traces a chart can show */
+#define SHIELD_XENSIV_A_CHART_MAX_TRACES        (4U)
+#endif
+
+#ifndef SHIELD_XENSIV_A_CHART_TILE_MAX_CHARS
+/** Number of characters a numeric tile can show */
+#define SHIELD_XENSIV_A_CHART_TILE_MAX_CHARS    (8U)
+#endif
+
+#ifndef SHIELD_XENSIV_A_CHART_SCROLL_REVERSED
+/** Set to 1 if the display orientation maps the columns to the scroll lines of
+ * the ST7735S in reverse order, which makes the chart scroll to the right */
+#define SHIELD_XENSIV_A_CHART_SCROLL_REVERSED   (0)
+#endif
+
+/** Width of a character of a numeric tile at scale 1 */
+#define SHIELD_XENSIV_A_CHART_CHAR_WIDTH        (6U)
+/** Height of a character of a numeric tile at scale 1 */
+#define SHIELD_XENSIV_A_CHART_CHAR_HEIGHT       (8U)
+/** Largest scale of the characters of a numeric tile */
+#define SHIELD_XENSIV_A_CHART_MAX_SCALE         (4U)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Configuration of the strip chart */
+typedef struct
+{
+    /** First column of the chart */
+    uint16_t    x0;
+    /** Number of columns of the chart, which use the full display height */
+    uint16_t    width;
+    /** Value shown in the bottom row */
+    float       min;
+    /** Value shown in the top row */
+    float       max;
+    /** Number of traces, up to SHIELD_XENSIV_A_CHART_MAX_TRACES */
+    uint8_t     traces;
+    /** RGB565 colors of the traces */
+    uint16_t    colors[SHIELD_XENSIV_A_CHART_MAX_TRACES];
+    /** RGB565 background color */
+    uint16_t    background;
+    /** RGB565 color of the horizontal grid lines */
+    uint16_t    grid_color;
+    /** Distance of the horizontal grid lines in rows, 0 for none */
+    uint16_t    grid_rows;
+} shield_xensiv_a_chart_cfg_t;
+
+/** A numeric tile. The public members are set by the application, the shown
+ * text must start zeroed, e.g. by static or designated initialization. */
+typedef struct
+{
+    uint16_t    x;          /**< Left column */
+    uint16_t    y;          /**< Top row */
+    uint8_t     chars;      /**< Width in characters, the value is right aligned */
+    uint8_t     decimals;   /**< Digits after the decimal point */
+    uint8_t     scale;      /**< Size of the characters, 1 to SHIELD_XENSIV_A_CHART_MAX_SCALE */
+    uint16_t    color;      /**< RGB565 color of the characters */
+    uint16_t    background; /**< RGB565 background color */
+    /** Text on the display, private */
+    char        shown[SHIELD_XENSIV_A_CHART_TILE_MAX_CHARS];
+} shield_xensiv_a_chart_tile_t;
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_chart_init
+******************************************************************************
+* Summary: Sets up a strip chart on the columns x0 to x0 + width - 1, using
+*          the vertical scroll area of the ST7735S: appending a sample writes
+*          a single new column and moves the scroll start, so the rest of the
+*          chart is not sent again. The columns of the chart are cleared. The
+*          columns outside the chart are not scrolled and can hold numeric
+*          tiles. Drawing is done with blocking SPI transfers while the SPI
+*          bus is reserved with shield_xensiv_a_spi_acquire(); framebuffer
+*          flushes and emWin drawing must not touch the chart columns.
+*
+* Parameters:
+*  cfg               Configuration of the chart, copied
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_BUSY if the SPI bus is
+*  in use
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_chart_init(const shield_xensiv_a_chart_cfg_t* cfg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_chart_append
+******************************************************************************
+* Summary: Appends one sample per trace on the right of the chart, scrolling
+*          the chart one column to the left. Each trace is drawn as a line
+*          from its previous sample, values outside the range are clipped.
+*          About 200 bytes are sent per sample.
+*
+* Parameters:
+*  values            One value per trace
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_BUSY if the SPI bus is
+*  in use
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_chart_append(const float* values);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_chart_clear
+******************************************************************************
+* Summary: Clears the chart and restarts the traces.
+*
+* Parameters: None
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_chart_clear(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_chart_tile_update
+******************************************************************************
+* Summary: Shows a value in a numeric tile. Nothing is sent if the text does
+*          not change, otherwise only the characters which differ are drawn.
+*          The value is a fixed point number with tile->decimals digits after
+*          the decimal point, e.g. 1234 with 2 decimals shows "12.34". A value
+*          which does not fit is shown as dashes. Tiles must not overlap the
+*          chart columns.
+*
+* Parameters:
+*  tile              The tile
+*  value             The value to show
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_BUSY if the SPI bus is
+*  in use
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_chart_tile_update(shield_xensiv_a_chart_tile_t* tile, int32_t value);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_chart_free
+******************************************************************************
+* Summary: Stops the strip chart: the chart columns are cleared to the
+*          background and the scrolling is turned off again, so that the
+*          display memory maps to the display as before. Nothing is done if
+*          no chart is set up.
+*
+* Parameters: None
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_BUSY if the SPI bus is
+*  in use, in which case the chart keeps running
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_chart_free(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
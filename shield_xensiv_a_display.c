@@ -0,0 +1,645 @@
+/******************************************************************************
+ * \file shield_xensiv_a_display.c
+ *
+ * Description: Implementation of the framebuffer mode of the display of the
+ *              shield support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "shield_xensiv_a_display.h"
+#include "shield_xensiv_a_metrics.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* ST7735S column address set command */
+#define ST7735S_CMD_CASET          (0x2AU)
+/* ST7735S row address set command */
+#define ST7735S_CMD_RASET          (0x2BU)
+/* ST7735S memory write command */
+#define ST7735S_CMD_RAMWR          (0x2CU)
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+typedef enum
+{
+    _DISPLAY_STEP_CASET,
+    _DISPLAY_STEP_CASET_DATA,
+    _DISPLAY_STEP_RASET,
+    _DISPLAY_STEP_RASET_DATA,
+    _DISPLAY_STEP_RAMWR,
+    _DISPLAY_STEP_PIXELS
+} _shield_xensiv_a_display_step_t;
+
+static uint16_t*                            _display_fb;
+static cyhal_spi_t*                         _display_spi;
+static uint8_t                              _display_intr_priority;
+
+/* Areas changed since the last flush */
+static shield_xensiv_a_display_rect_t       _display_dirty[SHIELD_XENSIV_A_DISPLAY_MAX_DIRTY_RECTS];
+static uint8_t                              _display_dirty_count;
+
+/* State of the flush in progress */
+static shield_xensiv_a_display_rect_t       _display_flush_rects[SHIELD_XENSIV_A_DISPLAY_MAX_DIRTY_RECTS];
+static uint8_t                              _display_flush_count;
+static uint8_t                              _display_flush_index;
+static uint16_t                             _display_flush_row;
+static _shield_xensiv_a_display_step_t      _display_flush_step;
+static volatile bool                        _display_busy;
+static uint8_t                              _display_cmd;
+static uint8_t                              _display_params[4];
+#if SHIELD_XENSIV_A_METRICS_ENABLED
+static uint32_t                             _display_flush_start_us;
+static uint32_t                             _display_flush_bytes;
+#endif
+static shield_xensiv_a_display_callback_t   _display_callback;
+static void*                                _display_callback_arg;
+
+
+/******************************************************************************
+* _shield_xensiv_a_display_touches
+******************************************************************************/
+/* Whether two rectangles overlap or are directly adjacent */
+static bool _shield_xensiv_a_display_touches(const shield_xensiv_a_display_rect_t* a,
+                                             const shield_xensiv_a_display_rect_t* b)
+{
+    return !(((a->x1 + 1U) < b->x0) || ((b->x1 + 1U) < a->x0) ||
+             ((a->y1 + 1U) < b->y0) || ((b->y1 + 1U) < a->y0));
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_display_union
+******************************************************************************/
+static void _shield_xensiv_a_display_union(shield_xensiv_a_display_rect_t* a,
+                                           const shield_xensiv_a_display_rect_t* b)
+{
+    a->x0 = (b->x0 < a->x0) ? b->x0 : a->x0;
+    a->y0 = (b->y0 < a->y0) ? b->y0 : a->y0;
+    a->x1 = (b->x1 > a->x1) ? b->x1 : a->x1;
+    a->y1 = (b->y1 > a->y1) ? b->y1 : a->y1;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_display_area
+******************************************************************************/
+static uint32_t _shield_xensiv_a_display_area(const shield_xensiv_a_display_rect_t* a)
+{
+    return (uint32_t)(a->x1 - a->x0 + 1U) * (uint32_t)(a->y1 - a->y0 + 1U);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_display_add_dirty
+******************************************************************************/
+static void _shield_xensiv_a_display_add_dirty(const shield_xensiv_a_display_rect_t* rect)
+{
+    uint8_t target = _display_dirty_count;
+
+    for (uint8_t i = 0; i < _display_dirty_count; i++)
+    {
+        if (_shield_xensiv_a_display_touches(&_display_dirty[i], rect))
+        {
+            target = i;
+            break;
+        }
+    }
+
+    if ((target == _display_dirty_count) &&
+        (_display_dirty_count == SHIELD_XENSIV_A_DISPLAY_MAX_DIRTY_RECTS))
+    {
+        /* No free slot, merge into the rectangle which grows the least */
+        uint32_t best_growth = UINT32_MAX;
+        for (uint8_t i = 0; i < _display_dirty_count; i++)
+        {
+            shield_xensiv_a_display_rect_t merged = _display_dirty[i];
+            _shield_xensiv_a_display_union(&merged, rect);
+            uint32_t growth = _shield_xensiv_a_display_area(&merged) -
+                              _shield_xensiv_a_display_area(&_display_dirty[i]);
+            if (growth < best_growth)
+            {
+                best_growth = growth;
+                target = i;
+            }
+        }
+    }
+
+    if (target == _display_dirty_count)
+    {
+        _display_dirty[_display_dirty_count++] = *rect;
+    }
+    else
+    {
+        /* A grown rectangle may now touch others, so keep merging */
+        bool merged;
+        _shield_xensiv_a_display_union(&_display_dirty[target], rect);
+        do
+        {
+            merged = false;
+            for (uint8_t i = 0; (i < _display_dirty_count) && !merged; i++)
+            {
+                if ((i != target) &&
+                    _shield_xensiv_a_display_touches(&_display_dirty[i], &_display_dirty[target]))
+                {
+                    _shield_xensiv_a_display_union(&_display_dirty[target], &_display_dirty[i]);
+                    _display_dirty[i] = _display_dirty[--_display_dirty_count];
+                    if (target == _display_dirty_count)
+                    {
+                        target = i;
+                    }
+                    merged = true;
+                }
+            }
+        } while (merged);
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_display_clip
+******************************************************************************/
+static bool _shield_xensiv_a_display_clip(const shield_xensiv_a_display_rect_t* in,
+                                          shield_xensiv_a_display_rect_t* out)
+{
+    bool visible = (NULL != in) && (in->x0 <= in->x1) && (in->y0 <= in->y1) &&
+                   (in->x0 < SHIELD_XENSIV_A_DISPLAY_WIDTH) &&
+                   (in->y0 < SHIELD_XENSIV_A_DISPLAY_HEIGHT);
+    if (visible)
+    {
+        *out = *in;
+        if (out->x1 >= SHIELD_XENSIV_A_DISPLAY_WIDTH)
+        {
+            out->x1 = SHIELD_XENSIV_A_DISPLAY_WIDTH - 1U;
+        }
+        if (out->y1 >= SHIELD_XENSIV_A_DISPLAY_HEIGHT)
+        {
+            out->y1 = SHIELD_XENSIV_A_DISPLAY_HEIGHT - 1U;
+        }
+    }
+    return visible;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_display_finish
+******************************************************************************/
+static void _shield_xensiv_a_display_finish(cy_rslt_t result)
+{
+    _display_busy = false;
+    shield_xensiv_a_spi_release(SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY);
+    SHIELD_XENSIV_A_METRICS_RECORD(SHIELD_XENSIV_A_METRICS_DISPLAY,
+                                   shield_xensiv_a_get_timestamp_us() - _display_flush_start_us,
+                                   _display_flush_bytes, result);
+    if (NULL != _display_callback)
+    {
+        _display_callback(result, _display_callback_arg);
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_display_select
+******************************************************************************/
+/* Selects whether the following bytes are a command or its data */
+static void _shield_xensiv_a_display_select(bool is_data)
+{
+    cyhal_gpio_write(shield_xensiv_a_get_pins()->spi_dc_ds, is_data);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_display_encode
+******************************************************************************/
+/* Converts 16-bit command parameters to the bytes sent, most significant byte
+   first. The window commands are encoded the same way by the flushes and the
+   blocking functions. */
+static size_t _shield_xensiv_a_display_encode(uint8_t* data, const uint16_t* params,
+                                              uint8_t count)
+{
+    for (uint8_t i = 0; i < count; i++)
+    {
+        data[2U * i]        = (uint8_t)(params[i] >> 8);
+        data[(2U * i) + 1U] = (uint8_t)(params[i] & 0xFFU);
+    }
+    return 2U * (size_t)count;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_display_range
+******************************************************************************/
+/* Parameters of CASET or RASET for a range of display columns or rows */
+static size_t _shield_xensiv_a_display_range(uint8_t* data, uint16_t start, uint16_t end,
+                                             uint16_t offset)
+{
+    const uint16_t range[2] = { start + offset, end + offset };
+    return _shield_xensiv_a_display_encode(data, range, 2);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_display_send
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_display_send(bool is_data, const uint8_t* data, size_t size)
+{
+    _shield_xensiv_a_display_select(is_data);
+#if SHIELD_XENSIV_A_METRICS_ENABLED
+    _display_flush_bytes += (uint32_t)size;
+#endif
+    return cyhal_spi_transfer_async(_display_spi, data, size, NULL, 0);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_display_send_blocking
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_display_send_blocking(bool is_data, const uint8_t* data,
+                                                        size_t size)
+{
+    _shield_xensiv_a_display_select(is_data);
+    return cyhal_spi_transfer(shield_xensiv_a_get_spi(), data, size, NULL, 0, 0);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_display_next
+******************************************************************************/
+/* Starts the next transfer of the flush, or completes it */
+static void _shield_xensiv_a_display_next(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    bool sent = false;
+
+    while (!sent && (CY_RSLT_SUCCESS == result) && (_display_flush_index < _display_flush_count))
+    {
+        const shield_xensiv_a_display_rect_t* rect = &_display_flush_rects[_display_flush_index];
+        uint16_t width = (uint16_t)(rect->x1 - rect->x0 + 1U);
+
+        switch (_display_flush_step)
+        {
+            case _DISPLAY_STEP_CASET:
+                _display_cmd = ST7735S_CMD_CASET;
+                result = _shield_xensiv_a_display_send(false, &_display_cmd, 1);
+                _display_flush_step = _DISPLAY_STEP_CASET_DATA;
+                sent = true;
+                break;
+
+            case _DISPLAY_STEP_CASET_DATA:
+                result = _shield_xensiv_a_display_send(
+                    true, _display_params,
+                    _shield_xensiv_a_display_range(_display_params, rect->x0, rect->x1,
+                                                   SHIELD_XENSIV_A_DISPLAY_X_OFFSET));
+                _display_flush_step = _DISPLAY_STEP_RASET;
+                sent = true;
+                break;
+
+            case _DISPLAY_STEP_RASET:
+                _display_cmd = ST7735S_CMD_RASET;
+                result = _shield_xensiv_a_display_send(false, &_display_cmd, 1);
+                _display_flush_step = _DISPLAY_STEP_RASET_DATA;
+                sent = true;
+                break;
+
+            case _DISPLAY_STEP_RASET_DATA:
+                result = _shield_xensiv_a_display_send(
+                    true, _display_params,
+                    _shield_xensiv_a_display_range(_display_params, rect->y0, rect->y1,
+                                                   SHIELD_XENSIV_A_DISPLAY_Y_OFFSET));
+                _display_flush_step = _DISPLAY_STEP_RAMWR;
+                sent = true;
+                break;
+
+            case _DISPLAY_STEP_RAMWR:
+                _display_cmd = ST7735S_CMD_RAMWR;
+                _display_flush_row = rect->y0;
+                result = _shield_xensiv_a_display_send(false, &_display_cmd, 1);
+                _display_flush_step = _DISPLAY_STEP_PIXELS;
+                sent = true;
+                break;
+
+            default:
+                if (_display_flush_row <= rect->y1)
+                {
+                    /* Full width rectangles are contiguous in the framebuffer */
+                    uint16_t rows = (width == SHIELD_XENSIV_A_DISPLAY_WIDTH)
+                        ? (uint16_t)(rect->y1 - _display_flush_row + 1U)
+                        : 1U;
+                    const uint16_t* pixels = &_display_fb[(_display_flush_row *
+                                                           SHIELD_XENSIV_A_DISPLAY_WIDTH) +
+                                                          rect->x0];
+                    _display_flush_row += rows;
+                    result = _shield_xensiv_a_display_send(true, (const uint8_t*)pixels,
+                                                           (size_t)width * rows * 2U);
+                    sent = true;
+                }
+                else
+                {
+                    _display_flush_index++;
+                    _display_flush_step = _DISPLAY_STEP_CASET;
+                }
+                break;
+        }
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        _shield_xensiv_a_display_finish(result);
+    }
+    else if (!sent)
+    {
+        _shield_xensiv_a_display_finish(CY_RSLT_SUCCESS);
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_display_event
+******************************************************************************/
+static void _shield_xensiv_a_display_event(void* callback_arg, cyhal_spi_event_t event)
+{
+    (void)callback_arg;
+
+    if (_display_busy)
+    {
+        if ((event & CYHAL_SPI_IRQ_ERROR) != 0)
+        {
+            _shield_xensiv_a_display_finish(SHIELD_XENSIV_A_RSLT_ERR_TRANSFER);
+        }
+        else if ((event & CYHAL_SPI_IRQ_DONE) != 0)
+        {
+            _shield_xensiv_a_display_next();
+        }
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_display_fb_init
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_display_fb_init(uint16_t* framebuffer, uint8_t intr_priority)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((NULL == framebuffer) || (NULL != _display_fb))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if ((shield_xensiv_a_get_ready_mask() & SHIELD_XENSIV_A_READY_DISPLAY) == 0)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        _display_spi = shield_xensiv_a_get_spi();
+        _display_fb = framebuffer;
+        _display_intr_priority = intr_priority;
+        _display_dirty_count = 0;
+        _display_busy = false;
+
+        /* Prefer DMA for the pixel data, but interrupt driven transfers work too */
+        if (CY_RSLT_SUCCESS != cyhal_spi_set_async_mode(_display_spi, CYHAL_ASYNC_DMA,
+                                                        CYHAL_DMA_PRIORITY_DEFAULT))
+        {
+            (void)cyhal_spi_set_async_mode(_display_spi, CYHAL_ASYNC_SW,
+                                           CYHAL_DMA_PRIORITY_DEFAULT);
+        }
+        cyhal_spi_register_callback(_display_spi, _shield_xensiv_a_display_event, NULL);
+        cyhal_spi_enable_event(_display_spi,
+                               (cyhal_spi_event_t)(CYHAL_SPI_IRQ_DONE | CYHAL_SPI_IRQ_ERROR),
+                               intr_priority, true);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_display_set_pixel
+******************************************************************************/
+void shield_xensiv_a_display_set_pixel(uint16_t x, uint16_t y, uint16_t color)
+{
+    if ((NULL != _display_fb) && (x < SHIELD_XENSIV_A_DISPLAY_WIDTH) &&
+        (y < SHIELD_XENSIV_A_DISPLAY_HEIGHT))
+    {
+        shield_xensiv_a_display_rect_t rect = { x, y, x, y };
+        _display_fb[(y * SHIELD_XENSIV_A_DISPLAY_WIDTH) + x] = SHIELD_XENSIV_A_DISPLAY_SWAP(color);
+        _shield_xensiv_a_display_add_dirty(&rect);
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_display_fill_rect
+******************************************************************************/
+void shield_xensiv_a_display_fill_rect(const shield_xensiv_a_display_rect_t* rect,
+                                       uint16_t color)
+{
+    shield_xensiv_a_display_rect_t clipped;
+
+    if ((NULL != _display_fb) && _shield_xensiv_a_display_clip(rect, &clipped))
+    {
+        uint16_t swapped = SHIELD_XENSIV_A_DISPLAY_SWAP(color);
+        for (uint16_t y = clipped.y0; y <= clipped.y1; y++)
+        {
+            uint16_t* row = &_display_fb[y * SHIELD_XENSIV_A_DISPLAY_WIDTH];
+            for (uint16_t x = clipped.x0; x <= clipped.x1; x++)
+            {
+                row[x] = swapped;
+            }
+        }
+        _shield_xensiv_a_display_add_dirty(&clipped);
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_display_mark_dirty
+******************************************************************************/
+void shield_xensiv_a_display_mark_dirty(const shield_xensiv_a_display_rect_t* rect)
+{
+    shield_xensiv_a_display_rect_t clipped;
+
+    if ((NULL != _display_fb) && _shield_xensiv_a_display_clip(rect, &clipped))
+    {
+        _shield_xensiv_a_display_add_dirty(&clipped);
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_display_flush
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_display_flush(shield_xensiv_a_display_callback_t callback,
+                                        void* callback_arg)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == _display_fb)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else if (_display_busy)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BUSY;
+    }
+    else
+    {
+        result = shield_xensiv_a_spi_acquire(SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        for (uint8_t i = 0; i < _display_dirty_count; i++)
+        {
+            _display_flush_rects[i] = _display_dirty[i];
+        }
+        _display_flush_count = _display_dirty_count;
+        _display_flush_index = 0;
+        _display_flush_step = _DISPLAY_STEP_CASET;
+        _display_dirty_count = 0;
+        _display_callback = callback;
+        _display_callback_arg = callback_arg;
+        _display_busy = true;
+#if SHIELD_XENSIV_A_METRICS_ENABLED
+        _display_flush_start_us = shield_xensiv_a_get_timestamp_us();
+        _display_flush_bytes = 0;
+#endif
+
+        uint32_t state = cyhal_system_critical_section_enter();
+        _shield_xensiv_a_display_next();
+        cyhal_system_critical_section_exit(state);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_display_is_busy
+******************************************************************************/
+bool shield_xensiv_a_display_is_busy(void)
+{
+    return _display_busy;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_display_command
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_display_command(uint8_t cmd, const uint16_t* params, uint8_t count)
+{
+    uint8_t data[2U * SHIELD_XENSIV_A_DISPLAY_MAX_PARAMS];
+    cy_rslt_t result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+
+    if ((count <= SHIELD_XENSIV_A_DISPLAY_MAX_PARAMS) && ((0U == count) || (NULL != params)))
+    {
+        size_t size = _shield_xensiv_a_display_encode(data, params, count);
+
+        result = _shield_xensiv_a_display_send_blocking(false, &cmd, 1);
+        if ((CY_RSLT_SUCCESS == result) && (size > 0U))
+        {
+            result = _shield_xensiv_a_display_send_blocking(true, data, size);
+        }
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_display_set_window
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_display_set_window(const shield_xensiv_a_display_rect_t* rect)
+{
+    uint8_t data[4];
+    uint8_t cmd = ST7735S_CMD_CASET;
+
+    cy_rslt_t result = _shield_xensiv_a_display_send_blocking(false, &cmd, 1);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = _shield_xensiv_a_display_send_blocking(
+            true, data, _shield_xensiv_a_display_range(data, rect->x0, rect->x1,
+                                                       SHIELD_XENSIV_A_DISPLAY_X_OFFSET));
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        cmd = ST7735S_CMD_RASET;
+        result = _shield_xensiv_a_display_send_blocking(false, &cmd, 1);
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = _shield_xensiv_a_display_send_blocking(
+            true, data, _shield_xensiv_a_display_range(data, rect->y0, rect->y1,
+                                                       SHIELD_XENSIV_A_DISPLAY_Y_OFFSET));
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        cmd = ST7735S_CMD_RAMWR;
+        result = _shield_xensiv_a_display_send_blocking(false, &cmd, 1);
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_display_write_pixels
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_display_write_pixels(const uint16_t* pixels, size_t count)
+{
+    return _shield_xensiv_a_display_send_blocking(true, (const uint8_t*)pixels, count * 2U);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_display_fb_free
+******************************************************************************/
+void shield_xensiv_a_display_fb_free(void)
+{
+    if (NULL != _display_fb)
+    {
+        if (_display_busy)
+        {
+            (void)cyhal_spi_abort_async(_display_spi);
+            _shield_xensiv_a_display_finish(SHIELD_XENSIV_A_RSLT_ERR_ABORTED);
+        }
+        cyhal_spi_enable_event(_display_spi,
+                               (cyhal_spi_event_t)(CYHAL_SPI_IRQ_DONE | CYHAL_SPI_IRQ_ERROR),
+                               _display_intr_priority, false);
+        cyhal_spi_register_callback(_display_spi, NULL, NULL);
+        (void)cyhal_spi_set_async_mode(_display_spi, CYHAL_ASYNC_SW, CYHAL_DMA_PRIORITY_DEFAULT);
+        _display_fb = NULL;
+        _display_spi = NULL;
+    }
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
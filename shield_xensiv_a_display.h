@@ -0,0 +1,278 @@
+/******************************************************************************
+ * \file shield_xensiv_a_display.h
+ *
+ * Description: This file is the interface for the framebuffer mode of the
+ *              ST7735S display on the SHIELD_XENSIV_A shield board.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/** Width of the display in pixels, in the landscape orientation used by the
+ * display driver */
+#define SHIELD_XENSIV_A_DISPLAY_WIDTH           (160U)
+/** Height of the display in pixels */
+#define SHIELD_XENSIV_A_DISPLAY_HEIGHT          (80U)
+/** Number of pixels in a framebuffer */
+#define SHIELD_XENSIV_A_DISPLAY_PIXELS          (SHIELD_XENSIV_A_DISPLAY_WIDTH * \
+                                                 SHIELD_XENSIV_A_DISPLAY_HEIGHT)
+
+#ifndef SHIELD_XENSIV_A_DISPLAY_X_OFFSET
+/** Offset of the first visible column in the ST7735S memory */
+#define SHIELD_XENSIV_A_DISPLAY_X_OFFSET        (1U)
+#endif
+
+#ifndef SHIELD_XENSIV_A_DISPLAY_Y_OFFSET
+/** Offset of the first visible row in the ST7735S memory */
+#define SHIELD_XENSIV_A_DISPLAY_Y_OFFSET        (26U)
+#endif
+
+#ifndef SHIELD_XENSIV_A_DISPLAY_MAX_DIRTY_RECTS
+/** Number of separate dirty rectangles tracked before they are merged */
+#define SHIELD_XENSIV_A_DISPLAY_MAX_DIRTY_RECTS (4U)
+#endif
+
+/** Converts 8-bit red, green and blue components to an RGB565 color */
+#define SHIELD_XENSIV_A_DISPLAY_RGB565(r, g, b) \
+    ((uint16_t)((((uint16_t)(r) & 0xF8U) << 8) | (((uint16_t)(g) & 0xFCU) << 3) | \
+                ((uint16_t)(b) >> 3)))
+
+/** Converts an RGB565 color to the byte order of the display, as stored in a
+ * framebuffer */
+#define SHIELD_XENSIV_A_DISPLAY_SWAP(color)     ((uint16_t)(((color) >> 8) | ((color) << 8)))
+
+/** Largest number of parameters of shield_xensiv_a_display_command() */
+#define SHIELD_XENSIV_A_DISPLAY_MAX_PARAMS      (3U)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** A rectangle on the display, with inclusive coordinates */
+typedef struct
+{
+    uint16_t x0;    /**< Left column */
+    uint16_t y0;    /**< Top row */
+    uint16_t x1;    /**< Right column */
+    uint16_t y1;    /**< Bottom row */
+} shield_xensiv_a_display_rect_t;
+
+/** Callback invoked from the SPI interrupt when a flush has completed */
+typedef void (*shield_xensiv_a_display_callback_t)(cy_rslt_t result, void* callback_arg);
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_display_fb_init
+******************************************************************************
+* Summary: Starts the framebuffer mode of the display. Drawing happens in the
+*          caller supplied framebuffer and only the changed areas are sent to
+*          the display by shield_xensiv_a_display_flush(), using asynchronous
+*          (DMA when available) SPI transfers. Use
+*          shield_xensiv_a_set_spi_frequency() to raise the SPI clock. The
+*          framebuffer mode must not be mixed with emWin drawing.
+*
+* Parameters:
+*  framebuffer       Buffer of SHIELD_XENSIV_A_DISPLAY_PIXELS pixels, which
+*                    must stay valid until shield_xensiv_a_display_fb_free().
+*                    Pixels are stored in the byte order of the display.
+*  intr_priority     Priority of the SPI interrupt
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_display_fb_init(uint16_t* framebuffer, uint8_t intr_priority);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_display_set_pixel
+******************************************************************************
+* Summary: Sets one pixel in the framebuffer and marks it dirty.
+*
+* Parameters:
+*  x                 Column of the pixel
+*  y                 Row of the pixel
+*  color             RGB565 color of the pixel
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_display_set_pixel(uint16_t x, uint16_t y, uint16_t color);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_display_fill_rect
+******************************************************************************
+* Summary: Fills a rectangle in the framebuffer and marks it dirty. The
+*          rectangle is clipped to the display.
+*
+* Parameters:
+*  rect              The rectangle to fill
+*  color             RGB565 fill color
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_display_fill_rect(const shield_xensiv_a_display_rect_t* rect,
+                                       uint16_t color);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_display_mark_dirty
+******************************************************************************
+* Summary: Marks a rectangle as changed after the application wrote to the
+*          framebuffer directly.
+*
+* Parameters:
+*  rect              The changed rectangle
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_display_mark_dirty(const shield_xensiv_a_display_rect_t* rect);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_display_flush
+******************************************************************************
+* Summary: Starts sending all dirty rectangles to the display and returns
+*          immediately. Areas drawn while the flush is in progress are sent
+*          by the next flush.
+*
+* Parameters:
+*  callback          An optional function to call when the flush completed
+*  callback_arg      Argument passed to the callback
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_BUSY if a flush is in
+*  progress
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_display_flush(shield_xensiv_a_display_callback_t callback,
+                                        void* callback_arg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_display_is_busy
+******************************************************************************
+* Summary: Reports whether a flush is in progress.
+*
+* Parameters: None
+*
+* Return:
+*  true while a flush is in progress
+*
+******************************************************************************/
+bool shield_xensiv_a_display_is_busy(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_display_command
+******************************************************************************
+* Summary: Sends a command to the ST7735S with a blocking SPI transfer. The
+*          SPI bus must be reserved with shield_xensiv_a_spi_acquire() and no
+*          flush may be in progress.
+*
+* Parameters:
+*  cmd               The command
+*  params            16-bit parameters, sent most significant byte first
+*  count             Number of parameters, up to
+*                    SHIELD_XENSIV_A_DISPLAY_MAX_PARAMS
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_display_command(uint8_t cmd, const uint16_t* params, uint8_t count);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_display_set_window
+******************************************************************************
+* Summary: Starts a memory write of the ST7735S to a rectangle given in
+*          display coordinates, which is filled row by row by
+*          shield_xensiv_a_display_write_pixels(). The same conditions as for
+*          shield_xensiv_a_display_command() apply.
+*
+* Parameters:
+*  rect              The rectangle
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_display_set_window(const shield_xensiv_a_display_rect_t* rect);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_display_write_pixels
+******************************************************************************
+* Summary: Sends pixels to the window set by
+*          shield_xensiv_a_display_set_window() with a blocking SPI transfer.
+*
+* Parameters:
+*  pixels            The pixels, in the byte order of the display
+*  count             Number of pixels
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_display_write_pixels(const uint16_t* pixels, size_t count);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_display_fb_free
+******************************************************************************
+* Summary: Stops the framebuffer mode, aborting a flush in progress. The
+*          callback of an aborted flush is invoked with
+*          SHIELD_XENSIV_A_RSLT_ERR_ABORTED and the SPI bus is released.
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_display_fb_free(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,405 @@
+/******************************************************************************
+ * \file shield_xensiv_a_fusion.c
+ *
+ * Description: Implementation of the orientation estimation of the shield
+ *              support library. This is a Madgwick gradient descent filter in
+ *              single precision, with the residuals of the objective function
+ *              evaluated once and shared between the gradient terms.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include <math.h>
+#include "shield_xensiv_a_fusion.h"
+#include "shield_xensiv_a_metrics.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static shield_xensiv_a_fusion_cfg_t         _fusion_cfg =
+{
+    .beta            = SHIELD_XENSIV_A_FUSION_BETA_DEFAULT,
+    .gyr_rad_per_lsb = SHIELD_XENSIV_A_FUSION_GYR_RAD_PER_LSB_2000DPS,
+    .mag_max_age_us  = SHIELD_XENSIV_A_FUSION_MAG_MAX_AGE_US_DEFAULT
+};
+static shield_xensiv_a_mag_calibration_t    _fusion_calibration =
+{
+    .hard_iron = { 0.0f, 0.0f, 0.0f },
+    .soft_iron = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } }
+};
+static shield_xensiv_a_quaternion_t         _fusion_q = { 1.0f, 0.0f, 0.0f, 0.0f };
+static const float                          _fusion_mag_axes[3][3] = SHIELD_XENSIV_A_FUSION_MAG_AXES;
+static float                                _fusion_mag[3];
+static uint32_t                             _fusion_mag_timestamp_us;
+static bool                                 _fusion_mag_valid;
+/* The sample before, for the interpolation to the IMU timestamps */
+static float                                _fusion_prev_mag[3];
+static uint32_t                             _fusion_prev_mag_timestamp_us;
+static bool                                 _fusion_prev_mag_valid;
+static uint32_t                             _fusion_last_timestamp_us;
+static bool                                 _fusion_started;
+
+
+/******************************************************************************
+* _shield_xensiv_a_fusion_step
+******************************************************************************/
+static void _shield_xensiv_a_fusion_step(float gx, float gy, float gz,
+                                         float ax, float ay, float az,
+                                         const float* mag, float dt)
+{
+    float q0 = _fusion_q.w;
+    float q1 = _fusion_q.x;
+    float q2 = _fusion_q.y;
+    float q3 = _fusion_q.z;
+
+    /* Rate of change of the quaternion from the gyroscope */
+    float dq0 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+    float dq1 = 0.5f * (q0 * gx + q2 * gz - q3 * gy);
+    float dq2 = 0.5f * (q0 * gy - q1 * gz + q3 * gx);
+    float dq3 = 0.5f * (q0 * gz + q1 * gy - q2 * gx);
+
+    float a_norm = ax * ax + ay * ay + az * az;
+    if (a_norm > 0.0f)
+    {
+        float recip = 1.0f / sqrtf(a_norm);
+        ax *= recip;
+        ay *= recip;
+        az *= recip;
+
+        float q0q0 = q0 * q0;
+        float q0q1 = q0 * q1;
+        float q0q2 = q0 * q2;
+        float q0q3 = q0 * q3;
+        float q1q1 = q1 * q1;
+        float q1q2 = q1 * q2;
+        float q1q3 = q1 * q3;
+        float q2q2 = q2 * q2;
+        float q2q3 = q2 * q3;
+        float q3q3 = q3 * q3;
+        float _2q0 = 2.0f * q0;
+        float _2q1 = 2.0f * q1;
+        float _2q2 = 2.0f * q2;
+        float _2q3 = 2.0f * q3;
+
+        /* Residuals between the measured and the estimated gravity direction */
+        float fax = 2.0f * (q1q3 - q0q2) - ax;
+        float fay = 2.0f * (q0q1 + q2q3) - ay;
+        float faz = 1.0f - 2.0f * (q1q1 + q2q2) - az;
+
+        /* Gradient of the objective function, J^T * f */
+        float s0 = -_2q2 * fax + _2q1 * fay;
+        float s1 = _2q3 * fax + _2q0 * fay - 2.0f * _2q1 * faz;
+        float s2 = -_2q0 * fax + _2q3 * fay - 2.0f * _2q2 * faz;
+        float s3 = _2q1 * fax + _2q2 * fay;
+
+        float m_norm = (NULL != mag)
+            ? (mag[0] * mag[0] + mag[1] * mag[1] + mag[2] * mag[2])
+            : 0.0f;
+        if (m_norm > 0.0f)
+        {
+            recip = 1.0f / sqrtf(m_norm);
+            float mx = mag[0] * recip;
+            float my = mag[1] * recip;
+            float mz = mag[2] * recip;
+
+            /* Reference direction of the earth's field, in the x-z plane */
+            float hx = mx * (q0q0 + q1q1 - q2q2 - q3q3) + 2.0f * my * (q1q2 - q0q3) +
+                       2.0f * mz * (q0q2 + q1q3);
+            float hy = 2.0f * mx * (q0q3 + q1q2) + my * (q0q0 - q1q1 + q2q2 - q3q3) +
+                       2.0f * mz * (q2q3 - q0q1);
+            float _2bx = sqrtf(hx * hx + hy * hy);
+            float _2bz = 2.0f * mx * (q1q3 - q0q2) + 2.0f * my * (q0q1 + q2q3) +
+                         mz * (q0q0 - q1q1 - q2q2 + q3q3);
+
+            /* Residuals between the measured and the estimated field direction */
+            float fmx = _2bx * (0.5f - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx;
+            float fmy = _2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my;
+            float fmz = _2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz;
+
+            s0 += -_2bz * q2 * fmx + (-_2bx * q3 + _2bz * q1) * fmy + _2bx * q2 * fmz;
+            s1 += _2bz * q3 * fmx + (_2bx * q2 + _2bz * q0) * fmy +
+                  (_2bx * q3 - 2.0f * _2bz * q1) * fmz;
+            s2 += (-2.0f * _2bx * q2 - _2bz * q0) * fmx + (_2bx * q1 + _2bz * q3) * fmy +
+                  (_2bx * q0 - 2.0f * _2bz * q2) * fmz;
+            s3 += (-2.0f * _2bx * q3 + _2bz * q1) * fmx + (-_2bx * q0 + _2bz * q2) * fmy +
+                  _2bx * q1 * fmz;
+        }
+
+        float s_norm = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+        if (s_norm > 0.0f)
+        {
+            recip = _fusion_cfg.beta / sqrtf(s_norm);
+            dq0 -= s0 * recip;
+            dq1 -= s1 * recip;
+            dq2 -= s2 * recip;
+            dq3 -= s3 * recip;
+        }
+    }
+
+    q0 += dq0 * dt;
+    q1 += dq1 * dt;
+    q2 += dq2 * dt;
+    q3 += dq3 * dt;
+
+    float recip = 1.0f / sqrtf(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+    _fusion_q.w = q0 * recip;
+    _fusion_q.x = q1 * recip;
+    _fusion_q.y = q2 * recip;
+    _fusion_q.z = q3 * recip;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_fusion_mag_at
+******************************************************************************/
+/* Estimates the field at an IMU timestamp from the last two magnetometer
+   samples. Returns false if the newest sample is too far away in time. */
+static bool _shield_xensiv_a_fusion_mag_at(uint32_t timestamp_us, float* mag)
+{
+    int32_t offset_us = (int32_t)(timestamp_us - _fusion_mag_timestamp_us);
+    uint32_t age_us = (offset_us < 0) ? (uint32_t)(-offset_us) : (uint32_t)offset_us;
+    bool valid = _fusion_mag_valid && (age_us <= _fusion_cfg.mag_max_age_us);
+
+    if (valid)
+    {
+        int32_t span_us = (int32_t)(_fusion_mag_timestamp_us - _fusion_prev_mag_timestamp_us);
+        float k = (_fusion_prev_mag_valid && (span_us > 0))
+            ? ((float)offset_us / (float)span_us)
+            : 0.0f;
+
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            mag[i] = _fusion_mag[i] + k * (_fusion_mag[i] - _fusion_prev_mag[i]);
+        }
+    }
+
+    return valid;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_fusion_init
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_fusion_init(const shield_xensiv_a_fusion_cfg_t* cfg)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((NULL == cfg) || (cfg->beta < 0.0f) || (cfg->gyr_rad_per_lsb <= 0.0f))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else
+    {
+        static const shield_xensiv_a_mag_calibration_t identity =
+        {
+            .hard_iron = { 0.0f, 0.0f, 0.0f },
+            .soft_iron = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } }
+        };
+
+        _fusion_cfg = *cfg;
+        _fusion_calibration = identity;
+        shield_xensiv_a_fusion_reset();
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_fusion_set_mag_calibration
+******************************************************************************/
+void shield_xensiv_a_fusion_set_mag_calibration(
+    const shield_xensiv_a_mag_calibration_t* calibration)
+{
+    if (NULL != calibration)
+    {
+        _fusion_calibration = *calibration;
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_fusion_update_mag
+******************************************************************************/
+void shield_xensiv_a_fusion_update_mag(const float mag_ut[3], uint32_t timestamp_us)
+{
+    float m[3] =
+    {
+        mag_ut[0] - _fusion_calibration.hard_iron[0],
+        mag_ut[1] - _fusion_calibration.hard_iron[1],
+        mag_ut[2] - _fusion_calibration.hard_iron[2]
+    };
+    float c[3];
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        c[i] = _fusion_calibration.soft_iron[i][0] * m[0] +
+               _fusion_calibration.soft_iron[i][1] * m[1] +
+               _fusion_calibration.soft_iron[i][2] * m[2];
+    }
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        _fusion_prev_mag[i] = _fusion_mag[i];
+        _fusion_mag[i] = _fusion_mag_axes[i][0] * c[0] +
+                         _fusion_mag_axes[i][1] * c[1] +
+                         _fusion_mag_axes[i][2] * c[2];
+    }
+    _fusion_prev_mag_timestamp_us = _fusion_mag_timestamp_us;
+    _fusion_prev_mag_valid = _fusion_mag_valid;
+    _fusion_mag_timestamp_us = timestamp_us;
+    _fusion_mag_valid = true;
+}
+
+
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+/******************************************************************************
+* shield_xensiv_a_fusion_read_mag
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_fusion_read_mag(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    mtb_bmm350_data_t data;
+
+    if ((shield_xensiv_a_get_ready_mask() & SHIELD_XENSIV_A_READY_MAGNETOMETER) == 0)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        SHIELD_XENSIV_A_METRICS_BEGIN(start_us);
+        result = mtb_bmm350_read(shield_xensiv_a_get_mag_sensor(), &data);
+        SHIELD_XENSIV_A_METRICS_END(SHIELD_XENSIV_A_METRICS_MAGNETOMETER, start_us,
+                                    SHIELD_XENSIV_A_METRICS_BMM350_BYTES, result);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        float mag_ut[3] = { data.sensor_data.x, data.sensor_data.y, data.sensor_data.z };
+        shield_xensiv_a_fusion_update_mag(mag_ut, shield_xensiv_a_get_timestamp_us());
+    }
+
+    return result;
+}
+#endif
+
+
+/******************************************************************************
+* shield_xensiv_a_fusion_update_motion
+******************************************************************************/
+void shield_xensiv_a_fusion_update_motion(const shield_xensiv_a_motion_frame_t* frames,
+                                          uint16_t num_frames)
+{
+    for (uint16_t i = 0; (NULL != frames) && (i < num_frames); i++)
+    {
+        const shield_xensiv_a_motion_frame_t* frame = &frames[i];
+        uint32_t dt_us = frame->timestamp_us - _fusion_last_timestamp_us;
+
+        if (_fusion_started && (dt_us > 0) && (dt_us <= SHIELD_XENSIV_A_FUSION_MAX_DT_US))
+        {
+            /* The magnetometer runs at a lower rate, its samples are only
+               used while they are close enough in time to the IMU frame */
+            float mag_at[3];
+            const float* mag = _shield_xensiv_a_fusion_mag_at(frame->timestamp_us, mag_at)
+                ? mag_at
+                : NULL;
+
+            _shield_xensiv_a_fusion_step((float)frame->gyr[0] * _fusion_cfg.gyr_rad_per_lsb,
+                                         (float)frame->gyr[1] * _fusion_cfg.gyr_rad_per_lsb,
+                                         (float)frame->gyr[2] * _fusion_cfg.gyr_rad_per_lsb,
+                                         (float)frame->acc[0],
+                                         (float)frame->acc[1],
+                                         (float)frame->acc[2],
+                                         mag, (float)dt_us * 1.0e-6f);
+        }
+
+        _fusion_last_timestamp_us = frame->timestamp_us;
+        _fusion_started = true;
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_fusion_get_quaternion
+******************************************************************************/
+void shield_xensiv_a_fusion_get_quaternion(shield_xensiv_a_quaternion_t* quaternion)
+{
+    if (NULL != quaternion)
+    {
+        *quaternion = _fusion_q;
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_fusion_get_euler
+******************************************************************************/
+void shield_xensiv_a_fusion_get_euler(shield_xensiv_a_euler_t* euler)
+{
+    if (NULL != euler)
+    {
+        float w = _fusion_q.w;
+        float x = _fusion_q.x;
+        float y = _fusion_q.y;
+        float z = _fusion_q.z;
+        float sin_pitch = 2.0f * (w * y - z * x);
+
+        if (sin_pitch > 1.0f)
+        {
+            sin_pitch = 1.0f;
+        }
+        else if (sin_pitch < -1.0f)
+        {
+            sin_pitch = -1.0f;
+        }
+
+        euler->roll = atan2f(2.0f * (w * x + y * z), 1.0f - 2.0f * (x * x + y * y));
+        euler->pitch = asinf(sin_pitch);
+        euler->yaw = atan2f(2.0f * (w * z + x * y), 1.0f - 2.0f * (y * y + z * z));
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_fusion_reset
+******************************************************************************/
+void shield_xensiv_a_fusion_reset(void)
+{
+    _fusion_q.w = 1.0f;
+    _fusion_q.x = 0.0f;
+    _fusion_q.y = 0.0f;
+    _fusion_q.z = 0.0f;
+    _fusion_mag_valid = false;
+    _fusion_prev_mag_valid = false;
+    _fusion_started = false;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,246 @@
+/******************************************************************************
+ * \file shield_xensiv_a_fusion.h
+ *
+ * Description: This file is the interface for the orientation estimation from
+ *              the BMI270 and BMM350 on the SHIELD_XENSIV_A shield board.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a_motion_fifo.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/** Default gain of the filter, trading noise against convergence speed */
+#define SHIELD_XENSIV_A_FUSION_BETA_DEFAULT             (0.1f)
+
+/** Gyroscope scaling in rad/s per LSB for the ±2000 °/s range, which is the
+ * range set up by shield_xensiv_a_init()
+ */
+#define SHIELD_XENSIV_A_FUSION_GYR_RAD_PER_LSB_2000DPS  (2000.0f / 32768.0f * 0.0174532925f)
+
+/** Default maximum time between an IMU frame and the magnetometer sample used
+ * with it. Older magnetometer data is ignored and the frame is fused from the
+ * accelerometer and gyroscope only.
+ */
+#define SHIELD_XENSIV_A_FUSION_MAG_MAX_AGE_US_DEFAULT   (50000UL)
+
+#ifndef SHIELD_XENSIV_A_FUSION_MAG_AXES
+/** Rotation from the BMM350 axes into the BMI270 axes, applied to the
+ * calibrated magnetometer samples. Row i gives BMI270 axis i in BMM350
+ * coordinates. The default is for both sensors placed with the same
+ * orientation. Override it for a board on which they are rotated, e.g.
+ * { { 1, 0, 0 }, { 0, -1, 0 }, { 0, 0, -1 } } for a BMM350 turned upside down
+ * around x.
+ */
+#define SHIELD_XENSIV_A_FUSION_MAG_AXES \
+    { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } }
+#endif
+
+/** Largest time step integrated at once, longer gaps restart the integration */
+#define SHIELD_XENSIV_A_FUSION_MAX_DT_US                (100000UL)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Orientation as a unit quaternion */
+typedef struct
+{
+    float   w;  /**< Scalar part */
+    float   x;  /**< x component of the vector part */
+    float   y;  /**< y component of the vector part */
+    float   z;  /**< z component of the vector part */
+} shield_xensiv_a_quaternion_t;
+
+/** Orientation as Euler angles in radians */
+typedef struct
+{
+    float   roll;   /**< Rotation around x */
+    float   pitch;  /**< Rotation around y */
+    float   yaw;    /**< Rotation around z */
+} shield_xensiv_a_euler_t;
+
+/** Magnetometer calibration in the BMM350 axes, applied as
+ * soft_iron * (raw - hard_iron) before the rotation by
+ * SHIELD_XENSIV_A_FUSION_MAG_AXES */
+typedef struct
+{
+    /** Hard-iron offset in µT */
+    float   hard_iron[3];
+    /** Soft-iron correction matrix */
+    float   soft_iron[3][3];
+} shield_xensiv_a_mag_calibration_t;
+
+/** Configuration of the orientation filter */
+typedef struct
+{
+    /** Filter gain, see SHIELD_XENSIV_A_FUSION_BETA_DEFAULT */
+    float       beta;
+    /** Gyroscope scaling in rad/s per LSB */
+    float       gyr_rad_per_lsb;
+    /** Maximum age of magnetometer data used for fusion */
+    uint32_t    mag_max_age_us;
+} shield_xensiv_a_fusion_cfg_t;
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_fusion_init
+******************************************************************************
+* Summary: Initializes the orientation filter. The magnetometer calibration is
+*          reset to identity.
+*
+* Parameters:
+*  cfg               The configuration of the filter
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_fusion_init(const shield_xensiv_a_fusion_cfg_t* cfg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_fusion_set_mag_calibration
+******************************************************************************
+* Summary: Sets the hard-iron and soft-iron calibration of the magnetometer.
+*
+* Parameters:
+*  calibration       The calibration to apply to new magnetometer samples
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_fusion_set_mag_calibration(
+    const shield_xensiv_a_mag_calibration_t* calibration);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_fusion_update_mag
+******************************************************************************
+* Summary: Provides a new magnetometer sample. It is calibrated and rotated into
+*          the BMI270 axes. The IMU frames within the configured maximum age
+*          of the newest sample are fused with the field at their own
+*          timestamp, interpolated or extrapolated linearly from the last two
+*          samples.
+*
+* Parameters:
+*  mag_ut            Magnetic field x, y and z in µT
+*  timestamp_us      Sampling time of the magnetic field
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_fusion_update_mag(const float mag_ut[3], uint32_t timestamp_us);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_fusion_read_mag
+******************************************************************************
+* Summary: Reads the BMM350 and provides the result to
+*          shield_xensiv_a_fusion_update_mag().
+*
+* Parameters: None
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_fusion_read_mag(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_fusion_update_motion
+******************************************************************************
+* Summary: Runs the filter for IMU frames in time order, as returned by
+*          shield_xensiv_a_motion_fifo_read(). The time step is taken from the
+*          frame timestamps.
+*
+* Parameters:
+*  frames            The frames
+*  num_frames        Number of frames
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_fusion_update_motion(const shield_xensiv_a_motion_frame_t* frames,
+                                          uint16_t num_frames);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_fusion_get_quaternion
+******************************************************************************
+* Summary: Gets the current orientation as a quaternion.
+*
+* Parameters:
+*  quaternion        Receives the orientation
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_fusion_get_quaternion(shield_xensiv_a_quaternion_t* quaternion);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_fusion_get_euler
+******************************************************************************
+* Summary: Gets the current orientation as Euler angles.
+*
+* Parameters:
+*  euler             Receives the orientation
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_fusion_get_euler(shield_xensiv_a_euler_t* euler);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_fusion_reset
+******************************************************************************
+* Summary: Resets the orientation to identity and restarts the integration.
+*          The configuration and calibration are kept.
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_fusion_reset(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,280 @@
+/******************************************************************************
+ * \file shield_xensiv_a_health.c
+ *
+ * Description: Implementation of the sensor health tracking and fault
+ *              recovery of the shield support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include <string.h>
+#include "shield_xensiv_a_health.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Sensors on the I2C bus whose health is tracked */
+#define HEALTH_DEVICES             (SHIELD_XENSIV_A_READY_HUMIDITY | SHIELD_XENSIV_A_READY_MOTION | \
+                                    SHIELD_XENSIV_A_READY_MAGNETOMETER |                          \
+                                    SHIELD_XENSIV_A_READY_PRESSURE | SHIELD_XENSIV_A_READY_CO2)
+/* One record per bit of the ready mask */
+#define HEALTH_RECORDS             (7U)
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static shield_xensiv_a_health_t             _health[HEALTH_RECORDS];
+static shield_xensiv_a_health_callback_t    _health_callback;
+static void*                                _health_callback_arg;
+
+
+/******************************************************************************
+* _shield_xensiv_a_health_record
+******************************************************************************/
+/* Record of a single tracked device, NULL for anything else */
+static shield_xensiv_a_health_t* _shield_xensiv_a_health_record(uint32_t device)
+{
+    shield_xensiv_a_health_t* record = NULL;
+
+    if (((device & HEALTH_DEVICES) == device) && (device != 0) &&
+        ((device & (device - 1U)) == 0))
+    {
+        uint32_t index = 0;
+        while ((device >> index) != 1U)
+        {
+            index++;
+        }
+        record = &_health[index];
+    }
+
+    return record;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_health_report
+******************************************************************************/
+void shield_xensiv_a_health_report(uint32_t device, cy_rslt_t result)
+{
+    shield_xensiv_a_health_t* record = _shield_xensiv_a_health_record(device);
+
+    if ((NULL != record) && (SHIELD_XENSIV_A_RSLT_PENDING != result) &&
+        (SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED != result) &&
+        (SHIELD_XENSIV_A_RSLT_ERR_DEADLINE != result) &&
+        (SHIELD_XENSIV_A_RSLT_ERR_ABORTED != result))
+    {
+        bool failed = false;
+        uint32_t state = cyhal_system_critical_section_enter();
+
+        if (CY_RSLT_SUCCESS == result)
+        {
+            record->consecutive_errors = 0;
+            record->state = SHIELD_XENSIV_A_HEALTH_OK;
+        }
+        else
+        {
+            record->consecutive_errors++;
+            record->errors++;
+            record->last_error    = result;
+            record->last_error_us = shield_xensiv_a_get_timestamp_us();
+            if (record->consecutive_errors < SHIELD_XENSIV_A_HEALTH_FAIL_THRESHOLD)
+            {
+                record->state = SHIELD_XENSIV_A_HEALTH_DEGRADED;
+            }
+            else if (SHIELD_XENSIV_A_HEALTH_FAILED != record->state)
+            {
+                record->state = SHIELD_XENSIV_A_HEALTH_FAILED;
+                failed = true;
+            }
+        }
+
+        shield_xensiv_a_health_callback_t callback = _health_callback;
+        void* callback_arg = _health_callback_arg;
+        cyhal_system_critical_section_exit(state);
+
+        if (failed && (NULL != callback))
+        {
+            callback(device, result, callback_arg);
+        }
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_health_report_address
+******************************************************************************/
+void shield_xensiv_a_health_report_address(uint16_t address, cy_rslt_t result)
+{
+    uint32_t device = 0;
+
+    switch (address)
+    {
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+        case MTB_SHT35_ADDRESS_DEFAULT:
+            device = SHIELD_XENSIV_A_READY_HUMIDITY;
+            break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_MOTION
+        case MTB_BMI270_ADDRESS_SEC:
+            device = SHIELD_XENSIV_A_READY_MOTION;
+            break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+        case MTB_BMM350_ADDRESS_DEFAULT:
+            device = SHIELD_XENSIV_A_READY_MAGNETOMETER;
+            break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+        case XENSIV_DPS3XX_I2C_ADDR_ALT:
+            device = SHIELD_XENSIV_A_READY_PRESSURE;
+            break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_CO2
+        case XENSIV_PASCO2_I2C_ADDR:
+            device = SHIELD_XENSIV_A_READY_CO2;
+            break;
+#endif
+
+        default:
+            break;
+    }
+
+    shield_xensiv_a_health_report(device, result);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_health_get
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_health_get(uint32_t device, shield_xensiv_a_health_t* health)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    const shield_xensiv_a_health_t* record = _shield_xensiv_a_health_record(device);
+
+    if ((NULL == record) || (NULL == health))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else
+    {
+        uint32_t state = cyhal_system_critical_section_enter();
+        *health = *record;
+        cyhal_system_critical_section_exit(state);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_health_get_failed_mask
+******************************************************************************/
+uint32_t shield_xensiv_a_health_get_failed_mask(void)
+{
+    uint32_t mask = 0;
+
+    for (uint32_t i = 0; i < HEALTH_RECORDS; i++)
+    {
+        if (SHIELD_XENSIV_A_HEALTH_FAILED == _health[i].state)
+        {
+            mask |= (1UL << i);
+        }
+    }
+
+    return mask;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_health_register_callback
+******************************************************************************/
+void shield_xensiv_a_health_register_callback(shield_xensiv_a_health_callback_t callback,
+                                              void* callback_arg)
+{
+    uint32_t state = cyhal_system_critical_section_enter();
+    _health_callback     = callback;
+    _health_callback_arg = callback_arg;
+    cyhal_system_critical_section_exit(state);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_health_recover
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_health_recover(uint32_t device, bool recover_bus)
+{
+    cy_rslt_t result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    shield_xensiv_a_health_t* record = _shield_xensiv_a_health_record(device);
+
+    if (NULL != record)
+    {
+        result = shield_xensiv_a_reinit(device);
+        if (recover_bus && (CY_RSLT_SUCCESS != result) &&
+            (SHIELD_XENSIV_A_RSLT_PENDING != result) &&
+            (SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG != result) &&
+            (SHIELD_XENSIV_A_RSLT_ERR_BUSY != result))
+        {
+            result = shield_xensiv_a_recover_i2c();
+            if (CY_RSLT_SUCCESS == result)
+            {
+                result = shield_xensiv_a_reinit(device);
+            }
+        }
+
+        uint32_t state = cyhal_system_critical_section_enter();
+        record->recoveries++;
+        if (CY_RSLT_SUCCESS == result)
+        {
+            record->consecutive_errors = 0;
+            record->state = SHIELD_XENSIV_A_HEALTH_OK;
+        }
+        cyhal_system_critical_section_exit(state);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_health_reset
+******************************************************************************/
+void shield_xensiv_a_health_reset(void)
+{
+    uint32_t state = cyhal_system_critical_section_enter();
+    memset(_health, 0, sizeof(_health));
+    cyhal_system_critical_section_exit(state);
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,210 @@
+/******************************************************************************
+ * \file shield_xensiv_a_health.h
+ *
+ * Description: This file is the interface for the sensor health tracking and
+ *              fault recovery of the SHIELD_XENSIV_A shield board.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#ifndef SHIELD_XENSIV_A_HEALTH_FAIL_THRESHOLD
+/** Consecutive failed accesses after which a sensor is reported as failed */
+#define SHIELD_XENSIV_A_HEALTH_FAIL_THRESHOLD   (3U)
+#endif
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Health of a sensor */
+typedef enum
+{
+    SHIELD_XENSIV_A_HEALTH_OK,          /**< The last access succeeded */
+    SHIELD_XENSIV_A_HEALTH_DEGRADED,    /**< Recent accesses failed */
+    SHIELD_XENSIV_A_HEALTH_FAILED       /**< SHIELD_XENSIV_A_HEALTH_FAIL_THRESHOLD
+                                             accesses in a row failed */
+} shield_xensiv_a_health_state_t;
+
+/** Health record of a sensor */
+typedef struct
+{
+    /** Current health */
+    shield_xensiv_a_health_state_t  state;
+    /** Failed accesses since the last successful one */
+    uint32_t                        consecutive_errors;
+    /** Failed accesses in total */
+    uint32_t                        errors;
+    /** Recoveries attempted with shield_xensiv_a_health_recover() */
+    uint32_t                        recoveries;
+    /** Result of the last failed access */
+    cy_rslt_t                       last_error;
+    /** Time of the last failed access */
+    uint32_t                        last_error_us;
+} shield_xensiv_a_health_t;
+
+/** Called when a sensor becomes SHIELD_XENSIV_A_HEALTH_FAILED, possibly from
+ * interrupt context, e.g. to schedule shield_xensiv_a_health_recover() */
+typedef void (*shield_xensiv_a_health_callback_t)(uint32_t device, cy_rslt_t result,
+                                                  void* callback_arg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_health_report
+******************************************************************************
+* Summary: Records the outcome of an access to a sensor. The I2C scheduler, the
+*          snapshot and the read cache report their accesses; the application
+*          reports the accesses it makes through the sensor drivers. Results
+*          which say nothing about the sensor (pending, not initialized,
+*          deadline missed, aborted) are ignored. May be called from interrupt
+*          context.
+*
+* Parameters:
+*  device            The SHIELD_XENSIV_A_READY_* bit of a sensor on the I2C
+*                    bus
+*  result            Result of the access
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_health_report(uint32_t device, cy_rslt_t result);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_health_report_address
+******************************************************************************
+* Summary: Records the outcome of an I2C transfer, see
+*          shield_xensiv_a_health_report(). Transfers to addresses which do not
+*          belong to a sensor of the shield are ignored.
+*
+* Parameters:
+*  address           7-bit I2C address of the transfer
+*  result            Result of the transfer
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_health_report_address(uint16_t address, cy_rslt_t result);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_health_get
+******************************************************************************
+* Summary: Takes a consistent copy of the health record of a sensor.
+*
+* Parameters:
+*  device            The SHIELD_XENSIV_A_READY_* bit of a sensor on the I2C
+*                    bus
+*  health            Receives the health record
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_health_get(uint32_t device, shield_xensiv_a_health_t* health);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_health_get_failed_mask
+******************************************************************************
+* Summary: Reports which sensors are SHIELD_XENSIV_A_HEALTH_FAILED.
+*
+* Parameters: None
+*
+* Return:
+*  A combination of the SHIELD_XENSIV_A_READY_* bits
+*
+******************************************************************************/
+uint32_t shield_xensiv_a_health_get_failed_mask(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_health_register_callback
+******************************************************************************
+* Summary: Registers a function called when a sensor becomes failed.
+*
+* Parameters:
+*  callback          The function, NULL to unregister
+*  callback_arg      Passed to the function
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_health_register_callback(shield_xensiv_a_health_callback_t callback,
+                                              void* callback_arg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_health_recover
+******************************************************************************
+* Summary: Reinitializes a sensor in place with shield_xensiv_a_reinit(), while
+*          the other sensors keep running. If that fails and recover_bus is
+*          set, the I2C bus is recovered with shield_xensiv_a_recover_i2c() and
+*          the sensor reinitialized once more; the I2C scheduler must not be
+*          in use then. A successful recovery resets the sensor to
+*          SHIELD_XENSIV_A_HEALTH_OK. Must be called from thread context.
+*
+* Parameters:
+*  device            The SHIELD_XENSIV_A_READY_* bit of a sensor on the I2C
+*                    bus
+*  recover_bus       Whether the I2C bus may be recovered
+*
+* Return:
+*  Status of the recovery, SHIELD_XENSIV_A_RSLT_PENDING for the CO2 sensor,
+*  which is completed by shield_xensiv_a_init_poll()
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_health_recover(uint32_t device, bool recover_bus);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_health_reset
+******************************************************************************
+* Summary: Resets the health records of all sensors.
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_health_reset(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
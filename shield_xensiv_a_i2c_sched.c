@@ -0,0 +1,424 @@
+/******************************************************************************
+ * \file shield_xensiv_a_i2c_sched.c
+ *
+ * Description: Implementation of the transaction scheduler of the shared I2C
+ *              bus of the shield support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "shield_xensiv_a_i2c_sched.h"
+#include "shield_xensiv_a_health.h"
+#include "shield_xensiv_a_metrics.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* I2C events handled by the scheduler */
+#define I2C_SCHED_EVENTS           ((cyhal_i2c_event_t)(CYHAL_I2C_MASTER_WR_CMPLT_EVENT | \
+                                                        CYHAL_I2C_MASTER_RD_CMPLT_EVENT | \
+                                                        CYHAL_I2C_MASTER_ERR_EVENT))
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static cyhal_i2c_t*                        _sched_i2c;
+static shield_xensiv_a_i2c_xfer_t*         _sched_queue;
+static shield_xensiv_a_i2c_xfer_t*         _sched_active;
+static uint8_t                             _sched_intr_priority;
+static bool                                _sched_held;
+static shield_xensiv_a_i2c_idle_callback_t _sched_idle_callback;
+static void*                               _sched_idle_arg;
+
+
+/******************************************************************************
+* _shield_xensiv_a_i2c_sched_retire
+******************************************************************************/
+/* Must be called with interrupts disabled. Appends a transaction which left
+   the scheduler to a list of finished transactions, whose callbacks are run by
+   _shield_xensiv_a_i2c_sched_complete() once the critical section is left. */
+static void _shield_xensiv_a_i2c_sched_retire(shield_xensiv_a_i2c_xfer_t** finished,
+                                              shield_xensiv_a_i2c_xfer_t* xfer,
+                                              cy_rslt_t result)
+{
+    xfer->result = result;
+    xfer->end_us = shield_xensiv_a_get_timestamp_us();
+    xfer->next = NULL;
+    while (NULL != *finished)
+    {
+        finished = &(*finished)->next;
+    }
+    *finished = xfer;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_i2c_sched_complete
+******************************************************************************/
+/* Records and reports the finished transactions. The list is unlinked before
+   each callback, which may submit its transaction again. */
+static void _shield_xensiv_a_i2c_sched_complete(shield_xensiv_a_i2c_xfer_t* finished)
+{
+    while (NULL != finished)
+    {
+        shield_xensiv_a_i2c_xfer_t* xfer = finished;
+        finished = xfer->next;
+        xfer->next = NULL;
+
+        SHIELD_XENSIV_A_METRICS_RECORD(
+            shield_xensiv_a_metrics_device_from_address(xfer->address),
+            xfer->end_us - xfer->start_us, (uint32_t)(xfer->tx_size + xfer->rx_size),
+            xfer->result);
+        shield_xensiv_a_health_report_address(xfer->address, xfer->result);
+        if (NULL != xfer->callback)
+        {
+            xfer->callback(xfer, xfer->callback_arg);
+        }
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_i2c_sched_take_idle
+******************************************************************************/
+/* Must be called with interrupts disabled. Returns the pending idle request
+   if the bus is idle, which the caller invokes after the critical section. */
+static shield_xensiv_a_i2c_idle_callback_t _shield_xensiv_a_i2c_sched_take_idle(
+    void** callback_arg)
+{
+    shield_xensiv_a_i2c_idle_callback_t callback = NULL;
+
+    if ((NULL == _sched_active) && !_sched_held)
+    {
+        callback = _sched_idle_callback;
+        *callback_arg = _sched_idle_arg;
+        _sched_idle_callback = NULL;
+    }
+    return callback;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_i2c_sched_before
+******************************************************************************/
+/* Whether a has to be started before b */
+static bool _shield_xensiv_a_i2c_sched_before(const shield_xensiv_a_i2c_xfer_t* a,
+                                              const shield_xensiv_a_i2c_xfer_t* b,
+                                              uint32_t now_us)
+{
+    bool before;
+
+    if (a->priority != b->priority)
+    {
+        before = (a->priority < b->priority);
+    }
+    else if ((0 == a->timeout_us) || (0 == b->timeout_us))
+    {
+        /* A transaction without a deadline never overtakes one with a deadline */
+        before = (0 != a->timeout_us) && (0 == b->timeout_us);
+    }
+    else
+    {
+        /* Compare the remaining time, which is safe across timer wrap-around */
+        before = (int32_t)(a->deadline_us - now_us) < (int32_t)(b->deadline_us - now_us);
+    }
+
+    return before;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_i2c_sched_dispatch
+******************************************************************************/
+/* Must be called with interrupts disabled. Transactions which end without
+   being transferred are added to the finished list. */
+static void _shield_xensiv_a_i2c_sched_dispatch(shield_xensiv_a_i2c_xfer_t** finished)
+{
+    while ((NULL == _sched_active) && !_sched_held && (NULL != _sched_queue))
+    {
+        shield_xensiv_a_i2c_xfer_t* xfer = _sched_queue;
+        uint32_t now_us = shield_xensiv_a_get_timestamp_us();
+
+        _sched_queue = xfer->next;
+        xfer->next = NULL;
+
+        if ((0 != xfer->timeout_us) && ((int32_t)(now_us - xfer->deadline_us) > 0))
+        {
+            xfer->start_us = now_us;
+            _shield_xensiv_a_i2c_sched_retire(finished, xfer, SHIELD_XENSIV_A_RSLT_ERR_DEADLINE);
+        }
+        else
+        {
+            _sched_active = xfer;
+            xfer->start_us = now_us;
+            cy_rslt_t result = cyhal_i2c_master_transfer_async(_sched_i2c, xfer->address,
+                                                               xfer->tx_data, xfer->tx_size,
+                                                               xfer->rx_data, xfer->rx_size);
+            if (CY_RSLT_SUCCESS != result)
+            {
+                _sched_active = NULL;
+                _shield_xensiv_a_i2c_sched_retire(finished, xfer, result);
+            }
+        }
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_i2c_sched_event
+******************************************************************************/
+static void _shield_xensiv_a_i2c_sched_event(void* callback_arg, cyhal_i2c_event_t event)
+{
+    (void)callback_arg;
+    shield_xensiv_a_i2c_xfer_t* xfer = _sched_active;
+    bool done = false;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL != xfer)
+    {
+        if ((event & CYHAL_I2C_MASTER_ERR_EVENT) != 0)
+        {
+            result = SHIELD_XENSIV_A_RSLT_ERR_TRANSFER;
+            done = true;
+        }
+        else if ((xfer->rx_size > 0) && (NULL != xfer->rx_data))
+        {
+            done = ((event & CYHAL_I2C_MASTER_RD_CMPLT_EVENT) != 0);
+        }
+        else
+        {
+            done = ((event & CYHAL_I2C_MASTER_WR_CMPLT_EVENT) != 0);
+        }
+    }
+
+    if (done)
+    {
+        shield_xensiv_a_i2c_xfer_t* finished = NULL;
+        void* idle_arg = NULL;
+
+        uint32_t state = cyhal_system_critical_section_enter();
+        _sched_active = NULL;
+        _shield_xensiv_a_i2c_sched_retire(&finished, xfer, result);
+        _shield_xensiv_a_i2c_sched_dispatch(&finished);
+        shield_xensiv_a_i2c_idle_callback_t idle =
+            _shield_xensiv_a_i2c_sched_take_idle(&idle_arg);
+        cyhal_system_critical_section_exit(state);
+
+        _shield_xensiv_a_i2c_sched_complete(finished);
+        if (NULL != idle)
+        {
+            idle(idle_arg);
+        }
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_i2c_sched_init
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_i2c_sched_init(uint8_t intr_priority)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL != _sched_i2c)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BUSY;
+    }
+    else if (NULL == shield_xensiv_a_get_i2c())
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        _sched_i2c = shield_xensiv_a_get_i2c();
+        _sched_queue = NULL;
+        _sched_active = NULL;
+        _sched_held = false;
+        _sched_intr_priority = intr_priority;
+        cyhal_i2c_register_callback(_sched_i2c, _shield_xensiv_a_i2c_sched_event, NULL);
+        cyhal_i2c_enable_event(_sched_i2c, I2C_SCHED_EVENTS, intr_priority, true);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_i2c_sched_submit
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_i2c_sched_submit(shield_xensiv_a_i2c_xfer_t* xfer)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((NULL == xfer) || ((0 == xfer->tx_size) && (0 == xfer->rx_size)))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if (NULL == _sched_i2c)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        shield_xensiv_a_i2c_xfer_t* finished = NULL;
+        uint32_t state = cyhal_system_critical_section_enter();
+        uint32_t now_us = shield_xensiv_a_get_timestamp_us();
+        shield_xensiv_a_i2c_xfer_t** link = &_sched_queue;
+
+        xfer->result = SHIELD_XENSIV_A_RSLT_PENDING;
+        xfer->submit_us = now_us;
+        xfer->deadline_us = now_us + xfer->timeout_us;
+
+        /* Keep the queue sorted, inserting behind transactions of equal rank */
+        while ((NULL != *link) && !_shield_xensiv_a_i2c_sched_before(xfer, *link, now_us))
+        {
+            link = &(*link)->next;
+        }
+        xfer->next = *link;
+        *link = xfer;
+
+        _shield_xensiv_a_i2c_sched_dispatch(&finished);
+        cyhal_system_critical_section_exit(state);
+
+        _shield_xensiv_a_i2c_sched_complete(finished);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_i2c_sched_acquire
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_i2c_sched_acquire(void)
+{
+    cy_rslt_t result = SHIELD_XENSIV_A_RSLT_ERR_BUSY;
+
+    uint32_t state = cyhal_system_critical_section_enter();
+    if ((NULL == _sched_active) && !_sched_held)
+    {
+        _sched_held = true;
+        result = CY_RSLT_SUCCESS;
+    }
+    cyhal_system_critical_section_exit(state);
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_i2c_sched_release
+******************************************************************************/
+void shield_xensiv_a_i2c_sched_release(void)
+{
+    shield_xensiv_a_i2c_xfer_t* finished = NULL;
+    void* idle_arg = NULL;
+
+    uint32_t state = cyhal_system_critical_section_enter();
+    _sched_held = false;
+    _shield_xensiv_a_i2c_sched_dispatch(&finished);
+    shield_xensiv_a_i2c_idle_callback_t idle = _shield_xensiv_a_i2c_sched_take_idle(&idle_arg);
+    cyhal_system_critical_section_exit(state);
+
+    _shield_xensiv_a_i2c_sched_complete(finished);
+    if (NULL != idle)
+    {
+        idle(idle_arg);
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_i2c_sched_notify_idle
+******************************************************************************/
+void shield_xensiv_a_i2c_sched_notify_idle(shield_xensiv_a_i2c_idle_callback_t callback,
+                                           void* callback_arg)
+{
+    void* idle_arg = NULL;
+
+    uint32_t state = cyhal_system_critical_section_enter();
+    _sched_idle_callback = callback;
+    _sched_idle_arg = callback_arg;
+    shield_xensiv_a_i2c_idle_callback_t idle = _shield_xensiv_a_i2c_sched_take_idle(&idle_arg);
+    cyhal_system_critical_section_exit(state);
+
+    if (NULL != idle)
+    {
+        idle(idle_arg);
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_i2c_sched_uses
+******************************************************************************/
+bool shield_xensiv_a_i2c_sched_uses(const cyhal_i2c_t* i2c)
+{
+    return (NULL != i2c) && (i2c == _sched_i2c);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_i2c_sched_free
+******************************************************************************/
+void shield_xensiv_a_i2c_sched_free(void)
+{
+    if (NULL != _sched_i2c)
+    {
+        cyhal_i2c_enable_event(_sched_i2c, I2C_SCHED_EVENTS, _sched_intr_priority, false);
+
+        shield_xensiv_a_i2c_xfer_t* finished = NULL;
+        uint32_t state = cyhal_system_critical_section_enter();
+        shield_xensiv_a_i2c_xfer_t* xfer = _sched_active;
+        if (NULL != xfer)
+        {
+            (void)cyhal_i2c_abort_async(_sched_i2c);
+            _sched_active = NULL;
+            _shield_xensiv_a_i2c_sched_retire(&finished, xfer, SHIELD_XENSIV_A_RSLT_ERR_ABORTED);
+        }
+        while (NULL != _sched_queue)
+        {
+            xfer = _sched_queue;
+            _sched_queue = xfer->next;
+            _shield_xensiv_a_i2c_sched_retire(&finished, xfer, SHIELD_XENSIV_A_RSLT_ERR_ABORTED);
+        }
+        cyhal_system_critical_section_exit(state);
+
+        _shield_xensiv_a_i2c_sched_complete(finished);
+
+        cyhal_i2c_register_callback(_sched_i2c, NULL, NULL);
+        _sched_held = false;
+        _sched_idle_callback = NULL;
+        _sched_i2c = NULL;
+    }
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
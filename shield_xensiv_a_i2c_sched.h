@@ -0,0 +1,234 @@
+/******************************************************************************
+ * \file shield_xensiv_a_i2c_sched.h
+ *
+ * Description: This file is the interface for the transaction scheduler of
+ *              the I2C bus shared by the sensors on the SHIELD_XENSIV_A
+ *              shield board.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Priority of a queued I2C transaction. Transactions of a higher priority are
+ * always started first; within a priority the earliest deadline goes first.
+ */
+typedef enum
+{
+    SHIELD_XENSIV_A_I2C_PRIORITY_HIGH   = 0,    /**< e.g. motion sensor reads */
+    SHIELD_XENSIV_A_I2C_PRIORITY_NORMAL = 1,    /**< e.g. magnetometer and pressure reads */
+    SHIELD_XENSIV_A_I2C_PRIORITY_LOW    = 2     /**< e.g. humidity and CO2 reads */
+} shield_xensiv_a_i2c_priority_t;
+
+/** Forward declaration of an I2C transaction */
+typedef struct shield_xensiv_a_i2c_xfer shield_xensiv_a_i2c_xfer_t;
+
+/** Callback invoked when a transaction completed, failed or missed its
+ * deadline. It usually runs in the I2C interrupt, so it must be short.
+ */
+typedef void (*shield_xensiv_a_i2c_callback_t)(shield_xensiv_a_i2c_xfer_t* xfer,
+                                               void* callback_arg);
+
+/** Callback invoked once the bus has become idle, see
+ * shield_xensiv_a_i2c_sched_notify_idle()
+ */
+typedef void (*shield_xensiv_a_i2c_idle_callback_t)(void* callback_arg);
+
+/** An I2C transaction. The object is owned by the caller and must stay valid
+ * until its callback was invoked. A write is followed by a read with a
+ * repeated start if both are given.
+ */
+struct shield_xensiv_a_i2c_xfer
+{
+    /** 7-bit address of the device */
+    uint16_t                        address;
+    /** Data to write, or NULL */
+    const uint8_t*                  tx_data;
+    /** Number of bytes to write */
+    size_t                          tx_size;
+    /** Buffer for the data to read, or NULL */
+    uint8_t*                        rx_data;
+    /** Number of bytes to read */
+    size_t                          rx_size;
+    /** Priority of the transaction */
+    shield_xensiv_a_i2c_priority_t  priority;
+    /** Time after submission by which the transaction must have started, or 0
+     * for no deadline */
+    uint32_t                        timeout_us;
+    /** Completion callback */
+    shield_xensiv_a_i2c_callback_t  callback;
+    /** Argument passed to the callback */
+    void*                           callback_arg;
+
+    /** Outcome of the transaction, valid in the callback */
+    volatile cy_rslt_t              result;
+    /** Time the transaction was submitted */
+    uint32_t                        submit_us;
+    /** Time the transaction was started on the bus */
+    uint32_t                        start_us;
+    /** Time the transaction completed */
+    uint32_t                        end_us;
+
+    /** \cond INTERNAL */
+    uint32_t                        deadline_us;
+    shield_xensiv_a_i2c_xfer_t*     next;
+    /** \endcond */
+};
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_i2c_sched_init
+******************************************************************************
+* Summary: Starts the transaction scheduler on the shield I2C bus. The
+*          shield must have been initialized. While the scheduler runs, the
+*          blocking sensor drivers may only use the bus between
+*          shield_xensiv_a_i2c_sched_acquire() and
+*          shield_xensiv_a_i2c_sched_release().
+*
+* Parameters:
+*  intr_priority     Priority of the I2C interrupt
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_i2c_sched_init(uint8_t intr_priority);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_i2c_sched_submit
+******************************************************************************
+* Summary: Queues a transaction. It is started as soon as the bus is free and
+*          no transaction of a higher priority or an earlier deadline is
+*          waiting, so a high priority transaction waits for at most the one
+*          transaction currently on the bus. May be called from an interrupt.
+*
+* Parameters:
+*  xfer              The transaction to queue
+*
+* Return:
+*  Status of the operation. The outcome of the transaction itself is reported
+*  through its callback.
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_i2c_sched_submit(shield_xensiv_a_i2c_xfer_t* xfer);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_i2c_sched_acquire
+******************************************************************************
+* Summary: Reserves the bus for blocking accesses, e.g. through the sensor
+*          drivers. Queued transactions are held back until the bus is
+*          released.
+*
+* Parameters: None
+*
+* Return:
+*  CY_RSLT_SUCCESS if the bus was reserved, SHIELD_XENSIV_A_RSLT_ERR_BUSY if a
+*  transaction is in progress or the bus is already reserved
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_i2c_sched_acquire(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_i2c_sched_release
+******************************************************************************
+* Summary: Releases a bus reservation and starts any queued transaction.
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_i2c_sched_release(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_i2c_sched_notify_idle
+******************************************************************************
+* Summary: Requests a single call of a function once the bus is neither
+*          reserved nor transferring, e.g. to retry
+*          shield_xensiv_a_i2c_sched_acquire() after it returned
+*          SHIELD_XENSIV_A_RSLT_ERR_BUSY. If the bus is idle already, the
+*          function is called right away. The function usually runs in the
+*          I2C interrupt. Only one request is kept, a new one replaces it.
+*
+* Parameters:
+*  callback          The function to call, NULL to cancel the request
+*  callback_arg      Argument passed to the function
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_i2c_sched_notify_idle(shield_xensiv_a_i2c_idle_callback_t callback,
+                                           void* callback_arg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_i2c_sched_uses
+******************************************************************************
+* Summary: Reports whether the scheduler is running on an I2C object, whose
+*          callback and events it then owns.
+*
+* Parameters:
+*  i2c               The I2C object
+*
+* Return:
+*  true while the scheduler is initialized on the I2C object
+*
+******************************************************************************/
+bool shield_xensiv_a_i2c_sched_uses(const cyhal_i2c_t* i2c);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_i2c_sched_free
+******************************************************************************
+* Summary: Stops the scheduler. The transaction in progress is aborted and
+*          all queued transactions complete with SHIELD_XENSIV_A_RSLT_ERR_ABORTED.
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_i2c_sched_free(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,363 @@
+/******************************************************************************
+ * \file shield_xensiv_a_irq.c
+ *
+ * Description: Implementation of the interrupt driven data-ready notifications
+ *              of the shield support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "shield_xensiv_a_irq.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* DPS368 interrupt and FIFO configuration register */
+#define DPS368_REG_CFG             (0x09U)
+/* DPS368 interrupt status register, cleared on read */
+#define DPS368_REG_INT_STS         (0x0AU)
+/* DPS368 CFG_REG bit selecting an active high interrupt */
+#define DPS368_CFG_INT_HL          (0x80U)
+/* DPS368 CFG_REG bit generating an interrupt when a pressure result is ready */
+#define DPS368_CFG_INT_PRS         (0x10U)
+/* Timeout for the DPS368 register accesses in ms */
+#define DPS368_I2C_TIMEOUT_MS      (10U)
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+typedef struct
+{
+    cyhal_gpio_t                    pin;
+    uint32_t                        ready_bit;
+    cyhal_gpio_callback_data_t      callback_data;
+    shield_xensiv_a_irq_callback_t  callback;
+    void*                           callback_arg;
+    volatile uint32_t               timestamp_us;
+    bool                            enabled;
+} _shield_xensiv_a_irq_t;
+
+static _shield_xensiv_a_irq_t _shield_irq[SHIELD_XENSIV_A_IRQ_COUNT] =
+{
+    { .pin = NC, .ready_bit = SHIELD_XENSIV_A_READY_MOTION       },
+    { .pin = NC, .ready_bit = SHIELD_XENSIV_A_READY_MAGNETOMETER },
+    { .pin = NC, .ready_bit = SHIELD_XENSIV_A_READY_PRESSURE     }
+};
+
+static volatile uint32_t _shield_irq_events;
+
+
+/******************************************************************************
+* _shield_xensiv_a_irq_pin
+******************************************************************************/
+/* Interrupt pin of a source in the pin assignment of the shield */
+static cyhal_gpio_t _shield_xensiv_a_irq_pin(shield_xensiv_a_irq_source_t source)
+{
+    const shield_xensiv_a_pins_t* pins = shield_xensiv_a_get_pins();
+
+    return (SHIELD_XENSIV_A_IRQ_MOTION == source)
+        ? pins->imu_int_1
+        : ((SHIELD_XENSIV_A_IRQ_MAGNETOMETER == source) ? pins->mag_int : pins->sen_int);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_irq_handler
+******************************************************************************/
+static void _shield_xensiv_a_irq_handler(void* callback_arg, cyhal_gpio_event_t event)
+{
+    (void)event;
+    shield_xensiv_a_irq_source_t source = (shield_xensiv_a_irq_source_t)(uintptr_t)callback_arg;
+    _shield_xensiv_a_irq_t* irq = &_shield_irq[source];
+
+    irq->timestamp_us = shield_xensiv_a_get_timestamp_us();
+    _shield_irq_events |= SHIELD_XENSIV_A_IRQ_EVENT(source);
+
+    if (NULL != irq->callback)
+    {
+        irq->callback(source, irq->timestamp_us, irq->callback_arg);
+    }
+}
+
+
+#if SHIELD_XENSIV_A_USE_MOTION
+/******************************************************************************
+* _shield_xensiv_a_irq_config_motion
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_irq_config_motion(bool enable)
+{
+    struct bmi2_dev* dev = &shield_xensiv_a_get_motion_sensor()->sensor;
+    struct bmi2_int_pin_config pin_config;
+
+    int8_t rslt = bmi2_get_int_pin_config(&pin_config, dev);
+    if ((BMI2_OK == rslt) && enable)
+    {
+        pin_config.pin_type = BMI2_INT1;
+        pin_config.int_latch = BMI2_INT_NON_LATCH;
+        pin_config.pin_cfg[0].output_en = BMI2_INT_OUTPUT_ENABLE;
+        pin_config.pin_cfg[0].od = BMI2_INT_PUSH_PULL;
+        pin_config.pin_cfg[0].lvl = BMI2_INT_ACTIVE_HIGH;
+        pin_config.pin_cfg[0].input_en = BMI2_DISABLE;
+        rslt = bmi2_set_int_pin_config(&pin_config, dev);
+    }
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi2_map_data_int(BMI2_DRDY_INT, enable ? BMI2_INT1 : BMI2_INT_NONE, dev);
+    }
+
+    return (BMI2_OK == rslt) ? CY_RSLT_SUCCESS : SHIELD_XENSIV_A_RSLT_ERR_SENSOR;
+}
+#endif
+
+
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+/******************************************************************************
+* _shield_xensiv_a_irq_config_mag
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_irq_config_mag(bool enable)
+{
+    struct bmm350_dev* dev = &shield_xensiv_a_get_mag_sensor()->sensor;
+    int8_t rslt = BMM350_OK;
+
+    if (enable)
+    {
+        rslt = bmm350_configure_interrupt(BMM350_PULSED, BMM350_ACTIVE_HIGH,
+                                          BMM350_INTR_PUSH_PULL, BMM350_MAP_TO_PIN, dev);
+    }
+    if (BMM350_OK == rslt)
+    {
+        rslt = bmm350_enable_interrupt(enable ? BMM350_ENABLE_INTERRUPT : BMM350_DISABLE_INTERRUPT,
+                                       dev);
+    }
+
+    return (BMM350_OK == rslt) ? CY_RSLT_SUCCESS : SHIELD_XENSIV_A_RSLT_ERR_SENSOR;
+}
+#endif
+
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+/******************************************************************************
+* _shield_xensiv_a_irq_config_pressure
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_irq_config_pressure(bool enable)
+{
+    /* The DPS3xx driver does not expose the interrupt enables, so update them
+       directly in the configuration register */
+    cyhal_i2c_t* i2c = shield_xensiv_a_get_i2c();
+    uint8_t cfg;
+
+    cy_rslt_t result = cyhal_i2c_master_mem_read(i2c, XENSIV_DPS3XX_I2C_ADDR_ALT, DPS368_REG_CFG,
+                                                 1, &cfg, 1, DPS368_I2C_TIMEOUT_MS);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        if (enable)
+        {
+            cfg |= (DPS368_CFG_INT_HL | DPS368_CFG_INT_PRS);
+        }
+        else
+        {
+            cfg &= (uint8_t)~(DPS368_CFG_INT_HL | DPS368_CFG_INT_PRS);
+        }
+        result = cyhal_i2c_master_mem_write(i2c, XENSIV_DPS3XX_I2C_ADDR_ALT, DPS368_REG_CFG,
+                                            1, &cfg, 1, DPS368_I2C_TIMEOUT_MS);
+    }
+    if ((CY_RSLT_SUCCESS == result) && enable)
+    {
+        /* Release a stale interrupt so the next result produces an edge */
+        result = shield_xensiv_a_irq_acknowledge(SHIELD_XENSIV_A_IRQ_PRESSURE);
+    }
+
+    return result;
+}
+#endif
+
+
+/******************************************************************************
+* _shield_xensiv_a_irq_config_sensor
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_irq_config_sensor(shield_xensiv_a_irq_source_t source,
+                                                    bool enable)
+{
+    cy_rslt_t result;
+
+    (void)enable;
+
+    switch (source)
+    {
+#if SHIELD_XENSIV_A_USE_MOTION
+        case SHIELD_XENSIV_A_IRQ_MOTION:
+            result = _shield_xensiv_a_irq_config_motion(enable);
+            break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+        case SHIELD_XENSIV_A_IRQ_MAGNETOMETER:
+            result = _shield_xensiv_a_irq_config_mag(enable);
+            break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+        case SHIELD_XENSIV_A_IRQ_PRESSURE:
+            result = _shield_xensiv_a_irq_config_pressure(enable);
+            break;
+#endif
+
+        default:
+            result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+            break;
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_irq_enable
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_irq_enable(shield_xensiv_a_irq_source_t source,
+                                     shield_xensiv_a_irq_callback_t callback,
+                                     void* callback_arg, uint8_t intr_priority)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    _shield_xensiv_a_irq_t* irq = NULL;
+
+    if ((source >= SHIELD_XENSIV_A_IRQ_COUNT) || _shield_irq[source].enabled)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if ((shield_xensiv_a_get_ready_mask() & _shield_irq[source].ready_bit) == 0)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        irq = &_shield_irq[source];
+        irq->pin = _shield_xensiv_a_irq_pin(source);
+        result = cyhal_gpio_init(irq->pin, CYHAL_GPIO_DIR_INPUT, CYHAL_GPIO_DRIVE_NONE, false);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        irq->callback = callback;
+        irq->callback_arg = callback_arg;
+        irq->callback_data.callback = _shield_xensiv_a_irq_handler;
+        irq->callback_data.callback_arg = (void*)(uintptr_t)source;
+        cyhal_gpio_register_callback(irq->pin, &irq->callback_data);
+        cyhal_gpio_enable_event(irq->pin, CYHAL_GPIO_IRQ_RISE, intr_priority, true);
+
+        result = _shield_xensiv_a_irq_config_sensor(source, true);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            irq->enabled = true;
+        }
+        else
+        {
+            cyhal_gpio_enable_event(irq->pin, CYHAL_GPIO_IRQ_RISE, intr_priority, false);
+            cyhal_gpio_free(irq->pin);
+        }
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_irq_disable
+******************************************************************************/
+void shield_xensiv_a_irq_disable(shield_xensiv_a_irq_source_t source)
+{
+    if ((source < SHIELD_XENSIV_A_IRQ_COUNT) && _shield_irq[source].enabled)
+    {
+        _shield_xensiv_a_irq_t* irq = &_shield_irq[source];
+
+        (void)_shield_xensiv_a_irq_config_sensor(source, false);
+        cyhal_gpio_enable_event(irq->pin, CYHAL_GPIO_IRQ_RISE, 0, false);
+        cyhal_gpio_free(irq->pin);
+
+        irq->enabled = false;
+        irq->callback = NULL;
+
+        uint32_t state = cyhal_system_critical_section_enter();
+        _shield_irq_events &= ~SHIELD_XENSIV_A_IRQ_EVENT(source);
+        cyhal_system_critical_section_exit(state);
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_irq_acknowledge
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_irq_acknowledge(shield_xensiv_a_irq_source_t source)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+    if (SHIELD_XENSIV_A_IRQ_PRESSURE == source)
+    {
+        uint8_t status;
+        result = cyhal_i2c_master_mem_read(shield_xensiv_a_get_i2c(),
+                                           XENSIV_DPS3XX_I2C_ADDR_ALT, DPS368_REG_INT_STS, 1,
+                                           &status, 1, DPS368_I2C_TIMEOUT_MS);
+    }
+    else
+#endif
+    if (source >= SHIELD_XENSIV_A_IRQ_COUNT)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_irq_take_events
+******************************************************************************/
+uint32_t shield_xensiv_a_irq_take_events(void)
+{
+    uint32_t state = cyhal_system_critical_section_enter();
+    uint32_t events = _shield_irq_events;
+    _shield_irq_events = 0;
+    cyhal_system_critical_section_exit(state);
+
+    return events;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_irq_get_timestamp_us
+******************************************************************************/
+uint32_t shield_xensiv_a_irq_get_timestamp_us(shield_xensiv_a_irq_source_t source)
+{
+    return (source < SHIELD_XENSIV_A_IRQ_COUNT) ? _shield_irq[source].timestamp_us : 0;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
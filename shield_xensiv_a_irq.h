@@ -0,0 +1,163 @@
+/******************************************************************************
+ * \file shield_xensiv_a_irq.h
+ *
+ * Description: This file is the interface for the interrupt driven data-ready
+ *              notifications of the sensors on the SHIELD_XENSIV_A shield
+ *              board.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Data-ready interrupt sources available on the shield */
+typedef enum
+{
+    /** BMI270 accelerometer/gyroscope data ready, on SHIELD_XENSIV_A_PIN_IMU_INT_1 */
+    SHIELD_XENSIV_A_IRQ_MOTION          = 0,
+    /** BMM350 magnetometer data ready, on SHIELD_XENSIV_A_PIN_MAG_INT */
+    SHIELD_XENSIV_A_IRQ_MAGNETOMETER    = 1,
+    /** DPS368 pressure data ready, on SHIELD_XENSIV_A_PIN_SEN_INT */
+    SHIELD_XENSIV_A_IRQ_PRESSURE        = 2,
+    /** Number of interrupt sources */
+    SHIELD_XENSIV_A_IRQ_COUNT           = 3
+} shield_xensiv_a_irq_source_t;
+
+/** Event mask bit of an interrupt source, as returned by
+ * shield_xensiv_a_irq_take_events()
+ */
+#define SHIELD_XENSIV_A_IRQ_EVENT(source)   (1UL << (uint32_t)(source))
+
+/** Callback invoked from the GPIO interrupt when a sensor signals that new
+ * data is ready. The timestamp is taken from shield_xensiv_a_get_timestamp_us()
+ * at the time of the interrupt. No I2C transfers may be started from this
+ * callback.
+ */
+typedef void (*shield_xensiv_a_irq_callback_t)(shield_xensiv_a_irq_source_t source,
+                                               uint32_t timestamp_us, void* callback_arg);
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_irq_enable
+******************************************************************************
+* Summary: Configures a sensor to signal data-ready on its interrupt line and
+*          enables the matching GPIO interrupt on the MCU. Each event is
+*          reported through the optional callback and is also recorded for
+*          shield_xensiv_a_irq_take_events(), so the application can sleep
+*          until data is available instead of polling over I2C.
+*
+* Parameters:
+*  source            The interrupt source to enable
+*  callback          An optional function to call from the interrupt
+*  callback_arg      Argument passed to the callback
+*  intr_priority     Priority of the GPIO interrupt
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_irq_enable(shield_xensiv_a_irq_source_t source,
+                                     shield_xensiv_a_irq_callback_t callback,
+                                     void* callback_arg, uint8_t intr_priority);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_irq_disable
+******************************************************************************
+* Summary: Disables the data-ready interrupt of a sensor and releases the
+*          GPIO used for it. This must be called for every enabled source
+*          before shield_xensiv_a_free().
+*
+* Parameters:
+*  source            The interrupt source to disable
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_irq_disable(shield_xensiv_a_irq_source_t source);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_irq_acknowledge
+******************************************************************************
+* Summary: Acknowledges a data-ready event after the data has been read. The
+*          DPS368 keeps its interrupt line asserted until its interrupt status
+*          register is read, so this must be called from thread context after
+*          each SHIELD_XENSIV_A_IRQ_PRESSURE event. For the other sources
+*          reading the data is enough and this does nothing.
+*
+* Parameters:
+*  source            The interrupt source to acknowledge
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_irq_acknowledge(shield_xensiv_a_irq_source_t source);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_irq_take_events
+******************************************************************************
+* Summary: Returns the sources which signaled data-ready since the previous
+*          call and clears them.
+*
+* Parameters: None
+*
+* Return:
+*  A combination of SHIELD_XENSIV_A_IRQ_EVENT() bits
+*
+******************************************************************************/
+uint32_t shield_xensiv_a_irq_take_events(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_irq_get_timestamp_us
+******************************************************************************
+* Summary: Gives the time of the most recent data-ready event of a source.
+*
+* Parameters:
+*  source            The interrupt source
+*
+* Return:
+*  Timestamp of the last event in microseconds
+*
+******************************************************************************/
+uint32_t shield_xensiv_a_irq_get_timestamp_us(shield_xensiv_a_irq_source_t source);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
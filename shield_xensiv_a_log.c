@@ -0,0 +1,495 @@
+/******************************************************************************
+ * \file shield_xensiv_a_log.c
+ *
+ * Description: Implementation of the compact binary log format of the shield
+ *              support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include <string.h>
+#include "shield_xensiv_a_log.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define LOG_MAGIC_0                 ((uint8_t)'S')
+#define LOG_MAGIC_1                 ((uint8_t)'X')
+
+#define LOG_TAG_SENSOR_MASK         (0x0FU)
+#define LOG_TAG_NEXT_SEQUENCE       (0x10U)
+#define LOG_TAG_SAME_VALUES         (0x20U)
+#define LOG_TAG_RESERVED            (0xC0U)
+
+#define LOG_MAX_BLOCK_SIZE          (0xFFFFU)
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+/* Number of channels used by every sensor */
+static const uint8_t _log_channels[SHIELD_XENSIV_A_SENSOR_COUNT] =
+{
+    2U, /* SHIELD_XENSIV_A_SENSOR_HUMIDITY */
+    3U, /* SHIELD_XENSIV_A_SENSOR_ACCEL */
+    3U, /* SHIELD_XENSIV_A_SENSOR_GYRO */
+    3U, /* SHIELD_XENSIV_A_SENSOR_MAGNETOMETER */
+    2U, /* SHIELD_XENSIV_A_SENSOR_PRESSURE */
+    1U, /* SHIELD_XENSIV_A_SENSOR_CO2 */
+};
+
+
+/******************************************************************************
+* _shield_xensiv_a_log_put_varint
+******************************************************************************/
+static inline size_t _shield_xensiv_a_log_put_varint(uint8_t* data, uint32_t value)
+{
+    size_t length = 0;
+
+    while (value >= 0x80U)
+    {
+        data[length++] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+    data[length++] = (uint8_t)value;
+
+    return length;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_log_get_varint
+******************************************************************************/
+/* Returns false if the varint is truncated or longer than 32 bits */
+static bool _shield_xensiv_a_log_get_varint(const uint8_t* data, size_t length, size_t* offset,
+                                            uint32_t* value)
+{
+    uint32_t result = 0;
+    uint8_t shift = 0;
+    bool done = false;
+
+    while ((!done) && (*offset < length) && (shift < 35U))
+    {
+        uint8_t byte = data[(*offset)++];
+        result |= (uint32_t)(byte & 0x7FU) << shift;
+        shift += 7U;
+        done = ((byte & 0x80U) == 0);
+    }
+    *value = result;
+
+    return done;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_log_zigzag
+******************************************************************************/
+static inline uint32_t _shield_xensiv_a_log_zigzag(int32_t value)
+{
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_log_unzigzag
+******************************************************************************/
+static inline int32_t _shield_xensiv_a_log_unzigzag(uint32_t value)
+{
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1U);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_log_quantize
+******************************************************************************/
+/* Divides by the resolution, rounding to the nearest step */
+static inline int32_t _shield_xensiv_a_log_quantize(int32_t value, uint16_t resolution)
+{
+    int32_t step = (int32_t)resolution;
+    return (value >= 0)
+           ? ((value + (step / 2)) / step)
+           : ((value - (step / 2)) / step);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_log_put_u16
+******************************************************************************/
+static inline void _shield_xensiv_a_log_put_u16(uint8_t* data, uint16_t value)
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_log_get_u16
+******************************************************************************/
+static inline uint16_t _shield_xensiv_a_log_get_u16(const uint8_t* data)
+{
+    return (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_log_begin_block
+******************************************************************************/
+/* Writes the resolution table and resets the delta state */
+static void _shield_xensiv_a_log_begin_block(shield_xensiv_a_log_encoder_t* encoder)
+{
+    size_t length = SHIELD_XENSIV_A_LOG_HEADER_SIZE;
+
+    for (uint8_t sensor = 0; sensor < SHIELD_XENSIV_A_SENSOR_COUNT; sensor++)
+    {
+        for (uint8_t channel = 0; channel < SHIELD_XENSIV_A_LOG_CHANNELS; channel++)
+        {
+            length += _shield_xensiv_a_log_put_varint(&encoder->cfg.buffer[length],
+                                                      encoder->cfg.resolution[sensor][channel]);
+        }
+    }
+
+    encoder->length = length;
+    encoder->records_offset = length;
+    encoder->records = 0;
+    memset(encoder->sequence, 0, sizeof(encoder->sequence));
+    memset(encoder->values, 0, sizeof(encoder->values));
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_log_encoder_init
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_log_encoder_init(shield_xensiv_a_log_encoder_t* encoder,
+                                           const shield_xensiv_a_log_cfg_t* cfg,
+                                           shield_xensiv_a_log_write_t write, void* write_arg)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((NULL == encoder) || (NULL == cfg) || (NULL == cfg->buffer) || (NULL == write) ||
+        (cfg->buffer_size < (SHIELD_XENSIV_A_LOG_MAX_HEADER_SIZE +
+                             SHIELD_XENSIV_A_LOG_MAX_RECORD_SIZE)) ||
+        (cfg->buffer_size > LOG_MAX_BLOCK_SIZE))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else
+    {
+        encoder->cfg = *cfg;
+        encoder->write = write;
+        encoder->write_arg = write_arg;
+
+        for (uint8_t sensor = 0; sensor < SHIELD_XENSIV_A_SENSOR_COUNT; sensor++)
+        {
+            for (uint8_t channel = 0; channel < SHIELD_XENSIV_A_LOG_CHANNELS; channel++)
+            {
+                if (0 == encoder->cfg.resolution[sensor][channel])
+                {
+                    encoder->cfg.resolution[sensor][channel] = 1U;
+                }
+            }
+        }
+
+        _shield_xensiv_a_log_begin_block(encoder);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_log_flush
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_log_flush(shield_xensiv_a_log_encoder_t* encoder)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == encoder)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if (encoder->records > 0)
+    {
+        uint8_t* header = encoder->cfg.buffer;
+
+        header[0] = LOG_MAGIC_0;
+        header[1] = LOG_MAGIC_1;
+        header[2] = SHIELD_XENSIV_A_LOG_VERSION;
+        header[3] = 0;
+        _shield_xensiv_a_log_put_u16(&header[4], (uint16_t)encoder->length);
+        _shield_xensiv_a_log_put_u16(&header[6], encoder->records);
+        _shield_xensiv_a_log_put_u16(&header[8], (uint16_t)encoder->first_timestamp_us);
+        _shield_xensiv_a_log_put_u16(&header[10], (uint16_t)(encoder->first_timestamp_us >> 16));
+
+        result = encoder->write(header, encoder->length, encoder->write_arg);
+
+        /* The resolution table is still in place, only the records are
+           discarded */
+        encoder->length = encoder->records_offset;
+        encoder->records = 0;
+        memset(encoder->sequence, 0, sizeof(encoder->sequence));
+        memset(encoder->values, 0, sizeof(encoder->values));
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_log_encode
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_log_encode(shield_xensiv_a_log_encoder_t* encoder,
+                                     const shield_xensiv_a_sample_t* sample)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((NULL == encoder) || (NULL == sample) || (sample->sensor >= SHIELD_XENSIV_A_SENSOR_COUNT))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else
+    {
+        if ((encoder->records > 0) &&
+            (((encoder->length + SHIELD_XENSIV_A_LOG_MAX_RECORD_SIZE) > encoder->cfg.buffer_size) ||
+             (encoder->records == 0xFFFFU) ||
+             ((encoder->cfg.keyframe_interval_us > 0) &&
+              ((sample->timestamp_us - encoder->first_timestamp_us) >=
+               encoder->cfg.keyframe_interval_us))))
+        {
+            result = shield_xensiv_a_log_flush(encoder);
+        }
+
+        uint8_t sensor = sample->sensor;
+        const uint16_t* resolution = encoder->cfg.resolution[sensor];
+        int32_t* previous = encoder->values[sensor];
+        uint8_t* data = &encoder->cfg.buffer[encoder->length];
+        uint16_t sequence_delta = (uint16_t)(sample->sequence - encoder->sequence[sensor]);
+        int32_t values[SHIELD_XENSIV_A_LOG_CHANNELS];
+        bool same = true;
+        size_t length = 1;
+
+        if (0 == encoder->records)
+        {
+            encoder->first_timestamp_us = sample->timestamp_us;
+            encoder->last_timestamp_us = sample->timestamp_us;
+        }
+
+        for (uint8_t channel = 0; channel < _log_channels[sensor]; channel++)
+        {
+            values[channel] = _shield_xensiv_a_log_quantize(sample->values[channel],
+                                                            resolution[channel]);
+            same = same && (values[channel] == previous[channel]);
+        }
+
+        data[0] = sensor;
+        if (1U == sequence_delta)
+        {
+            data[0] |= LOG_TAG_NEXT_SEQUENCE;
+        }
+        else
+        {
+            length += _shield_xensiv_a_log_put_varint(&data[length], sequence_delta);
+        }
+
+        length += _shield_xensiv_a_log_put_varint(&data[length],
+                                                  sample->timestamp_us -
+                                                  encoder->last_timestamp_us);
+
+        if (same)
+        {
+            data[0] |= LOG_TAG_SAME_VALUES;
+        }
+        else
+        {
+            for (uint8_t channel = 0; channel < _log_channels[sensor]; channel++)
+            {
+                length += _shield_xensiv_a_log_put_varint(
+                    &data[length],
+                    _shield_xensiv_a_log_zigzag(values[channel] - previous[channel]));
+                previous[channel] = values[channel];
+            }
+        }
+
+        encoder->length += length;
+        encoder->records++;
+        encoder->sequence[sensor] = sample->sequence;
+        encoder->last_timestamp_us = sample->timestamp_us;
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_log_encode_stream
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_log_encode_stream(shield_xensiv_a_log_encoder_t* encoder,
+                                            shield_xensiv_a_stream_t* stream)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    shield_xensiv_a_sample_t sample;
+
+    if ((NULL == encoder) || (NULL == stream))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else
+    {
+        while (shield_xensiv_a_stream_pop(stream, &sample))
+        {
+            cy_rslt_t encoded = shield_xensiv_a_log_encode(encoder, &sample);
+            if (CY_RSLT_SUCCESS == result)
+            {
+                result = encoded;
+            }
+        }
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_log_decode
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_log_decode(const uint8_t* data, size_t length, size_t* consumed,
+                                     shield_xensiv_a_log_sample_callback_t callback,
+                                     void* callback_arg)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t resolution[SHIELD_XENSIV_A_SENSOR_COUNT][SHIELD_XENSIV_A_LOG_CHANNELS];
+    int32_t values[SHIELD_XENSIV_A_SENSOR_COUNT][SHIELD_XENSIV_A_LOG_CHANNELS] = { { 0 } };
+    uint16_t sequence[SHIELD_XENSIV_A_SENSOR_COUNT] = { 0 };
+    size_t block_length = 0;
+    size_t offset = SHIELD_XENSIV_A_LOG_HEADER_SIZE;
+    uint16_t records = 0;
+    uint32_t timestamp_us = 0;
+
+    if ((NULL == data) || (NULL == callback))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if ((length < SHIELD_XENSIV_A_LOG_HEADER_SIZE) ||
+             (LOG_MAGIC_0 != data[0]) || (LOG_MAGIC_1 != data[1]) ||
+             (SHIELD_XENSIV_A_LOG_VERSION != data[2]))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_FORMAT;
+    }
+    else
+    {
+        block_length = _shield_xensiv_a_log_get_u16(&data[4]);
+        records = _shield_xensiv_a_log_get_u16(&data[6]);
+        timestamp_us = _shield_xensiv_a_log_get_u16(&data[8]) |
+                       ((uint32_t)_shield_xensiv_a_log_get_u16(&data[10]) << 16);
+
+        if ((block_length > length) || (block_length < SHIELD_XENSIV_A_LOG_HEADER_SIZE))
+        {
+            result = SHIELD_XENSIV_A_RSLT_ERR_FORMAT;
+        }
+
+        for (uint8_t sensor = 0; (CY_RSLT_SUCCESS == result) &&
+             (sensor < SHIELD_XENSIV_A_SENSOR_COUNT); sensor++)
+        {
+            for (uint8_t channel = 0; (CY_RSLT_SUCCESS == result) &&
+                 (channel < SHIELD_XENSIV_A_LOG_CHANNELS); channel++)
+            {
+                if (!_shield_xensiv_a_log_get_varint(data, block_length, &offset,
+                                                     &resolution[sensor][channel]))
+                {
+                    result = SHIELD_XENSIV_A_RSLT_ERR_FORMAT;
+                }
+            }
+        }
+    }
+
+    for (uint16_t record = 0; (CY_RSLT_SUCCESS == result) && (record < records); record++)
+    {
+        shield_xensiv_a_sample_t sample;
+        uint8_t tag = 0;
+        uint8_t sensor = SHIELD_XENSIV_A_SENSOR_COUNT;
+        uint32_t delta = 1U;
+
+        if (offset < block_length)
+        {
+            tag = data[offset++];
+            sensor = tag & LOG_TAG_SENSOR_MASK;
+        }
+        if ((sensor >= SHIELD_XENSIV_A_SENSOR_COUNT) || ((tag & LOG_TAG_RESERVED) != 0) ||
+            (((tag & LOG_TAG_NEXT_SEQUENCE) == 0) &&
+             !_shield_xensiv_a_log_get_varint(data, block_length, &offset, &delta)))
+        {
+            result = SHIELD_XENSIV_A_RSLT_ERR_FORMAT;
+        }
+        else
+        {
+            sequence[sensor] = (uint16_t)(sequence[sensor] + delta);
+            if (!_shield_xensiv_a_log_get_varint(data, block_length, &offset, &delta))
+            {
+                result = SHIELD_XENSIV_A_RSLT_ERR_FORMAT;
+            }
+            timestamp_us += delta;
+        }
+
+        for (uint8_t channel = 0; (CY_RSLT_SUCCESS == result) &&
+             ((tag & LOG_TAG_SAME_VALUES) == 0) && (channel < _log_channels[sensor]); channel++)
+        {
+            if (_shield_xensiv_a_log_get_varint(data, block_length, &offset, &delta))
+            {
+                values[sensor][channel] += _shield_xensiv_a_log_unzigzag(delta);
+            }
+            else
+            {
+                result = SHIELD_XENSIV_A_RSLT_ERR_FORMAT;
+            }
+        }
+
+        if (CY_RSLT_SUCCESS == result)
+        {
+            memset(&sample, 0, sizeof(sample));
+            sample.sensor = sensor;
+            sample.sequence = sequence[sensor];
+            sample.timestamp_us = timestamp_us;
+            for (uint8_t channel = 0; channel < _log_channels[sensor]; channel++)
+            {
+                sample.values[channel] = values[sensor][channel] *
+                                         (int32_t)resolution[sensor][channel];
+            }
+            callback(&sample, callback_arg);
+        }
+    }
+
+    if ((CY_RSLT_SUCCESS == result) && (NULL != consumed))
+    {
+        *consumed = block_length;
+    }
+
+    return result;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
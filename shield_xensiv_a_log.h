@@ -0,0 +1,240 @@
+/******************************************************************************
+ * \file shield_xensiv_a_log.h
+ *
+ * Description: This file is the interface for the compact binary log format
+ *              of the samples of the sensors on the SHIELD_XENSIV_A shield
+ *              board.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * A log is a sequence of self-contained blocks, each of which can be decoded
+ * on its own, so a reader can start at any block.
+ *
+ * Block header, multi-byte fields little endian:
+ *   [0..1]   magic "SX"
+ *   [2]      format version, SHIELD_XENSIV_A_LOG_VERSION
+ *   [3]      reserved, 0
+ *   [4..5]   total length of the block in bytes, including the header
+ *   [6..7]   number of records
+ *   [8..11]  timestamp of the first record in us
+ *   then the resolution of every channel as unsigned varint, sensor by
+ *   sensor, SHIELD_XENSIV_A_LOG_CHANNELS entries per sensor
+ *
+ * Record:
+ *   tag      bits 0..3: sensor, bit 4: sequence is previous + 1,
+ *            bit 5: values equal the previous values of the sensor
+ *   varint   sequence - previous sequence of the sensor, if bit 4 is clear
+ *   varint   timestamp - timestamp of the previous record
+ *   zigzag   value / resolution - previous one of the channel, for every
+ *            channel of the sensor, if bit 5 is clear
+ *
+ * Previous sequences and values are 0 at the start of a block, so the first
+ * record of every sensor in a block holds absolute values.
+ */
+
+#pragma once
+
+#include "shield_xensiv_a_stream.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/** Version of the block format */
+#define SHIELD_XENSIV_A_LOG_VERSION             (1U)
+/** Size of the fixed part of the block header */
+#define SHIELD_XENSIV_A_LOG_HEADER_SIZE         (12U)
+/** Number of channels per sensor, matches the values of a sample */
+#define SHIELD_XENSIV_A_LOG_CHANNELS            (3U)
+/** Upper bound of the encoded size of a record */
+#define SHIELD_XENSIV_A_LOG_MAX_RECORD_SIZE     (1U + 3U + 5U + (5U * SHIELD_XENSIV_A_LOG_CHANNELS))
+/** Upper bound of the size of the block header */
+#define SHIELD_XENSIV_A_LOG_MAX_HEADER_SIZE     \
+    (SHIELD_XENSIV_A_LOG_HEADER_SIZE + (3U * SHIELD_XENSIV_A_SENSOR_COUNT * SHIELD_XENSIV_A_LOG_CHANNELS))
+
+/** Default resolution of every channel, in units of the sample values:
+ * 0.01 °C and 0.01 %RH, raw inertial values, 0.01 µT, 0.001 hPa and
+ * 0.01 °C, and 1 ppm
+ */
+#define SHIELD_XENSIV_A_LOG_RESOLUTION_DEFAULT  \
+    {                                           \
+        { 10U, 10U, 1U },                       \
+        { 1U, 1U, 1U },                         \
+        { 1U, 1U, 1U },                         \
+        { 10U, 10U, 10U },                      \
+        { 1U, 10U, 1U },                        \
+        { 1U, 1U, 1U }                          \
+    }
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Writes a completed block to storage, returns the status of the write */
+typedef cy_rslt_t (*shield_xensiv_a_log_write_t)(const uint8_t* data, size_t length, void* arg);
+
+/** Called for every decoded sample */
+typedef void (*shield_xensiv_a_log_sample_callback_t)(const shield_xensiv_a_sample_t* sample,
+                                                      void* arg);
+
+/** Configuration of an encoder */
+typedef struct
+{
+    /** Storage for one block, supplied by the application, e.g. a flash page */
+    uint8_t*    buffer;
+    /** Size of buffer, at least SHIELD_XENSIV_A_LOG_MAX_HEADER_SIZE +
+     * SHIELD_XENSIV_A_LOG_MAX_RECORD_SIZE and at most 65535 bytes */
+    size_t      buffer_size;
+    /** Maximum time covered by a block in us, bounds the amount of data to
+     * read before a position in time can be decoded, 0 for no limit */
+    uint32_t    keyframe_interval_us;
+    /** Quantization step of every channel, 0 is treated as 1 */
+    uint16_t    resolution[SHIELD_XENSIV_A_SENSOR_COUNT][SHIELD_XENSIV_A_LOG_CHANNELS];
+} shield_xensiv_a_log_cfg_t;
+
+/** State of an encoder, not to be accessed by the application */
+typedef struct
+{
+    shield_xensiv_a_log_cfg_t       cfg;
+    shield_xensiv_a_log_write_t     write;
+    void*                           write_arg;
+    /** Bytes used in the buffer */
+    size_t                          length;
+    /** Offset of the first record in the buffer */
+    size_t                          records_offset;
+    uint16_t                        records;
+    uint32_t                        first_timestamp_us;
+    uint32_t                        last_timestamp_us;
+    uint16_t                        sequence[SHIELD_XENSIV_A_SENSOR_COUNT];
+    int32_t                         values[SHIELD_XENSIV_A_SENSOR_COUNT][SHIELD_XENSIV_A_LOG_CHANNELS];
+} shield_xensiv_a_log_encoder_t;
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_log_encoder_init
+******************************************************************************
+* Summary: Initializes an encoder. Completed blocks are passed to the write
+*          function from shield_xensiv_a_log_encode() and
+*          shield_xensiv_a_log_flush().
+*
+* Parameters:
+*  encoder           The encoder to initialize
+*  cfg               Configuration, copied into the encoder
+*  write             Function writing a completed block to storage
+*  write_arg         Argument passed to the write function
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_log_encoder_init(shield_xensiv_a_log_encoder_t* encoder,
+                                           const shield_xensiv_a_log_cfg_t* cfg,
+                                           shield_xensiv_a_log_write_t write, void* write_arg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_log_encode
+******************************************************************************
+* Summary: Appends a sample to the current block. The block is written first
+*          if the sample does not fit into it or if the keyframe interval has
+*          elapsed.
+*
+* Parameters:
+*  encoder           The encoder
+*  sample            The sample to append
+*
+* Return:
+*  Status of the operation, the status of the write function if a block was
+*  written. The sample is appended even if the write failed.
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_log_encode(shield_xensiv_a_log_encoder_t* encoder,
+                                     const shield_xensiv_a_sample_t* sample);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_log_encode_stream
+******************************************************************************
+* Summary: Appends all samples of a stream. Must only be called from the
+*          consumer context of the stream.
+*
+* Parameters:
+*  encoder           The encoder
+*  stream            The stream to drain
+*
+* Return:
+*  Status of the operation, the first failure of the write function
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_log_encode_stream(shield_xensiv_a_log_encoder_t* encoder,
+                                            shield_xensiv_a_stream_t* stream);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_log_flush
+******************************************************************************
+* Summary: Writes the current block, if it holds any record, and starts a new
+*          one.
+*
+* Parameters:
+*  encoder           The encoder
+*
+* Return:
+*  Status of the write function
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_log_flush(shield_xensiv_a_log_encoder_t* encoder);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_log_decode
+******************************************************************************
+* Summary: Decodes the block at the start of data.
+*
+* Parameters:
+*  data              The encoded data
+*  length            Number of bytes available at data
+*  consumed          Returns the length of the block, may be NULL
+*  callback          Called for every sample of the block
+*  callback_arg      Argument passed to the callback
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_FORMAT if data does not
+*  start with a valid block
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_log_decode(const uint8_t* data, size_t length, size_t* consumed,
+                                     shield_xensiv_a_log_sample_callback_t callback,
+                                     void* callback_arg);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,243 @@
+/******************************************************************************
+ * \file shield_xensiv_a_metrics.c
+ *
+ * Description: Implementation of the optional instrumentation of the shield
+ *              support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include <string.h>
+#include "shield_xensiv_a_metrics.h"
+
+#if SHIELD_XENSIV_A_METRICS_ENABLED
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static shield_xensiv_a_metrics_t    _metrics[SHIELD_XENSIV_A_METRICS_DEVICE_COUNT];
+
+
+/******************************************************************************
+* _shield_xensiv_a_metrics_bucket
+******************************************************************************/
+static inline uint8_t _shield_xensiv_a_metrics_bucket(uint32_t duration_us)
+{
+    uint8_t bucket = 0;
+
+    /* Index of the highest set bit */
+    while ((duration_us > 1U) && (bucket < (SHIELD_XENSIV_A_METRICS_BUCKETS - 1U)))
+    {
+        duration_us >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_metrics_record
+******************************************************************************/
+void shield_xensiv_a_metrics_record(shield_xensiv_a_metrics_device_t device,
+                                    uint32_t duration_us, uint32_t bytes, cy_rslt_t result)
+{
+    if (device < SHIELD_XENSIV_A_METRICS_DEVICE_COUNT)
+    {
+        shield_xensiv_a_metrics_t* metrics = &_metrics[device];
+        uint32_t state = cyhal_system_critical_section_enter();
+
+        metrics->transactions++;
+        if (CY_RSLT_SUCCESS == result)
+        {
+            if ((metrics->transactions == (metrics->errors + 1U)) ||
+                (duration_us < metrics->min_us))
+            {
+                metrics->min_us = duration_us;
+            }
+            if (duration_us > metrics->max_us)
+            {
+                metrics->max_us = duration_us;
+            }
+            metrics->bytes += bytes;
+            metrics->total_us += duration_us;
+            metrics->histogram[_shield_xensiv_a_metrics_bucket(duration_us)]++;
+        }
+        else
+        {
+            metrics->errors++;
+        }
+
+        cyhal_system_critical_section_exit(state);
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_metrics_record_retry
+******************************************************************************/
+void shield_xensiv_a_metrics_record_retry(shield_xensiv_a_metrics_device_t device)
+{
+    if (device < SHIELD_XENSIV_A_METRICS_DEVICE_COUNT)
+    {
+        uint32_t state = cyhal_system_critical_section_enter();
+        _metrics[device].retries++;
+        cyhal_system_critical_section_exit(state);
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_metrics_device_from_address
+******************************************************************************/
+shield_xensiv_a_metrics_device_t shield_xensiv_a_metrics_device_from_address(uint16_t address)
+{
+    shield_xensiv_a_metrics_device_t device;
+
+    switch (address)
+    {
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+        case MTB_SHT35_ADDRESS_DEFAULT:
+            device = SHIELD_XENSIV_A_METRICS_HUMIDITY;
+            break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_MOTION
+        case MTB_BMI270_ADDRESS_SEC:
+            device = SHIELD_XENSIV_A_METRICS_MOTION;
+            break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+        case MTB_BMM350_ADDRESS_DEFAULT:
+            device = SHIELD_XENSIV_A_METRICS_MAGNETOMETER;
+            break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+        case XENSIV_DPS3XX_I2C_ADDR_ALT:
+            device = SHIELD_XENSIV_A_METRICS_PRESSURE;
+            break;
+#endif
+
+#if SHIELD_XENSIV_A_USE_CO2
+        case XENSIV_PASCO2_I2C_ADDR:
+            device = SHIELD_XENSIV_A_METRICS_CO2;
+            break;
+#endif
+
+        default:
+            device = SHIELD_XENSIV_A_METRICS_I2C_OTHER;
+            break;
+    }
+
+    return device;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_metrics_get
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_metrics_get(shield_xensiv_a_metrics_device_t device,
+                                      shield_xensiv_a_metrics_t* metrics)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((device >= SHIELD_XENSIV_A_METRICS_DEVICE_COUNT) || (NULL == metrics))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else
+    {
+        uint32_t state = cyhal_system_critical_section_enter();
+        *metrics = _metrics[device];
+        cyhal_system_critical_section_exit(state);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_metrics_percentile_us
+******************************************************************************/
+uint32_t shield_xensiv_a_metrics_percentile_us(const shield_xensiv_a_metrics_t* metrics,
+                                               uint8_t percent)
+{
+    uint32_t duration_us = 0;
+    uint32_t count = metrics->transactions - metrics->errors;
+
+    if ((count > 0) && (percent <= 100U))
+    {
+        /* Rank of the percentile, rounded up, at least the first sample */
+        uint32_t rank = (uint32_t)(((uint64_t)count * percent + 99U) / 100U);
+        uint32_t seen = 0;
+        uint8_t bucket = 0;
+
+        if (rank == 0)
+        {
+            rank = 1;
+        }
+        while ((bucket < (SHIELD_XENSIV_A_METRICS_BUCKETS - 1U)) &&
+               ((seen + metrics->histogram[bucket]) < rank))
+        {
+            seen += metrics->histogram[bucket];
+            bucket++;
+        }
+
+        duration_us = (2UL << bucket) - 1U;
+        if ((duration_us > metrics->max_us) || (bucket == (SHIELD_XENSIV_A_METRICS_BUCKETS - 1U)))
+        {
+            duration_us = metrics->max_us;
+        }
+        if (duration_us < metrics->min_us)
+        {
+            duration_us = metrics->min_us;
+        }
+    }
+
+    return duration_us;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_metrics_reset
+******************************************************************************/
+void shield_xensiv_a_metrics_reset(void)
+{
+    uint32_t state = cyhal_system_critical_section_enter();
+    memset(_metrics, 0, sizeof(_metrics));
+    cyhal_system_critical_section_exit(state);
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // if SHIELD_XENSIV_A_METRICS_ENABLED
+
+
+/* [] END OF FILE */
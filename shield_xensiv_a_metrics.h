@@ -0,0 +1,236 @@
+/******************************************************************************
+ * \file shield_xensiv_a_metrics.h
+ *
+ * Description: This file is the interface for the optional instrumentation of
+ *              the bus and PDM usage of the SHIELD_XENSIV_A support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#ifndef SHIELD_XENSIV_A_METRICS_ENABLED
+/** Set to 1, e.g. with DEFINES+=SHIELD_XENSIV_A_METRICS_ENABLED=1 in the
+ * application Makefile, to collect metrics. When 0 the instrumentation
+ * compiles to nothing and the functions below are not available.
+ */
+#define SHIELD_XENSIV_A_METRICS_ENABLED     (0)
+#endif
+
+/** Number of latency histogram buckets. Bucket 0 counts durations below 2 µs,
+ * bucket n counts durations from 2^n to 2^(n+1) - 1 µs and the last bucket
+ * also counts all longer durations.
+ */
+#define SHIELD_XENSIV_A_METRICS_BUCKETS     (24U)
+
+/** Bytes recorded for a sample read through a sensor driver, the size of its
+ * data registers. A driver read may take several transfers, it is recorded
+ * as one transaction. Configuration and power mode changes, polls of the
+ * data ready status, the staged initialization, shield_xensiv_a_reinit()
+ * and accesses through the driver objects returned by the
+ * shield_xensiv_a_get_*_sensor() functions are not recorded.
+ */
+#define SHIELD_XENSIV_A_METRICS_SHT35_BYTES     (6U)
+#define SHIELD_XENSIV_A_METRICS_BMI270_BYTES    (12U)
+#define SHIELD_XENSIV_A_METRICS_BMM350_BYTES    (12U)
+#define SHIELD_XENSIV_A_METRICS_DPS368_BYTES    (6U)
+#define SHIELD_XENSIV_A_METRICS_PASCO2_BYTES    (2U)
+
+#if SHIELD_XENSIV_A_METRICS_ENABLED
+/** Declares a local variable holding the start time of a measurement */
+#define SHIELD_XENSIV_A_METRICS_BEGIN(name) \
+    uint32_t name = shield_xensiv_a_get_timestamp_us()
+/** Records a transaction which started at the time held by name */
+#define SHIELD_XENSIV_A_METRICS_END(device, name, bytes, result) \
+    shield_xensiv_a_metrics_record((device), shield_xensiv_a_get_timestamp_us() - (name), \
+                                   (bytes), (result))
+/** Records a transaction of known duration */
+#define SHIELD_XENSIV_A_METRICS_RECORD(device, duration_us, bytes, result) \
+    shield_xensiv_a_metrics_record((device), (duration_us), (bytes), (result))
+/** Records a retry of a transaction */
+#define SHIELD_XENSIV_A_METRICS_RETRY(device) \
+    shield_xensiv_a_metrics_record_retry(device)
+#else
+#define SHIELD_XENSIV_A_METRICS_BEGIN(name)
+#define SHIELD_XENSIV_A_METRICS_END(device, name, bytes, result)
+#define SHIELD_XENSIV_A_METRICS_RECORD(device, duration_us, bytes, result)
+#define SHIELD_XENSIV_A_METRICS_RETRY(device)
+#endif
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Devices for which metrics are collected */
+typedef enum
+{
+    SHIELD_XENSIV_A_METRICS_HUMIDITY,       /**< SHT35 on I2C */
+    SHIELD_XENSIV_A_METRICS_MOTION,         /**< BMI270 on I2C */
+    SHIELD_XENSIV_A_METRICS_MAGNETOMETER,   /**< BMM350 on I2C */
+    SHIELD_XENSIV_A_METRICS_PRESSURE,       /**< DPS368 on I2C */
+    SHIELD_XENSIV_A_METRICS_CO2,            /**< PAS CO2 on I2C */
+    SHIELD_XENSIV_A_METRICS_I2C_OTHER,      /**< Any other I2C address */
+    SHIELD_XENSIV_A_METRICS_DISPLAY,        /**< ST7735S on SPI, one transaction per flush */
+    SHIELD_XENSIV_A_METRICS_PDM,            /**< PDM microphone, one transaction per block */
+    SHIELD_XENSIV_A_METRICS_DEVICE_COUNT    /**< Number of devices */
+} shield_xensiv_a_metrics_device_t;
+
+/** Metrics of one device */
+typedef struct
+{
+    /** Number of completed transactions, including failed ones */
+    uint32_t    transactions;
+    /** Number of bytes transferred by successful transactions */
+    uint32_t    bytes;
+    /** Number of failed transactions */
+    uint32_t    errors;
+    /** Number of retried transactions */
+    uint32_t    retries;
+    /** Shortest duration of a successful transaction in µs */
+    uint32_t    min_us;
+    /** Longest duration of a successful transaction in µs */
+    uint32_t    max_us;
+    /** Total duration of all successful transactions in µs */
+    uint64_t    total_us;
+    /** Durations of the successful transactions, see
+     * SHIELD_XENSIV_A_METRICS_BUCKETS */
+    uint32_t    histogram[SHIELD_XENSIV_A_METRICS_BUCKETS];
+} shield_xensiv_a_metrics_t;
+
+#if SHIELD_XENSIV_A_METRICS_ENABLED
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_metrics_record
+******************************************************************************
+* Summary: Records a completed transaction. Used through the
+*          SHIELD_XENSIV_A_METRICS_* macros by the library, and may be called
+*          from interrupt context.
+*
+* Parameters:
+*  device            The device of the transaction
+*  duration_us       Duration of the transaction
+*  bytes             Number of bytes transferred
+*  result            Result of the transaction
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_metrics_record(shield_xensiv_a_metrics_device_t device,
+                                    uint32_t duration_us, uint32_t bytes, cy_rslt_t result);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_metrics_record_retry
+******************************************************************************
+* Summary: Records a retry of a transaction.
+*
+* Parameters:
+*  device            The device of the transaction
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_metrics_record_retry(shield_xensiv_a_metrics_device_t device);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_metrics_device_from_address
+******************************************************************************
+* Summary: Gets the device which uses an I2C address on the shield.
+*
+* Parameters:
+*  address           7-bit I2C address
+*
+* Return:
+*  The device, SHIELD_XENSIV_A_METRICS_I2C_OTHER for unknown addresses
+*
+******************************************************************************/
+shield_xensiv_a_metrics_device_t shield_xensiv_a_metrics_device_from_address(uint16_t address);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_metrics_get
+******************************************************************************
+* Summary: Takes a consistent copy of the metrics of a device.
+*
+* Parameters:
+*  device            The device
+*  metrics           Receives the metrics
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_metrics_get(shield_xensiv_a_metrics_device_t device,
+                                      shield_xensiv_a_metrics_t* metrics);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_metrics_percentile_us
+******************************************************************************
+* Summary: Estimates a percentile of the transaction durations from the
+*          histogram. The result is the upper bound of the bucket containing
+*          the percentile, limited to the longest duration seen.
+*
+* Parameters:
+*  metrics           Metrics from shield_xensiv_a_metrics_get()
+*  percent           The percentile, 0 to 100
+*
+* Return:
+*  The duration in µs, or 0 if there were no transactions
+*
+******************************************************************************/
+uint32_t shield_xensiv_a_metrics_percentile_us(const shield_xensiv_a_metrics_t* metrics,
+                                               uint8_t percent);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_metrics_reset
+******************************************************************************
+* Summary: Clears the metrics of all devices.
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_metrics_reset(void);
+
+#endif // if SHIELD_XENSIV_A_METRICS_ENABLED
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
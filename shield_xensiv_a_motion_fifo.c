@@ -0,0 +1,357 @@
+/******************************************************************************
+ * \file shield_xensiv_a_motion_fifo.c
+ *
+ * Description: Implementation of the batched BMI270 FIFO acquisition of the
+ *              shield support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "shield_xensiv_a_motion_fifo.h"
+#include "shield_xensiv_a_stream.h"
+#include "shield_xensiv_a_metrics.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#if SHIELD_XENSIV_A_USE_MOTION
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Size of a headerless FIFO frame holding accelerometer and gyroscope data */
+#define FIFO_FRAME_BYTES           (12U)
+/* Size of the BMI270 FIFO in frames */
+#define FIFO_CAPACITY_FRAMES       (170U)
+/* Lowest supported ODR setting, for which the rate is 25 Hz */
+#define FIFO_ODR_BASE_HZ           (25UL)
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static uint8_t                                  _fifo_raw[SHIELD_XENSIV_A_MOTION_FIFO_MAX_FRAMES *
+                                                          FIFO_FRAME_BYTES];
+static struct bmi2_sens_axes_data               _fifo_acc[SHIELD_XENSIV_A_MOTION_FIFO_MAX_FRAMES];
+static struct bmi2_sens_axes_data               _fifo_gyr[SHIELD_XENSIV_A_MOTION_FIFO_MAX_FRAMES];
+static cyhal_gpio_t                             _fifo_pin;
+static cyhal_gpio_callback_data_t               _fifo_callback_data;
+static shield_xensiv_a_motion_fifo_callback_t   _fifo_callback;
+static void*                                    _fifo_callback_arg;
+static uint32_t                                 _fifo_period_us;
+static uint16_t                                 _fifo_watermark_frames;
+static volatile uint32_t                        _fifo_irq_timestamp_us;
+static volatile bool                            _fifo_irq_pending;
+static bool                                     _fifo_started;
+
+
+/******************************************************************************
+* _shield_xensiv_a_motion_fifo_irq
+******************************************************************************/
+static void _shield_xensiv_a_motion_fifo_irq(void* callback_arg, cyhal_gpio_event_t event)
+{
+    (void)callback_arg;
+    (void)event;
+
+    _fifo_irq_timestamp_us = shield_xensiv_a_get_timestamp_us();
+    _fifo_irq_pending = true;
+
+    if (NULL != _fifo_callback)
+    {
+        _fifo_callback(_fifo_irq_timestamp_us, _fifo_callback_arg);
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_motion_fifo_config_sensor
+******************************************************************************/
+static int8_t _shield_xensiv_a_motion_fifo_config_sensor(struct bmi2_dev* dev,
+                                                         const shield_xensiv_a_motion_fifo_cfg_t* cfg)
+{
+    static const uint8_t sensor_list[] = { BMI2_ACCEL, BMI2_GYRO };
+    struct bmi2_sens_config config[2] =
+    {
+        { .type = BMI2_ACCEL },
+        { .type = BMI2_GYRO  }
+    };
+    struct bmi2_int_pin_config pin_config;
+
+    int8_t rslt = bmi270_get_sensor_config(config, 2, dev);
+    if (BMI2_OK == rslt)
+    {
+        config[0].cfg.acc.odr = (uint8_t)cfg->odr;
+        config[0].cfg.acc.filter_perf = BMI2_PERF_OPT_MODE;
+        config[1].cfg.gyr.odr = (uint8_t)cfg->odr;
+        config[1].cfg.gyr.filter_perf = BMI2_PERF_OPT_MODE;
+        rslt = bmi270_set_sensor_config(config, 2, dev);
+    }
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi270_sensor_enable(sensor_list, 2, dev);
+    }
+
+    /* Headerless frames with accelerometer and gyroscope data only */
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi2_set_fifo_config(BMI2_FIFO_ALL_EN, BMI2_DISABLE, dev);
+    }
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi2_set_fifo_config(BMI2_FIFO_ACC_EN | BMI2_FIFO_GYR_EN, BMI2_ENABLE, dev);
+    }
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi2_set_fifo_wm((uint16_t)(cfg->watermark_frames * FIFO_FRAME_BYTES), dev);
+    }
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi2_set_command_register(BMI2_FIFO_FLUSH_CMD, dev);
+    }
+
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi2_get_int_pin_config(&pin_config, dev);
+    }
+    if (BMI2_OK == rslt)
+    {
+        pin_config.pin_type = BMI2_INT2;
+        pin_config.int_latch = BMI2_INT_NON_LATCH;
+        pin_config.pin_cfg[1].output_en = BMI2_INT_OUTPUT_ENABLE;
+        pin_config.pin_cfg[1].od = BMI2_INT_PUSH_PULL;
+        pin_config.pin_cfg[1].lvl = BMI2_INT_ACTIVE_HIGH;
+        pin_config.pin_cfg[1].input_en = BMI2_DISABLE;
+        rslt = bmi2_set_int_pin_config(&pin_config, dev);
+    }
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi2_map_data_int(BMI2_FWM_INT, BMI2_INT2, dev);
+    }
+
+    return rslt;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_motion_fifo_drain
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_motion_fifo_drain(shield_xensiv_a_motion_frame_t* frames,
+                                                    uint16_t max_frames, uint16_t* num_frames)
+{
+    struct bmi2_dev* dev = &shield_xensiv_a_get_motion_sensor()->sensor;
+    struct bmi2_fifo_frame fifo = { 0 };
+    uint16_t fifo_length = 0;
+    uint16_t acc_frames = SHIELD_XENSIV_A_MOTION_FIFO_MAX_FRAMES;
+    uint16_t gyr_frames = SHIELD_XENSIV_A_MOTION_FIFO_MAX_FRAMES;
+    uint16_t count = 0;
+
+    /* Anchor the timestamps on the watermark interrupt when there was one,
+       otherwise on the time of this read */
+    bool from_irq = _fifo_irq_pending;
+    uint32_t anchor_us = from_irq ? _fifo_irq_timestamp_us : shield_xensiv_a_get_timestamp_us();
+    _fifo_irq_pending = false;
+
+    int8_t rslt = bmi2_get_fifo_length(&fifo_length, dev);
+    if ((BMI2_OK == rslt) && (fifo_length >= FIFO_FRAME_BYTES))
+    {
+        uint16_t limit = (max_frames < SHIELD_XENSIV_A_MOTION_FIFO_MAX_FRAMES)
+            ? max_frames
+            : SHIELD_XENSIV_A_MOTION_FIFO_MAX_FRAMES;
+        if (fifo_length > (limit * FIFO_FRAME_BYTES))
+        {
+            fifo_length = (uint16_t)(limit * FIFO_FRAME_BYTES);
+        }
+        fifo.data = _fifo_raw;
+        fifo.length = (uint16_t)(fifo_length - (fifo_length % FIFO_FRAME_BYTES));
+
+        /* Transfer the whole FIFO content in one I2C burst */
+        uint16_t read_write_len = dev->read_write_len;
+        dev->read_write_len = fifo.length;
+        SHIELD_XENSIV_A_METRICS_BEGIN(start_us);
+        rslt = bmi2_read_fifo_data(&fifo, dev);
+        SHIELD_XENSIV_A_METRICS_END(SHIELD_XENSIV_A_METRICS_MOTION, start_us, fifo.length,
+                                    (BMI2_OK == rslt)
+                                    ? CY_RSLT_SUCCESS
+                                    : SHIELD_XENSIV_A_RSLT_ERR_SENSOR);
+        dev->read_write_len = read_write_len;
+    }
+
+    if ((BMI2_OK == rslt) && (fifo.length > 0))
+    {
+        rslt = bmi2_extract_accel(_fifo_acc, &acc_frames, &fifo, dev);
+        if (BMI2_OK == rslt)
+        {
+            rslt = bmi2_extract_gyro(_fifo_gyr, &gyr_frames, &fifo, dev);
+        }
+        count = (acc_frames < gyr_frames) ? acc_frames : gyr_frames;
+    }
+
+    if ((BMI2_OK == rslt) && (count > 0))
+    {
+        uint16_t anchor_index = (from_irq && (_fifo_watermark_frames <= count))
+            ? (uint16_t)(_fifo_watermark_frames - 1U)
+            : (uint16_t)(count - 1U);
+
+        for (uint16_t i = 0; i < count; i++)
+        {
+            frames[i].timestamp_us = anchor_us +
+                                     (uint32_t)((int32_t)i - (int32_t)anchor_index) *
+                                     _fifo_period_us;
+            frames[i].acc[0] = _fifo_acc[i].x;
+            frames[i].acc[1] = _fifo_acc[i].y;
+            frames[i].acc[2] = _fifo_acc[i].z;
+            frames[i].gyr[0] = _fifo_gyr[i].x;
+            frames[i].gyr[1] = _fifo_gyr[i].y;
+            frames[i].gyr[2] = _fifo_gyr[i].z;
+        }
+
+        if (NULL != shield_xensiv_a_stream_get_attached())
+        {
+            for (uint16_t i = 0; i < count; i++)
+            {
+                int32_t acc[3] = { frames[i].acc[0], frames[i].acc[1], frames[i].acc[2] };
+                int32_t gyr[3] = { frames[i].gyr[0], frames[i].gyr[1], frames[i].gyr[2] };
+                (void)shield_xensiv_a_stream_put(SHIELD_XENSIV_A_SENSOR_ACCEL,
+                                                 frames[i].timestamp_us, acc);
+                (void)shield_xensiv_a_stream_put(SHIELD_XENSIV_A_SENSOR_GYRO,
+                                                 frames[i].timestamp_us, gyr);
+            }
+        }
+        *num_frames = count;
+    }
+
+    return (BMI2_OK == rslt) ? CY_RSLT_SUCCESS : SHIELD_XENSIV_A_RSLT_ERR_SENSOR;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_motion_fifo_start
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_motion_fifo_start(const shield_xensiv_a_motion_fifo_cfg_t* cfg,
+                                            shield_xensiv_a_motion_fifo_callback_t callback,
+                                            void* callback_arg)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((NULL == cfg) || _fifo_started || (cfg->watermark_frames == 0) ||
+        (cfg->watermark_frames > SHIELD_XENSIV_A_MOTION_FIFO_MAX_FRAMES) ||
+        (cfg->watermark_frames > FIFO_CAPACITY_FRAMES) ||
+        (cfg->odr < SHIELD_XENSIV_A_MOTION_ODR_25HZ) ||
+        (cfg->odr > SHIELD_XENSIV_A_MOTION_ODR_1600HZ))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if ((shield_xensiv_a_get_ready_mask() & SHIELD_XENSIV_A_READY_MOTION) == 0)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        _fifo_pin = shield_xensiv_a_get_pins()->imu_int_2;
+        result = cyhal_gpio_init(_fifo_pin, CYHAL_GPIO_DIR_INPUT, CYHAL_GPIO_DRIVE_NONE, false);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        uint32_t odr_hz = FIFO_ODR_BASE_HZ << (cfg->odr - SHIELD_XENSIV_A_MOTION_ODR_25HZ);
+
+        _fifo_period_us = 1000000UL / odr_hz;
+        _fifo_watermark_frames = cfg->watermark_frames;
+        _fifo_irq_pending = false;
+        _fifo_callback = callback;
+        _fifo_callback_arg = callback_arg;
+        _fifo_callback_data.callback = _shield_xensiv_a_motion_fifo_irq;
+        _fifo_callback_data.callback_arg = NULL;
+        cyhal_gpio_register_callback(_fifo_pin, &_fifo_callback_data);
+        cyhal_gpio_enable_event(_fifo_pin, CYHAL_GPIO_IRQ_RISE,
+                                cfg->intr_priority, true);
+
+        if (BMI2_OK == _shield_xensiv_a_motion_fifo_config_sensor(
+                &shield_xensiv_a_get_motion_sensor()->sensor, cfg))
+        {
+            _fifo_started = true;
+        }
+        else
+        {
+            cyhal_gpio_enable_event(_fifo_pin, CYHAL_GPIO_IRQ_RISE,
+                                    cfg->intr_priority, false);
+            cyhal_gpio_free(_fifo_pin);
+            result = SHIELD_XENSIV_A_RSLT_ERR_SENSOR;
+        }
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_motion_fifo_read
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_motion_fifo_read(shield_xensiv_a_motion_frame_t* frames,
+                                           uint16_t max_frames, uint16_t* num_frames)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((NULL == frames) || (NULL == num_frames))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else
+    {
+        *num_frames = 0;
+        result = _fifo_started
+            ? _shield_xensiv_a_motion_fifo_drain(frames, max_frames, num_frames)
+            : SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_motion_fifo_stop
+******************************************************************************/
+void shield_xensiv_a_motion_fifo_stop(void)
+{
+    if (_fifo_started)
+    {
+        struct bmi2_dev* dev = &shield_xensiv_a_get_motion_sensor()->sensor;
+
+        (void)bmi2_map_data_int(BMI2_FWM_INT, BMI2_INT_NONE, dev);
+        (void)bmi2_set_fifo_config(BMI2_FIFO_ALL_EN, BMI2_DISABLE, dev);
+
+        cyhal_gpio_enable_event(_fifo_pin, CYHAL_GPIO_IRQ_RISE, 0, false);
+        cyhal_gpio_free(_fifo_pin);
+
+        _fifo_callback = NULL;
+        _fifo_started = false;
+    }
+}
+
+
+#endif /* SHIELD_XENSIV_A_USE_MOTION */
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
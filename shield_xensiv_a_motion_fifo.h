@@ -0,0 +1,154 @@
+/******************************************************************************
+ * \file shield_xensiv_a_motion_fifo.h
+ *
+ * Description: This file is the interface for the batched acquisition of the
+ *              BMI270 motion sensor through its hardware FIFO.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#ifndef SHIELD_XENSIV_A_MOTION_FIFO_MAX_FRAMES
+/** Maximum number of frames transferred by one call to
+ * shield_xensiv_a_motion_fifo_read(). This sizes the internal buffers, which
+ * take 36 bytes per frame. The BMI270 FIFO holds up to 170 frames.
+ */
+#define SHIELD_XENSIV_A_MOTION_FIFO_MAX_FRAMES  (64U)
+#endif
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Output data rates of the accelerometer and gyroscope in FIFO mode */
+typedef enum
+{
+    SHIELD_XENSIV_A_MOTION_ODR_25HZ     = 0x06, /**< 25 Hz */
+    SHIELD_XENSIV_A_MOTION_ODR_50HZ     = 0x07, /**< 50 Hz */
+    SHIELD_XENSIV_A_MOTION_ODR_100HZ    = 0x08, /**< 100 Hz */
+    SHIELD_XENSIV_A_MOTION_ODR_200HZ    = 0x09, /**< 200 Hz */
+    SHIELD_XENSIV_A_MOTION_ODR_400HZ    = 0x0A, /**< 400 Hz */
+    SHIELD_XENSIV_A_MOTION_ODR_800HZ    = 0x0B, /**< 800 Hz */
+    SHIELD_XENSIV_A_MOTION_ODR_1600HZ   = 0x0C  /**< 1600 Hz */
+} shield_xensiv_a_motion_odr_t;
+
+/** Configuration of the BMI270 FIFO mode */
+typedef struct
+{
+    /** Output data rate of both the accelerometer and the gyroscope */
+    shield_xensiv_a_motion_odr_t    odr;
+    /** Number of frames in the FIFO which trigger the watermark interrupt,
+     * at most SHIELD_XENSIV_A_MOTION_FIFO_MAX_FRAMES */
+    uint16_t                        watermark_frames;
+    /** Priority of the watermark GPIO interrupt */
+    uint8_t                         intr_priority;
+} shield_xensiv_a_motion_fifo_cfg_t;
+
+/** One decoded accelerometer and gyroscope sample */
+typedef struct
+{
+    /** Estimated sampling time from shield_xensiv_a_get_timestamp_us() */
+    uint32_t    timestamp_us;
+    /** Raw accelerometer x, y and z values */
+    int16_t     acc[3];
+    /** Raw gyroscope x, y and z values */
+    int16_t     gyr[3];
+} shield_xensiv_a_motion_frame_t;
+
+/** Callback invoked from the GPIO interrupt when the FIFO reaches its
+ * watermark. No I2C transfers may be started from this callback; call
+ * shield_xensiv_a_motion_fifo_read() from thread context instead.
+ */
+typedef void (*shield_xensiv_a_motion_fifo_callback_t)(uint32_t timestamp_us,
+                                                       void* callback_arg);
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_motion_fifo_start
+******************************************************************************
+* Summary: Switches the BMI270 to FIFO mode. The accelerometer and gyroscope
+*          are sampled at the configured rate into the sensor FIFO and the
+*          watermark interrupt is signaled on SHIELD_XENSIV_A_PIN_IMU_INT_2.
+*
+* Parameters:
+*  cfg               The FIFO configuration
+*  callback          An optional function to call on the watermark interrupt
+*  callback_arg      Argument passed to the callback
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_motion_fifo_start(const shield_xensiv_a_motion_fifo_cfg_t* cfg,
+                                            shield_xensiv_a_motion_fifo_callback_t callback,
+                                            void* callback_arg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_motion_fifo_read
+******************************************************************************
+* Summary: Drains the BMI270 FIFO with a single burst I2C read and decodes it
+*          into timestamped frames. Frames which do not fit are left in the
+*          FIFO for the next call. Timestamps are derived from the time of the
+*          last watermark interrupt and the output data rate.
+*
+* Parameters:
+*  frames            Buffer receiving the decoded frames
+*  max_frames        Number of frames which fit into the buffer
+*  num_frames        Receives the number of frames written to the buffer
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_motion_fifo_read(shield_xensiv_a_motion_frame_t* frames,
+                                           uint16_t max_frames, uint16_t* num_frames);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_motion_fifo_stop
+******************************************************************************
+* Summary: Disables the FIFO mode and the watermark interrupt. This must be
+*          called before shield_xensiv_a_free() if the FIFO mode was started.
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_motion_fifo_stop(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
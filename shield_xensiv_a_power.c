@@ -0,0 +1,863 @@
+/******************************************************************************
+ * \file shield_xensiv_a_power.c
+ *
+ * Description: Implementation of the duty-cycling of the shield support
+ *              library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "shield_xensiv_a_power.h"
+#include "shield_xensiv_a_stream.h"
+#include "shield_xensiv_a_display.h"
+#include "shield_xensiv_a_i2c_sched.h"
+#include "shield_xensiv_a_metrics.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define US_PER_MS                  (1000UL)
+/* Time from enabling the BMI270 gyroscope to valid data */
+#define MOTION_STARTUP_MS          (50U)
+/* Time for a BMM350 forced measurement */
+#define MAG_MEAS_MS                (10U)
+/* Time from starting the DPS368 background mode to the first results */
+#define PRESSURE_STARTUP_MS        (40U)
+/* Time a sensor may take to deliver data once it is due */
+#define READ_TIMEOUT_MS            (100U)
+/* Time the ST7735S needs after leaving sleep before it is switched on */
+#define DISPLAY_WAKE_MS            (120U)
+
+/* ST7735S commands */
+#define ST7735S_CMD_SLPIN          (0x10U)
+#define ST7735S_CMD_SLPOUT         (0x11U)
+#define ST7735S_CMD_DISPOFF        (0x28U)
+#define ST7735S_CMD_DISPON         (0x29U)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+typedef enum
+{
+    _POWER_STATE_ASLEEP,
+    _POWER_STATE_AWAKE,
+    _POWER_STATE_READING
+} _shield_xensiv_a_power_state_t;
+
+typedef enum
+{
+    _DISPLAY_STATE_ON,
+    _DISPLAY_STATE_WAKING,
+    _DISPLAY_STATE_ASLEEP
+} _shield_xensiv_a_power_display_state_t;
+
+/* How a sensor is woken, read and suspended */
+typedef struct
+{
+    uint32_t    ready_bit;
+    cy_rslt_t   (*wake)(void);
+    /* Returns SHIELD_XENSIV_A_RSLT_PENDING while the data is not available */
+    cy_rslt_t   (*read)(void);
+    void        (*sleep)(void);
+    /* Time between wake and read */
+    uint32_t    lead_ms;
+    /* Time the sensor is awake for a sample, for the current estimate */
+    uint32_t    active_ms;
+    uint32_t    timeout_ms;
+    uint32_t    active_ua;
+    uint32_t    sleep_ua;
+} _shield_xensiv_a_power_sensor_t;
+
+/******************************************************************************
+* Function Prototypes
+******************************************************************************/
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+static cy_rslt_t _shield_xensiv_a_power_wake_humidity(void);
+static cy_rslt_t _shield_xensiv_a_power_read_humidity(void);
+static void _shield_xensiv_a_power_sleep_humidity(void);
+#endif
+#if SHIELD_XENSIV_A_USE_MOTION
+static cy_rslt_t _shield_xensiv_a_power_wake_motion(void);
+static cy_rslt_t _shield_xensiv_a_power_read_motion(void);
+static void _shield_xensiv_a_power_sleep_motion(void);
+#endif
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+static cy_rslt_t _shield_xensiv_a_power_wake_mag(void);
+static cy_rslt_t _shield_xensiv_a_power_read_mag(void);
+static void _shield_xensiv_a_power_sleep_mag(void);
+#endif
+#if SHIELD_XENSIV_A_USE_PRESSURE
+static cy_rslt_t _shield_xensiv_a_power_wake_pressure(void);
+static cy_rslt_t _shield_xensiv_a_power_read_pressure(void);
+static void _shield_xensiv_a_power_sleep_pressure(void);
+#endif
+#if SHIELD_XENSIV_A_USE_CO2
+static cy_rslt_t _shield_xensiv_a_power_wake_co2(void);
+static cy_rslt_t _shield_xensiv_a_power_read_co2(void);
+static void _shield_xensiv_a_power_sleep_co2(void);
+#endif
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+/* Entries of sensors whose support is compiled out stay empty */
+static const _shield_xensiv_a_power_sensor_t _power_sensors[SHIELD_XENSIV_A_POWER_SENSOR_COUNT] =
+{
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+    [SHIELD_XENSIV_A_POWER_HUMIDITY] =
+    {
+        .ready_bit  = SHIELD_XENSIV_A_READY_HUMIDITY,
+        .wake       = _shield_xensiv_a_power_wake_humidity,
+        .read       = _shield_xensiv_a_power_read_humidity,
+        .sleep      = _shield_xensiv_a_power_sleep_humidity,
+        .lead_ms    = SHIELD_XENSIV_A_SHT35_MEAS_MS,
+        .active_ms  = SHIELD_XENSIV_A_SHT35_MEAS_MS,
+        .timeout_ms = READ_TIMEOUT_MS,
+        .active_ua  = SHIELD_XENSIV_A_POWER_HUMIDITY_ACTIVE_UA,
+        .sleep_ua   = SHIELD_XENSIV_A_POWER_HUMIDITY_SLEEP_UA
+    },
+#endif
+#if SHIELD_XENSIV_A_USE_MOTION
+    [SHIELD_XENSIV_A_POWER_MOTION] =
+    {
+        .ready_bit  = SHIELD_XENSIV_A_READY_MOTION,
+        .wake       = _shield_xensiv_a_power_wake_motion,
+        .read       = _shield_xensiv_a_power_read_motion,
+        .sleep      = _shield_xensiv_a_power_sleep_motion,
+        .lead_ms    = MOTION_STARTUP_MS,
+        .active_ms  = MOTION_STARTUP_MS,
+        .timeout_ms = READ_TIMEOUT_MS,
+        .active_ua  = SHIELD_XENSIV_A_POWER_MOTION_ACTIVE_UA,
+        .sleep_ua   = SHIELD_XENSIV_A_POWER_MOTION_SLEEP_UA
+    },
+#endif
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+    [SHIELD_XENSIV_A_POWER_MAGNETOMETER] =
+    {
+        .ready_bit  = SHIELD_XENSIV_A_READY_MAGNETOMETER,
+        .wake       = _shield_xensiv_a_power_wake_mag,
+        .read       = _shield_xensiv_a_power_read_mag,
+        .sleep      = _shield_xensiv_a_power_sleep_mag,
+        .lead_ms    = MAG_MEAS_MS,
+        .active_ms  = MAG_MEAS_MS,
+        .timeout_ms = READ_TIMEOUT_MS,
+        .active_ua  = SHIELD_XENSIV_A_POWER_MAG_ACTIVE_UA,
+        .sleep_ua   = SHIELD_XENSIV_A_POWER_MAG_SLEEP_UA
+    },
+#endif
+#if SHIELD_XENSIV_A_USE_PRESSURE
+    [SHIELD_XENSIV_A_POWER_PRESSURE] =
+    {
+        .ready_bit  = SHIELD_XENSIV_A_READY_PRESSURE,
+        .wake       = _shield_xensiv_a_power_wake_pressure,
+        .read       = _shield_xensiv_a_power_read_pressure,
+        .sleep      = _shield_xensiv_a_power_sleep_pressure,
+        .lead_ms    = PRESSURE_STARTUP_MS,
+        .active_ms  = PRESSURE_STARTUP_MS,
+        .timeout_ms = READ_TIMEOUT_MS,
+        .active_ua  = SHIELD_XENSIV_A_POWER_PRESSURE_ACTIVE_UA,
+        .sleep_ua   = SHIELD_XENSIV_A_POWER_PRESSURE_SLEEP_UA
+    },
+#endif
+#if SHIELD_XENSIV_A_USE_CO2
+    [SHIELD_XENSIV_A_POWER_CO2] =
+    {
+        .ready_bit  = SHIELD_XENSIV_A_READY_CO2,
+        .wake       = _shield_xensiv_a_power_wake_co2,
+        .read       = _shield_xensiv_a_power_read_co2,
+        .sleep      = _shield_xensiv_a_power_sleep_co2,
+        .lead_ms    = SHIELD_XENSIV_A_CO2_WARMUP_MS,
+        .active_ms  = SHIELD_XENSIV_A_CO2_WARMUP_MS + SHIELD_XENSIV_A_POWER_CO2_MEAS_MS,
+        .timeout_ms = SHIELD_XENSIV_A_CO2_READY_TIMEOUT_MS + SHIELD_XENSIV_A_POWER_CO2_MEAS_MS,
+        .active_ua  = SHIELD_XENSIV_A_POWER_CO2_ACTIVE_UA,
+        .sleep_ua   = 0
+    }
+#endif
+};
+
+static shield_xensiv_a_power_cfg_t              _power_cfg;
+static shield_xensiv_a_power_callback_t         _power_callback;
+static void*                                    _power_callback_arg;
+static bool                                     _power_running;
+static _shield_xensiv_a_power_state_t           _power_states[SHIELD_XENSIV_A_POWER_SENSOR_COUNT];
+static uint32_t                                 _power_due_ms[SHIELD_XENSIV_A_POWER_SENSOR_COUNT];
+
+/* Millisecond time base extended from the microsecond timestamps, so that
+   periods longer than the timestamp wrap-around work */
+static uint32_t                                 _power_now_ms;
+static uint32_t                                 _power_last_us;
+
+#if SHIELD_XENSIV_A_USE_CO2
+static bool                                     _power_co2_measuring;
+#endif
+
+static _shield_xensiv_a_power_display_state_t   _power_display_state;
+static uint32_t                                 _power_display_since_ms;
+
+
+/******************************************************************************
+* _shield_xensiv_a_power_update_time
+******************************************************************************/
+static uint32_t _shield_xensiv_a_power_update_time(void)
+{
+    uint32_t now_us = shield_xensiv_a_get_timestamp_us();
+    uint32_t elapsed_ms = (now_us - _power_last_us) / US_PER_MS;
+
+    /* Keep the remainder for the next update */
+    _power_last_us += elapsed_ms * US_PER_MS;
+    _power_now_ms += elapsed_ms;
+
+    return _power_now_ms;
+}
+
+
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+/******************************************************************************
+* _shield_xensiv_a_power_wake_humidity
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_power_wake_humidity(void)
+{
+    /* Restarts the periodic measurement of the driver, the first result is
+       available after one measurement */
+    cy_rslt_t result = mtb_sht3x_init(shield_xensiv_a_get_humidity_sensor(),
+                                      MTB_SHT35_ADDRESS_DEFAULT);
+
+    return (CY_RSLT_SUCCESS == result) ? CY_RSLT_SUCCESS : SHIELD_XENSIV_A_RSLT_ERR_SENSOR;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_power_read_humidity
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_power_read_humidity(void)
+{
+    return shield_xensiv_a_stream_capture(SHIELD_XENSIV_A_READY_HUMIDITY);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_power_sleep_humidity
+******************************************************************************/
+static void _shield_xensiv_a_power_sleep_humidity(void)
+{
+    /* Without the periodic measurement the sensor stays idle */
+    (void)shield_xensiv_a_sht35_command(SHIELD_XENSIV_A_SHT35_CMD_BREAK);
+}
+#endif
+
+
+#if SHIELD_XENSIV_A_USE_MOTION
+/******************************************************************************
+* _shield_xensiv_a_power_wake_motion
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_power_wake_motion(void)
+{
+    static const uint8_t sensors[] = { BMI2_ACCEL, BMI2_GYRO };
+    struct bmi2_dev* dev = &shield_xensiv_a_get_motion_sensor()->sensor;
+
+    /* The configuration can only be changed with advanced power save off */
+    int8_t rslt = bmi2_set_adv_power_save(BMI2_DISABLE, dev);
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi2_sensor_enable(sensors, sizeof(sensors), dev);
+    }
+
+    return (BMI2_OK == rslt) ? CY_RSLT_SUCCESS : SHIELD_XENSIV_A_RSLT_ERR_SENSOR;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_power_read_motion
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_power_read_motion(void)
+{
+    return shield_xensiv_a_stream_capture(SHIELD_XENSIV_A_READY_MOTION);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_power_sleep_motion
+******************************************************************************/
+static void _shield_xensiv_a_power_sleep_motion(void)
+{
+    static const uint8_t sensors[] = { BMI2_ACCEL, BMI2_GYRO };
+    struct bmi2_dev* dev = &shield_xensiv_a_get_motion_sensor()->sensor;
+
+    (void)bmi2_sensor_disable(sensors, sizeof(sensors), dev);
+    (void)bmi2_set_adv_power_save(BMI2_ENABLE, dev);
+}
+#endif
+
+
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+/******************************************************************************
+* _shield_xensiv_a_power_wake_mag
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_power_wake_mag(void)
+{
+    /* A forced measurement returns to suspend mode by itself */
+    int8_t rslt = bmm350_set_powermode(BMM350_FORCED_MODE,
+                                       &shield_xensiv_a_get_mag_sensor()->sensor);
+
+    return (BMM350_OK == rslt) ? CY_RSLT_SUCCESS : SHIELD_XENSIV_A_RSLT_ERR_SENSOR;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_power_read_mag
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_power_read_mag(void)
+{
+    return shield_xensiv_a_stream_capture(SHIELD_XENSIV_A_READY_MAGNETOMETER);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_power_sleep_mag
+******************************************************************************/
+static void _shield_xensiv_a_power_sleep_mag(void)
+{
+    (void)bmm350_set_powermode(BMM350_SUSPEND_MODE, &shield_xensiv_a_get_mag_sensor()->sensor);
+}
+#endif
+
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+/******************************************************************************
+* _shield_xensiv_a_power_set_pressure_mode
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_power_set_pressure_mode(xensiv_dps3xx_mode_t mode)
+{
+    xensiv_dps3xx_config_t config;
+    cy_rslt_t result = xensiv_dps3xx_get_config(shield_xensiv_a_get_pressure_sensor(), &config);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        config.dev_mode = mode;
+        result = xensiv_dps3xx_set_config(shield_xensiv_a_get_pressure_sensor(), &config);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_power_wake_pressure
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_power_wake_pressure(void)
+{
+    return _shield_xensiv_a_power_set_pressure_mode(XENSIV_DPS3XX_MODE_BACKGROUND_ALL);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_power_read_pressure
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_power_read_pressure(void)
+{
+    return shield_xensiv_a_stream_capture(SHIELD_XENSIV_A_READY_PRESSURE);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_power_sleep_pressure
+******************************************************************************/
+static void _shield_xensiv_a_power_sleep_pressure(void)
+{
+    (void)_shield_xensiv_a_power_set_pressure_mode(XENSIV_DPS3XX_MODE_IDLE);
+}
+#endif
+
+
+#if SHIELD_XENSIV_A_USE_CO2
+/******************************************************************************
+* _shield_xensiv_a_power_wake_co2
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_power_wake_co2(void)
+{
+    /* The sensor is set up once the warm-up time has passed, in the read */
+    _power_co2_measuring = false;
+    cyhal_gpio_write(shield_xensiv_a_get_pins()->co2_pwr_en, true);
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_power_read_co2
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_power_read_co2(void)
+{
+    cy_rslt_t result = SHIELD_XENSIV_A_RSLT_PENDING;
+    xensiv_pasco2_t* sensor = shield_xensiv_a_get_co2_sensor();
+
+    if (!_power_co2_measuring)
+    {
+        /* The sensor lost its state while unpowered. Until it responds, keep
+           trying until the read times out. */
+        if ((CY_RSLT_SUCCESS == xensiv_pasco2_mtb_init_i2c(sensor, shield_xensiv_a_get_i2c())) &&
+            (XENSIV_PASCO2_OK == xensiv_pasco2_start_single_mode(sensor)))
+        {
+            _power_co2_measuring = true;
+        }
+    }
+    else
+    {
+        uint16_t ppm;
+        SHIELD_XENSIV_A_METRICS_BEGIN(start_us);
+        cy_rslt_t co2_result = xensiv_pasco2_get_result(sensor, &ppm);
+        SHIELD_XENSIV_A_METRICS_END(SHIELD_XENSIV_A_METRICS_CO2, start_us,
+                                    SHIELD_XENSIV_A_METRICS_PASCO2_BYTES,
+                                    (XENSIV_PASCO2_READ_NRDY == co2_result)
+                                    ? CY_RSLT_SUCCESS
+                                    : co2_result);
+
+        if (XENSIV_PASCO2_OK == co2_result)
+        {
+            int32_t values[3] = { ppm, 0, 0 };
+            (void)shield_xensiv_a_stream_put(SHIELD_XENSIV_A_SENSOR_CO2,
+                                             shield_xensiv_a_get_timestamp_us(), values);
+            result = CY_RSLT_SUCCESS;
+        }
+        else if (XENSIV_PASCO2_READ_NRDY != co2_result)
+        {
+            result = co2_result;
+        }
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_power_sleep_co2
+******************************************************************************/
+static void _shield_xensiv_a_power_sleep_co2(void)
+{
+    _power_co2_measuring = false;
+    cyhal_gpio_write(shield_xensiv_a_get_pins()->co2_pwr_en, false);
+}
+#endif
+
+
+/******************************************************************************
+* _shield_xensiv_a_power_finish
+******************************************************************************/
+static void _shield_xensiv_a_power_finish(shield_xensiv_a_power_sensor_t sensor,
+                                          cy_rslt_t result, uint32_t now_ms)
+{
+    const _shield_xensiv_a_power_sensor_t* desc = &_power_sensors[sensor];
+
+    if (NULL != desc->sleep)
+    {
+        desc->sleep();
+    }
+    _power_states[sensor] = _POWER_STATE_ASLEEP;
+
+    /* Stay on the period grid, unless samples were missed entirely */
+    _power_due_ms[sensor] += _power_cfg.period_ms[sensor];
+    if ((int32_t)(_power_due_ms[sensor] - (now_ms + desc->lead_ms)) < 0)
+    {
+        _power_due_ms[sensor] = now_ms + desc->lead_ms;
+    }
+
+    if (NULL != _power_callback)
+    {
+        _power_callback(sensor, result, _power_callback_arg);
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_power_display_command
+******************************************************************************/
+/* Returns false if the SPI bus is in use, e.g. by the radar sensor */
+static bool _shield_xensiv_a_power_display_command(uint8_t first, uint8_t second)
+{
+#if SHIELD_XENSIV_A_USE_DISPLAY
+    bool sent = (CY_RSLT_SUCCESS == shield_xensiv_a_spi_acquire(SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY));
+
+    if (sent)
+    {
+        mtb_st7735s_write_command(first);
+        if (0U != second)
+        {
+            mtb_st7735s_write_command(second);
+        }
+        shield_xensiv_a_spi_release(SHIELD_XENSIV_A_SPI_DEVICE_DISPLAY);
+    }
+
+    return sent;
+#else
+    (void)first;
+    (void)second;
+    return false;
+#endif
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_power_process_display
+******************************************************************************/
+static uint32_t _shield_xensiv_a_power_process_display(uint32_t now_ms)
+{
+    uint32_t wait_ms = UINT32_MAX;
+    uint32_t elapsed_ms = now_ms - _power_display_since_ms;
+
+    if (_DISPLAY_STATE_WAKING == _power_display_state)
+    {
+        if (elapsed_ms < DISPLAY_WAKE_MS)
+        {
+            wait_ms = DISPLAY_WAKE_MS - elapsed_ms;
+        }
+        else if (_shield_xensiv_a_power_display_command(ST7735S_CMD_DISPON, 0U))
+        {
+            _power_display_state = _DISPLAY_STATE_ON;
+            _power_display_since_ms = now_ms;
+            elapsed_ms = 0;
+        }
+        else
+        {
+            wait_ms = SHIELD_XENSIV_A_POWER_POLL_MS;
+        }
+    }
+
+    if ((_DISPLAY_STATE_ON == _power_display_state) && (0U != _power_cfg.display_idle_ms))
+    {
+        if ((elapsed_ms >= _power_cfg.display_idle_ms) && !shield_xensiv_a_display_is_busy() &&
+            _shield_xensiv_a_power_display_command(ST7735S_CMD_DISPOFF, ST7735S_CMD_SLPIN))
+        {
+            _power_display_state = _DISPLAY_STATE_ASLEEP;
+        }
+        else
+        {
+            wait_ms = (elapsed_ms < _power_cfg.display_idle_ms)
+                ? (_power_cfg.display_idle_ms - elapsed_ms)
+                : SHIELD_XENSIV_A_POWER_POLL_MS;
+        }
+    }
+
+    return wait_ms;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_power_start
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_power_start(const shield_xensiv_a_power_cfg_t* cfg,
+                                      shield_xensiv_a_power_callback_t callback,
+                                      void* callback_arg)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t required = 0;
+
+    if ((NULL == cfg) || _power_running)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else
+    {
+        for (uint8_t i = 0; i < SHIELD_XENSIV_A_POWER_SENSOR_COUNT; i++)
+        {
+            if (0U != cfg->period_ms[i])
+            {
+                required |= _power_sensors[i].ready_bit;
+                if (NULL == _power_sensors[i].read)
+                {
+                    result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+                }
+            }
+        }
+        if (0U != cfg->display_idle_ms)
+        {
+            required |= SHIELD_XENSIV_A_READY_DISPLAY;
+        }
+        if ((shield_xensiv_a_get_ready_mask() & required) != required)
+        {
+            result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+        }
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = shield_xensiv_a_i2c_sched_acquire();
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        uint32_t ready_mask = shield_xensiv_a_get_ready_mask();
+
+        _power_cfg = *cfg;
+        _power_callback = callback;
+        _power_callback_arg = callback_arg;
+        _power_last_us = shield_xensiv_a_get_timestamp_us();
+        _power_now_ms = 0;
+        _power_display_state = _DISPLAY_STATE_ON;
+        _power_display_since_ms = 0;
+
+        for (uint8_t i = 0; i < SHIELD_XENSIV_A_POWER_SENSOR_COUNT; i++)
+        {
+            const _shield_xensiv_a_power_sensor_t* desc = &_power_sensors[i];
+            if ((NULL != desc->sleep) && ((ready_mask & desc->ready_bit) != 0))
+            {
+                desc->sleep();
+            }
+            _power_states[i] = _POWER_STATE_ASLEEP;
+            /* The first sample is taken as soon as the sensor is ready */
+            _power_due_ms[i] = desc->lead_ms;
+        }
+        shield_xensiv_a_i2c_sched_release();
+        _power_running = true;
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_power_process
+******************************************************************************/
+uint32_t shield_xensiv_a_power_process(void)
+{
+    uint32_t wait_ms = UINT32_MAX;
+
+    if (_power_running)
+    {
+        uint32_t now_ms = _shield_xensiv_a_power_update_time();
+
+        /* While a scheduled transaction is on the bus the sensors wait for a later call */
+        if (CY_RSLT_SUCCESS != shield_xensiv_a_i2c_sched_acquire())
+        {
+            wait_ms = SHIELD_XENSIV_A_POWER_POLL_MS;
+        }
+        else
+        {
+            for (uint8_t i = 0; i < SHIELD_XENSIV_A_POWER_SENSOR_COUNT; i++)
+            {
+                const _shield_xensiv_a_power_sensor_t* desc = &_power_sensors[i];
+                shield_xensiv_a_power_sensor_t sensor = (shield_xensiv_a_power_sensor_t)i;
+                int32_t until_due_ms = (int32_t)(_power_due_ms[i] - now_ms);
+                uint32_t sensor_wait_ms = UINT32_MAX;
+                bool enabled = (0U != _power_cfg.period_ms[i]);
+
+                if (enabled && (_POWER_STATE_ASLEEP == _power_states[i]) &&
+                    (until_due_ms <= (int32_t)desc->lead_ms))
+                {
+                    cy_rslt_t result = (NULL != desc->wake) ? desc->wake() : CY_RSLT_SUCCESS;
+                    if (CY_RSLT_SUCCESS == result)
+                    {
+                        _power_states[i] = _POWER_STATE_AWAKE;
+                    }
+                    else
+                    {
+                        _shield_xensiv_a_power_finish(sensor, result, now_ms);
+                    }
+                }
+
+                if ((_POWER_STATE_AWAKE == _power_states[i]) && (until_due_ms <= 0))
+                {
+                    _power_states[i] = _POWER_STATE_READING;
+                }
+
+                if (_POWER_STATE_READING == _power_states[i])
+                {
+                    cy_rslt_t result = desc->read();
+                    if (SHIELD_XENSIV_A_RSLT_PENDING != result)
+                    {
+                        _shield_xensiv_a_power_finish(sensor, result, now_ms);
+                    }
+                    else if ((uint32_t)(-until_due_ms) >= desc->timeout_ms)
+                    {
+                        _shield_xensiv_a_power_finish(sensor, SHIELD_XENSIV_A_RSLT_ERR_TIMEOUT,
+                                                      now_ms);
+                    }
+                    else
+                    {
+                        sensor_wait_ms = SHIELD_XENSIV_A_POWER_POLL_MS;
+                    }
+                }
+
+                until_due_ms = (int32_t)(_power_due_ms[i] - now_ms);
+                if (!enabled)
+                {
+                    sensor_wait_ms = UINT32_MAX;
+                }
+                else if (_POWER_STATE_ASLEEP == _power_states[i])
+                {
+                    sensor_wait_ms = (until_due_ms > (int32_t)desc->lead_ms)
+                        ? ((uint32_t)until_due_ms - desc->lead_ms)
+                        : 0U;
+                }
+                else if (_POWER_STATE_AWAKE == _power_states[i])
+                {
+                    sensor_wait_ms = (until_due_ms > 0) ? (uint32_t)until_due_ms : 0U;
+                }
+
+                if (sensor_wait_ms < wait_ms)
+                {
+                    wait_ms = sensor_wait_ms;
+                }
+            }
+            shield_xensiv_a_i2c_sched_release();
+        }
+
+        uint32_t display_wait_ms = _shield_xensiv_a_power_process_display(now_ms);
+        if (display_wait_ms < wait_ms)
+        {
+            wait_ms = display_wait_ms;
+        }
+    }
+
+    return wait_ms;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_power_display_activity
+******************************************************************************/
+void shield_xensiv_a_power_display_activity(void)
+{
+    if (_power_running)
+    {
+        uint32_t now_ms = _shield_xensiv_a_power_update_time();
+
+        if ((_DISPLAY_STATE_ASLEEP == _power_display_state) &&
+            _shield_xensiv_a_power_display_command(ST7735S_CMD_SLPOUT, 0U))
+        {
+            _power_display_state = _DISPLAY_STATE_WAKING;
+        }
+        _power_display_since_ms = now_ms;
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_power_estimate_ua
+******************************************************************************/
+uint32_t shield_xensiv_a_power_estimate_ua(const shield_xensiv_a_power_cfg_t* cfg)
+{
+    uint32_t current_ua = 0;
+
+    if (NULL != cfg)
+    {
+        for (uint8_t i = 0; i < SHIELD_XENSIV_A_POWER_SENSOR_COUNT; i++)
+        {
+            const _shield_xensiv_a_power_sensor_t* desc = &_power_sensors[i];
+            uint32_t period_ms = cfg->period_ms[i];
+
+            current_ua += desc->sleep_ua;
+            if (0U != period_ms)
+            {
+                uint32_t active_ms = (desc->active_ms < period_ms) ? desc->active_ms : period_ms;
+                current_ua += (uint32_t)(((uint64_t)(desc->active_ua - desc->sleep_ua) *
+                                          active_ms) / period_ms);
+            }
+        }
+
+        current_ua += (0U != cfg->display_idle_ms)
+            ? SHIELD_XENSIV_A_POWER_DISPLAY_SLEEP_UA
+            : SHIELD_XENSIV_A_POWER_DISPLAY_ON_UA;
+    }
+
+    return current_ua;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_power_stop
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_power_stop(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (_power_running)
+    {
+        result = shield_xensiv_a_i2c_sched_acquire();
+    }
+
+    if (_power_running && (CY_RSLT_SUCCESS == result))
+    {
+        uint32_t ready_mask = shield_xensiv_a_get_ready_mask();
+        (void)ready_mask;
+        _power_running = false;
+
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+        if ((ready_mask & SHIELD_XENSIV_A_READY_HUMIDITY) != 0)
+        {
+            (void)_shield_xensiv_a_power_wake_humidity();
+        }
+#endif
+#if SHIELD_XENSIV_A_USE_MOTION
+        if ((ready_mask & SHIELD_XENSIV_A_READY_MOTION) != 0)
+        {
+            (void)_shield_xensiv_a_power_wake_motion();
+        }
+#endif
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+        if ((ready_mask & SHIELD_XENSIV_A_READY_MAGNETOMETER) != 0)
+        {
+            (void)bmm350_set_powermode(BMM350_NORMAL_MODE,
+                                       &shield_xensiv_a_get_mag_sensor()->sensor);
+        }
+#endif
+#if SHIELD_XENSIV_A_USE_PRESSURE
+        if ((ready_mask & SHIELD_XENSIV_A_READY_PRESSURE) != 0)
+        {
+            (void)_shield_xensiv_a_power_wake_pressure();
+        }
+#endif
+#if SHIELD_XENSIV_A_USE_CO2
+        if ((ready_mask & SHIELD_XENSIV_A_READY_CO2) != 0)
+        {
+            /* The sensor was left in single mode or unpowered, so it is set
+               up for continuous operation again like at initialization */
+            _power_co2_measuring = false;
+            (void)shield_xensiv_a_reinit(SHIELD_XENSIV_A_READY_CO2);
+        }
+#endif
+        shield_xensiv_a_i2c_sched_release();
+
+        if (_DISPLAY_STATE_ASLEEP == _power_display_state)
+        {
+            (void)_shield_xensiv_a_power_display_command(ST7735S_CMD_SLPOUT, 0U);
+            cyhal_system_delay_ms(DISPLAY_WAKE_MS);
+        }
+        if (_DISPLAY_STATE_ON != _power_display_state)
+        {
+            (void)_shield_xensiv_a_power_display_command(ST7735S_CMD_DISPON, 0U);
+        }
+        _power_callback = NULL;
+    }
+
+    return result;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
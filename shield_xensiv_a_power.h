@@ -0,0 +1,228 @@
+/******************************************************************************
+ * \file shield_xensiv_a_power.h
+ *
+ * Description: This file is the interface for the duty-cycling of the sensors
+ *              and the display on the SHIELD_XENSIV_A shield board.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#ifndef SHIELD_XENSIV_A_POWER_CO2_MEAS_MS
+/** Duration of a single CO2 measurement after it was triggered */
+#define SHIELD_XENSIV_A_POWER_CO2_MEAS_MS           (1150U)
+#endif
+
+#ifndef SHIELD_XENSIV_A_POWER_POLL_MS
+/** Interval at which a measurement in progress is polled */
+#define SHIELD_XENSIV_A_POWER_POLL_MS               (50U)
+#endif
+
+/* Typical supply currents used by shield_xensiv_a_power_estimate_ua(). The
+ * values are approximations from the sensor datasheets and can be replaced
+ * with measured values of the actual board. */
+#ifndef SHIELD_XENSIV_A_POWER_HUMIDITY_ACTIVE_UA
+/** SHT35 current while measuring */
+#define SHIELD_XENSIV_A_POWER_HUMIDITY_ACTIVE_UA    (800U)
+#endif
+#ifndef SHIELD_XENSIV_A_POWER_HUMIDITY_SLEEP_UA
+/** SHT35 current with the periodic measurement stopped */
+#define SHIELD_XENSIV_A_POWER_HUMIDITY_SLEEP_UA     (2U)
+#endif
+#ifndef SHIELD_XENSIV_A_POWER_MOTION_ACTIVE_UA
+/** BMI270 current with accelerometer and gyroscope enabled */
+#define SHIELD_XENSIV_A_POWER_MOTION_ACTIVE_UA      (685U)
+#endif
+#ifndef SHIELD_XENSIV_A_POWER_MOTION_SLEEP_UA
+/** BMI270 current in advanced power save with both sensors disabled */
+#define SHIELD_XENSIV_A_POWER_MOTION_SLEEP_UA       (4U)
+#endif
+#ifndef SHIELD_XENSIV_A_POWER_MAG_ACTIVE_UA
+/** BMM350 current during a forced measurement */
+#define SHIELD_XENSIV_A_POWER_MAG_ACTIVE_UA         (200U)
+#endif
+#ifndef SHIELD_XENSIV_A_POWER_MAG_SLEEP_UA
+/** BMM350 current in suspend mode */
+#define SHIELD_XENSIV_A_POWER_MAG_SLEEP_UA          (1U)
+#endif
+#ifndef SHIELD_XENSIV_A_POWER_PRESSURE_ACTIVE_UA
+/** DPS368 current while measuring */
+#define SHIELD_XENSIV_A_POWER_PRESSURE_ACTIVE_UA    (350U)
+#endif
+#ifndef SHIELD_XENSIV_A_POWER_PRESSURE_SLEEP_UA
+/** DPS368 current in standby */
+#define SHIELD_XENSIV_A_POWER_PRESSURE_SLEEP_UA     (1U)
+#endif
+#ifndef SHIELD_XENSIV_A_POWER_CO2_ACTIVE_UA
+/** PAS CO2 average current while powered */
+#define SHIELD_XENSIV_A_POWER_CO2_ACTIVE_UA         (8000U)
+#endif
+#ifndef SHIELD_XENSIV_A_POWER_DISPLAY_ON_UA
+/** Display module current while on */
+#define SHIELD_XENSIV_A_POWER_DISPLAY_ON_UA         (3000U)
+#endif
+#ifndef SHIELD_XENSIV_A_POWER_DISPLAY_SLEEP_UA
+/** Display module current in sleep mode */
+#define SHIELD_XENSIV_A_POWER_DISPLAY_SLEEP_UA      (10U)
+#endif
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Sensors managed by the duty-cycling */
+typedef enum
+{
+    SHIELD_XENSIV_A_POWER_HUMIDITY,         /**< SHT35 */
+    SHIELD_XENSIV_A_POWER_MOTION,           /**< BMI270 */
+    SHIELD_XENSIV_A_POWER_MAGNETOMETER,     /**< BMM350 */
+    SHIELD_XENSIV_A_POWER_PRESSURE,         /**< DPS368 */
+    SHIELD_XENSIV_A_POWER_CO2,              /**< PAS CO2, switched with SHIELD_XENSIV_A_PIN_CO2_PWR_EN */
+    SHIELD_XENSIV_A_POWER_SENSOR_COUNT      /**< Number of sensors */
+} shield_xensiv_a_power_sensor_t;
+
+/** Duty-cycling configuration */
+typedef struct
+{
+    /** Sample period of each sensor, 0 keeps the sensor in its lowest power
+     * state without sampling it */
+    uint32_t    period_ms[SHIELD_XENSIV_A_POWER_SENSOR_COUNT];
+    /** Time without display activity after which the display is put to
+     * sleep, 0 to leave it on */
+    uint32_t    display_idle_ms;
+} shield_xensiv_a_power_cfg_t;
+
+/** Callback invoked from shield_xensiv_a_power_process() after a sample was
+ * taken. The sample itself is pushed to the ring attached with
+ * shield_xensiv_a_stream_attach(). It is called with the I2C bus reserved,
+ * so it must not read the sensors through the cache or the snapshot. */
+typedef void (*shield_xensiv_a_power_callback_t)(shield_xensiv_a_power_sensor_t sensor,
+                                                 cy_rslt_t result, void* callback_arg);
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_power_start
+******************************************************************************
+* Summary: Puts the configured sensors into their low power states and starts
+*          sampling them at their periods. While running, the sensors must
+*          not be accessed by other parts of the application. The sensors are
+*          accessed with the I2C bus reserved.
+*
+* Parameters:
+*  cfg               The duty-cycling configuration
+*  callback          An optional function to call after each sample
+*  callback_arg      Argument passed to the callback
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_BUSY while a scheduled
+*  transaction is on the I2C bus
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_power_start(const shield_xensiv_a_power_cfg_t* cfg,
+                                      shield_xensiv_a_power_callback_t callback,
+                                      void* callback_arg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_power_process
+******************************************************************************
+* Summary: Wakes, samples and suspends the sensors which are due. Must be
+*          called at least as often as the value it returns, which allows the
+*          application to sleep in between. While a scheduled transaction is
+*          on the I2C bus, the sensors are left for a call after
+*          SHIELD_XENSIV_A_POWER_POLL_MS.
+*
+* Parameters: None
+*
+* Return:
+*  Time in ms until the next call is needed
+*
+******************************************************************************/
+uint32_t shield_xensiv_a_power_process(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_power_display_activity
+******************************************************************************
+* Summary: Restarts the display idle time, and wakes the display if it was put
+*          to sleep. The display accepts drawing again about 120 ms later,
+*          once shield_xensiv_a_power_process() switched it on.
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_power_display_activity(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_power_estimate_ua
+******************************************************************************
+* Summary: Estimates the average supply current of the shield sensors and the
+*          display for a configuration, assuming the display stays idle.
+*
+* Parameters:
+*  cfg               The duty-cycling configuration
+*
+* Return:
+*  The estimated average current in µA
+*
+******************************************************************************/
+uint32_t shield_xensiv_a_power_estimate_ua(const shield_xensiv_a_power_cfg_t* cfg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_power_stop
+******************************************************************************
+* Summary: Stops the duty-cycling and returns the sensors and the display to
+*          continuous operation. The CO2 sensor is reinitialized with
+*          shield_xensiv_a_reinit(), so it is missing from the ready mask
+*          until shield_xensiv_a_init_poll() stops returning
+*          SHIELD_XENSIV_A_RSLT_PENDING.
+*
+* Parameters: None
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_BUSY if the duty-cycling
+*  keeps running because a scheduled transaction is on the I2C bus
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_power_stop(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,476 @@
+/******************************************************************************
+ * \file shield_xensiv_a_radar.c
+ *
+ * Description: Implementation of the BGT60LTR11 radar sensor support of the
+ *              shield support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "shield_xensiv_a_radar.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Time the radar reset is held active */
+#define RADAR_RESET_MS             (1U)
+/* Bit in the first byte of an SPI frame selecting a register write */
+#define RADAR_SPI_WRITE            (0x01U)
+/* Length of an SPI frame: address with R/W bit and 16 data bits */
+#define RADAR_SPI_FRAME_BYTES      (3U)
+/* Highest register address */
+#define RADAR_REG_MAX              (0x7FU)
+/* Minimum acquisition time of the IF signal channels */
+#define RADAR_ADC_ACQUISITION_NS   (1000U)
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static shield_xensiv_a_radar_callback_t         _radar_callback;
+static void*                                    _radar_callback_arg;
+static uint8_t                                  _radar_intr_priority;
+static bool                                     _radar_initialized;
+static cyhal_gpio_callback_data_t               _radar_tdet_callback_data;
+static cyhal_gpio_callback_data_t               _radar_pdet_callback_data;
+
+static cyhal_adc_t                              _radar_adc;
+static cyhal_adc_channel_t                      _radar_adc_channels[SHIELD_XENSIV_A_RADAR_IF_CHANNELS];
+static bool                                     _radar_adc_initialized;
+static uint8_t                                  _radar_adc_channel_count;
+static volatile bool                            _radar_capture_busy;
+static shield_xensiv_a_radar_capture_callback_t _radar_capture_callback;
+static void*                                    _radar_capture_callback_arg;
+
+
+/******************************************************************************
+* _shield_xensiv_a_radar_direction
+******************************************************************************/
+static shield_xensiv_a_radar_event_t _shield_xensiv_a_radar_direction(void)
+{
+    return (SHIELD_XENSIV_A_RADAR_PDET_APPROACHING ==
+            cyhal_gpio_read(shield_xensiv_a_get_pins()->radar_gpio1))
+        ? SHIELD_XENSIV_A_RADAR_EVENT_APPROACHING
+        : SHIELD_XENSIV_A_RADAR_EVENT_DEPARTING;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_radar_tdet_handler
+******************************************************************************/
+static void _shield_xensiv_a_radar_tdet_handler(void* callback_arg, cyhal_gpio_event_t event)
+{
+    (void)callback_arg;
+    (void)event;
+
+    if (NULL != _radar_callback)
+    {
+        uint32_t timestamp_us = shield_xensiv_a_get_timestamp_us();
+
+        if (shield_xensiv_a_radar_is_present())
+        {
+            _radar_callback(SHIELD_XENSIV_A_RADAR_EVENT_PRESENCE, timestamp_us,
+                            _radar_callback_arg);
+            _radar_callback(_shield_xensiv_a_radar_direction(), timestamp_us,
+                            _radar_callback_arg);
+        }
+        else
+        {
+            _radar_callback(SHIELD_XENSIV_A_RADAR_EVENT_ABSENCE, timestamp_us,
+                            _radar_callback_arg);
+        }
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_radar_pdet_handler
+******************************************************************************/
+static void _shield_xensiv_a_radar_pdet_handler(void* callback_arg, cyhal_gpio_event_t event)
+{
+    (void)callback_arg;
+    (void)event;
+
+    /* The direction output is only meaningful while a target is detected */
+    if ((NULL != _radar_callback) && shield_xensiv_a_radar_is_present())
+    {
+        _radar_callback(_shield_xensiv_a_radar_direction(), shield_xensiv_a_get_timestamp_us(),
+                        _radar_callback_arg);
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_radar_adc_event
+******************************************************************************/
+static void _shield_xensiv_a_radar_adc_event(void* callback_arg, cyhal_adc_event_t event)
+{
+    (void)callback_arg;
+
+    if ((event & CYHAL_ADC_ASYNC_READ_COMPLETE) != 0)
+    {
+        _radar_capture_busy = false;
+        if (NULL != _radar_capture_callback)
+        {
+            _radar_capture_callback(CY_RSLT_SUCCESS, _radar_capture_callback_arg);
+        }
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_radar_init_adc
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_radar_init_adc(void)
+{
+    static const cyhal_adc_config_t adc_config =
+    {
+        .continuous_scanning = true,
+        .average_count       = 1,
+        .vref                = CYHAL_ADC_REF_VDDA,
+        .vneg                = CYHAL_ADC_VNEG_VSSA,
+        .enable_vref_bypass  = false,
+        .ext_vref            = NC,
+        .ext_vref_mv         = 0,
+        .bypass_pin          = NC,
+        .resolution          = 12
+    };
+    static const cyhal_adc_channel_config_t channel_config =
+    {
+        .enabled            = true,
+        .enable_averaging   = false,
+        .min_acquisition_ns = RADAR_ADC_ACQUISITION_NS
+    };
+
+    const shield_xensiv_a_pins_t* pins = shield_xensiv_a_get_pins();
+
+    cy_rslt_t result = cyhal_adc_init(&_radar_adc, pins->radar_adc1, NULL);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        _radar_adc_initialized = true;
+        result = cyhal_adc_configure(&_radar_adc, &adc_config);
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cyhal_adc_channel_init_diff(&_radar_adc_channels[0], &_radar_adc,
+                                             pins->radar_adc1, CYHAL_ADC_VNEG,
+                                             &channel_config);
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        _radar_adc_channel_count = 1;
+        result = cyhal_adc_channel_init_diff(&_radar_adc_channels[1], &_radar_adc,
+                                             pins->radar_adc2, CYHAL_ADC_VNEG,
+                                             &channel_config);
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        _radar_adc_channel_count = 2;
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        if (CY_RSLT_SUCCESS != cyhal_adc_set_async_mode(&_radar_adc, CYHAL_ASYNC_DMA,
+                                                        CYHAL_DMA_PRIORITY_DEFAULT))
+        {
+            (void)cyhal_adc_set_async_mode(&_radar_adc, CYHAL_ASYNC_SW,
+                                           CYHAL_DMA_PRIORITY_DEFAULT);
+        }
+        cyhal_adc_register_callback(&_radar_adc, _shield_xensiv_a_radar_adc_event, NULL);
+        cyhal_adc_enable_event(&_radar_adc, CYHAL_ADC_ASYNC_READ_COMPLETE,
+                               _radar_intr_priority, true);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_radar_free_adc
+******************************************************************************/
+static void _shield_xensiv_a_radar_free_adc(void)
+{
+    if (_radar_adc_initialized)
+    {
+        cyhal_adc_enable_event(&_radar_adc, CYHAL_ADC_ASYNC_READ_COMPLETE,
+                               _radar_intr_priority, false);
+        while (_radar_adc_channel_count > 0)
+        {
+            _radar_adc_channel_count--;
+            cyhal_adc_channel_free(&_radar_adc_channels[_radar_adc_channel_count]);
+        }
+        cyhal_adc_free(&_radar_adc);
+        _radar_adc_initialized = false;
+        _radar_capture_busy = false;
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_radar_transfer
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_radar_transfer(const uint8_t* tx, uint8_t* rx)
+{
+    cy_rslt_t result = _radar_initialized
+        ? shield_xensiv_a_spi_acquire(SHIELD_XENSIV_A_SPI_DEVICE_RADAR)
+        : SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cyhal_spi_transfer(shield_xensiv_a_get_spi(), tx, RADAR_SPI_FRAME_BYTES,
+                                    rx, RADAR_SPI_FRAME_BYTES, 0);
+        shield_xensiv_a_spi_release(SHIELD_XENSIV_A_SPI_DEVICE_RADAR);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_radar_init
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_radar_init(shield_xensiv_a_radar_callback_t callback,
+                                     void* callback_arg, uint8_t intr_priority)
+{
+    const shield_xensiv_a_pins_t* pins = shield_xensiv_a_get_pins();
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (_radar_initialized)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BUSY;
+    }
+    else if (NULL == shield_xensiv_a_get_spi())
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        _radar_callback = callback;
+        _radar_callback_arg = callback_arg;
+        _radar_intr_priority = intr_priority;
+        result = cyhal_gpio_init(pins->radar_rst, CYHAL_GPIO_DIR_OUTPUT,
+                                 CYHAL_GPIO_DRIVE_STRONG, false);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        cyhal_system_delay_ms(RADAR_RESET_MS);
+        cyhal_gpio_write(pins->radar_rst, true);
+
+        result = cyhal_gpio_init(pins->radar_gpio2, CYHAL_GPIO_DIR_INPUT,
+                                 CYHAL_GPIO_DRIVE_NONE, false);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            result = cyhal_gpio_init(pins->radar_gpio1, CYHAL_GPIO_DIR_INPUT,
+                                     CYHAL_GPIO_DRIVE_NONE, false);
+            if (CY_RSLT_SUCCESS != result)
+            {
+                cyhal_gpio_free(pins->radar_gpio2);
+            }
+        }
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cyhal_gpio_free(pins->radar_rst);
+        }
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        _radar_tdet_callback_data.callback = _shield_xensiv_a_radar_tdet_handler;
+        _radar_tdet_callback_data.callback_arg = NULL;
+        cyhal_gpio_register_callback(pins->radar_gpio2, &_radar_tdet_callback_data);
+        cyhal_gpio_enable_event(pins->radar_gpio2, CYHAL_GPIO_IRQ_BOTH,
+                                intr_priority, true);
+
+        _radar_pdet_callback_data.callback = _shield_xensiv_a_radar_pdet_handler;
+        _radar_pdet_callback_data.callback_arg = NULL;
+        cyhal_gpio_register_callback(pins->radar_gpio1, &_radar_pdet_callback_data);
+        cyhal_gpio_enable_event(pins->radar_gpio1, CYHAL_GPIO_IRQ_BOTH,
+                                intr_priority, true);
+
+        _radar_initialized = true;
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_radar_is_present
+******************************************************************************/
+bool shield_xensiv_a_radar_is_present(void)
+{
+    return _radar_initialized &&
+           (SHIELD_XENSIV_A_RADAR_TDET_ACTIVE ==
+            cyhal_gpio_read(shield_xensiv_a_get_pins()->radar_gpio2));
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_radar_read_reg
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_radar_read_reg(uint8_t address, uint16_t* value)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint8_t tx[RADAR_SPI_FRAME_BYTES] = { (uint8_t)(address << 1), 0, 0 };
+    uint8_t rx[RADAR_SPI_FRAME_BYTES] = { 0 };
+
+    if ((address > RADAR_REG_MAX) || (NULL == value))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else
+    {
+        result = _shield_xensiv_a_radar_transfer(tx, rx);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        *value = (uint16_t)(((uint16_t)rx[1] << 8) | rx[2]);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_radar_write_reg
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_radar_write_reg(uint8_t address, uint16_t value)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint8_t tx[RADAR_SPI_FRAME_BYTES] =
+    {
+        (uint8_t)((address << 1) | RADAR_SPI_WRITE),
+        (uint8_t)(value >> 8),
+        (uint8_t)(value & 0xFFU)
+    };
+    uint8_t rx[RADAR_SPI_FRAME_BYTES];
+
+    if (address > RADAR_REG_MAX)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else
+    {
+        result = _shield_xensiv_a_radar_transfer(tx, rx);
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_radar_capture_start
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_radar_capture_start(int32_t* buffer, size_t num_scans,
+                                              uint32_t sample_rate_hz,
+                                              shield_xensiv_a_radar_capture_callback_t callback,
+                                              void* callback_arg)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t actual_rate_hz;
+
+    if ((NULL == buffer) || (0 == num_scans) || (0 == sample_rate_hz))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if (!_radar_initialized)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else if (_radar_capture_busy)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BUSY;
+    }
+    else if (!_radar_adc_initialized)
+    {
+        /* The ADC is only claimed once the IF signals are needed */
+        result = _shield_xensiv_a_radar_init_adc();
+        if (CY_RSLT_SUCCESS != result)
+        {
+            _shield_xensiv_a_radar_free_adc();
+        }
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cyhal_adc_set_sample_rate(&_radar_adc, sample_rate_hz, &actual_rate_hz);
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        _radar_capture_callback = callback;
+        _radar_capture_callback_arg = callback_arg;
+        _radar_capture_busy = true;
+        result = cyhal_adc_read_async_uv(&_radar_adc, num_scans, buffer);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            _radar_capture_busy = false;
+        }
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_radar_capture_is_busy
+******************************************************************************/
+bool shield_xensiv_a_radar_capture_is_busy(void)
+{
+    return _radar_capture_busy;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_radar_free
+******************************************************************************/
+void shield_xensiv_a_radar_free(void)
+{
+    if (_radar_initialized)
+    {
+        const shield_xensiv_a_pins_t* pins = shield_xensiv_a_get_pins();
+
+        _shield_xensiv_a_radar_free_adc();
+
+        cyhal_gpio_enable_event(pins->radar_gpio1, CYHAL_GPIO_IRQ_BOTH,
+                                _radar_intr_priority, false);
+        cyhal_gpio_enable_event(pins->radar_gpio2, CYHAL_GPIO_IRQ_BOTH,
+                                _radar_intr_priority, false);
+        cyhal_gpio_free(pins->radar_gpio1);
+        cyhal_gpio_free(pins->radar_gpio2);
+        cyhal_gpio_free(pins->radar_rst);
+
+        _radar_callback = NULL;
+        _radar_capture_callback = NULL;
+        _radar_initialized = false;
+    }
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
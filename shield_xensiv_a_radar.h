@@ -0,0 +1,206 @@
+/******************************************************************************
+ * \file shield_xensiv_a_radar.h
+ *
+ * Description: This file is the interface for the BGT60LTR11 radar sensor
+ *              connected to the radar pins of the SHIELD_XENSIV_A shield board.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#ifndef SHIELD_XENSIV_A_RADAR_TDET_ACTIVE
+/** Level of T_DET (SHIELD_XENSIV_A_PIN_RADAR_GPIO2) while a target is detected */
+#define SHIELD_XENSIV_A_RADAR_TDET_ACTIVE       (false)
+#endif
+
+#ifndef SHIELD_XENSIV_A_RADAR_PDET_APPROACHING
+/** Level of P_DET (SHIELD_XENSIV_A_PIN_RADAR_GPIO1) for an approaching target */
+#define SHIELD_XENSIV_A_RADAR_PDET_APPROACHING  (true)
+#endif
+
+/** Number of values per scan of the IF signal capture */
+#define SHIELD_XENSIV_A_RADAR_IF_CHANNELS       (2U)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Events reported by the radar sensor in autonomous mode */
+typedef enum
+{
+    SHIELD_XENSIV_A_RADAR_EVENT_PRESENCE,       /**< A target was detected */
+    SHIELD_XENSIV_A_RADAR_EVENT_ABSENCE,        /**< The target is no longer detected */
+    SHIELD_XENSIV_A_RADAR_EVENT_APPROACHING,    /**< The detected target moves towards the sensor */
+    SHIELD_XENSIV_A_RADAR_EVENT_DEPARTING       /**< The detected target moves away from the sensor */
+} shield_xensiv_a_radar_event_t;
+
+/** Callback invoked from the GPIO interrupt for radar events */
+typedef void (*shield_xensiv_a_radar_callback_t)(shield_xensiv_a_radar_event_t event,
+                                                 uint32_t timestamp_us, void* callback_arg);
+
+/** Callback invoked from the ADC interrupt once an IF signal capture completed */
+typedef void (*shield_xensiv_a_radar_capture_callback_t)(cy_rslt_t result,
+                                                         void* callback_arg);
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_radar_init
+******************************************************************************
+* Summary: Resets the radar sensor and enables the interrupts of its target
+*          and direction detection outputs. The GPIO interrupts also wake the
+*          device from deep sleep, so the application can keep everything
+*          else powered down until a target is present. The shield must have
+*          been initialized.
+*
+* Parameters:
+*  callback          An optional function to call for radar events
+*  callback_arg      Argument passed to the callback
+*  intr_priority     Priority of the GPIO and ADC interrupts
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_radar_init(shield_xensiv_a_radar_callback_t callback,
+                                     void* callback_arg, uint8_t intr_priority);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_radar_is_present
+******************************************************************************
+* Summary: Reads whether a target is currently detected.
+*
+* Parameters: None
+*
+* Return:
+*  true if a target is detected
+*
+******************************************************************************/
+bool shield_xensiv_a_radar_is_present(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_radar_read_reg
+******************************************************************************
+* Summary: Reads a register of the radar sensor over the shared SPI bus. The
+*          bus is acquired for the duration of the access.
+*
+* Parameters:
+*  address           Register address, 0 to 0x7F
+*  value             Receives the register value
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_radar_read_reg(uint8_t address, uint16_t* value);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_radar_write_reg
+******************************************************************************
+* Summary: Writes a register of the radar sensor over the shared SPI bus. The
+*          bus is acquired for the duration of the access.
+*
+* Parameters:
+*  address           Register address, 0 to 0x7F
+*  value             The register value
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_radar_write_reg(uint8_t address, uint16_t value);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_radar_capture_start
+******************************************************************************
+* Summary: Starts sampling the I and Q IF signals on
+*          SHIELD_XENSIV_A_PIN_RADAR_ADC1 and SHIELD_XENSIV_A_PIN_RADAR_ADC2
+*          into a buffer, in µV. The call returns immediately.
+*
+* Parameters:
+*  buffer            Receives num_scans * SHIELD_XENSIV_A_RADAR_IF_CHANNELS
+*                    values, I and Q interleaved
+*  num_scans         Number of I/Q pairs to capture
+*  sample_rate_hz    Number of I/Q pairs per second
+*  callback          An optional function to call when the capture completed
+*  callback_arg      Argument passed to the callback
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_radar_capture_start(int32_t* buffer, size_t num_scans,
+                                              uint32_t sample_rate_hz,
+                                              shield_xensiv_a_radar_capture_callback_t callback,
+                                              void* callback_arg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_radar_capture_is_busy
+******************************************************************************
+* Summary: Reports whether an IF signal capture is in progress.
+*
+* Parameters: None
+*
+* Return:
+*  true while capturing
+*
+******************************************************************************/
+bool shield_xensiv_a_radar_capture_is_busy(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_radar_free
+******************************************************************************
+* Summary: Disables the radar interrupts and frees the radar pins and the ADC.
+*          This must be called before shield_xensiv_a_free() if the radar was
+*          initialized.
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_radar_free(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,499 @@
+/******************************************************************************
+ * \file shield_xensiv_a_sampler.c
+ *
+ * Description: Implementation of the multi-rate sampling scheduler of the
+ *              shield support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include <string.h>
+#include "shield_xensiv_a_sampler.h"
+#include "shield_xensiv_a_stream.h"
+#include "shield_xensiv_a_i2c_sched.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Frequency of the sampler timer in Hz */
+#define SAMPLER_TIMER_FREQ_HZ      (1000000UL)
+/* Number of release offsets tried for a new task */
+#define SAMPLER_MAX_OFFSETS        (256U)
+/* Sensors which shield_xensiv_a_stream_capture() reads */
+#define SAMPLER_SENSORS            (SHIELD_XENSIV_A_READY_HUMIDITY | SHIELD_XENSIV_A_READY_MOTION | \
+                                    SHIELD_XENSIV_A_READY_MAGNETOMETER |                          \
+                                    SHIELD_XENSIV_A_READY_PRESSURE | SHIELD_XENSIV_A_READY_CO2)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+typedef struct
+{
+    shield_xensiv_a_sampler_read_t      read;
+    void*                               read_arg;
+    shield_xensiv_a_sampler_callback_t  callback;
+    void*                               callback_arg;
+    uint32_t                            period_ticks;
+    uint32_t                            offset_ticks;
+    uint8_t                             priority;
+
+    /* Written by the timer interrupt */
+    uint32_t                            next_tick;
+    volatile bool                       pending;
+    volatile uint32_t                   release_us;
+    volatile uint32_t                   releases;
+    volatile uint32_t                   overruns;
+
+    /* Written by shield_xensiv_a_sampler_process() */
+    bool                                started;
+    uint32_t                            last_start_us;
+    uint32_t                            runs;
+    uint32_t                            deadline_misses;
+    uint32_t                            latency_max_us;
+    uint64_t                            latency_total_us;
+    uint32_t                            jitter_max_us;
+} _shield_xensiv_a_sampler_task_t;
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static _shield_xensiv_a_sampler_task_t  _sampler_tasks[SHIELD_XENSIV_A_SAMPLER_MAX_TASKS];
+static uint8_t                          _sampler_task_count;
+static cyhal_timer_t                    _sampler_timer;
+static bool                             _sampler_running;
+static uint32_t                         _sampler_tick;
+static shield_xensiv_a_sampler_notify_t _sampler_notify;
+static void*                            _sampler_notify_arg;
+
+
+/******************************************************************************
+* _shield_xensiv_a_sampler_gcd
+******************************************************************************/
+static uint32_t _shield_xensiv_a_sampler_gcd(uint32_t a, uint32_t b)
+{
+    while (0U != b)
+    {
+        uint32_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_sampler_pick_offset
+******************************************************************************/
+/* Two tasks with periods p and q are released together once every lcm(p, q)
+   ticks if their offsets are equal modulo gcd(p, q), and never otherwise. The
+   offset with the lowest rate of coinciding releases is used. */
+static uint32_t _shield_xensiv_a_sampler_pick_offset(uint32_t period_ticks)
+{
+    uint32_t limit = (period_ticks < SAMPLER_MAX_OFFSETS) ? period_ticks : SAMPLER_MAX_OFFSETS;
+    uint32_t best_offset = 0;
+    float best_rate = 0.0f;
+
+    for (uint32_t offset = 0; offset < limit; offset++)
+    {
+        float rate = 0.0f;
+
+        for (uint8_t i = 0; i < _sampler_task_count; i++)
+        {
+            const _shield_xensiv_a_sampler_task_t* other = &_sampler_tasks[i];
+            uint32_t gcd = _shield_xensiv_a_sampler_gcd(period_ticks, other->period_ticks);
+
+            if ((offset % gcd) == (other->offset_ticks % gcd))
+            {
+                /* 1 / lcm(p, q) */
+                rate += (float)gcd / ((float)period_ticks * (float)other->period_ticks);
+            }
+        }
+
+        if ((0U == offset) || (rate < best_rate))
+        {
+            best_offset = offset;
+            best_rate = rate;
+        }
+        if (0.0f == best_rate)
+        {
+            offset = limit;
+        }
+    }
+
+    return best_offset;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_sampler_read_sensors
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_sampler_read_sensors(void* read_arg)
+{
+    return shield_xensiv_a_stream_capture((uint32_t)(uintptr_t)read_arg);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_sampler_tick
+******************************************************************************/
+static void _shield_xensiv_a_sampler_tick(void* callback_arg, cyhal_timer_event_t event)
+{
+    (void)callback_arg;
+    (void)event;
+
+    uint32_t now_us = shield_xensiv_a_get_timestamp_us();
+    bool released = false;
+
+    _sampler_tick++;
+    for (uint8_t i = 0; i < _sampler_task_count; i++)
+    {
+        _shield_xensiv_a_sampler_task_t* task = &_sampler_tasks[i];
+
+        if ((int32_t)(_sampler_tick - task->next_tick) >= 0)
+        {
+            task->next_tick += task->period_ticks;
+            task->releases++;
+            if (task->pending)
+            {
+                task->overruns++;
+            }
+            task->release_us = now_us;
+            task->pending = true;
+            released = true;
+        }
+    }
+
+    if (released && (NULL != _sampler_notify))
+    {
+        _sampler_notify(_sampler_notify_arg);
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_sampler_bus_idle
+******************************************************************************/
+/* Wakes the processing context for tasks which were left waiting while the
+   I2C bus was in use */
+static void _shield_xensiv_a_sampler_bus_idle(void* callback_arg)
+{
+    (void)callback_arg;
+
+    if (_sampler_running && (NULL != _sampler_notify))
+    {
+        _sampler_notify(_sampler_notify_arg);
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_sampler_take_next
+******************************************************************************/
+/* Returns the released task of the highest priority, or NULL */
+static _shield_xensiv_a_sampler_task_t* _shield_xensiv_a_sampler_take_next(uint32_t* release_us)
+{
+    _shield_xensiv_a_sampler_task_t* next = NULL;
+
+    uint32_t state = cyhal_system_critical_section_enter();
+    for (uint8_t i = 0; i < _sampler_task_count; i++)
+    {
+        _shield_xensiv_a_sampler_task_t* task = &_sampler_tasks[i];
+        if (task->pending && ((NULL == next) || (task->priority < next->priority)))
+        {
+            next = task;
+        }
+    }
+    if (NULL != next)
+    {
+        next->pending = false;
+        *release_us = next->release_us;
+    }
+    cyhal_system_critical_section_exit(state);
+
+    return next;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_sampler_add
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_sampler_add(uint32_t period_us, uint8_t priority,
+                                      shield_xensiv_a_sampler_read_t read, void* read_arg,
+                                      shield_xensiv_a_sampler_callback_t callback,
+                                      void* callback_arg, uint8_t* task)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t period_ticks = (period_us + (SHIELD_XENSIV_A_SAMPLER_TICK_US / 2U)) /
+                            SHIELD_XENSIV_A_SAMPLER_TICK_US;
+
+    if ((NULL == read) || (0U == period_ticks))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if (_sampler_running || (_sampler_task_count >= SHIELD_XENSIV_A_SAMPLER_MAX_TASKS))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BUSY;
+    }
+    else
+    {
+        _shield_xensiv_a_sampler_task_t* entry = &_sampler_tasks[_sampler_task_count];
+
+        memset(entry, 0, sizeof(*entry));
+        entry->read = read;
+        entry->read_arg = read_arg;
+        entry->callback = callback;
+        entry->callback_arg = callback_arg;
+        entry->period_ticks = period_ticks;
+        entry->offset_ticks = _shield_xensiv_a_sampler_pick_offset(period_ticks);
+        entry->priority = priority;
+
+        if (NULL != task)
+        {
+            *task = _sampler_task_count;
+        }
+        _sampler_task_count++;
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_sampler_add_sensors
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_sampler_add_sensors(uint32_t sensors, uint32_t period_us,
+                                              uint8_t priority,
+                                              shield_xensiv_a_sampler_callback_t callback,
+                                              void* callback_arg, uint8_t* task)
+{
+    return ((0U == sensors) || ((sensors & ~SAMPLER_SENSORS) != 0))
+        ? SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG
+        : shield_xensiv_a_sampler_add(period_us, priority,
+                                      _shield_xensiv_a_sampler_read_sensors,
+                                      (void*)(uintptr_t)sensors, callback, callback_arg, task);
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_sampler_start
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_sampler_start(shield_xensiv_a_sampler_notify_t notify,
+                                        void* notify_arg, uint8_t intr_priority)
+{
+    static const cyhal_timer_cfg_t timer_cfg =
+    {
+        .is_continuous = true,
+        .direction     = CYHAL_TIMER_DIR_UP,
+        .is_compare    = false,
+        .period        = SHIELD_XENSIV_A_SAMPLER_TICK_US - 1UL,
+        .compare_value = 0,
+        .value         = 0
+    };
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (_sampler_running || (0U == _sampler_task_count))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if (NULL == shield_xensiv_a_get_i2c())
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        _sampler_notify = notify;
+        _sampler_notify_arg = notify_arg;
+        _sampler_tick = 0;
+        for (uint8_t i = 0; i < _sampler_task_count; i++)
+        {
+            /* The tick count is incremented before the releases are checked */
+            _sampler_tasks[i].next_tick = _sampler_tasks[i].offset_ticks + 1U;
+            _sampler_tasks[i].pending = false;
+        }
+
+        result = cyhal_timer_init(&_sampler_timer, NC, NULL);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            result = cyhal_timer_configure(&_sampler_timer, &timer_cfg);
+            if (CY_RSLT_SUCCESS == result)
+            {
+                result = cyhal_timer_set_frequency(&_sampler_timer, SAMPLER_TIMER_FREQ_HZ);
+            }
+            if (CY_RSLT_SUCCESS == result)
+            {
+                cyhal_timer_register_callback(&_sampler_timer, _shield_xensiv_a_sampler_tick,
+                                              NULL);
+                cyhal_timer_enable_event(&_sampler_timer, CYHAL_TIMER_IRQ_TERMINAL_COUNT,
+                                         intr_priority, true);
+                result = cyhal_timer_start(&_sampler_timer);
+            }
+            if (CY_RSLT_SUCCESS == result)
+            {
+                _sampler_running = true;
+            }
+            else
+            {
+                cyhal_timer_free(&_sampler_timer);
+            }
+        }
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_sampler_process
+******************************************************************************/
+uint32_t shield_xensiv_a_sampler_process(void)
+{
+    uint32_t executed = 0;
+    bool done = !_sampler_running;
+
+    while (!done)
+    {
+        _shield_xensiv_a_sampler_task_t* task = NULL;
+        uint32_t release_us = 0;
+
+        /* Leave released tasks waiting while a scheduled transaction is on
+           the bus, the scheduler notifies once the bus is idle again */
+        if (CY_RSLT_SUCCESS != shield_xensiv_a_i2c_sched_acquire())
+        {
+            shield_xensiv_a_i2c_sched_notify_idle(_shield_xensiv_a_sampler_bus_idle, NULL);
+        }
+        else
+        {
+            task = _shield_xensiv_a_sampler_take_next(&release_us);
+            if (NULL != task)
+            {
+                shield_xensiv_a_sampler_event_t event;
+                uint32_t period_us = task->period_ticks * SHIELD_XENSIV_A_SAMPLER_TICK_US;
+
+                event.task = (uint8_t)(task - _sampler_tasks);
+                event.release_us = release_us;
+                event.start_us = shield_xensiv_a_get_timestamp_us();
+                event.result = task->read(task->read_arg);
+                event.end_us = shield_xensiv_a_get_timestamp_us();
+                shield_xensiv_a_i2c_sched_release();
+
+                uint32_t latency_us = event.start_us - event.release_us;
+                task->runs++;
+                task->latency_total_us += latency_us;
+                if (latency_us > task->latency_max_us)
+                {
+                    task->latency_max_us = latency_us;
+                }
+                if ((event.end_us - event.release_us) > period_us)
+                {
+                    task->deadline_misses++;
+                }
+                if (task->started)
+                {
+                    int32_t deviation_us = (int32_t)((event.start_us - task->last_start_us) -
+                                                     period_us);
+                    uint32_t jitter_us = (uint32_t)((deviation_us < 0) ? -deviation_us
+                                                                       : deviation_us);
+                    if (jitter_us > task->jitter_max_us)
+                    {
+                        task->jitter_max_us = jitter_us;
+                    }
+                }
+                task->started = true;
+                task->last_start_us = event.start_us;
+                executed++;
+
+                if (NULL != task->callback)
+                {
+                    task->callback(&event, task->callback_arg);
+                }
+            }
+            else
+            {
+                shield_xensiv_a_i2c_sched_release();
+            }
+        }
+
+        done = (NULL == task);
+    }
+
+    return executed;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_sampler_get_stats
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_sampler_get_stats(uint8_t task, shield_xensiv_a_sampler_stats_t* stats)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((task >= _sampler_task_count) || (NULL == stats))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else
+    {
+        const _shield_xensiv_a_sampler_task_t* entry = &_sampler_tasks[task];
+
+        uint32_t state = cyhal_system_critical_section_enter();
+        stats->releases = entry->releases;
+        stats->overruns = entry->overruns;
+        cyhal_system_critical_section_exit(state);
+
+        stats->runs = entry->runs;
+        stats->deadline_misses = entry->deadline_misses;
+        stats->latency_max_us = entry->latency_max_us;
+        stats->latency_total_us = entry->latency_total_us;
+        stats->jitter_max_us = entry->jitter_max_us;
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_sampler_stop
+******************************************************************************/
+void shield_xensiv_a_sampler_stop(void)
+{
+    if (_sampler_running)
+    {
+        cyhal_timer_enable_event(&_sampler_timer, CYHAL_TIMER_IRQ_TERMINAL_COUNT, 0U, false);
+        (void)cyhal_timer_stop(&_sampler_timer);
+        cyhal_timer_register_callback(&_sampler_timer, NULL, NULL);
+        cyhal_timer_free(&_sampler_timer);
+        _sampler_running = false;
+    }
+    _sampler_task_count = 0;
+    _sampler_notify = NULL;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
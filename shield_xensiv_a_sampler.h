@@ -0,0 +1,238 @@
+/******************************************************************************
+ * \file shield_xensiv_a_sampler.h
+ *
+ * Description: This file is the interface for the multi-rate sampling
+ *              scheduler of the sensors on the SHIELD_XENSIV_A shield board.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#ifndef SHIELD_XENSIV_A_SAMPLER_MAX_TASKS
+/** Maximum number of registered sampling tasks */
+#define SHIELD_XENSIV_A_SAMPLER_MAX_TASKS       (8U)
+#endif
+
+#ifndef SHIELD_XENSIV_A_SAMPLER_TICK_US
+/** Period of the hardware timer interrupt, the resolution of the task periods
+ * and release times */
+#define SHIELD_XENSIV_A_SAMPLER_TICK_US         (500UL)
+#endif
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Reads a sensor, called from shield_xensiv_a_sampler_process() */
+typedef cy_rslt_t (*shield_xensiv_a_sampler_read_t)(void* read_arg);
+
+/** Outcome and timing of one execution of a task */
+typedef struct
+{
+    /** The task, as returned when it was added */
+    uint8_t     task;
+    /** Result of the read */
+    cy_rslt_t   result;
+    /** Time the task was released by the timer */
+    uint32_t    release_us;
+    /** Time the read started */
+    uint32_t    start_us;
+    /** Time the read completed */
+    uint32_t    end_us;
+} shield_xensiv_a_sampler_event_t;
+
+/** Called after every execution of a task */
+typedef void (*shield_xensiv_a_sampler_callback_t)(const shield_xensiv_a_sampler_event_t* event,
+                                                   void* callback_arg);
+
+/** Called from the timer interrupt when a task was released, e.g. to wake
+ * the RTOS task calling shield_xensiv_a_sampler_process() */
+typedef void (*shield_xensiv_a_sampler_notify_t)(void* notify_arg);
+
+/** Timing statistics of a task */
+typedef struct
+{
+    /** Number of releases by the timer */
+    uint32_t    releases;
+    /** Number of executions */
+    uint32_t    runs;
+    /** Number of releases while the previous one was still waiting, each of
+     * which is a lost sample */
+    uint32_t    overruns;
+    /** Number of executions which completed later than one period after
+     * their release */
+    uint32_t    deadline_misses;
+    /** Largest time from a release to the start of the read */
+    uint32_t    latency_max_us;
+    /** Sum of the times from a release to the start of the read */
+    uint64_t    latency_total_us;
+    /** Largest deviation of the time between two consecutive reads from the
+     * period */
+    uint32_t    jitter_max_us;
+} shield_xensiv_a_sampler_stats_t;
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_sampler_add
+******************************************************************************
+* Summary: Registers a periodic task. The release of the task is offset
+*          against the tasks already registered so that as few releases as
+*          possible coincide. Tasks can only be added while the sampler is
+*          stopped.
+*
+* Parameters:
+*  period_us         Period of the task, rounded to a multiple of
+*                    SHIELD_XENSIV_A_SAMPLER_TICK_US
+*  priority          Priority of the task, 0 is the highest. Of the tasks due
+*                    at the same time, the one with the highest priority runs
+*                    first.
+*  read              Function reading the sensor
+*  read_arg          Argument passed to the read function
+*  callback          Optional function called after every execution
+*  callback_arg      Argument passed to the callback
+*  task              Returns the number of the task, may be NULL
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_BUSY if the sampler is
+*  running or all SHIELD_XENSIV_A_SAMPLER_MAX_TASKS tasks are in use
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_sampler_add(uint32_t period_us, uint8_t priority,
+                                      shield_xensiv_a_sampler_read_t read, void* read_arg,
+                                      shield_xensiv_a_sampler_callback_t callback,
+                                      void* callback_arg, uint8_t* task);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_sampler_add_sensors
+******************************************************************************
+* Summary: Registers a periodic task reading shield sensors with
+*          shield_xensiv_a_stream_capture(). The samples are pushed into the
+*          ring attached with shield_xensiv_a_stream_attach().
+*
+* Parameters:
+*  sensors           Combination of SHIELD_XENSIV_A_READY_HUMIDITY, _MOTION,
+*                    _MAGNETOMETER, _PRESSURE and _CO2
+*  period_us         Period of the task
+*  priority          Priority of the task, 0 is the highest
+*  callback          Optional function called after every execution
+*  callback_arg      Argument passed to the callback
+*  task              Returns the number of the task, may be NULL
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_sampler_add_sensors(uint32_t sensors, uint32_t period_us,
+                                              uint8_t priority,
+                                              shield_xensiv_a_sampler_callback_t callback,
+                                              void* callback_arg, uint8_t* task);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_sampler_start
+******************************************************************************
+* Summary: Starts the hardware timer releasing the tasks. The shield must have
+*          been initialized.
+*
+* Parameters:
+*  notify            Optional function called from the timer interrupt when a
+*                    task was released, and from the I2C interrupt when tasks
+*                    which waited for a scheduled transaction can run
+*  notify_arg        Argument passed to the notify function
+*  intr_priority     Priority of the timer interrupt
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_sampler_start(shield_xensiv_a_sampler_notify_t notify,
+                                        void* notify_arg, uint8_t intr_priority);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_sampler_process
+******************************************************************************
+* Summary: Executes all released tasks one after the other, in the order of
+*          their priority, and reports them to their callbacks. The reads run
+*          with the I2C bus reserved through shield_xensiv_a_i2c_sched_acquire(),
+*          so they never collide with each other or with scheduled
+*          transactions. Released tasks wait while a scheduled transaction is
+*          on the bus, and the notify function is called again once it is
+*          idle. Must be called from a single thread context, e.g. the main
+*          loop or one RTOS task woken by the notify function.
+*
+* Parameters: None
+*
+* Return:
+*  Number of executed tasks
+*
+******************************************************************************/
+uint32_t shield_xensiv_a_sampler_process(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_sampler_get_stats
+******************************************************************************
+* Summary: Reads the timing statistics of a task.
+*
+* Parameters:
+*  task              The task
+*  stats             Returns the statistics
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_sampler_get_stats(uint8_t task, shield_xensiv_a_sampler_stats_t* stats);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_sampler_stop
+******************************************************************************
+* Summary: Stops the timer and removes all tasks.
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_sampler_stop(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,464 @@
+/******************************************************************************
+ * \file shield_xensiv_a_snapshot.c
+ *
+ * Description: Implementation of the snapshot of the environmental sensors of
+ *              the shield support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "shield_xensiv_a_snapshot.h"
+#include "shield_xensiv_a_health.h"
+#include "shield_xensiv_a_i2c_sched.h"
+#include "shield_xensiv_a_metrics.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define US_PER_MS                  (1000UL)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+typedef enum
+{
+    _SNAPSHOT_HUMIDITY,
+    _SNAPSHOT_PRESSURE,
+    _SNAPSHOT_CO2,
+    _SNAPSHOT_SENSOR_COUNT
+} _shield_xensiv_a_snapshot_sensor_id_t;
+
+/* How a sensor is triggered, read and returned to its periodic measurement */
+typedef struct
+{
+    uint32_t    ready_bit;
+    cy_rslt_t   (*trigger)(void);
+    /* Returns SHIELD_XENSIV_A_RSLT_PENDING while the result is not ready */
+    cy_rslt_t   (*collect)(shield_xensiv_a_snapshot_t* snapshot);
+    void        (*restore)(void);
+    uint32_t    conversion_ms;
+} _shield_xensiv_a_snapshot_sensor_t;
+
+/******************************************************************************
+* Function prototypes
+******************************************************************************/
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+static cy_rslt_t _shield_xensiv_a_snapshot_trigger_humidity(void);
+static cy_rslt_t _shield_xensiv_a_snapshot_collect_humidity(shield_xensiv_a_snapshot_t* snapshot);
+static void _shield_xensiv_a_snapshot_restore_humidity(void);
+#endif
+#if SHIELD_XENSIV_A_USE_PRESSURE
+static cy_rslt_t _shield_xensiv_a_snapshot_collect_pressure(shield_xensiv_a_snapshot_t* snapshot);
+#endif
+#if SHIELD_XENSIV_A_USE_CO2
+static cy_rslt_t _shield_xensiv_a_snapshot_trigger_co2(void);
+static cy_rslt_t _shield_xensiv_a_snapshot_collect_co2(shield_xensiv_a_snapshot_t* snapshot);
+static void _shield_xensiv_a_snapshot_restore_co2(void);
+#endif
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static const _shield_xensiv_a_snapshot_sensor_t _snapshot_sensors[_SNAPSHOT_SENSOR_COUNT] =
+{
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+    [_SNAPSHOT_HUMIDITY] =
+    {
+        .ready_bit      = SHIELD_XENSIV_A_READY_HUMIDITY,
+        .trigger        = _shield_xensiv_a_snapshot_trigger_humidity,
+        .collect        = _shield_xensiv_a_snapshot_collect_humidity,
+        .restore        = _shield_xensiv_a_snapshot_restore_humidity,
+        .conversion_ms  = SHIELD_XENSIV_A_SHT35_MEAS_MS
+    },
+#endif
+#if SHIELD_XENSIV_A_USE_PRESSURE
+    /* The DPS368 measures in background mode, its next result is collected
+       as soon as it is ready */
+    [_SNAPSHOT_PRESSURE] =
+    {
+        .ready_bit      = SHIELD_XENSIV_A_READY_PRESSURE,
+        .trigger        = NULL,
+        .collect        = _shield_xensiv_a_snapshot_collect_pressure,
+        .restore        = NULL,
+        .conversion_ms  = 0
+    },
+#endif
+#if SHIELD_XENSIV_A_USE_CO2
+    [_SNAPSHOT_CO2] =
+    {
+        .ready_bit      = SHIELD_XENSIV_A_READY_CO2,
+        .trigger        = _shield_xensiv_a_snapshot_trigger_co2,
+        .collect        = _shield_xensiv_a_snapshot_collect_co2,
+        .restore        = _shield_xensiv_a_snapshot_restore_co2,
+        .conversion_ms  = SHIELD_XENSIV_A_SNAPSHOT_CO2_MEAS_MS
+    }
+#endif
+};
+
+static shield_xensiv_a_snapshot_t*  _snapshot;
+static uint32_t                     _snapshot_outstanding;
+static uint32_t                     _snapshot_untriggered;
+static cy_rslt_t                    _snapshot_result;
+static uint32_t                     _snapshot_due_us[_SNAPSHOT_SENSOR_COUNT];
+
+
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+/******************************************************************************
+* _shield_xensiv_a_snapshot_trigger_humidity
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_snapshot_trigger_humidity(void)
+{
+    /* The sensor does not accept a single shot during its periodic
+       measurement. The break is not acknowledged if it is already idle. */
+    (void)shield_xensiv_a_sht35_command(SHIELD_XENSIV_A_SHT35_CMD_BREAK);
+    cyhal_system_delay_ms(SHIELD_XENSIV_A_SHT35_BREAK_MS);
+
+    return shield_xensiv_a_sht35_command(SHIELD_XENSIV_A_SHT35_CMD_SINGLE_HIGH);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_snapshot_collect_humidity
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_snapshot_collect_humidity(shield_xensiv_a_snapshot_t* snapshot)
+{
+    /* The read is not acknowledged until the measurement has completed */
+    cy_rslt_t result = shield_xensiv_a_sht35_read(&snapshot->temperature, &snapshot->humidity);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        snapshot->humidity_timestamp_us = shield_xensiv_a_get_timestamp_us();
+    }
+    else if (SHIELD_XENSIV_A_RSLT_ERR_SENSOR != result)
+    {
+        result = SHIELD_XENSIV_A_RSLT_PENDING;
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_snapshot_restore_humidity
+******************************************************************************/
+static void _shield_xensiv_a_snapshot_restore_humidity(void)
+{
+    /* The driver sets up its periodic measurement when it is initialized */
+    (void)mtb_sht3x_init(shield_xensiv_a_get_humidity_sensor(), MTB_SHT35_ADDRESS_DEFAULT);
+}
+#endif
+
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+/******************************************************************************
+* _shield_xensiv_a_snapshot_collect_pressure
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_snapshot_collect_pressure(shield_xensiv_a_snapshot_t* snapshot)
+{
+    xensiv_dps3xx_t* sensor = shield_xensiv_a_get_pressure_sensor();
+    bool pressure_ready = false;
+    bool temperature_ready = false;
+
+    cy_rslt_t result = xensiv_dps3xx_check_ready(sensor, &pressure_ready, &temperature_ready);
+    if ((CY_RSLT_SUCCESS == result) && !(pressure_ready && temperature_ready))
+    {
+        result = SHIELD_XENSIV_A_RSLT_PENDING;
+    }
+    else if (CY_RSLT_SUCCESS == result)
+    {
+        SHIELD_XENSIV_A_METRICS_BEGIN(start_us);
+        result = xensiv_dps3xx_read(sensor, &snapshot->pressure, &snapshot->pressure_temperature);
+        SHIELD_XENSIV_A_METRICS_END(SHIELD_XENSIV_A_METRICS_PRESSURE, start_us,
+                                    SHIELD_XENSIV_A_METRICS_DPS368_BYTES, result);
+        snapshot->pressure_timestamp_us = shield_xensiv_a_get_timestamp_us();
+    }
+
+    return result;
+}
+#endif
+
+
+#if SHIELD_XENSIV_A_USE_CO2
+/******************************************************************************
+* _shield_xensiv_a_snapshot_trigger_co2
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_snapshot_trigger_co2(void)
+{
+    return xensiv_pasco2_start_single_mode(shield_xensiv_a_get_co2_sensor());
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_snapshot_collect_co2
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_snapshot_collect_co2(shield_xensiv_a_snapshot_t* snapshot)
+{
+    uint16_t ppm;
+
+    SHIELD_XENSIV_A_METRICS_BEGIN(start_us);
+    cy_rslt_t result = xensiv_pasco2_get_result(shield_xensiv_a_get_co2_sensor(), &ppm);
+    SHIELD_XENSIV_A_METRICS_END(SHIELD_XENSIV_A_METRICS_CO2, start_us,
+                                SHIELD_XENSIV_A_METRICS_PASCO2_BYTES,
+                                (XENSIV_PASCO2_READ_NRDY == result) ? CY_RSLT_SUCCESS : result);
+
+    if (XENSIV_PASCO2_OK == result)
+    {
+        snapshot->co2_ppm = ppm;
+        snapshot->co2_timestamp_us = shield_xensiv_a_get_timestamp_us();
+    }
+    else if (XENSIV_PASCO2_READ_NRDY == result)
+    {
+        result = SHIELD_XENSIV_A_RSLT_PENDING;
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_snapshot_restore_co2
+******************************************************************************/
+static void _shield_xensiv_a_snapshot_restore_co2(void)
+{
+    /* The driver sets up its continuous measurement when it is initialized */
+    (void)xensiv_pasco2_mtb_init_i2c(shield_xensiv_a_get_co2_sensor(), shield_xensiv_a_get_i2c());
+}
+#endif
+
+
+/******************************************************************************
+* _shield_xensiv_a_snapshot_finish
+******************************************************************************/
+static void _shield_xensiv_a_snapshot_finish(_shield_xensiv_a_snapshot_sensor_id_t id,
+                                             cy_rslt_t result)
+{
+    const _shield_xensiv_a_snapshot_sensor_t* desc = &_snapshot_sensors[id];
+
+    _snapshot_outstanding &= ~desc->ready_bit;
+    shield_xensiv_a_health_report(desc->ready_bit, result);
+    if (NULL != desc->restore)
+    {
+        desc->restore();
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        _snapshot->valid |= desc->ready_bit;
+    }
+    else if (CY_RSLT_SUCCESS == _snapshot_result)
+    {
+        _snapshot_result = result;
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_snapshot_trigger
+******************************************************************************/
+/* Triggers the conversions which were not triggered yet, with the bus
+   reserved */
+static void _shield_xensiv_a_snapshot_trigger(void)
+{
+    for (uint8_t i = 0; i < _SNAPSHOT_SENSOR_COUNT; i++)
+    {
+        const _shield_xensiv_a_snapshot_sensor_t* desc = &_snapshot_sensors[i];
+
+        if ((_snapshot_untriggered & desc->ready_bit) != 0)
+        {
+            cy_rslt_t trigger_result = (NULL != desc->trigger)
+                ? desc->trigger()
+                : CY_RSLT_SUCCESS;
+
+            _snapshot_untriggered &= ~desc->ready_bit;
+            _snapshot_due_us[i] = shield_xensiv_a_get_timestamp_us() +
+                                  (desc->conversion_ms * US_PER_MS);
+            if (CY_RSLT_SUCCESS != trigger_result)
+            {
+                _shield_xensiv_a_snapshot_finish((_shield_xensiv_a_snapshot_sensor_id_t)i,
+                                                 trigger_result);
+            }
+        }
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_snapshot_start
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_snapshot_start(uint32_t sensors, shield_xensiv_a_snapshot_t* snapshot)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t supported = 0;
+
+    for (uint8_t i = 0; i < _SNAPSHOT_SENSOR_COUNT; i++)
+    {
+        supported |= _snapshot_sensors[i].ready_bit;
+    }
+
+    if ((NULL == snapshot) || (0U == sensors) || ((sensors & ~supported) != 0))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if (NULL != _snapshot)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BUSY;
+    }
+    else if ((shield_xensiv_a_get_ready_mask() & sensors) != sensors)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        snapshot->requested = sensors;
+        snapshot->valid = 0;
+        _snapshot = snapshot;
+        _snapshot_outstanding = sensors;
+        _snapshot_untriggered = sensors;
+        _snapshot_result = CY_RSLT_SUCCESS;
+
+        /* Trigger all conversions first, so that they run concurrently. While
+           the I2C scheduler has a transaction on the bus, the next poll
+           triggers them. */
+        if (CY_RSLT_SUCCESS == shield_xensiv_a_i2c_sched_acquire())
+        {
+            _shield_xensiv_a_snapshot_trigger();
+            shield_xensiv_a_i2c_sched_release();
+        }
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_snapshot_poll
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_snapshot_poll(void)
+{
+    cy_rslt_t result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+
+    /* Leave the results waiting while a scheduled transaction is on the bus */
+    if ((NULL != _snapshot) && (CY_RSLT_SUCCESS == shield_xensiv_a_i2c_sched_acquire()))
+    {
+        _shield_xensiv_a_snapshot_trigger();
+
+        for (uint8_t i = 0; i < _SNAPSHOT_SENSOR_COUNT; i++)
+        {
+            const _shield_xensiv_a_snapshot_sensor_t* desc = &_snapshot_sensors[i];
+            int32_t since_due_us = (int32_t)(shield_xensiv_a_get_timestamp_us() -
+                                             _snapshot_due_us[i]);
+
+            if (((_snapshot_outstanding & desc->ready_bit) != 0) && (since_due_us >= 0))
+            {
+                cy_rslt_t sensor_result = desc->collect(_snapshot);
+
+                if ((SHIELD_XENSIV_A_RSLT_PENDING == sensor_result) &&
+                    ((uint32_t)since_due_us >= (SHIELD_XENSIV_A_SNAPSHOT_TIMEOUT_MS * US_PER_MS)))
+                {
+                    sensor_result = SHIELD_XENSIV_A_RSLT_ERR_TIMEOUT;
+                }
+                if (SHIELD_XENSIV_A_RSLT_PENDING != sensor_result)
+                {
+                    _shield_xensiv_a_snapshot_finish((_shield_xensiv_a_snapshot_sensor_id_t)i,
+                                                     sensor_result);
+                }
+            }
+        }
+        shield_xensiv_a_i2c_sched_release();
+    }
+
+    if ((NULL != _snapshot) && (0U == _snapshot_outstanding))
+    {
+        result = _snapshot_result;
+        _snapshot = NULL;
+    }
+    else if (NULL != _snapshot)
+    {
+        result = SHIELD_XENSIV_A_RSLT_PENDING;
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_snapshot_read
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_snapshot_read(uint32_t sensors, shield_xensiv_a_snapshot_t* snapshot)
+{
+    cy_rslt_t result = shield_xensiv_a_snapshot_start(sensors, snapshot);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = shield_xensiv_a_snapshot_poll();
+        while (SHIELD_XENSIV_A_RSLT_PENDING == result)
+        {
+            cyhal_system_delay_ms(SHIELD_XENSIV_A_SNAPSHOT_POLL_MS);
+            result = shield_xensiv_a_snapshot_poll();
+        }
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_snapshot_abort
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_snapshot_abort(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL != _snapshot)
+    {
+        result = shield_xensiv_a_i2c_sched_acquire();
+    }
+    if ((NULL != _snapshot) && (CY_RSLT_SUCCESS == result))
+    {
+        for (uint8_t i = 0; i < _SNAPSHOT_SENSOR_COUNT; i++)
+        {
+            const _shield_xensiv_a_snapshot_sensor_t* desc = &_snapshot_sensors[i];
+
+            if (((_snapshot_outstanding & ~_snapshot_untriggered & desc->ready_bit) != 0) &&
+                (NULL != desc->restore))
+            {
+                desc->restore();
+            }
+        }
+        shield_xensiv_a_i2c_sched_release();
+        _snapshot_outstanding = 0;
+        _snapshot_untriggered = 0;
+        _snapshot = NULL;
+    }
+
+    return result;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,173 @@
+/******************************************************************************
+ * \file shield_xensiv_a_snapshot.h
+ *
+ * Description: This file is the interface for reading all environmental
+ *              sensors of the SHIELD_XENSIV_A shield board with overlapping
+ *              conversions.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#ifndef SHIELD_XENSIV_A_SNAPSHOT_CO2_MEAS_MS
+/** Duration of a single CO2 measurement after it was triggered */
+#define SHIELD_XENSIV_A_SNAPSHOT_CO2_MEAS_MS    (1150U)
+#endif
+
+#ifndef SHIELD_XENSIV_A_SNAPSHOT_TIMEOUT_MS
+/** Time a sensor may take to deliver its result beyond its conversion time */
+#define SHIELD_XENSIV_A_SNAPSHOT_TIMEOUT_MS     (200U)
+#endif
+
+#ifndef SHIELD_XENSIV_A_SNAPSHOT_POLL_MS
+/** Interval at which shield_xensiv_a_snapshot_read() polls the sensors */
+#define SHIELD_XENSIV_A_SNAPSHOT_POLL_MS        (2U)
+#endif
+
+/** Sensors that can be part of a snapshot */
+#define SHIELD_XENSIV_A_SNAPSHOT_SENSORS        \
+    (SHIELD_XENSIV_A_READY_HUMIDITY | SHIELD_XENSIV_A_READY_PRESSURE | SHIELD_XENSIV_A_READY_CO2)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Results of one snapshot. Only the fields of the sensors in valid are set,
+ * each with the time its result was collected. */
+typedef struct
+{
+    uint32_t    requested;              /**< SHIELD_XENSIV_A_READY_* bits of the sensors read */
+    uint32_t    valid;                  /**< SHIELD_XENSIV_A_READY_* bits of the valid fields */
+    float       temperature;            /**< SHT35 temperature in °C */
+    float       humidity;               /**< SHT35 relative humidity in % */
+    uint32_t    humidity_timestamp_us;  /**< Time of the SHT35 result */
+    float       pressure;               /**< DPS368 pressure in hPa */
+    float       pressure_temperature;   /**< DPS368 temperature in °C */
+    uint32_t    pressure_timestamp_us;  /**< Time of the DPS368 result */
+    uint16_t    co2_ppm;                /**< PAS CO2 concentration in ppm */
+    uint32_t    co2_timestamp_us;       /**< Time of the PAS CO2 result */
+} shield_xensiv_a_snapshot_t;
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_snapshot_start
+******************************************************************************
+* Summary: Starts the conversions of the requested sensors without waiting for
+*          any of them. The SHT35 and the PAS CO2 sensor are triggered for a
+*          single measurement, the DPS368 delivers the next result of its
+*          background measurement. The results are then collected with
+*          shield_xensiv_a_snapshot_poll(). Only one snapshot can be in
+*          progress at a time. The I2C bus is reserved with
+*          shield_xensiv_a_i2c_sched_acquire() for the triggers. While the
+*          I2C scheduler has a transaction on the bus, the conversions are
+*          triggered by the next poll instead. The bus must not be reserved
+*          by the caller.
+*
+* Parameters:
+*  sensors           SHIELD_XENSIV_A_READY_* bits of the sensors to read, a
+*                    subset of SHIELD_XENSIV_A_SNAPSHOT_SENSORS
+*  snapshot          Snapshot receiving the results, must stay valid until the
+*                    snapshot has completed
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_BUSY if a snapshot is in
+*  progress. Errors of the individual sensors are reported by
+*  shield_xensiv_a_snapshot_poll().
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_snapshot_start(uint32_t sensors, shield_xensiv_a_snapshot_t* snapshot);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_snapshot_poll
+******************************************************************************
+* Summary: Collects the results of the sensors whose conversion has completed,
+*          in the order they complete. The SHT35 and the PAS CO2 sensor are
+*          returned to the periodic measurement set up by the shield
+*          initialization once their result has been read. The I2C bus is
+*          reserved like in shield_xensiv_a_snapshot_start(). While the I2C
+*          scheduler has a transaction on the bus, nothing is collected.
+*
+* Parameters: None
+*
+* Return:
+*  SHIELD_XENSIV_A_RSLT_PENDING while a result is outstanding, otherwise the
+*  status of the snapshot: CY_RSLT_SUCCESS if every requested sensor is valid,
+*  or the first error of a sensor, SHIELD_XENSIV_A_RSLT_ERR_TIMEOUT if it did
+*  not deliver its result in time. SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED if
+*  no snapshot is in progress.
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_snapshot_poll(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_snapshot_read
+******************************************************************************
+* Summary: Starts a snapshot and waits until it has completed, polling every
+*          SHIELD_XENSIV_A_SNAPSHOT_POLL_MS. The time taken is about that of
+*          the slowest conversion rather than the sum of all of them.
+*
+* Parameters:
+*  sensors           SHIELD_XENSIV_A_READY_* bits of the sensors to read
+*  snapshot          Snapshot receiving the results
+*
+* Return:
+*  Status of the snapshot, see shield_xensiv_a_snapshot_poll()
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_snapshot_read(uint32_t sensors, shield_xensiv_a_snapshot_t* snapshot);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_snapshot_abort
+******************************************************************************
+* Summary: Abandons the snapshot in progress. Sensors that were triggered are
+*          returned to their periodic measurement.
+*
+* Parameters: None
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_BUSY if the I2C
+*  scheduler has a transaction on the bus. The snapshot is then still in
+*  progress and the call has to be repeated.
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_snapshot_abort(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,334 @@
+/******************************************************************************
+ * \file shield_xensiv_a_stream.c
+ *
+ * Description: Implementation of the unified sample stream of the shield
+ *              support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "shield_xensiv_a_stream.h"
+#include "shield_xensiv_a_metrics.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Reference pressure for the CO2 compensation when no pressure is available */
+#define STREAM_CO2_DEFAULT_PRESSURE_HPA    (1015U)
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static shield_xensiv_a_stream_t*    _stream_attached;
+static uint16_t                     _stream_sequences[SHIELD_XENSIV_A_SENSOR_COUNT];
+
+
+/******************************************************************************
+* _shield_xensiv_a_stream_scale
+******************************************************************************/
+static inline int32_t _shield_xensiv_a_stream_scale(float value)
+{
+    float scaled = value * (float)SHIELD_XENSIV_A_STREAM_SCALE;
+    return (int32_t)((scaled < 0.0f) ? (scaled - 0.5f) : (scaled + 0.5f));
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_stream_init
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_stream_init(shield_xensiv_a_stream_t* stream,
+                                      shield_xensiv_a_sample_t* buffer, uint32_t capacity)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((NULL == stream) || (NULL == buffer) || (capacity == 0) ||
+        ((capacity & (capacity - 1U)) != 0))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else
+    {
+        stream->buffer = buffer;
+        stream->mask = capacity - 1U;
+        stream->head = 0;
+        stream->tail = 0;
+        stream->dropped = 0;
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_stream_push
+******************************************************************************/
+bool shield_xensiv_a_stream_push(shield_xensiv_a_stream_t* stream,
+                                 const shield_xensiv_a_sample_t* sample)
+{
+    uint32_t head = stream->head;
+    bool pushed = ((head - stream->tail) <= stream->mask);
+
+    if (pushed)
+    {
+        stream->buffer[head & stream->mask] = *sample;
+        /* The sample must be visible before the consumer sees the new head */
+        __DMB();
+        stream->head = head + 1U;
+    }
+    else
+    {
+        stream->dropped++;
+    }
+
+    return pushed;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_stream_pop
+******************************************************************************/
+bool shield_xensiv_a_stream_pop(shield_xensiv_a_stream_t* stream,
+                                shield_xensiv_a_sample_t* sample)
+{
+    uint32_t tail = stream->tail;
+    bool popped = (tail != stream->head);
+
+    if (popped)
+    {
+        __DMB();
+        *sample = stream->buffer[tail & stream->mask];
+        /* The slot must be read before the producer may reuse it */
+        __DMB();
+        stream->tail = tail + 1U;
+    }
+
+    return popped;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_stream_count
+******************************************************************************/
+uint32_t shield_xensiv_a_stream_count(const shield_xensiv_a_stream_t* stream)
+{
+    return stream->head - stream->tail;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_stream_attach
+******************************************************************************/
+void shield_xensiv_a_stream_attach(shield_xensiv_a_stream_t* stream)
+{
+    _stream_attached = stream;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_stream_get_attached
+******************************************************************************/
+shield_xensiv_a_stream_t* shield_xensiv_a_stream_get_attached(void)
+{
+    return _stream_attached;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_stream_put
+******************************************************************************/
+bool shield_xensiv_a_stream_put(shield_xensiv_a_sensor_id_t sensor, uint32_t timestamp_us,
+                                const int32_t values[3])
+{
+    bool pushed = true;
+    shield_xensiv_a_stream_t* stream = _stream_attached;
+
+    if ((NULL != stream) && (sensor < SHIELD_XENSIV_A_SENSOR_COUNT))
+    {
+        shield_xensiv_a_sample_t sample =
+        {
+            .sensor       = (uint8_t)sensor,
+            .reserved     = 0,
+            .sequence     = _stream_sequences[sensor]++,
+            .timestamp_us = timestamp_us,
+            .values       = { values[0], values[1], values[2] }
+        };
+        pushed = shield_xensiv_a_stream_push(stream, &sample);
+    }
+
+    return pushed;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_stream_capture
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_stream_capture(uint32_t sensors)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+#if SHIELD_XENSIV_A_USE_CO2
+    uint16_t co2_pressure_hpa = STREAM_CO2_DEFAULT_PRESSURE_HPA;
+#endif
+
+    if ((sensors & ~SHIELD_XENSIV_A_READY_ALL) != 0)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if ((shield_xensiv_a_get_ready_mask() & sensors) != sensors)
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+
+#if SHIELD_XENSIV_A_USE_HUMIDITY
+    if ((CY_RSLT_SUCCESS == result) && ((sensors & SHIELD_XENSIV_A_READY_HUMIDITY) != 0))
+    {
+        mtb_sht3x_value_t value;
+        SHIELD_XENSIV_A_METRICS_BEGIN(start_us);
+        result = mtb_sht3x_read(shield_xensiv_a_get_humidity_sensor(), &value);
+        SHIELD_XENSIV_A_METRICS_END(SHIELD_XENSIV_A_METRICS_HUMIDITY, start_us,
+                                    SHIELD_XENSIV_A_METRICS_SHT35_BYTES, result);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            int32_t values[3] =
+            {
+                _shield_xensiv_a_stream_scale(value.temperature),
+                _shield_xensiv_a_stream_scale(value.humidity),
+                0
+            };
+            (void)shield_xensiv_a_stream_put(SHIELD_XENSIV_A_SENSOR_HUMIDITY,
+                                             shield_xensiv_a_get_timestamp_us(), values);
+        }
+    }
+#endif
+
+#if SHIELD_XENSIV_A_USE_MOTION
+    if ((CY_RSLT_SUCCESS == result) && ((sensors & SHIELD_XENSIV_A_READY_MOTION) != 0))
+    {
+        mtb_bmi270_data_t data;
+        SHIELD_XENSIV_A_METRICS_BEGIN(start_us);
+        result = mtb_bmi270_read(shield_xensiv_a_get_motion_sensor(), &data);
+        SHIELD_XENSIV_A_METRICS_END(SHIELD_XENSIV_A_METRICS_MOTION, start_us,
+                                    SHIELD_XENSIV_A_METRICS_BMI270_BYTES, result);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            uint32_t timestamp_us = shield_xensiv_a_get_timestamp_us();
+            int32_t acc[3] =
+            {
+                data.sensor_data.acc.x, data.sensor_data.acc.y, data.sensor_data.acc.z
+            };
+            int32_t gyr[3] =
+            {
+                data.sensor_data.gyr.x, data.sensor_data.gyr.y, data.sensor_data.gyr.z
+            };
+            (void)shield_xensiv_a_stream_put(SHIELD_XENSIV_A_SENSOR_ACCEL, timestamp_us, acc);
+            (void)shield_xensiv_a_stream_put(SHIELD_XENSIV_A_SENSOR_GYRO, timestamp_us, gyr);
+        }
+    }
+#endif
+
+#if SHIELD_XENSIV_A_USE_MAGNETOMETER
+    if ((CY_RSLT_SUCCESS == result) && ((sensors & SHIELD_XENSIV_A_READY_MAGNETOMETER) != 0))
+    {
+        mtb_bmm350_data_t data;
+        SHIELD_XENSIV_A_METRICS_BEGIN(start_us);
+        result = mtb_bmm350_read(shield_xensiv_a_get_mag_sensor(), &data);
+        SHIELD_XENSIV_A_METRICS_END(SHIELD_XENSIV_A_METRICS_MAGNETOMETER, start_us,
+                                    SHIELD_XENSIV_A_METRICS_BMM350_BYTES, result);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            /* µT scaled by 1000 gives nT */
+            int32_t values[3] =
+            {
+                _shield_xensiv_a_stream_scale(data.sensor_data.x),
+                _shield_xensiv_a_stream_scale(data.sensor_data.y),
+                _shield_xensiv_a_stream_scale(data.sensor_data.z)
+            };
+            (void)shield_xensiv_a_stream_put(SHIELD_XENSIV_A_SENSOR_MAGNETOMETER,
+                                             shield_xensiv_a_get_timestamp_us(), values);
+        }
+    }
+#endif
+
+#if SHIELD_XENSIV_A_USE_PRESSURE
+    if ((CY_RSLT_SUCCESS == result) && ((sensors & SHIELD_XENSIV_A_READY_PRESSURE) != 0))
+    {
+        float pressure, temperature;
+        SHIELD_XENSIV_A_METRICS_BEGIN(start_us);
+        result = xensiv_dps3xx_read(shield_xensiv_a_get_pressure_sensor(), &pressure,
+                                    &temperature);
+        SHIELD_XENSIV_A_METRICS_END(SHIELD_XENSIV_A_METRICS_PRESSURE, start_us,
+                                    SHIELD_XENSIV_A_METRICS_DPS368_BYTES, result);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            int32_t values[3] =
+            {
+                _shield_xensiv_a_stream_scale(pressure),
+                _shield_xensiv_a_stream_scale(temperature),
+                0
+            };
+            (void)shield_xensiv_a_stream_put(SHIELD_XENSIV_A_SENSOR_PRESSURE,
+                                             shield_xensiv_a_get_timestamp_us(), values);
+#if SHIELD_XENSIV_A_USE_CO2
+            co2_pressure_hpa = (uint16_t)(pressure + 0.5f);
+#endif
+        }
+    }
+#endif
+
+#if SHIELD_XENSIV_A_USE_CO2
+    if ((CY_RSLT_SUCCESS == result) && ((sensors & SHIELD_XENSIV_A_READY_CO2) != 0))
+    {
+        uint16_t ppm;
+        SHIELD_XENSIV_A_METRICS_BEGIN(start_us);
+        cy_rslt_t co2_result = xensiv_pasco2_mtb_read(shield_xensiv_a_get_co2_sensor(),
+                                                      co2_pressure_hpa, &ppm);
+        /* A result which is not ready yet was still read successfully */
+        SHIELD_XENSIV_A_METRICS_END(SHIELD_XENSIV_A_METRICS_CO2, start_us,
+                                    SHIELD_XENSIV_A_METRICS_PASCO2_BYTES,
+                                    (XENSIV_PASCO2_READ_NRDY == co2_result)
+                                    ? CY_RSLT_SUCCESS
+                                    : co2_result);
+        if (XENSIV_PASCO2_OK == co2_result)
+        {
+            int32_t values[3] = { ppm, 0, 0 };
+            (void)shield_xensiv_a_stream_put(SHIELD_XENSIV_A_SENSOR_CO2,
+                                             shield_xensiv_a_get_timestamp_us(), values);
+        }
+        else if (XENSIV_PASCO2_READ_NRDY != co2_result)
+        {
+            result = co2_result;
+        }
+    }
+#endif
+
+    return result;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,245 @@
+/******************************************************************************
+ * \file shield_xensiv_a_stream.h
+ *
+ * Description: This file is the interface for the unified, timestamped sample
+ *              stream of the sensors on the SHIELD_XENSIV_A shield board.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/** Scaling of the values which the drivers report as floating point numbers,
+ * these are stored in thousandths of the driver unit
+ */
+#define SHIELD_XENSIV_A_STREAM_SCALE            (1000)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Sensor which produced a sample, and the meaning of its values */
+typedef enum
+{
+    /** values[0]: temperature in m°C, values[1]: relative humidity in m% */
+    SHIELD_XENSIV_A_SENSOR_HUMIDITY     = 0,
+    /** values[0..2]: raw accelerometer x, y, z */
+    SHIELD_XENSIV_A_SENSOR_ACCEL        = 1,
+    /** values[0..2]: raw gyroscope x, y, z */
+    SHIELD_XENSIV_A_SENSOR_GYRO         = 2,
+    /** values[0..2]: magnetic field x, y, z in nT */
+    SHIELD_XENSIV_A_SENSOR_MAGNETOMETER = 3,
+    /** values[0]: pressure in 1/1000 hPa, values[1]: temperature in m°C */
+    SHIELD_XENSIV_A_SENSOR_PRESSURE     = 4,
+    /** values[0]: CO2 concentration in ppm */
+    SHIELD_XENSIV_A_SENSOR_CO2          = 5,
+    /** Number of sensor ids */
+    SHIELD_XENSIV_A_SENSOR_COUNT
+} shield_xensiv_a_sensor_id_t;
+
+/** A sample record of fixed size */
+typedef struct
+{
+    /** Source of the sample, see shield_xensiv_a_sensor_id_t */
+    uint8_t     sensor;
+    /** Reserved, set to 0 */
+    uint8_t     reserved;
+    /** Per-sensor running number, gaps indicate lost samples */
+    uint16_t    sequence;
+    /** Acquisition time, see shield_xensiv_a_get_timestamp_us() */
+    uint32_t    timestamp_us;
+    /** Sensor values, unused entries are 0 */
+    int32_t     values[3];
+} shield_xensiv_a_sample_t;
+
+/** Single-producer / single-consumer ring of samples */
+typedef struct
+{
+    /** Storage supplied by the application */
+    shield_xensiv_a_sample_t*   buffer;
+    /** Capacity - 1, the capacity is a power of two */
+    uint32_t                    mask;
+    /** Number of samples pushed, only written by the producer */
+    volatile uint32_t           head;
+    /** Number of samples popped, only written by the consumer */
+    volatile uint32_t           tail;
+    /** Number of samples rejected because the ring was full */
+    volatile uint32_t           dropped;
+} shield_xensiv_a_stream_t;
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_stream_init
+******************************************************************************
+* Summary: Initializes an empty ring on caller supplied storage.
+*
+* Parameters:
+*  stream            The ring to initialize
+*  buffer            Storage for the samples
+*  capacity          Number of samples in buffer, must be a power of two
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_stream_init(shield_xensiv_a_stream_t* stream,
+                                      shield_xensiv_a_sample_t* buffer, uint32_t capacity);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_stream_push
+******************************************************************************
+* Summary: Appends a sample. Must only be called from the producer context.
+*
+* Parameters:
+*  stream            The ring
+*  sample            The sample to copy into the ring
+*
+* Return:
+*  false if the ring was full and the sample was dropped
+*
+******************************************************************************/
+bool shield_xensiv_a_stream_push(shield_xensiv_a_stream_t* stream,
+                                 const shield_xensiv_a_sample_t* sample);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_stream_pop
+******************************************************************************
+* Summary: Removes the oldest sample. Must only be called from the consumer
+*          context.
+*
+* Parameters:
+*  stream            The ring
+*  sample            Receives the sample
+*
+* Return:
+*  false if the ring was empty
+*
+******************************************************************************/
+bool shield_xensiv_a_stream_pop(shield_xensiv_a_stream_t* stream,
+                                shield_xensiv_a_sample_t* sample);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_stream_count
+******************************************************************************
+* Summary: Gets the number of samples waiting in the ring.
+*
+* Parameters:
+*  stream            The ring
+*
+* Return:
+*  Number of samples
+*
+******************************************************************************/
+uint32_t shield_xensiv_a_stream_count(const shield_xensiv_a_stream_t* stream);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_stream_attach
+******************************************************************************
+* Summary: Selects the ring into which the acquisition paths of the library
+*          push their samples. Currently these are the motion FIFO reads and
+*          shield_xensiv_a_stream_capture(). The library is then the producer
+*          of the ring.
+*
+* Parameters:
+*  stream            The ring, or NULL to detach
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_stream_attach(shield_xensiv_a_stream_t* stream);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_stream_get_attached
+******************************************************************************
+* Summary: Gets the ring selected with shield_xensiv_a_stream_attach().
+*
+* Parameters: None
+*
+* Return:
+*  The attached ring or NULL
+*
+******************************************************************************/
+shield_xensiv_a_stream_t* shield_xensiv_a_stream_get_attached(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_stream_put
+******************************************************************************
+* Summary: Pushes a sample to the attached ring, assigning the next sequence
+*          number of the sensor. Does nothing if no ring is attached. This is
+*          used by the acquisition paths of the library and may be used for
+*          samples acquired by the application in the same producer context.
+*
+* Parameters:
+*  sensor            The sensor which produced the sample
+*  timestamp_us      Acquisition time of the sample
+*  values            The three values of the sample
+*
+* Return:
+*  false if a ring is attached and the sample was dropped
+*
+******************************************************************************/
+bool shield_xensiv_a_stream_put(shield_xensiv_a_sensor_id_t sensor, uint32_t timestamp_us,
+                                const int32_t values[3]);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_stream_capture
+******************************************************************************
+* Summary: Reads the selected sensors once and pushes one sample per sensor to
+*          the attached ring. A CO2 sensor without a new result is skipped.
+*
+* Parameters:
+*  sensors           The sensors to read, a combination of
+*                    SHIELD_XENSIV_A_READY_HUMIDITY, _MOTION, _MAGNETOMETER,
+*                    _PRESSURE and _CO2
+*
+* Return:
+*  Status of the operation
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_stream_capture(uint32_t sensors);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,806 @@
+/******************************************************************************
+ * \file shield_xensiv_a_trigger.c
+ *
+ * Description: Implementation of the event triggered capture of the shield
+ *              support library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include <math.h>
+#include <string.h>
+#include "shield_xensiv_a_trigger.h"
+#include "shield_xensiv_a_health.h"
+#include "shield_xensiv_a_i2c_sched.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define TRIGGER_MOTION_SOURCES     (SHIELD_XENSIV_A_TRIGGER_ANY_MOTION | \
+                                    SHIELD_XENSIV_A_TRIGGER_NO_MOTION |  \
+                                    SHIELD_XENSIV_A_TRIGGER_SIG_MOTION)
+#define TRIGGER_ALL_SOURCES        (TRIGGER_MOTION_SOURCES | SHIELD_XENSIV_A_TRIGGER_SOUND)
+/* Limits of the BMI270 any-motion and no-motion settings */
+#define TRIGGER_MAX_THRESHOLD      (0x7FFU)
+#define TRIGGER_MAX_DURATION       (0x1FFFU)
+/* Largest accepted sound threshold */
+#define TRIGGER_MAX_SOUND_DB       (90.0f)
+/* Fractional bits of the sound threshold ratio */
+#define TRIGGER_RATIO_SHIFT        (8U)
+/* The noise floor rises by 1/64 of the difference per frame */
+#define TRIGGER_FLOOR_SHIFT        (6U)
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+/* Overwriting ring of fixed size elements. The oldest "captured" elements
+   belong to an event and are not dropped when trimming to the pre-trigger
+   time. */
+typedef struct
+{
+    uint8_t*    buffer;
+    uint32_t    capacity;
+    uint32_t    size;
+    uint32_t    head;
+    uint32_t    count;
+    uint32_t    captured;
+} _shield_xensiv_a_trigger_ring_t;
+
+static shield_xensiv_a_trigger_cfg_t        _trigger_cfg;
+static shield_xensiv_a_trigger_callback_t   _trigger_callback;
+static void*                                _trigger_callback_arg;
+static bool                                 _trigger_armed;
+static uint32_t                             _trigger_fired;
+
+static _shield_xensiv_a_trigger_ring_t      _trigger_motion;
+static _shield_xensiv_a_trigger_ring_t      _trigger_audio;
+static uint32_t                             _trigger_motion_newest_us;
+static uint32_t                             _trigger_audio_last_us;
+static uint32_t                             _trigger_pre_samples;
+
+/* Data from capture_from up to window_end belongs to an event */
+static bool                                 _trigger_has_event;
+static uint32_t                             _trigger_capture_from_us;
+static uint32_t                             _trigger_window_end_us;
+
+/* Sound activity detector */
+static uint32_t                             _trigger_sound_ratio;
+static uint32_t                             _trigger_sound_sum;
+static uint32_t                             _trigger_sound_samples;
+static uint32_t                             _trigger_sound_floor;
+static bool                                 _trigger_sound_has_floor;
+static bool                                 _trigger_sound_active;
+
+#if SHIELD_XENSIV_A_USE_MOTION
+static cyhal_gpio_t                         _trigger_motion_pin = NC;
+static cyhal_gpio_callback_data_t           _trigger_motion_callback_data;
+static volatile bool                        _trigger_motion_pending;
+static volatile uint32_t                    _trigger_motion_irq_us;
+#endif
+
+
+/******************************************************************************
+* _shield_xensiv_a_trigger_ring_init
+******************************************************************************/
+static void _shield_xensiv_a_trigger_ring_init(_shield_xensiv_a_trigger_ring_t* ring,
+                                               void* buffer, uint32_t capacity, uint32_t size)
+{
+    ring->buffer   = (uint8_t*)buffer;
+    ring->capacity = (NULL == buffer) ? 0U : capacity;
+    ring->size     = size;
+    ring->head     = 0;
+    ring->count    = 0;
+    ring->captured = 0;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_trigger_ring_drop
+******************************************************************************/
+static void _shield_xensiv_a_trigger_ring_drop(_shield_xensiv_a_trigger_ring_t* ring, uint32_t n)
+{
+    if (n > ring->count)
+    {
+        n = ring->count;
+    }
+    if (n > 0U)
+    {
+        ring->head = (ring->head + n) % ring->capacity;
+        ring->count -= n;
+        ring->captured = (ring->captured > n) ? (ring->captured - n) : 0U;
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_trigger_ring_write
+******************************************************************************/
+/* Appends elements, overwriting the oldest ones if needed. If capture is set,
+   everything in the ring is kept for the event. */
+static void _shield_xensiv_a_trigger_ring_write(_shield_xensiv_a_trigger_ring_t* ring,
+                                                const void* data, uint32_t n, bool capture)
+{
+    const uint8_t* src = (const uint8_t*)data;
+
+    if (ring->capacity > 0U)
+    {
+        if (n > ring->capacity)
+        {
+            src += (n - ring->capacity) * ring->size;
+            n = ring->capacity;
+        }
+        if ((ring->count + n) > ring->capacity)
+        {
+            _shield_xensiv_a_trigger_ring_drop(ring, ring->count + n - ring->capacity);
+        }
+
+        /* At most two copies, the second one after wrapping around */
+        uint32_t tail  = (ring->head + ring->count) % ring->capacity;
+        uint32_t first = ring->capacity - tail;
+        if (first > n)
+        {
+            first = n;
+        }
+        memcpy(&ring->buffer[tail * ring->size], src, first * ring->size);
+        memcpy(ring->buffer, &src[first * ring->size], (n - first) * ring->size);
+
+        ring->count += n;
+        if (capture)
+        {
+            ring->captured = ring->count;
+        }
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_trigger_ring_read
+******************************************************************************/
+static uint32_t _shield_xensiv_a_trigger_ring_read(_shield_xensiv_a_trigger_ring_t* ring,
+                                                   void* data, uint32_t max)
+{
+    uint8_t* dst = (uint8_t*)data;
+    uint32_t n = (max < ring->count) ? max : ring->count;
+
+    if (n > 0U)
+    {
+        uint32_t first = ring->capacity - ring->head;
+        if (first > n)
+        {
+            first = n;
+        }
+        memcpy(dst, &ring->buffer[ring->head * ring->size], first * ring->size);
+        memcpy(&dst[first * ring->size], ring->buffer, (n - first) * ring->size);
+        _shield_xensiv_a_trigger_ring_drop(ring, n);
+    }
+
+    return n;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_trigger_samples_us
+******************************************************************************/
+/* Duration of a number of audio samples */
+static inline uint32_t _shield_xensiv_a_trigger_samples_us(uint32_t samples)
+{
+    return (uint32_t)(((uint64_t)samples * 1000000ULL) / _trigger_cfg.sample_rate_hz);
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_trigger_in_capture
+******************************************************************************/
+static inline bool _shield_xensiv_a_trigger_in_capture(uint32_t timestamp_us)
+{
+    return _trigger_has_event &&
+           ((uint32_t)(timestamp_us - _trigger_capture_from_us) <=
+            (uint32_t)(_trigger_window_end_us - _trigger_capture_from_us));
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_trigger_oldest_motion_us
+******************************************************************************/
+static inline uint32_t _shield_xensiv_a_trigger_oldest_motion_us(void)
+{
+    const shield_xensiv_a_motion_frame_t* frames =
+        (const shield_xensiv_a_motion_frame_t*)(const void*)_trigger_motion.buffer;
+    return frames[_trigger_motion.head].timestamp_us;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_trigger_trim
+******************************************************************************/
+/* Keeps only the pre-trigger time of the data while no event is captured */
+static void _shield_xensiv_a_trigger_trim(void)
+{
+    if (0U == _trigger_motion.captured)
+    {
+        uint32_t pre_us = _trigger_cfg.pre_trigger_ms * 1000UL;
+        while ((_trigger_motion.count > 0U) &&
+               ((uint32_t)(_trigger_motion_newest_us -
+                           _shield_xensiv_a_trigger_oldest_motion_us()) > pre_us))
+        {
+            _shield_xensiv_a_trigger_ring_drop(&_trigger_motion, 1);
+        }
+    }
+
+    if ((0U == _trigger_audio.captured) && (_trigger_audio.count > _trigger_pre_samples))
+    {
+        _shield_xensiv_a_trigger_ring_drop(&_trigger_audio,
+                                           _trigger_audio.count - _trigger_pre_samples);
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_trigger_fire
+******************************************************************************/
+static void _shield_xensiv_a_trigger_fire(uint32_t sources, uint32_t timestamp_us)
+{
+    /* A new event during the capture of the previous one extends it */
+    if (!_shield_xensiv_a_trigger_in_capture(timestamp_us))
+    {
+        _trigger_capture_from_us = timestamp_us - (_trigger_cfg.pre_trigger_ms * 1000UL);
+    }
+    _trigger_window_end_us = timestamp_us + (_trigger_cfg.post_trigger_ms * 1000UL);
+    _trigger_has_event = true;
+
+    /* Drop what is older than the pre-trigger time of the event, the motion
+       frames may lag behind the event by the FIFO watermark */
+    if (0U == _trigger_motion.captured)
+    {
+        while ((_trigger_motion.count > 0U) &&
+               ((int32_t)(_shield_xensiv_a_trigger_oldest_motion_us() -
+                          _trigger_capture_from_us) < 0))
+        {
+            _shield_xensiv_a_trigger_ring_drop(&_trigger_motion, 1);
+        }
+    }
+    if ((0U == _trigger_audio.captured) && (_trigger_audio.count > 0U))
+    {
+        int32_t since_us = (int32_t)(_trigger_audio_last_us - _trigger_capture_from_us);
+        uint32_t keep = (since_us < 0) ? 0U
+                        : (uint32_t)((((uint64_t)(uint32_t)since_us *
+                                       _trigger_cfg.sample_rate_hz) / 1000000ULL) + 1U);
+        if (_trigger_audio.count > keep)
+        {
+            _shield_xensiv_a_trigger_ring_drop(&_trigger_audio, _trigger_audio.count - keep);
+        }
+    }
+    _trigger_motion.captured = _trigger_motion.count;
+    _trigger_audio.captured  = _trigger_audio.count;
+
+    _trigger_fired |= sources;
+    if (NULL != _trigger_callback)
+    {
+        _trigger_callback(sources, timestamp_us, _trigger_callback_arg);
+    }
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_trigger_sound_frame
+******************************************************************************/
+static void _shield_xensiv_a_trigger_sound_frame(uint32_t timestamp_us)
+{
+    uint32_t level = _trigger_sound_sum / _trigger_sound_samples;
+    _trigger_sound_sum = 0;
+    _trigger_sound_samples = 0;
+
+    if (!_trigger_sound_has_floor)
+    {
+        _trigger_sound_floor = level << TRIGGER_FLOOR_SHIFT;
+        _trigger_sound_has_floor = true;
+    }
+
+    /* Threshold and level scaled by the fractional bits of the ratio */
+    uint64_t threshold = ((uint64_t)(_trigger_sound_floor >> TRIGGER_FLOOR_SHIFT) *
+                          _trigger_sound_ratio);
+    uint64_t scaled = (uint64_t)level << TRIGGER_RATIO_SHIFT;
+
+    if (!_trigger_sound_active && (level >= _trigger_cfg.sound_min_level) &&
+        (scaled > threshold))
+    {
+        _trigger_sound_active = true;
+        _shield_xensiv_a_trigger_fire(SHIELD_XENSIV_A_TRIGGER_SOUND, timestamp_us);
+    }
+    else if (_trigger_sound_active &&
+             ((level < _trigger_cfg.sound_min_level) || ((scaled * 2U) <= threshold)))
+    {
+        /* 6 dB of hysteresis */
+        _trigger_sound_active = false;
+    }
+
+    /* Falls at once, rises slowly, so continuous sound stops being active */
+    if ((level << TRIGGER_FLOOR_SHIFT) < _trigger_sound_floor)
+    {
+        _trigger_sound_floor = level << TRIGGER_FLOOR_SHIFT;
+    }
+    else
+    {
+        _trigger_sound_floor += level - (_trigger_sound_floor >> TRIGGER_FLOOR_SHIFT);
+    }
+}
+
+
+#if SHIELD_XENSIV_A_USE_MOTION
+/******************************************************************************
+* _shield_xensiv_a_trigger_motion_irq
+******************************************************************************/
+static void _shield_xensiv_a_trigger_motion_irq(void* callback_arg, cyhal_gpio_event_t event)
+{
+    (void)callback_arg;
+    (void)event;
+
+    _trigger_motion_irq_us = shield_xensiv_a_get_timestamp_us();
+    _trigger_motion_pending = true;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_trigger_config_motion
+******************************************************************************/
+static cy_rslt_t _shield_xensiv_a_trigger_config_motion(bool enable)
+{
+    struct bmi2_dev* dev = &shield_xensiv_a_get_motion_sensor()->sensor;
+    enum bmi2_hw_int_pin pin = (2U == _trigger_cfg.motion_int) ? BMI2_INT2 : BMI2_INT1;
+    uint8_t features[3];
+    struct bmi2_sens_config config[3];
+    struct bmi2_sens_int_config int_config[3];
+    uint8_t count = 0;
+    int8_t rslt = BMI2_OK;
+
+    if ((_trigger_cfg.sources & SHIELD_XENSIV_A_TRIGGER_ANY_MOTION) != 0)
+    {
+        features[count++] = BMI2_ANY_MOTION;
+    }
+    if ((_trigger_cfg.sources & SHIELD_XENSIV_A_TRIGGER_NO_MOTION) != 0)
+    {
+        features[count++] = BMI2_NO_MOTION;
+    }
+    if ((_trigger_cfg.sources & SHIELD_XENSIV_A_TRIGGER_SIG_MOTION) != 0)
+    {
+        features[count++] = BMI2_SIG_MOTION;
+    }
+    for (uint8_t i = 0; i < count; i++)
+    {
+        config[i].type = features[i];
+        int_config[i].type = features[i];
+        int_config[i].hw_int_pin = enable ? pin : BMI2_INT_NONE;
+    }
+
+    if (enable)
+    {
+        /* The significant motion feature keeps its default settings */
+        rslt = bmi270_get_sensor_config(config, count, dev);
+        for (uint8_t i = 0; (BMI2_OK == rslt) && (i < count); i++)
+        {
+            if (BMI2_ANY_MOTION == config[i].type)
+            {
+                config[i].cfg.any_motion.threshold = _trigger_cfg.motion_threshold;
+                config[i].cfg.any_motion.duration  = _trigger_cfg.motion_duration;
+                config[i].cfg.any_motion.select_x  = BMI2_ENABLE;
+                config[i].cfg.any_motion.select_y  = BMI2_ENABLE;
+                config[i].cfg.any_motion.select_z  = BMI2_ENABLE;
+            }
+            else if (BMI2_NO_MOTION == config[i].type)
+            {
+                config[i].cfg.no_motion.threshold = _trigger_cfg.motion_threshold;
+                config[i].cfg.no_motion.duration  = _trigger_cfg.motion_duration;
+                config[i].cfg.no_motion.select_x  = BMI2_ENABLE;
+                config[i].cfg.no_motion.select_y  = BMI2_ENABLE;
+                config[i].cfg.no_motion.select_z  = BMI2_ENABLE;
+            }
+        }
+        if (BMI2_OK == rslt)
+        {
+            rslt = bmi270_set_sensor_config(config, count, dev);
+        }
+        if (BMI2_OK == rslt)
+        {
+            rslt = bmi270_sensor_enable(features, count, dev);
+        }
+
+        struct bmi2_int_pin_config pin_config;
+        uint8_t index = (BMI2_INT2 == pin) ? 1U : 0U;
+        if (BMI2_OK == rslt)
+        {
+            rslt = bmi2_get_int_pin_config(&pin_config, dev);
+        }
+        if (BMI2_OK == rslt)
+        {
+            pin_config.pin_type = (uint8_t)pin;
+            pin_config.int_latch = BMI2_INT_NON_LATCH;
+            pin_config.pin_cfg[index].output_en = BMI2_INT_OUTPUT_ENABLE;
+            pin_config.pin_cfg[index].od = BMI2_INT_PUSH_PULL;
+            pin_config.pin_cfg[index].lvl = BMI2_INT_ACTIVE_HIGH;
+            pin_config.pin_cfg[index].input_en = BMI2_DISABLE;
+            rslt = bmi2_set_int_pin_config(&pin_config, dev);
+        }
+    }
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi270_map_feat_int(int_config, count, dev);
+    }
+    if ((BMI2_OK == rslt) && !enable)
+    {
+        rslt = bmi270_sensor_disable(features, count, dev);
+    }
+
+    return (BMI2_OK == rslt) ? CY_RSLT_SUCCESS : SHIELD_XENSIV_A_RSLT_ERR_SENSOR;
+}
+
+
+/******************************************************************************
+* _shield_xensiv_a_trigger_process_motion
+******************************************************************************/
+static void _shield_xensiv_a_trigger_process_motion(void)
+{
+    /* While a scheduled transaction is on the bus the status is read by a later call */
+    if (_trigger_motion_pending && (CY_RSLT_SUCCESS == shield_xensiv_a_i2c_sched_acquire()))
+    {
+        uint16_t status = 0;
+        uint32_t sources = 0;
+
+        uint32_t state = cyhal_system_critical_section_enter();
+        uint32_t timestamp_us = _trigger_motion_irq_us;
+        _trigger_motion_pending = false;
+        cyhal_system_critical_section_exit(state);
+
+        /* Reading the status clears it */
+        int8_t rslt = bmi2_get_int_status(&status, &shield_xensiv_a_get_motion_sensor()->sensor);
+        shield_xensiv_a_i2c_sched_release();
+        shield_xensiv_a_health_report(SHIELD_XENSIV_A_READY_MOTION,
+                                      (BMI2_OK == rslt) ? CY_RSLT_SUCCESS
+                                      : SHIELD_XENSIV_A_RSLT_ERR_SENSOR);
+
+        if ((status & BMI270_ANY_MOT_STATUS_MASK) != 0)
+        {
+            sources |= SHIELD_XENSIV_A_TRIGGER_ANY_MOTION;
+        }
+        if ((status & BMI270_NO_MOT_STATUS_MASK) != 0)
+        {
+            sources |= SHIELD_XENSIV_A_TRIGGER_NO_MOTION;
+        }
+        if ((status & BMI270_SIG_MOT_STATUS_MASK) != 0)
+        {
+            sources |= SHIELD_XENSIV_A_TRIGGER_SIG_MOTION;
+        }
+        sources &= _trigger_cfg.sources;
+
+        if (0U != sources)
+        {
+            _shield_xensiv_a_trigger_fire(sources, timestamp_us);
+        }
+    }
+}
+#endif /* SHIELD_XENSIV_A_USE_MOTION */
+
+
+/******************************************************************************
+* shield_xensiv_a_trigger_init
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_trigger_init(const shield_xensiv_a_trigger_cfg_t* cfg,
+                                       shield_xensiv_a_trigger_callback_t callback,
+                                       void* callback_arg)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((NULL == cfg) || _trigger_armed || ((cfg->sources & ~TRIGGER_ALL_SOURCES) != 0))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if (((cfg->sources & TRIGGER_MOTION_SOURCES) != 0) &&
+             ((!SHIELD_XENSIV_A_USE_MOTION) ||
+              ((1U != cfg->motion_int) && (2U != cfg->motion_int))))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if (((cfg->sources & (SHIELD_XENSIV_A_TRIGGER_ANY_MOTION |
+                               SHIELD_XENSIV_A_TRIGGER_NO_MOTION)) != 0) &&
+             ((0U == cfg->motion_threshold) || (cfg->motion_threshold > TRIGGER_MAX_THRESHOLD) ||
+              (0U == cfg->motion_duration) || (cfg->motion_duration > TRIGGER_MAX_DURATION)))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if ((((cfg->sources & SHIELD_XENSIV_A_TRIGGER_SOUND) != 0) ||
+              (NULL != cfg->audio_buffer)) && (0U == cfg->sample_rate_hz))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if (((cfg->sources & SHIELD_XENSIV_A_TRIGGER_SOUND) != 0) &&
+             ((0U == cfg->sound_frame_samples) || !(cfg->sound_threshold_db >= 0.0f) ||
+              (cfg->sound_threshold_db > TRIGGER_MAX_SOUND_DB)))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_BAD_ARG;
+    }
+    else if (((cfg->sources & TRIGGER_MOTION_SOURCES) != 0) &&
+             ((shield_xensiv_a_get_ready_mask() & SHIELD_XENSIV_A_READY_MOTION) == 0))
+    {
+        result = SHIELD_XENSIV_A_RSLT_ERR_NOT_INITIALIZED;
+    }
+    else
+    {
+        _trigger_cfg = *cfg;
+        _trigger_callback = callback;
+        _trigger_callback_arg = callback_arg;
+        _trigger_fired = 0;
+        _trigger_has_event = false;
+
+        _shield_xensiv_a_trigger_ring_init(&_trigger_motion, cfg->motion_buffer,
+                                           cfg->motion_capacity,
+                                           sizeof(shield_xensiv_a_motion_frame_t));
+        _shield_xensiv_a_trigger_ring_init(&_trigger_audio, cfg->audio_buffer,
+                                           cfg->audio_capacity, sizeof(int16_t));
+        _trigger_pre_samples = (uint32_t)(((uint64_t)cfg->pre_trigger_ms *
+                                           cfg->sample_rate_hz) / 1000U);
+
+        _trigger_sound_ratio = (uint32_t)((powf(10.0f, cfg->sound_threshold_db / 20.0f) *
+                                           (float)(1UL << TRIGGER_RATIO_SHIFT)) + 0.5f);
+        _trigger_sound_sum = 0;
+        _trigger_sound_samples = 0;
+        _trigger_sound_has_floor = false;
+        _trigger_sound_active = false;
+    }
+
+#if SHIELD_XENSIV_A_USE_MOTION
+    if ((CY_RSLT_SUCCESS == result) && ((cfg->sources & TRIGGER_MOTION_SOURCES) != 0))
+    {
+        result = shield_xensiv_a_i2c_sched_acquire();
+    }
+    if ((CY_RSLT_SUCCESS == result) && ((cfg->sources & TRIGGER_MOTION_SOURCES) != 0))
+    {
+        _trigger_motion_pin = (2U == cfg->motion_int) ? shield_xensiv_a_get_pins()->imu_int_2
+                                                      : shield_xensiv_a_get_pins()->imu_int_1;
+        _trigger_motion_pending = false;
+        result = cyhal_gpio_init(_trigger_motion_pin, CYHAL_GPIO_DIR_INPUT,
+                                 CYHAL_GPIO_DRIVE_NONE, false);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            _trigger_motion_callback_data.callback = _shield_xensiv_a_trigger_motion_irq;
+            _trigger_motion_callback_data.callback_arg = NULL;
+            cyhal_gpio_register_callback(_trigger_motion_pin, &_trigger_motion_callback_data);
+            cyhal_gpio_enable_event(_trigger_motion_pin, CYHAL_GPIO_IRQ_RISE,
+                                    cfg->intr_priority, true);
+
+            result = _shield_xensiv_a_trigger_config_motion(true);
+            if (CY_RSLT_SUCCESS != result)
+            {
+                cyhal_gpio_enable_event(_trigger_motion_pin, CYHAL_GPIO_IRQ_RISE,
+                                        cfg->intr_priority, false);
+                cyhal_gpio_free(_trigger_motion_pin);
+            }
+        }
+        shield_xensiv_a_i2c_sched_release();
+        if (CY_RSLT_SUCCESS != result)
+        {
+            _trigger_motion_pin = NC;
+        }
+    }
+#endif
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        _trigger_armed = true;
+    }
+
+    return result;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_trigger_feed_motion
+******************************************************************************/
+void shield_xensiv_a_trigger_feed_motion(const shield_xensiv_a_motion_frame_t* frames,
+                                         uint16_t num_frames)
+{
+    if (_trigger_armed && (NULL != frames))
+    {
+        for (uint16_t i = 0; i < num_frames; i++)
+        {
+            _trigger_motion_newest_us = frames[i].timestamp_us;
+            _shield_xensiv_a_trigger_ring_write(&_trigger_motion, &frames[i], 1,
+                                                _shield_xensiv_a_trigger_in_capture(
+                                                    frames[i].timestamp_us));
+        }
+        _shield_xensiv_a_trigger_trim();
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_trigger_feed_audio
+******************************************************************************/
+void shield_xensiv_a_trigger_feed_audio(const int16_t* samples, size_t num_samples,
+                                        uint32_t timestamp_us)
+{
+    bool sound = ((_trigger_cfg.sources & SHIELD_XENSIV_A_TRIGGER_SOUND) != 0);
+    size_t done = 0;
+
+    if (!_trigger_armed || (NULL == samples) || (0U == _trigger_cfg.sample_rate_hz))
+    {
+        num_samples = 0;
+    }
+
+    /* Split at the ends of the detector frames, so an event sees exactly the
+       samples up to its frame */
+    while (done < num_samples)
+    {
+        size_t piece = num_samples - done;
+        if (sound && (piece > (_trigger_cfg.sound_frame_samples - _trigger_sound_samples)))
+        {
+            piece = _trigger_cfg.sound_frame_samples - _trigger_sound_samples;
+        }
+
+        _trigger_audio_last_us = timestamp_us -
+                                 _shield_xensiv_a_trigger_samples_us(
+                                     (uint32_t)(num_samples - done - piece));
+        _shield_xensiv_a_trigger_ring_write(&_trigger_audio, &samples[done], (uint32_t)piece,
+                                            _shield_xensiv_a_trigger_in_capture(
+                                                _trigger_audio_last_us));
+
+        if (sound)
+        {
+            for (size_t i = done; i < (done + piece); i++)
+            {
+                int32_t sample = samples[i];
+                _trigger_sound_sum += (uint32_t)((sample < 0) ? -sample : sample);
+            }
+            _trigger_sound_samples += (uint32_t)piece;
+            if (_trigger_sound_samples == _trigger_cfg.sound_frame_samples)
+            {
+                _shield_xensiv_a_trigger_sound_frame(_trigger_audio_last_us);
+            }
+        }
+
+        done += piece;
+        _shield_xensiv_a_trigger_trim();
+    }
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_trigger_process
+******************************************************************************/
+uint32_t shield_xensiv_a_trigger_process(void)
+{
+    uint32_t fired = 0;
+
+    if (_trigger_armed)
+    {
+#if SHIELD_XENSIV_A_USE_MOTION
+        _shield_xensiv_a_trigger_process_motion();
+#endif
+
+        if (((_trigger_cfg.sources & SHIELD_XENSIV_A_TRIGGER_SOUND) != 0) ||
+            (_trigger_audio.capacity > 0U))
+        {
+            shield_xensiv_a_audio_block_t block;
+            while (shield_xensiv_a_audio_acquire_block(&block))
+            {
+                shield_xensiv_a_trigger_feed_audio(block.samples, block.num_samples,
+                                                   block.timestamp_us);
+                shield_xensiv_a_audio_release_block();
+            }
+        }
+
+        fired = _trigger_fired;
+        _trigger_fired = 0;
+    }
+
+    return fired;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_trigger_read_motion
+******************************************************************************/
+uint32_t shield_xensiv_a_trigger_read_motion(shield_xensiv_a_motion_frame_t* frames,
+                                             uint32_t max_frames)
+{
+    return (NULL != frames)
+           ? _shield_xensiv_a_trigger_ring_read(&_trigger_motion, frames, max_frames)
+           : 0U;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_trigger_read_audio
+******************************************************************************/
+size_t shield_xensiv_a_trigger_read_audio(int16_t* samples, size_t max_samples,
+                                          uint32_t* timestamp_us)
+{
+    uint32_t n = 0;
+
+    if (NULL != samples)
+    {
+        n = _shield_xensiv_a_trigger_ring_read(&_trigger_audio, samples, (uint32_t)max_samples);
+    }
+    if ((NULL != timestamp_us) && (n > 0U))
+    {
+        *timestamp_us = _trigger_audio_last_us -
+                        _shield_xensiv_a_trigger_samples_us(_trigger_audio.count);
+    }
+
+    return n;
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_trigger_is_capturing
+******************************************************************************/
+bool shield_xensiv_a_trigger_is_capturing(void)
+{
+    return (_trigger_motion.captured > 0U) || (_trigger_audio.captured > 0U) ||
+           _shield_xensiv_a_trigger_in_capture(shield_xensiv_a_get_timestamp_us());
+}
+
+
+/******************************************************************************
+* shield_xensiv_a_trigger_free
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_trigger_free(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+#if SHIELD_XENSIV_A_USE_MOTION
+    if (_trigger_armed && (NC != _trigger_motion_pin))
+    {
+        result = shield_xensiv_a_i2c_sched_acquire();
+        if (CY_RSLT_SUCCESS == result)
+        {
+            (void)_shield_xensiv_a_trigger_config_motion(false);
+            shield_xensiv_a_i2c_sched_release();
+            cyhal_gpio_enable_event(_trigger_motion_pin, CYHAL_GPIO_IRQ_RISE, 0, false);
+            cyhal_gpio_free(_trigger_motion_pin);
+            _trigger_motion_pin = NC;
+        }
+    }
+#endif
+
+    if (_trigger_armed && (CY_RSLT_SUCCESS == result))
+    {
+
+        _shield_xensiv_a_trigger_ring_init(&_trigger_motion, NULL, 0,
+                                           sizeof(shield_xensiv_a_motion_frame_t));
+        _shield_xensiv_a_trigger_ring_init(&_trigger_audio, NULL, 0, sizeof(int16_t));
+        _trigger_callback = NULL;
+        _trigger_has_event = false;
+        _trigger_armed = false;
+    }
+
+    return result;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,270 @@
+/******************************************************************************
+ * \file shield_xensiv_a_trigger.h
+ *
+ * Description: This file is the interface for the event triggered capture of
+ *              motion and audio data with pre-trigger buffering on the
+ *              SHIELD_XENSIV_A shield board.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "shield_xensiv_a_motion_fifo.h"
+#include "shield_xensiv_a_audio.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/** BMI270 any-motion feature: the acceleration changed by more than the
+ * threshold for the duration */
+#define SHIELD_XENSIV_A_TRIGGER_ANY_MOTION      (0x01UL)
+/** BMI270 no-motion feature: the acceleration stayed within the threshold for
+ * the duration */
+#define SHIELD_XENSIV_A_TRIGGER_NO_MOTION       (0x02UL)
+/** BMI270 significant-motion feature: motion consistent with a change of
+ * location, detected over several seconds */
+#define SHIELD_XENSIV_A_TRIGGER_SIG_MOTION      (0x04UL)
+/** Sound activity on the PDM microphone stream */
+#define SHIELD_XENSIV_A_TRIGGER_SOUND           (0x08UL)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Configuration of the triggers and the pre-trigger buffers */
+typedef struct
+{
+    /** Enabled triggers, a combination of the SHIELD_XENSIV_A_TRIGGER_* bits */
+    uint32_t                        sources;
+
+    /** BMI270 interrupt pin signaling the motion features, 1 for
+     * SHIELD_XENSIV_A_PIN_IMU_INT_1 or 2 for SHIELD_XENSIV_A_PIN_IMU_INT_2. It
+     * must not be used by the interrupts or the motion FIFO at the same time. */
+    uint8_t                         motion_int;
+    /** Priority of the GPIO interrupt of the motion features */
+    uint8_t                         intr_priority;
+    /** Threshold of the any-motion and no-motion features, 1 to 2047 in units
+     * of 0.48 mg */
+    uint16_t                        motion_threshold;
+    /** Duration of the any-motion and no-motion features, 1 to 8191 in units
+     * of 20 ms */
+    uint16_t                        motion_duration;
+
+    /** Sample rate of the PCM stream in Hz */
+    uint32_t                        sample_rate_hz;
+    /** Number of samples over which the sound level is measured */
+    uint16_t                        sound_frame_samples;
+    /** Mean absolute sample value a frame must exceed to count as sound,
+     * which keeps a silent input from triggering */
+    uint16_t                        sound_min_level;
+    /** Level above the tracked noise floor at which sound is detected */
+    float                           sound_threshold_db;
+
+    /** Data kept before an event */
+    uint32_t                        pre_trigger_ms;
+    /** Data kept after an event */
+    uint32_t                        post_trigger_ms;
+    /** Storage of the motion pre-trigger buffer, NULL for none */
+    shield_xensiv_a_motion_frame_t* motion_buffer;
+    /** Number of frames which fit into motion_buffer */
+    uint32_t                        motion_capacity;
+    /** Storage of the audio pre-trigger buffer, NULL for none */
+    int16_t*                        audio_buffer;
+    /** Number of samples which fit into audio_buffer */
+    uint32_t                        audio_capacity;
+} shield_xensiv_a_trigger_cfg_t;
+
+/** Callback invoked from thread context when triggers fire. The data before
+ * the event is in the pre-trigger buffers at this point. */
+typedef void (*shield_xensiv_a_trigger_callback_t)(uint32_t sources, uint32_t timestamp_us,
+                                                   void* callback_arg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_trigger_init
+******************************************************************************
+* Summary: Arms the triggers. The selected BMI270 motion features are enabled
+*          and mapped to the configured interrupt pin, and the sound activity
+*          detector is reset. While no event is being captured, the pre-
+*          trigger buffers only keep the last pre_trigger_ms of the data fed
+*          to them, so the data can be dropped cheaply instead of processed.
+*          When a trigger fires, this data and everything fed until
+*          post_trigger_ms after the event is kept until it is read. The
+*          motion features are set up with the I2C bus reserved.
+*
+* Parameters:
+*  cfg               The configuration, the buffers must stay valid until
+*                    shield_xensiv_a_trigger_free()
+*  callback          An optional function to call when triggers fire
+*  callback_arg      Argument passed to the callback
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_BUSY while a scheduled
+*  transaction is on the I2C bus
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_trigger_init(const shield_xensiv_a_trigger_cfg_t* cfg,
+                                       shield_xensiv_a_trigger_callback_t callback,
+                                       void* callback_arg);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_trigger_feed_motion
+******************************************************************************
+* Summary: Adds motion frames, e.g. from shield_xensiv_a_motion_fifo_read(), to
+*          the motion pre-trigger buffer. If the buffer is full, the oldest
+*          frames are overwritten.
+*
+* Parameters:
+*  frames            The frames, in time order
+*  num_frames        Number of frames
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_trigger_feed_motion(const shield_xensiv_a_motion_frame_t* frames,
+                                         uint16_t num_frames);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_trigger_feed_audio
+******************************************************************************
+* Summary: Adds mono PCM samples to the audio pre-trigger buffer and runs the
+*          sound activity detector on them. The detector compares the mean
+*          absolute value of each frame with a slowly rising, quickly falling
+*          noise floor, so it costs one addition per sample. If the buffer is
+*          full, the oldest samples are overwritten.
+*
+* Parameters:
+*  samples           The samples
+*  num_samples       Number of samples
+*  timestamp_us      Time of the last sample
+*
+* Return: None
+*
+******************************************************************************/
+void shield_xensiv_a_trigger_feed_audio(const int16_t* samples, size_t num_samples,
+                                        uint32_t timestamp_us);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_trigger_process
+******************************************************************************
+* Summary: Reads the motion feature status after an interrupt and, if sound
+*          activity is enabled or there is an audio buffer, consumes all filled
+*          blocks of the audio streaming in place, see
+*          shield_xensiv_a_audio_start(). Must be called regularly from thread
+*          context. The status is read with the I2C bus reserved, and left for
+*          a later call while a scheduled transaction is on the bus.
+*
+* Parameters: None
+*
+* Return:
+*  The SHIELD_XENSIV_A_TRIGGER_* bits of the triggers which fired since the
+*  previous call
+*
+******************************************************************************/
+uint32_t shield_xensiv_a_trigger_process(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_trigger_read_motion
+******************************************************************************
+* Summary: Removes the oldest frames from the motion pre-trigger buffer.
+*
+* Parameters:
+*  frames            Buffer receiving the frames
+*  max_frames        Number of frames which fit into the buffer
+*
+* Return:
+*  Number of frames written to the buffer
+*
+******************************************************************************/
+uint32_t shield_xensiv_a_trigger_read_motion(shield_xensiv_a_motion_frame_t* frames,
+                                             uint32_t max_frames);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_trigger_read_audio
+******************************************************************************
+* Summary: Removes the oldest samples from the audio pre-trigger buffer.
+*
+* Parameters:
+*  samples           Buffer receiving the samples
+*  max_samples       Number of samples which fit into the buffer
+*  timestamp_us      Receives the time of the last sample read, may be NULL
+*
+* Return:
+*  Number of samples written to the buffer
+*
+******************************************************************************/
+size_t shield_xensiv_a_trigger_read_audio(int16_t* samples, size_t max_samples,
+                                          uint32_t* timestamp_us);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_trigger_is_capturing
+******************************************************************************
+* Summary: Reports whether data is being kept for an event, i.e. whether an
+*          event fired and not all of its data has been read yet.
+*
+* Parameters: None
+*
+* Return:
+*  true while data is captured for an event
+*
+******************************************************************************/
+bool shield_xensiv_a_trigger_is_capturing(void);
+
+
+
+/******************************************************************************
+* Function Name: shield_xensiv_a_trigger_free
+******************************************************************************
+* Summary: Disarms the triggers, disables the motion features and releases
+*          their GPIO. This must be called before shield_xensiv_a_free() if the
+*          triggers were armed.
+*
+* Parameters: None
+*
+* Return:
+*  Status of the operation, SHIELD_XENSIV_A_RSLT_ERR_BUSY if the triggers stay
+*  armed because a scheduled transaction is on the I2C bus
+*
+******************************************************************************/
+cy_rslt_t shield_xensiv_a_trigger_free(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,308 @@
+/******************************************************************************
+ * \file bench_audio.c
+ *
+ * Description: Host benchmark of the audio feature extraction. It feeds a 16 bit
+ *              PCM WAV file, or a synthetic recording without an argument,
+ *              in blocks of SHIELD_XENSIV_A_AUDIO_BLOCK_SAMPLES to
+ *              shield_xensiv_a_audio_features_feed() and reports the host
+ *              cycles spent per block for frames processed in place and for
+ *              overlapping frames.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+#include "shield_xensiv_a_audio_features.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define BENCH_RUNS                  (5U)
+#define BENCH_BANDS                 (16U)
+/* The synthetic recording */
+#define BENCH_SYNTH_RATE_HZ         (16000U)
+#define BENCH_SYNTH_SECONDS         (10U)
+#define BENCH_PI                    (3.14159265f)
+#define US_PER_S                    (1000000U)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+typedef struct
+{
+    int16_t*    samples;
+    size_t      num_samples;
+    uint32_t    sample_rate_hz;
+} bench_pcm_t;
+
+typedef struct
+{
+    const char* name;
+    uint16_t    frame_size;
+    uint16_t    hop_size;
+} bench_case_t;
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static const bench_case_t _bench_cases[] =
+{
+    { "frame 256, hop 256 (in place)", 256U, 256U },
+    { "frame 512, hop 512 (in place)", 512U, 512U },
+    { "frame 256, hop 128",            256U, 128U },
+    { "frame 512, hop 256",            512U, 256U },
+};
+
+static uint32_t _bench_frames;
+static float    _bench_level_sum;
+
+
+/******************************************************************************
+* _bench_le16
+******************************************************************************/
+static uint16_t _bench_le16(const uint8_t* bytes)
+{
+    return (uint16_t)(bytes[0] | ((uint16_t)bytes[1] << 8));
+}
+
+
+/******************************************************************************
+* _bench_le32
+******************************************************************************/
+static uint32_t _bench_le32(const uint8_t* bytes)
+{
+    return (uint32_t)_bench_le16(bytes) | ((uint32_t)_bench_le16(&bytes[2]) << 16);
+}
+
+
+/******************************************************************************
+* _bench_read_wav
+******************************************************************************/
+/* Reads a 16 bit PCM WAV file, keeping the first channel */
+static bool _bench_read_wav(const char* path, bench_pcm_t* pcm)
+{
+    FILE* file = fopen(path, "rb");
+    uint8_t header[12];
+    uint16_t channels = 0;
+    bool found = false;
+
+    if ((NULL == file) || (fread(header, 1, sizeof(header), file) != sizeof(header)) ||
+        (0 != memcmp(header, "RIFF", 4)) || (0 != memcmp(&header[8], "WAVE", 4)))
+    {
+        printf("%s: not a WAV file\n", path);
+        if (NULL != file)
+        {
+            fclose(file);
+        }
+        return false;
+    }
+
+    while (!found && (fread(header, 1, 8, file) == 8))
+    {
+        uint32_t size = _bench_le32(&header[4]);
+
+        if (0 == memcmp(header, "fmt ", 4))
+        {
+            uint8_t fmt[16];
+            if ((size < sizeof(fmt)) || (fread(fmt, 1, sizeof(fmt), file) != sizeof(fmt)) ||
+                (1U != _bench_le16(fmt)) || (16U != _bench_le16(&fmt[14])))
+            {
+                break;
+            }
+            channels = _bench_le16(&fmt[2]);
+            pcm->sample_rate_hz = _bench_le32(&fmt[4]);
+            fseek(file, (long)(size - sizeof(fmt) + (size & 1U)), SEEK_CUR);
+        }
+        else if ((0 == memcmp(header, "data", 4)) && (channels > 0))
+        {
+            size_t frames = size / (2U * channels);
+            uint8_t* raw = malloc(frames * 2U * channels);
+
+            pcm->samples = malloc(frames * sizeof(int16_t));
+            if ((NULL != raw) && (NULL != pcm->samples))
+            {
+                pcm->num_samples = fread(raw, 2U * channels, frames, file);
+                for (size_t i = 0; i < pcm->num_samples; i++)
+                {
+                    pcm->samples[i] = (int16_t)_bench_le16(&raw[i * 2U * channels]);
+                }
+                found = true;
+            }
+            free(raw);
+        }
+        else
+        {
+            fseek(file, (long)(size + (size & 1U)), SEEK_CUR);
+        }
+    }
+    fclose(file);
+
+    if (!found)
+    {
+        printf("%s: no 16 bit PCM data\n", path);
+    }
+    return found;
+}
+
+
+/******************************************************************************
+* _bench_synthesize
+******************************************************************************/
+/* A tone sweeping from 100 Hz to 4 kHz with a second harmonic and noise */
+static bool _bench_synthesize(bench_pcm_t* pcm)
+{
+    uint32_t seed = 1U;
+
+    pcm->sample_rate_hz = BENCH_SYNTH_RATE_HZ;
+    pcm->num_samples = BENCH_SYNTH_RATE_HZ * BENCH_SYNTH_SECONDS;
+    pcm->samples = malloc(pcm->num_samples * sizeof(int16_t));
+    if (NULL == pcm->samples)
+    {
+        return false;
+    }
+
+    float phase = 0.0f;
+    for (size_t i = 0; i < pcm->num_samples; i++)
+    {
+        float t = (float)i / (float)pcm->num_samples;
+        float f = 100.0f * powf(40.0f, t);
+
+        phase += (2.0f * BENCH_PI * f) / (float)BENCH_SYNTH_RATE_HZ;
+        if (phase > (2.0f * BENCH_PI))
+        {
+            phase -= 2.0f * BENCH_PI;
+        }
+        seed = (seed * 1103515245U) + 12345U;
+        float noise = (float)((int32_t)(seed >> 16) & 0x7FF) - 1024.0f;
+        pcm->samples[i] = (int16_t)((8000.0f * sinf(phase)) + (2000.0f * sinf(2.0f * phase)) +
+                                    noise);
+    }
+    return true;
+}
+
+
+/******************************************************************************
+* _bench_callback
+******************************************************************************/
+static void _bench_callback(const shield_xensiv_a_audio_features_t* features,
+                            void* callback_arg)
+{
+    (void)callback_arg;
+    _bench_frames++;
+    _bench_level_sum += features->level_dba;
+}
+
+
+/******************************************************************************
+* _bench_run
+******************************************************************************/
+/* Returns the counts spent per block, the best of several runs */
+static double _bench_run(const bench_pcm_t* pcm, const bench_case_t* bench_case,
+                         uint32_t* blocks)
+{
+    shield_xensiv_a_audio_features_cfg_t cfg =
+    {
+        .sample_rate_hz = pcm->sample_rate_hz,
+        .frame_size     = bench_case->frame_size,
+        .hop_size       = bench_case->hop_size,
+        .num_bands      = BENCH_BANDS
+    };
+    double best = -1.0;
+
+    *blocks = (uint32_t)(pcm->num_samples / SHIELD_XENSIV_A_AUDIO_BLOCK_SAMPLES);
+    for (uint32_t run = 0; (run < BENCH_RUNS) && (*blocks > 0); run++)
+    {
+        uint64_t spent = 0;
+
+        if (CY_RSLT_SUCCESS != shield_xensiv_a_audio_features_init(&cfg, _bench_callback, NULL))
+        {
+            return -1.0;
+        }
+        _bench_frames = 0;
+        _bench_level_sum = 0.0f;
+        for (uint32_t i = 0; i < *blocks; i++)
+        {
+            const int16_t* block = &pcm->samples[i * SHIELD_XENSIV_A_AUDIO_BLOCK_SAMPLES];
+            uint32_t timestamp_us = (uint32_t)((((uint64_t)(i + 1U) *
+                                                 SHIELD_XENSIV_A_AUDIO_BLOCK_SAMPLES) *
+                                                US_PER_S) / pcm->sample_rate_hz);
+
+            uint64_t start = sim_cycles();
+            shield_xensiv_a_audio_features_feed(block, SHIELD_XENSIV_A_AUDIO_BLOCK_SAMPLES,
+                                                timestamp_us);
+            spent += sim_cycles() - start;
+        }
+
+        double per_block = (double)spent / (double)*blocks;
+        if ((best < 0.0) || (per_block < best))
+        {
+            best = per_block;
+        }
+    }
+    return best;
+}
+
+
+/******************************************************************************
+* main
+******************************************************************************/
+int main(int argc, char* argv[])
+{
+    bench_pcm_t pcm = { 0 };
+    int status = EXIT_SUCCESS;
+
+    if (!((argc > 1) ? _bench_read_wav(argv[1], &pcm) : _bench_synthesize(&pcm)))
+    {
+        return EXIT_FAILURE;
+    }
+
+    printf("Audio features, %s, %lu samples at %lu Hz, blocks of %u, %u bands, "
+           "best of %u runs\n", (argc > 1) ? argv[1] : "synthetic sweep",
+           (unsigned long)pcm.num_samples, (unsigned long)pcm.sample_rate_hz,
+           SHIELD_XENSIV_A_AUDIO_BLOCK_SAMPLES, BENCH_BANDS, BENCH_RUNS);
+    for (size_t i = 0; (i < (sizeof(_bench_cases) / sizeof(_bench_cases[0]))) &&
+         (EXIT_SUCCESS == status); i++)
+    {
+        uint32_t blocks;
+        double per_block = _bench_run(&pcm, &_bench_cases[i], &blocks);
+
+        if ((per_block < 0.0) || (0U == _bench_frames))
+        {
+            printf("  %-30s failed\n", _bench_cases[i].name);
+            status = EXIT_FAILURE;
+        }
+        else
+        {
+            printf("  %-30s %10.0f %s per block, %6.2f frames per block, avg %.1f dBA\n",
+                   _bench_cases[i].name, per_block, sim_cycles_unit(),
+                   (double)_bench_frames / (double)blocks,
+                   _bench_level_sum / (float)_bench_frames);
+        }
+    }
+
+    free(pcm.samples);
+    return status;
+}
+
+
+/* [] END OF FILE */
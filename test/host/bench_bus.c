@@ -0,0 +1,266 @@
+/******************************************************************************
+ * \file bench_bus.c
+ *
+ * Description: Host benchmark of the bus traffic of the library. It runs the
+ *              staged initialization with the default configuration against
+ *              the simulated shield and reports the time until the sensors and
+ *              the CO2 sensor are ready and the bytes and transactions on the
+ *              I2C and SPI buses per device. It then captures motion samples
+ *              on the BMI270 data ready interrupt and reports the latency from
+ *              the sample to the interrupt and to the end of its capture.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "sim.h"
+#include "shield_xensiv_a.h"
+#include "shield_xensiv_a_irq.h"
+#include "shield_xensiv_a_stream.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Motion samples captured for the latency measurement */
+#define BENCH_SAMPLES               (200U)
+/* Limit of the simulated time waited for a sample */
+#define BENCH_SAMPLE_TIMEOUT_US     (100000U)
+#define BENCH_STREAM_RECORDS        (16U)
+#define INIT_POLL_INTERVAL_MS       (10U)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+typedef struct
+{
+    uint64_t    min_us;
+    uint64_t    max_us;
+    uint64_t    sum_us;
+    uint32_t    count;
+} bench_latency_t;
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static const uint8_t _bench_addresses[] = { 0x44U, 0x69U, 0x14U, 0x76U, 0x28U };
+#if SHIELD_XENSIV_A_USE_MOTION
+static volatile bool _bench_irq;
+#endif
+
+
+#if SHIELD_XENSIV_A_USE_MOTION
+/******************************************************************************
+* _bench_latency_add
+******************************************************************************/
+static void _bench_latency_add(bench_latency_t* latency, uint64_t us)
+{
+    if ((0U == latency->count) || (us < latency->min_us))
+    {
+        latency->min_us = us;
+    }
+    if (us > latency->max_us)
+    {
+        latency->max_us = us;
+    }
+    latency->sum_us += us;
+    latency->count++;
+}
+
+
+/******************************************************************************
+* _bench_latency_print
+******************************************************************************/
+static void _bench_latency_print(const char* name, const bench_latency_t* latency)
+{
+    printf("  %-28s min %6llu us  avg %6llu us  max %6llu us\n", name,
+           (unsigned long long)latency->min_us,
+           (unsigned long long)(latency->sum_us / ((0U != latency->count) ? latency->count : 1U)),
+           (unsigned long long)latency->max_us);
+}
+#endif
+
+
+/******************************************************************************
+* _bench_print_stats
+******************************************************************************/
+static void _bench_print_stats(const char* name, sim_bus_stats_t stats)
+{
+    printf("  %-10s %8lu bytes written %8lu bytes read %6lu transactions %4lu NACKs "
+           "%8llu us busy\n", name, (unsigned long)stats.bytes_written,
+           (unsigned long)stats.bytes_read, (unsigned long)stats.transactions,
+           (unsigned long)stats.nacks, (unsigned long long)stats.busy_us);
+}
+
+
+/******************************************************************************
+* _bench_print_buses
+******************************************************************************/
+static void _bench_print_buses(void)
+{
+    for (size_t i = 0; i < sizeof(_bench_addresses); i++)
+    {
+        _bench_print_stats(sim_i2c_device_name(_bench_addresses[i]),
+                           sim_i2c_stats(_bench_addresses[i]));
+    }
+    _bench_print_stats("I2C total", sim_i2c_total());
+    _bench_print_stats("SPI total", sim_spi_total());
+}
+
+
+#if SHIELD_XENSIV_A_USE_MOTION
+/******************************************************************************
+* _bench_irq_callback
+******************************************************************************/
+static void _bench_irq_callback(shield_xensiv_a_irq_source_t source, uint32_t timestamp_us,
+                                void* callback_arg)
+{
+    (void)source;
+    (void)timestamp_us;
+    (void)callback_arg;
+    _bench_irq = true;
+}
+#endif
+
+
+/******************************************************************************
+* _bench_init
+******************************************************************************/
+static int _bench_init(void)
+{
+    shield_xensiv_a_cfg_t cfg = SHIELD_XENSIV_A_CFG_DEFAULT;
+    cy_rslt_t result;
+
+    sim_reset();
+    result = shield_xensiv_a_init_start_cfg(&cfg);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("shield_xensiv_a_init_start_cfg failed: 0x%08lx\n", (unsigned long)result);
+        return EXIT_FAILURE;
+    }
+    printf("Staged initialization\n");
+    printf("  sensors ready after %llu us, ready mask 0x%02lx\n",
+           (unsigned long long)sim_now_us(), (unsigned long)shield_xensiv_a_get_ready_mask());
+    _bench_print_buses();
+
+    sim_stats_reset();
+    do
+    {
+        cyhal_system_delay_ms(INIT_POLL_INTERVAL_MS);
+        result = shield_xensiv_a_init_poll();
+    } while (SHIELD_XENSIV_A_RSLT_PENDING == result);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("shield_xensiv_a_init_poll failed: 0x%08lx\n", (unsigned long)result);
+        return EXIT_FAILURE;
+    }
+    printf("  CO2 sensor ready after %llu us, ready mask 0x%02lx\n",
+           (unsigned long long)sim_now_us(), (unsigned long)shield_xensiv_a_get_ready_mask());
+    _bench_print_buses();
+    return EXIT_SUCCESS;
+}
+
+
+#if SHIELD_XENSIV_A_USE_MOTION
+/******************************************************************************
+* _bench_motion
+******************************************************************************/
+static int _bench_motion(void)
+{
+    static shield_xensiv_a_sample_t records[BENCH_STREAM_RECORDS];
+    shield_xensiv_a_stream_t stream;
+    bench_latency_t to_irq = { 0 };
+    bench_latency_t to_capture = { 0 };
+    shield_xensiv_a_sample_t record;
+    cy_rslt_t result = shield_xensiv_a_stream_init(&stream, records, BENCH_STREAM_RECORDS);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        shield_xensiv_a_stream_attach(&stream);
+        result = shield_xensiv_a_irq_enable(SHIELD_XENSIV_A_IRQ_MOTION, _bench_irq_callback,
+                                            NULL, 0);
+    }
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("motion interrupt setup failed: 0x%08lx\n", (unsigned long)result);
+        return EXIT_FAILURE;
+    }
+
+    sim_stats_reset();
+    for (uint32_t i = 0; (i < BENCH_SAMPLES) && (CY_RSLT_SUCCESS == result); i++)
+    {
+        uint64_t limit_us = sim_now_us() + BENCH_SAMPLE_TIMEOUT_US;
+        _bench_irq = false;
+        while (!_bench_irq && sim_step(limit_us))
+        {
+        }
+        if (!_bench_irq)
+        {
+            printf("no motion interrupt\n");
+            return EXIT_FAILURE;
+        }
+
+        uint64_t sample_us = sim_bmi270_sample_us();
+        uint32_t irq_us = shield_xensiv_a_irq_get_timestamp_us(SHIELD_XENSIV_A_IRQ_MOTION);
+        _bench_latency_add(&to_irq, (uint32_t)(irq_us - (uint32_t)sample_us));
+        result = shield_xensiv_a_stream_capture(SHIELD_XENSIV_A_READY_MOTION);
+        _bench_latency_add(&to_capture, sim_now_us() - sample_us);
+        while (shield_xensiv_a_stream_pop(&stream, &record))
+        {
+        }
+    }
+    shield_xensiv_a_irq_disable(SHIELD_XENSIV_A_IRQ_MOTION);
+    shield_xensiv_a_stream_attach(NULL);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("shield_xensiv_a_stream_capture failed: 0x%08lx\n", (unsigned long)result);
+        return EXIT_FAILURE;
+    }
+
+    sim_bus_stats_t stats = sim_i2c_stats(0x69U);
+    printf("Motion capture on the data ready interrupt, %u samples\n", BENCH_SAMPLES);
+    _bench_latency_print("sample to interrupt", &to_irq);
+    _bench_latency_print("sample to end of capture", &to_capture);
+    printf("  %lu bytes and %lu transactions per sample\n",
+           (unsigned long)((stats.bytes_written + stats.bytes_read) / BENCH_SAMPLES),
+           (unsigned long)(stats.transactions / BENCH_SAMPLES));
+    return EXIT_SUCCESS;
+}
+#endif
+
+
+/******************************************************************************
+* main
+******************************************************************************/
+int main(void)
+{
+    int status = _bench_init();
+
+#if SHIELD_XENSIV_A_USE_MOTION
+    if (EXIT_SUCCESS == status)
+    {
+        status = _bench_motion();
+    }
+#endif
+    shield_xensiv_a_free();
+    return status;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,146 @@
+/******************************************************************************
+ * \file bench_fusion.c
+ *
+ * Description: Host benchmark of the orientation filter. It feeds synthetic
+ *              IMU frames at 100 Hz in FIFO sized batches to
+ *              shield_xensiv_a_fusion_update_motion(), without and with
+ *              magnetometer samples at 25 Hz, and reports the host cycles
+ *              spent per frame.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "sim.h"
+#include "shield_xensiv_a_fusion.h"
+#include "shield_xensiv_a_motion_fifo.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define BENCH_FRAMES                (20000U)
+#define BENCH_BATCH                 (32U)
+#define BENCH_RUNS                  (5U)
+#define BENCH_FRAME_PERIOD_US       (10000U)
+/* One magnetometer sample per 4 IMU frames */
+#define BENCH_MAG_DIVIDER           (4U)
+#define BENCH_PI                    (3.14159265f)
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static shield_xensiv_a_motion_frame_t _bench_frames[BENCH_FRAMES];
+
+
+/******************************************************************************
+* _bench_make_frames
+******************************************************************************/
+/* A slow rotation around z with some wobble, 1 g on z */
+static void _bench_make_frames(void)
+{
+    for (uint32_t i = 0; i < BENCH_FRAMES; i++)
+    {
+        float phase = (2.0f * BENCH_PI * (float)i) / 500.0f;
+        _bench_frames[i].timestamp_us = i * BENCH_FRAME_PERIOD_US;
+        _bench_frames[i].acc[0] = (int16_t)(800.0f * sinf(phase));
+        _bench_frames[i].acc[1] = (int16_t)(800.0f * cosf(phase));
+        _bench_frames[i].acc[2] = 16384;
+        _bench_frames[i].gyr[0] = (int16_t)(40.0f * cosf(phase));
+        _bench_frames[i].gyr[1] = (int16_t)(-40.0f * sinf(phase));
+        _bench_frames[i].gyr[2] = 200;
+    }
+}
+
+
+/******************************************************************************
+* _bench_run
+******************************************************************************/
+/* Returns the counts spent in the filter per frame, the best of several runs */
+static double _bench_run(bool with_mag, shield_xensiv_a_quaternion_t* quaternion)
+{
+    shield_xensiv_a_fusion_cfg_t cfg =
+    {
+        .beta            = SHIELD_XENSIV_A_FUSION_BETA_DEFAULT,
+        .gyr_rad_per_lsb = SHIELD_XENSIV_A_FUSION_GYR_RAD_PER_LSB_2000DPS,
+        .mag_max_age_us  = SHIELD_XENSIV_A_FUSION_MAG_MAX_AGE_US_DEFAULT
+    };
+    double best = 0.0;
+
+    for (uint32_t run = 0; run < BENCH_RUNS; run++)
+    {
+        uint64_t spent = 0;
+
+        (void)shield_xensiv_a_fusion_init(&cfg);
+        for (uint32_t i = 0; i < BENCH_FRAMES; i += BENCH_BATCH)
+        {
+            uint16_t count = (uint16_t)(((BENCH_FRAMES - i) < BENCH_BATCH)
+                                        ? (BENCH_FRAMES - i)
+                                        : BENCH_BATCH);
+            if (with_mag)
+            {
+                /* The samples of the batch, in the magnetometer axes */
+                for (uint32_t j = i; j < (i + count); j += BENCH_MAG_DIVIDER)
+                {
+                    float phase = (2.0f * BENCH_PI * (float)j) / 500.0f;
+                    float mag[3] = { 20.0f * cosf(phase), -20.0f * sinf(phase), 40.0f };
+                    shield_xensiv_a_fusion_update_mag(mag, _bench_frames[j].timestamp_us);
+                }
+            }
+
+            uint64_t start = sim_cycles();
+            shield_xensiv_a_fusion_update_motion(&_bench_frames[i], count);
+            spent += sim_cycles() - start;
+        }
+
+        double per_frame = (double)spent / (double)BENCH_FRAMES;
+        if ((0U == run) || (per_frame < best))
+        {
+            best = per_frame;
+        }
+    }
+    shield_xensiv_a_fusion_get_quaternion(quaternion);
+    return best;
+}
+
+
+/******************************************************************************
+* main
+******************************************************************************/
+int main(void)
+{
+    shield_xensiv_a_quaternion_t q_imu;
+    shield_xensiv_a_quaternion_t q_mag;
+
+    _bench_make_frames();
+    double imu = _bench_run(false, &q_imu);
+    double mag = _bench_run(true, &q_mag);
+
+    printf("Orientation filter, %u frames in batches of %u, best of %u runs\n", BENCH_FRAMES,
+           BENCH_BATCH, BENCH_RUNS);
+    printf("  gyroscope and accelerometer   %8.1f %s per frame\n", imu, sim_cycles_unit());
+    printf("  with magnetometer             %8.1f %s per frame\n", mag, sim_cycles_unit());
+    printf("  final orientation w %.4f x %.4f y %.4f z %.4f / w %.4f x %.4f y %.4f z %.4f\n",
+           q_imu.w, q_imu.x, q_imu.y, q_imu.z, q_mag.w, q_mag.x, q_mag.y, q_mag.z);
+    return (isfinite(q_imu.w) && isfinite(q_mag.w)) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,257 @@
+/******************************************************************************
+ * \file bmi2_defs.h
+ *
+ * Description: Host stand-in for the definitions and the API of the Bosch
+ *              BMI2 sensor API used by the library. The functions are
+ *              implemented in sim/sim_drivers.c on top of the register access
+ *              functions bound to the device.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define BMI2_OK                             (0)
+#define BMI2_E_NULL_PTR                     (-1)
+#define BMI2_E_COM_FAIL                     (-2)
+#define BMI2_E_DEV_NOT_FOUND                (-3)
+#define BMI2_E_CONFIG_LOAD                  (-10)
+
+#define BMI2_ENABLE                         (1U)
+#define BMI2_DISABLE                        (0U)
+
+/* Sensor and feature selection */
+#define BMI2_ACCEL                          (0U)
+#define BMI2_GYRO                           (1U)
+#define BMI2_SIG_MOTION                     (3U)
+#define BMI2_ANY_MOTION                     (4U)
+#define BMI2_NO_MOTION                      (5U)
+
+/* Data interrupts */
+#define BMI2_FFULL_INT                      (0x01U)
+#define BMI2_FWM_INT                        (0x02U)
+#define BMI2_DRDY_INT                       (0x04U)
+
+#define BMI2_SOFT_RESET_CMD                 (0xB6U)
+#define BMI2_FIFO_FLUSH_CMD                 (0xB0U)
+
+#define BMI2_ACC_ODR_25HZ                   (0x06U)
+#define BMI2_ACC_ODR_100HZ                  (0x08U)
+#define BMI2_ACC_ODR_1600HZ                 (0x0CU)
+#define BMI2_GYR_ODR_100HZ                  (0x08U)
+#define BMI2_ACC_RANGE_2G                   (0x00U)
+#define BMI2_GYR_RANGE_2000                 (0x00U)
+#define BMI2_ACC_NORMAL_AVG4                (0x02U)
+#define BMI2_GYR_NORMAL_MODE                (0x02U)
+#define BMI2_POWER_OPT_MODE                 (0U)
+#define BMI2_PERF_OPT_MODE                  (1U)
+
+#define BMI2_FIFO_TIME_EN                   (0x0200U)
+#define BMI2_FIFO_HEADER_EN                 (0x1000U)
+#define BMI2_FIFO_ACC_EN                    (0x4000U)
+#define BMI2_FIFO_GYR_EN                    (0x8000U)
+#define BMI2_FIFO_ALL_EN                    (0xFFFFU)
+
+#define BMI2_INT_OUTPUT_ENABLE              (1U)
+#define BMI2_INT_PUSH_PULL                  (0U)
+#define BMI2_INT_ACTIVE_HIGH                (1U)
+#define BMI2_INT_NON_LATCH                  (0U)
+#define BMI2_INT_LATCH                      (1U)
+
+#define BMI270_SIG_MOT_STATUS_MASK          (0x01U)
+#define BMI270_NO_MOT_STATUS_MASK           (0x20U)
+#define BMI270_ANY_MOT_STATUS_MASK          (0x40U)
+
+enum bmi2_hw_int_pin
+{
+    BMI2_INT_NONE,
+    BMI2_INT1,
+    BMI2_INT2,
+    BMI2_INT_BOTH
+};
+
+enum bmi2_intf
+{
+    BMI2_SPI_INTF = 1,
+    BMI2_I2C_INTF
+};
+
+typedef int8_t (*bmi2_read_fptr_t)(uint8_t reg_addr, uint8_t* data, uint32_t len, void* intf_ptr);
+typedef int8_t (*bmi2_write_fptr_t)(uint8_t reg_addr, const uint8_t* data, uint32_t len,
+                                    void* intf_ptr);
+typedef void (*bmi2_delay_fptr_t)(uint32_t period, void* intf_ptr);
+
+struct bmi2_dev
+{
+    uint8_t             chip_id;
+    void*               intf_ptr;
+    uint16_t            read_write_len;
+    bmi2_read_fptr_t    read;
+    bmi2_write_fptr_t   write;
+    bmi2_delay_fptr_t   delay_us;
+    enum bmi2_intf      intf;
+    const uint8_t*      config_file_ptr;
+};
+
+struct bmi2_sens_axes_data
+{
+    int16_t     x;
+    int16_t     y;
+    int16_t     z;
+    uint32_t    virt_sens_time;
+};
+
+struct bmi2_sens_data
+{
+    struct bmi2_sens_axes_data  acc;
+    struct bmi2_sens_axes_data  gyr;
+    uint32_t                    sens_time;
+};
+
+struct bmi2_fifo_frame
+{
+    uint8_t*    data;
+    uint16_t    length;
+    uint8_t     header_enable;
+    uint16_t    data_enable;
+    uint16_t    acc_byte_start_idx;
+    uint16_t    gyr_byte_start_idx;
+    uint32_t    sensor_time;
+    uint8_t     skipped_frame_count;
+};
+
+struct bmi2_accel_config
+{
+    uint8_t     odr;
+    uint8_t     bwp;
+    uint8_t     filter_perf;
+    uint8_t     range;
+};
+
+struct bmi2_gyro_config
+{
+    uint8_t     odr;
+    uint8_t     bwp;
+    uint8_t     filter_perf;
+    uint8_t     ois_range;
+    uint8_t     range;
+    uint8_t     noise_perf;
+};
+
+struct bmi2_any_motion_config
+{
+    uint16_t    duration;
+    uint16_t    threshold;
+    uint8_t     select_x;
+    uint8_t     select_y;
+    uint8_t     select_z;
+};
+
+struct bmi2_no_motion_config
+{
+    uint16_t    duration;
+    uint16_t    threshold;
+    uint8_t     select_x;
+    uint8_t     select_y;
+    uint8_t     select_z;
+};
+
+struct bmi2_sig_motion_config
+{
+    uint16_t    block_size;
+};
+
+union bmi2_sens_config_types
+{
+    struct bmi2_accel_config        acc;
+    struct bmi2_gyro_config         gyr;
+    struct bmi2_any_motion_config   any_motion;
+    struct bmi2_no_motion_config    no_motion;
+    struct bmi2_sig_motion_config   sig_motion;
+};
+
+struct bmi2_sens_config
+{
+    uint8_t                         type;
+    union bmi2_sens_config_types    cfg;
+};
+
+struct bmi2_sens_int_config
+{
+    uint8_t                 type;
+    enum bmi2_hw_int_pin    hw_int_pin;
+};
+
+struct bmi2_int_pin_cfg
+{
+    uint8_t     lvl;
+    uint8_t     od;
+    uint8_t     output_en;
+    uint8_t     input_en;
+};
+
+struct bmi2_int_pin_config
+{
+    uint8_t                 pin_type;
+    uint8_t                 int_latch;
+    struct bmi2_int_pin_cfg pin_cfg[2];
+};
+
+int8_t bmi270_init(struct bmi2_dev* dev);
+int8_t bmi270_get_sensor_config(struct bmi2_sens_config* sens_cfg, uint8_t n_sens,
+                                struct bmi2_dev* dev);
+int8_t bmi270_set_sensor_config(struct bmi2_sens_config* sens_cfg, uint8_t n_sens,
+                                struct bmi2_dev* dev);
+int8_t bmi270_sensor_enable(const uint8_t* sens_list, uint8_t n_sens, struct bmi2_dev* dev);
+int8_t bmi270_sensor_disable(const uint8_t* sens_list, uint8_t n_sens, struct bmi2_dev* dev);
+int8_t bmi270_map_feat_int(const struct bmi2_sens_int_config* sens_int, uint8_t n_sens,
+                           struct bmi2_dev* dev);
+int8_t bmi2_get_regs(uint8_t reg_addr, uint8_t* data, uint16_t len, struct bmi2_dev* dev);
+int8_t bmi2_set_regs(uint8_t reg_addr, const uint8_t* data, uint16_t len, struct bmi2_dev* dev);
+int8_t bmi2_sensor_enable(const uint8_t* sens_list, uint8_t n_sens, struct bmi2_dev* dev);
+int8_t bmi2_sensor_disable(const uint8_t* sens_list, uint8_t n_sens, struct bmi2_dev* dev);
+int8_t bmi2_get_sensor_data(struct bmi2_sens_data* data, struct bmi2_dev* dev);
+int8_t bmi2_set_adv_power_save(uint8_t enable, struct bmi2_dev* dev);
+int8_t bmi2_set_command_register(uint8_t command, struct bmi2_dev* dev);
+int8_t bmi2_set_fifo_config(uint16_t config, uint8_t enable, struct bmi2_dev* dev);
+int8_t bmi2_set_fifo_wm(uint16_t fifo_wm, struct bmi2_dev* dev);
+int8_t bmi2_get_fifo_length(uint16_t* fifo_length, struct bmi2_dev* dev);
+int8_t bmi2_read_fifo_data(struct bmi2_fifo_frame* fifo, struct bmi2_dev* dev);
+int8_t bmi2_extract_accel(struct bmi2_sens_axes_data* accel_data, uint16_t* accel_length,
+                          struct bmi2_fifo_frame* fifo, const struct bmi2_dev* dev);
+int8_t bmi2_extract_gyro(struct bmi2_sens_axes_data* gyro_data, uint16_t* gyro_length,
+                         struct bmi2_fifo_frame* fifo, const struct bmi2_dev* dev);
+int8_t bmi2_map_data_int(uint8_t data_int, enum bmi2_hw_int_pin int_pin, struct bmi2_dev* dev);
+int8_t bmi2_get_int_pin_config(struct bmi2_int_pin_config* int_cfg, struct bmi2_dev* dev);
+int8_t bmi2_set_int_pin_config(const struct bmi2_int_pin_config* int_cfg, struct bmi2_dev* dev);
+int8_t bmi2_get_int_status(uint16_t* int_status, struct bmi2_dev* dev);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,53 @@
+/******************************************************************************
+ * \file cy_result.h
+ *
+ * Description: Host stand-in for the result codes of the ModusToolbox core
+ *              library.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+typedef uint32_t cy_rslt_t;
+
+#define CY_RSLT_SUCCESS                     ((cy_rslt_t)0x00000000U)
+
+#define CY_RSLT_TYPE_INFO                   (0U)
+#define CY_RSLT_TYPE_WARNING                (1U)
+#define CY_RSLT_TYPE_ERROR                  (2U)
+#define CY_RSLT_TYPE_FATAL                  (3U)
+
+#define CY_RSLT_MODULE_BOARD_SHIELD_BASE    (0x01B8U)
+#define CY_RSLT_MODULE_ABSTRACTION_HAL      (0x0100U)
+#define CY_RSLT_MODULE_ABSTRACTION_OS       (0x0102U)
+#define CY_RSLT_MODULE_BOARD_HARDWARE_BASE  (0x01C0U)
+
+#define CY_RSLT_CREATE(type, module, code) \
+    ((((module) & 0x3FFFU) << 18U) | (((code) & 0xFFFFU) << 0U) | (((type) & 0x3U) << 16U))
+#define CY_RSLT_GET_TYPE(result)            (((result) >> 16U) & 0x3U)
+#define CY_RSLT_GET_MODULE(result)          (((result) >> 18U) & 0x3FFFU)
+#define CY_RSLT_GET_CODE(result)            ((result) & 0xFFFFU)
+
+#define CY_ASSERT(x)                        ((void)(x))
+
+
+/* [] END OF FILE */
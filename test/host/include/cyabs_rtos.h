@@ -0,0 +1,56 @@
+/******************************************************************************
+ * \file cyabs_rtos.h
+ *
+ * Description: Host stand-in for the mutexes of the RTOS abstraction, which
+ *              are no-ops as the simulation runs in a single thread.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cy_result.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define CY_RTOS_NEVER_TIMEOUT               (0xFFFFFFFFUL)
+
+typedef uint32_t cy_time_t;
+
+typedef struct
+{
+    bool    locked;
+} cy_mutex_t;
+
+cy_rslt_t cy_rtos_init_mutex(cy_mutex_t* mutex);
+cy_rslt_t cy_rtos_get_mutex(cy_mutex_t* mutex, cy_time_t timeout_ms);
+cy_rslt_t cy_rtos_set_mutex(cy_mutex_t* mutex);
+cy_rslt_t cy_rtos_deinit_mutex(cy_mutex_t* mutex);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,56 @@
+/******************************************************************************
+ * \file cybsp.h
+ *
+ * Description: Host stand-in for the board support package, numbering the
+ *              Arduino header pins used by the shield.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "cyhal.h"
+
+#define CYBSP_I2C_SCL                       (1)
+#define CYBSP_I2C_SDA                       (2)
+#define CYBSP_SPI_CLK                       (3)
+#define CYBSP_SPI_MISO                      (4)
+#define CYBSP_SPI_MOSI                      (5)
+#define CYBSP_SPI_CS                        (6)
+#define CYBSP_D2                            (7)
+#define CYBSP_D4                            (8)
+#define CYBSP_D5                            (9)
+#define CYBSP_D6                            (10)
+#define CYBSP_D7                            (11)
+#define CYBSP_D9                            (12)
+#define CYBSP_A0                            (13)
+#define CYBSP_A1                            (14)
+#define CYBSP_A2                            (15)
+#define CYBSP_A3                            (16)
+#define CYBSP_A4                            (17)
+#define CYBSP_A5                            (18)
+#define CYBSP_J2_2                          (19)
+#define CYBSP_J2_4                          (20)
+#define CYBSP_J2_6                          (21)
+#define CYBSP_J2_8                          (22)
+#define CYBSP_J2_10                         (23)
+#define CYBSP_J2_12                         (24)
+
+
+/* [] END OF FILE */
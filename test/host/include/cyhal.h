@@ -0,0 +1,369 @@
+/******************************************************************************
+ * \file cyhal.h
+ *
+ * Description: Host stand-in for the subset of the ModusToolbox HAL used by
+ *              the library. The objects hold the state of the simulated
+ *              peripherals, which are implemented in sim/sim_hal.c.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "cy_result.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Common
+******************************************************************************/
+#define CYHAL_RSLT_ERR_HOST                 \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_HAL, 0x0001U)
+#define CYHAL_RSLT_ERR_NACK                 \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_HAL, 0x0002U)
+#define CYHAL_RSLT_ERR_BUSY                 \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_HAL, 0x0003U)
+
+#define CYHAL_DMA_PRIORITY_DEFAULT          (0U)
+
+/* The simulation runs in a single thread, so there is nothing to order */
+#define __DMB()                             __sync_synchronize()
+
+typedef int cyhal_gpio_t;
+
+#define NC                                  ((cyhal_gpio_t)-1)
+
+typedef enum
+{
+    CYHAL_ASYNC_SW,
+    CYHAL_ASYNC_DMA
+} cyhal_async_mode_t;
+
+typedef struct
+{
+    uint32_t    frequency_hz;
+} cyhal_clock_t;
+
+
+/******************************************************************************
+* System
+******************************************************************************/
+void cyhal_system_delay_ms(uint32_t milliseconds);
+void cyhal_system_delay_us(uint16_t microseconds);
+uint32_t cyhal_system_critical_section_enter(void);
+void cyhal_system_critical_section_exit(uint32_t old_state);
+
+
+/******************************************************************************
+* GPIO
+******************************************************************************/
+typedef enum
+{
+    CYHAL_GPIO_DIR_INPUT,
+    CYHAL_GPIO_DIR_OUTPUT,
+    CYHAL_GPIO_DIR_BIDIRECTIONAL
+} cyhal_gpio_direction_t;
+
+typedef enum
+{
+    CYHAL_GPIO_DRIVE_NONE,
+    CYHAL_GPIO_DRIVE_STRONG,
+    CYHAL_GPIO_DRIVE_OPENDRAINDRIVESLOW,
+    CYHAL_GPIO_DRIVE_PULLUP
+} cyhal_gpio_drive_mode_t;
+
+typedef enum
+{
+    CYHAL_GPIO_IRQ_NONE = 0,
+    CYHAL_GPIO_IRQ_RISE = 1,
+    CYHAL_GPIO_IRQ_FALL = 2,
+    CYHAL_GPIO_IRQ_BOTH = 3
+} cyhal_gpio_event_t;
+
+typedef void (*cyhal_gpio_event_callback_t)(void* callback_arg, cyhal_gpio_event_t event);
+
+typedef struct cyhal_gpio_callback_data_s
+{
+    cyhal_gpio_event_callback_t         callback;
+    void*                               callback_arg;
+    struct cyhal_gpio_callback_data_s*  next;
+    cyhal_gpio_t                        pin;
+} cyhal_gpio_callback_data_t;
+
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction,
+                          cyhal_gpio_drive_mode_t drive_mode, bool init_val);
+void cyhal_gpio_free(cyhal_gpio_t pin);
+void cyhal_gpio_write(cyhal_gpio_t pin, bool value);
+bool cyhal_gpio_read(cyhal_gpio_t pin);
+void cyhal_gpio_register_callback(cyhal_gpio_t pin, cyhal_gpio_callback_data_t* callback_data);
+void cyhal_gpio_enable_event(cyhal_gpio_t pin, cyhal_gpio_event_t event, uint8_t intr_priority,
+                             bool enable);
+
+
+/******************************************************************************
+* I2C
+******************************************************************************/
+typedef enum
+{
+    CYHAL_I2C_EVENT_NONE            = 0,
+    CYHAL_I2C_MASTER_WR_CMPLT_EVENT = 1 << 16,
+    CYHAL_I2C_MASTER_RD_CMPLT_EVENT = 1 << 17,
+    CYHAL_I2C_MASTER_ERR_EVENT      = 1 << 18
+} cyhal_i2c_event_t;
+
+typedef void (*cyhal_i2c_event_callback_t)(void* callback_arg, cyhal_i2c_event_t event);
+
+typedef struct
+{
+    bool        is_slave;
+    uint16_t    address;
+    uint32_t    frequencyhal_hz;
+} cyhal_i2c_cfg_t;
+
+typedef struct
+{
+    uint32_t                    frequency_hz;
+    cyhal_i2c_event_callback_t  callback;
+    void*                       callback_arg;
+    uint32_t                    events;
+    /* Asynchronous transfer in flight */
+    bool                        busy;
+    uint16_t                    address;
+    const uint8_t*              tx;
+    size_t                      tx_size;
+    uint8_t*                    rx;
+    size_t                      rx_size;
+} cyhal_i2c_t;
+
+cy_rslt_t cyhal_i2c_init(cyhal_i2c_t* obj, cyhal_gpio_t sda, cyhal_gpio_t scl,
+                         const cyhal_clock_t* clk);
+cy_rslt_t cyhal_i2c_configure(cyhal_i2c_t* obj, const cyhal_i2c_cfg_t* cfg);
+void cyhal_i2c_free(cyhal_i2c_t* obj);
+cy_rslt_t cyhal_i2c_master_write(cyhal_i2c_t* obj, uint16_t dev_addr, const uint8_t* data,
+                                 uint16_t size, uint32_t timeout, bool send_stop);
+cy_rslt_t cyhal_i2c_master_read(cyhal_i2c_t* obj, uint16_t dev_addr, uint8_t* data,
+                                uint16_t size, uint32_t timeout, bool send_stop);
+cy_rslt_t cyhal_i2c_master_mem_write(cyhal_i2c_t* obj, uint16_t address, uint16_t mem_addr,
+                                     uint16_t mem_addr_size, const uint8_t* data,
+                                     uint16_t size, uint32_t timeout);
+cy_rslt_t cyhal_i2c_master_mem_read(cyhal_i2c_t* obj, uint16_t address, uint16_t mem_addr,
+                                    uint16_t mem_addr_size, uint8_t* data, uint16_t size,
+                                    uint32_t timeout);
+cy_rslt_t cyhal_i2c_master_transfer_async(cyhal_i2c_t* obj, uint16_t address, const void* tx,
+                                          size_t tx_size, void* rx, size_t rx_size);
+cy_rslt_t cyhal_i2c_abort_async(cyhal_i2c_t* obj);
+void cyhal_i2c_register_callback(cyhal_i2c_t* obj, cyhal_i2c_event_callback_t callback,
+                                 void* callback_arg);
+void cyhal_i2c_enable_event(cyhal_i2c_t* obj, cyhal_i2c_event_t event, uint8_t intr_priority,
+                            bool enable);
+
+
+/******************************************************************************
+* SPI
+******************************************************************************/
+typedef enum
+{
+    CYHAL_SPI_MODE_00_MSB,
+    CYHAL_SPI_MODE_00_LSB
+} cyhal_spi_mode_t;
+
+typedef enum
+{
+    CYHAL_SPI_IRQ_NONE  = 0,
+    CYHAL_SPI_IRQ_DONE  = 1 << 2,
+    CYHAL_SPI_IRQ_ERROR = 1 << 3
+} cyhal_spi_event_t;
+
+typedef void (*cyhal_spi_event_callback_t)(void* callback_arg, cyhal_spi_event_t event);
+
+typedef struct
+{
+    uint32_t                    frequency_hz;
+    cyhal_spi_event_callback_t  callback;
+    void*                       callback_arg;
+    uint32_t                    events;
+    /* Asynchronous transfer in flight */
+    bool                        busy;
+} cyhal_spi_t;
+
+cy_rslt_t cyhal_spi_init(cyhal_spi_t* obj, cyhal_gpio_t mosi, cyhal_gpio_t miso,
+                         cyhal_gpio_t sclk, cyhal_gpio_t ssel, const cyhal_clock_t* clk,
+                         uint8_t bits, cyhal_spi_mode_t mode, bool is_slave);
+cy_rslt_t cyhal_spi_set_frequency(cyhal_spi_t* obj, uint32_t hz);
+void cyhal_spi_free(cyhal_spi_t* obj);
+cy_rslt_t cyhal_spi_transfer(cyhal_spi_t* obj, const uint8_t* tx, size_t tx_length, uint8_t* rx,
+                             size_t rx_length, uint8_t write_fill);
+cy_rslt_t cyhal_spi_transfer_async(cyhal_spi_t* obj, const uint8_t* tx, size_t tx_length,
+                                   uint8_t* rx, size_t rx_length);
+cy_rslt_t cyhal_spi_abort_async(cyhal_spi_t* obj);
+cy_rslt_t cyhal_spi_set_async_mode(cyhal_spi_t* obj, cyhal_async_mode_t mode,
+                                   uint8_t dma_priority);
+void cyhal_spi_register_callback(cyhal_spi_t* obj, cyhal_spi_event_callback_t callback,
+                                 void* callback_arg);
+void cyhal_spi_enable_event(cyhal_spi_t* obj, cyhal_spi_event_t event, uint8_t intr_priority,
+                            bool enable);
+
+
+/******************************************************************************
+* Timer
+******************************************************************************/
+typedef enum
+{
+    CYHAL_TIMER_DIR_UP,
+    CYHAL_TIMER_DIR_DOWN
+} cyhal_timer_direction_t;
+
+typedef enum
+{
+    CYHAL_TIMER_IRQ_NONE            = 0,
+    CYHAL_TIMER_IRQ_TERMINAL_COUNT  = 1,
+    CYHAL_TIMER_IRQ_CAPTURE_COMPARE = 2
+} cyhal_timer_event_t;
+
+typedef void (*cyhal_timer_event_callback_t)(void* callback_arg, cyhal_timer_event_t event);
+
+typedef struct
+{
+    bool                    is_continuous;
+    cyhal_timer_direction_t direction;
+    bool                    is_compare;
+    uint32_t                period;
+    uint32_t                compare_value;
+    uint32_t                value;
+} cyhal_timer_cfg_t;
+
+typedef struct
+{
+    cyhal_timer_cfg_t               cfg;
+    uint32_t                        frequency_hz;
+    bool                            running;
+    /* Simulated time at which the counter was last zero */
+    uint64_t                        start_us;
+    cyhal_timer_event_callback_t    callback;
+    void*                           callback_arg;
+    uint32_t                        events;
+} cyhal_timer_t;
+
+cy_rslt_t cyhal_timer_init(cyhal_timer_t* obj, cyhal_gpio_t pin, const cyhal_clock_t* clk);
+cy_rslt_t cyhal_timer_configure(cyhal_timer_t* obj, const cyhal_timer_cfg_t* cfg);
+cy_rslt_t cyhal_timer_set_frequency(cyhal_timer_t* obj, uint32_t hz);
+cy_rslt_t cyhal_timer_start(cyhal_timer_t* obj);
+cy_rslt_t cyhal_timer_stop(cyhal_timer_t* obj);
+uint32_t cyhal_timer_read(const cyhal_timer_t* obj);
+void cyhal_timer_free(cyhal_timer_t* obj);
+void cyhal_timer_register_callback(cyhal_timer_t* obj, cyhal_timer_event_callback_t callback,
+                                   void* callback_arg);
+void cyhal_timer_enable_event(cyhal_timer_t* obj, cyhal_timer_event_t event,
+                              uint8_t intr_priority, bool enable);
+
+
+/******************************************************************************
+* ADC
+******************************************************************************/
+#define CYHAL_ADC_VNEG                      ((cyhal_gpio_t)-2)
+
+typedef enum
+{
+    CYHAL_ADC_REF_INTERNAL,
+    CYHAL_ADC_REF_VDDA
+} cyhal_adc_vref_t;
+
+typedef enum
+{
+    CYHAL_ADC_VNEG_VSSA,
+    CYHAL_ADC_VNEG_VREF
+} cyhal_adc_vneg_t;
+
+typedef enum
+{
+    CYHAL_ADC_EOS                 = 1,
+    CYHAL_ADC_ASYNC_READ_COMPLETE = 2
+} cyhal_adc_event_t;
+
+typedef void (*cyhal_adc_event_callback_t)(void* callback_arg, cyhal_adc_event_t event);
+
+typedef struct
+{
+    bool                continuous_scanning;
+    uint16_t            average_count;
+    cyhal_adc_vref_t    vref;
+    cyhal_adc_vneg_t    vneg;
+    bool                enable_vref_bypass;
+    cyhal_gpio_t        ext_vref;
+    uint32_t            ext_vref_mv;
+    cyhal_gpio_t        bypass_pin;
+    uint8_t             resolution;
+} cyhal_adc_config_t;
+
+typedef struct
+{
+    bool        enabled;
+    bool        enable_averaging;
+    uint32_t    min_acquisition_ns;
+} cyhal_adc_channel_config_t;
+
+typedef struct
+{
+    uint32_t                    sample_rate_hz;
+    uint8_t                     channels;
+    cyhal_adc_event_callback_t  callback;
+    void*                       callback_arg;
+    uint32_t                    events;
+    /* Asynchronous read in flight */
+    bool                        busy;
+    int32_t*                    result_list;
+    size_t                      num_scan;
+} cyhal_adc_t;
+
+typedef struct
+{
+    cyhal_adc_t*    adc;
+} cyhal_adc_channel_t;
+
+cy_rslt_t cyhal_adc_init(cyhal_adc_t* obj, cyhal_gpio_t pin, const cyhal_clock_t* clk);
+cy_rslt_t cyhal_adc_configure(cyhal_adc_t* obj, const cyhal_adc_config_t* config);
+cy_rslt_t cyhal_adc_set_sample_rate(cyhal_adc_t* obj, uint32_t desired_sample_rate_hz,
+                                    uint32_t* achieved_sample_rate_hz);
+void cyhal_adc_free(cyhal_adc_t* obj);
+cy_rslt_t cyhal_adc_channel_init_diff(cyhal_adc_channel_t* obj, cyhal_adc_t* adc,
+                                      cyhal_gpio_t vplus, cyhal_gpio_t vminus,
+                                      const cyhal_adc_channel_config_t* cfg);
+void cyhal_adc_channel_free(cyhal_adc_channel_t* obj);
+cy_rslt_t cyhal_adc_read_async_uv(cyhal_adc_t* obj, size_t num_scan, int32_t* result_list);
+cy_rslt_t cyhal_adc_set_async_mode(cyhal_adc_t* obj, cyhal_async_mode_t mode,
+                                   uint8_t dma_priority);
+void cyhal_adc_register_callback(cyhal_adc_t* obj, cyhal_adc_event_callback_t callback,
+                                 void* callback_arg);
+void cyhal_adc_enable_event(cyhal_adc_t* obj, cyhal_adc_event_t event, uint8_t intr_priority,
+                            bool enable);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#include "cyhal_pdmpcm.h"
+
+
+/* [] END OF FILE */
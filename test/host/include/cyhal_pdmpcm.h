@@ -0,0 +1,97 @@
+/******************************************************************************
+ * \file cyhal_pdmpcm.h
+ *
+ * Description: Host stand-in for the PDM/PCM driver of the ModusToolbox HAL.
+ *              Reads complete after the time the samples take to arrive at
+ *              the configured rate and are filled by the simulation.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+typedef enum
+{
+    CYHAL_PDM_PCM_MODE_LEFT,
+    CYHAL_PDM_PCM_MODE_RIGHT,
+    CYHAL_PDM_PCM_MODE_STEREO
+} cyhal_pdm_pcm_mode_t;
+
+typedef enum
+{
+    CYHAL_PDM_PCM_RX_HALF_FULL   = 1,
+    CYHAL_PDM_PCM_RX_NOT_EMPTY   = 2,
+    CYHAL_PDM_PCM_RX_OVERFLOW    = 4,
+    CYHAL_PDM_PCM_RX_UNDERFLOW   = 8,
+    CYHAL_PDM_PCM_ASYNC_COMPLETE = 16
+} cyhal_pdm_pcm_event_t;
+
+typedef void (*cyhal_pdm_pcm_event_callback_t)(void* callback_arg, cyhal_pdm_pcm_event_t event);
+
+typedef struct
+{
+    uint32_t                sample_rate;
+    uint8_t                 decimation_rate;
+    cyhal_pdm_pcm_mode_t    mode;
+    uint8_t                 word_length;
+    int16_t                 left_gain;
+    int16_t                 right_gain;
+} cyhal_pdm_pcm_cfg_t;
+
+typedef struct
+{
+    cyhal_pdm_pcm_cfg_t             cfg;
+    bool                            running;
+    cyhal_pdm_pcm_event_callback_t  callback;
+    void*                           callback_arg;
+    uint32_t                        events;
+    /* Asynchronous read in flight */
+    bool                            busy;
+    void*                           data;
+    size_t                          length;
+} cyhal_pdm_pcm_t;
+
+cy_rslt_t cyhal_pdm_pcm_init(cyhal_pdm_pcm_t* obj, cyhal_gpio_t pin_data, cyhal_gpio_t pin_clk,
+                             const cyhal_clock_t* clk_source, const cyhal_pdm_pcm_cfg_t* cfg);
+void cyhal_pdm_pcm_free(cyhal_pdm_pcm_t* obj);
+cy_rslt_t cyhal_pdm_pcm_start(cyhal_pdm_pcm_t* obj);
+cy_rslt_t cyhal_pdm_pcm_stop(cyhal_pdm_pcm_t* obj);
+cy_rslt_t cyhal_pdm_pcm_clear(cyhal_pdm_pcm_t* obj);
+cy_rslt_t cyhal_pdm_pcm_read_async(cyhal_pdm_pcm_t* obj, void* data, size_t length);
+cy_rslt_t cyhal_pdm_pcm_abort_async(cyhal_pdm_pcm_t* obj);
+cy_rslt_t cyhal_pdm_pcm_set_async_mode(cyhal_pdm_pcm_t* obj, cyhal_async_mode_t mode,
+                                       uint8_t dma_priority);
+void cyhal_pdm_pcm_register_callback(cyhal_pdm_pcm_t* obj, cyhal_pdm_pcm_event_callback_t callback,
+                                     void* callback_arg);
+void cyhal_pdm_pcm_enable_event(cyhal_pdm_pcm_t* obj, cyhal_pdm_pcm_event_t event,
+                                uint8_t intr_priority, bool enable);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
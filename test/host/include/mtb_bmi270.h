@@ -0,0 +1,62 @@
+/******************************************************************************
+ * \file mtb_bmi270.h
+ *
+ * Description: Host stand-in for the ModusToolbox BMI270 wrapper, implemented
+ *              in sim/sim_drivers.c.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyhal.h"
+#include "bmi2_defs.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+typedef enum
+{
+    MTB_BMI270_ADDRESS_DEFAULT = 0x68,
+    MTB_BMI270_ADDRESS_SEC     = 0x69
+} mtb_bmi270_address_t;
+
+typedef struct
+{
+    struct bmi2_dev sensor;
+    cyhal_gpio_t    intpin1;
+    cyhal_gpio_t    intpin2;
+} mtb_bmi270_t;
+
+typedef struct
+{
+    struct bmi2_sens_data   sensor_data;
+} mtb_bmi270_data_t;
+
+cy_rslt_t mtb_bmi270_config_default(mtb_bmi270_t* dev);
+cy_rslt_t mtb_bmi270_read(mtb_bmi270_t* dev, mtb_bmi270_data_t* data);
+void mtb_bmi270_free_pin(mtb_bmi270_t* dev);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
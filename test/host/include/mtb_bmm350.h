@@ -0,0 +1,180 @@
+/******************************************************************************
+ * \file mtb_bmm350.h
+ *
+ * Description: Host stand-in for the Bosch BMM350 sensor API and its
+ *              ModusToolbox wrapper, implemented in sim/sim_drivers.c.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define BMM350_OK                           (0)
+#define BMM350_E_NULL_PTR                   (-1)
+#define BMM350_E_COM_FAIL                   (-2)
+#define BMM350_E_DEV_NOT_FOUND              (-3)
+
+enum bmm350_power_modes
+{
+    BMM350_SUSPEND_MODE,
+    BMM350_NORMAL_MODE,
+    BMM350_FORCED_MODE,
+    BMM350_FORCED_MODE_FAST
+};
+
+enum bmm350_intr_latch
+{
+    BMM350_PULSED,
+    BMM350_LATCHED
+};
+
+enum bmm350_intr_polarity
+{
+    BMM350_ACTIVE_LOW,
+    BMM350_ACTIVE_HIGH
+};
+
+enum bmm350_intr_drive
+{
+    BMM350_INTR_OPEN_DRAIN,
+    BMM350_INTR_PUSH_PULL
+};
+
+enum bmm350_intr_map
+{
+    BMM350_UNMAP_FROM_PIN,
+    BMM350_MAP_TO_PIN
+};
+
+enum bmm350_interrupt_enable_disable
+{
+    BMM350_DISABLE_INTERRUPT,
+    BMM350_ENABLE_INTERRUPT
+};
+
+enum bmm350_data_rates
+{
+    BMM350_DATA_RATE_400HZ = 2,
+    BMM350_DATA_RATE_200HZ,
+    BMM350_DATA_RATE_100HZ,
+    BMM350_DATA_RATE_50HZ,
+    BMM350_DATA_RATE_25HZ
+};
+
+enum bmm350_performance_parameters
+{
+    BMM350_NO_AVERAGING,
+    BMM350_AVERAGING_2,
+    BMM350_AVERAGING_4,
+    BMM350_AVERAGING_8
+};
+
+enum bmm350_x_axis_en_dis
+{
+    BMM350_X_DIS,
+    BMM350_X_EN
+};
+
+enum bmm350_y_axis_en_dis
+{
+    BMM350_Y_DIS,
+    BMM350_Y_EN
+};
+
+enum bmm350_z_axis_en_dis
+{
+    BMM350_Z_DIS,
+    BMM350_Z_EN
+};
+
+typedef int8_t (*bmm350_read_fptr_t)(uint8_t reg_addr, uint8_t* data, uint32_t len,
+                                     void* intf_ptr);
+typedef int8_t (*bmm350_write_fptr_t)(uint8_t reg_addr, const uint8_t* data, uint32_t len,
+                                      void* intf_ptr);
+typedef void (*bmm350_delay_us_fptr_t)(uint32_t period, void* intf_ptr);
+
+struct bmm350_dev
+{
+    void*                   intf_ptr;
+    uint8_t                 chip_id;
+    bmm350_read_fptr_t      read;
+    bmm350_write_fptr_t     write;
+    bmm350_delay_us_fptr_t  delay_us;
+    /* Compensation data read from the OTP memory */
+    uint16_t                otp_data[32];
+};
+
+struct bmm350_mag_temp_data
+{
+    float   x;
+    float   y;
+    float   z;
+    float   temperature;
+};
+
+typedef enum
+{
+    MTB_BMM350_ADDRESS_DEFAULT = 0x14,
+    MTB_BMM350_ADDRESS_SEC     = 0x15
+} mtb_bmm350_address_t;
+
+typedef struct
+{
+    struct bmm350_dev   sensor;
+} mtb_bmm350_t;
+
+typedef struct
+{
+    struct bmm350_mag_temp_data sensor_data;
+} mtb_bmm350_data_t;
+
+int8_t bmm350_init(struct bmm350_dev* dev);
+int8_t bmm350_get_regs(uint8_t reg_addr, uint8_t* reg_data, uint32_t len, struct bmm350_dev* dev);
+int8_t bmm350_set_regs(uint8_t reg_addr, const uint8_t* reg_data, uint32_t len,
+                       struct bmm350_dev* dev);
+int8_t bmm350_set_odr_performance(enum bmm350_data_rates odr,
+                                  enum bmm350_performance_parameters performance,
+                                  struct bmm350_dev* dev);
+int8_t bmm350_enable_axes(enum bmm350_x_axis_en_dis en_x, enum bmm350_y_axis_en_dis en_y,
+                          enum bmm350_z_axis_en_dis en_z, struct bmm350_dev* dev);
+int8_t bmm350_set_powermode(enum bmm350_power_modes powermode, struct bmm350_dev* dev);
+int8_t bmm350_configure_interrupt(enum bmm350_intr_latch latching,
+                                  enum bmm350_intr_polarity polarity,
+                                  enum bmm350_intr_drive drivertype,
+                                  enum bmm350_intr_map map_int, struct bmm350_dev* dev);
+int8_t bmm350_enable_interrupt(enum bmm350_interrupt_enable_disable enable_disable,
+                               struct bmm350_dev* dev);
+int8_t bmm350_get_compensated_mag_xyz_temp_data(struct bmm350_mag_temp_data* mag_temp_data,
+                                                struct bmm350_dev* dev);
+
+cy_rslt_t mtb_bmm350_read(mtb_bmm350_t* dev, mtb_bmm350_data_t* data);
+void mtb_bmm350_free_pin(mtb_bmm350_t* dev);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
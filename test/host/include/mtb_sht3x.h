@@ -0,0 +1,55 @@
+/******************************************************************************
+ * \file mtb_sht3x.h
+ *
+ * Description: Host stand-in for the ModusToolbox SHT3x driver, implemented
+ *              in sim/sim_drivers.c.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+typedef enum
+{
+    MTB_SHT35_ADDRESS_DEFAULT = 0x44,
+    MTB_SHT35_ADDRESS_SEC     = 0x45
+} mtb_sht3x_address_t;
+
+typedef struct
+{
+    float   temperature;
+    float   humidity;
+} mtb_sht3x_value_t;
+
+cy_rslt_t mtb_sht3x_init(cyhal_i2c_t* i2c_instance, mtb_sht3x_address_t address);
+cy_rslt_t mtb_sht3x_read(cyhal_i2c_t* i2c_instance, mtb_sht3x_value_t* value);
+void mtb_sht3x_free(cyhal_i2c_t* i2c_instance);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,52 @@
+/******************************************************************************
+ * \file mtb_st7735s.h
+ *
+ * Description: Host stand-in for the ModusToolbox ST7735S display driver,
+ *              implemented in sim/sim_drivers.c.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+typedef struct
+{
+    cyhal_gpio_t    dc;
+    cyhal_gpio_t    rst;
+} mtb_st7735s_pins_t;
+
+cy_rslt_t mtb_st7735s_init_spi(cyhal_spi_t* spi_inst, const mtb_st7735s_pins_t* pin_data);
+void mtb_st7735s_write_command(uint8_t data);
+void mtb_st7735s_write_data(uint8_t data);
+void mtb_st7735s_write_command_stream(uint8_t* data, int num);
+void mtb_st7735s_write_data_stream(uint8_t* data, int num);
+void mtb_st7735s_free(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * \file xensiv_dps3xx_mtb.h
+ *
+ * Description: Host stand-in for the XENSIV DPS3xx pressure sensor driver,
+ *              implemented in sim/sim_drivers.c.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define XENSIV_DPS3XX_RSLT_ERR_COMM         \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_BOARD_HARDWARE_BASE, 0x0001U)
+#define XENSIV_DPS3XX_RSLT_ERR_WRONG_PRODUCT \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_BOARD_HARDWARE_BASE, 0x0002U)
+#define XENSIV_DPS3XX_RSLT_ERR_DATA_NOT_READY \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_BOARD_HARDWARE_BASE, 0x0003U)
+
+typedef enum
+{
+    XENSIV_DPS3XX_I2C_ADDR_DEFAULT = 0x77,
+    XENSIV_DPS3XX_I2C_ADDR_ALT     = 0x76
+} xensiv_dps3xx_i2c_addr_t;
+
+typedef enum
+{
+    XENSIV_DPS3XX_MODE_IDLE                   = 0,
+    XENSIV_DPS3XX_MODE_COMMAND_PRESSURE       = 1,
+    XENSIV_DPS3XX_MODE_COMMAND_TEMPERATURE    = 2,
+    XENSIV_DPS3XX_MODE_BACKGROUND_PRESSURE    = 5,
+    XENSIV_DPS3XX_MODE_BACKGROUND_TEMPERATURE = 6,
+    XENSIV_DPS3XX_MODE_BACKGROUND_ALL         = 7
+} xensiv_dps3xx_mode_t;
+
+typedef struct
+{
+    xensiv_dps3xx_mode_t    dev_mode;
+    uint8_t                 pressure_rate;
+    uint8_t                 temperature_rate;
+    uint8_t                 pressure_oversample;
+    uint8_t                 temperature_oversample;
+} xensiv_dps3xx_config_t;
+
+typedef struct
+{
+    cyhal_i2c_t*            i2c;
+    uint8_t                 address;
+    xensiv_dps3xx_config_t  config;
+    /* Calibration coefficients read at initialization */
+    int32_t                 c0;
+    int32_t                 c1;
+    int32_t                 c00;
+    int32_t                 c10;
+} xensiv_dps3xx_t;
+
+cy_rslt_t xensiv_dps3xx_mtb_init_i2c(xensiv_dps3xx_t* dev, cyhal_i2c_t* i2c_inst,
+                                     xensiv_dps3xx_i2c_addr_t i2c_addr);
+cy_rslt_t xensiv_dps3xx_read(xensiv_dps3xx_t* dev, float* pressure, float* temperature);
+cy_rslt_t xensiv_dps3xx_get_config(xensiv_dps3xx_t* dev, xensiv_dps3xx_config_t* config);
+cy_rslt_t xensiv_dps3xx_set_config(xensiv_dps3xx_t* dev, xensiv_dps3xx_config_t* config);
+cy_rslt_t xensiv_dps3xx_check_ready(xensiv_dps3xx_t* dev, bool* pressure_ready,
+                                    bool* temperature_ready);
+void xensiv_dps3xx_free(xensiv_dps3xx_t* dev);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,58 @@
+/******************************************************************************
+ * \file xensiv_pasco2_mtb.h
+ *
+ * Description: Host stand-in for the XENSIV PAS CO2 sensor driver,
+ *              implemented in sim/sim_drivers.c.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define XENSIV_PASCO2_I2C_ADDR              (0x28U)
+
+#define XENSIV_PASCO2_OK                    (CY_RSLT_SUCCESS)
+#define XENSIV_PASCO2_ERR_COMM              (1)
+#define XENSIV_PASCO2_ERR_WRITE_TOO_LARGE   (2)
+#define XENSIV_PASCO2_ERR_NOT_READY         (3)
+#define XENSIV_PASCO2_ICCERR                (4)
+#define XENSIV_PASCO2_READ_NRDY             (5)
+
+typedef struct
+{
+    cyhal_i2c_t*    i2c;
+} xensiv_pasco2_t;
+
+cy_rslt_t xensiv_pasco2_mtb_init_i2c(xensiv_pasco2_t* dev, cyhal_i2c_t* i2c);
+cy_rslt_t xensiv_pasco2_mtb_read(xensiv_pasco2_t* dev, uint16_t press_ref, uint16_t* co2_ppm_val);
+cy_rslt_t xensiv_pasco2_start_single_mode(const xensiv_pasco2_t* dev);
+cy_rslt_t xensiv_pasco2_get_result(const xensiv_pasco2_t* dev, uint16_t* val);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,429 @@
+/******************************************************************************
+ * \file sim.h
+ *
+ * Description: This file is the control interface of the host simulation of
+ *              the SHIELD_XENSIV_A shield board. The simulation provides the
+ *              HAL and the sensor drivers the library is built against on the
+ *              host, a virtual microsecond clock which advances with the delays
+ *              and the transfers of the library, register models of the
+ *              sensors on the I2C bus and the traffic statistics of the buses.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/** Number of GPIO pins of the simulation */
+#define SIM_GPIO_COUNT                      (64U)
+
+/** Time the HAL spends setting up a blocking or asynchronous I2C transfer */
+#define SIM_I2C_SETUP_US                    (10U)
+
+/** Time the HAL spends setting up an SPI transfer */
+#define SIM_SPI_SETUP_US                    (5U)
+
+/** Ready time of the CO2 sensor which never becomes ready */
+#define SIM_NEVER                           (UINT32_MAX)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/** Function run by the simulation at a point in time, in interrupt context */
+typedef void (*sim_event_t)(void* arg);
+
+/** Function notified when the library drives an output pin */
+typedef void (*sim_gpio_watch_t)(cyhal_gpio_t pin, bool level, void* arg);
+
+/** A device on the I2C bus. The functions return false to NACK the address,
+ * in which case no data is transferred. */
+typedef struct
+{
+    const char* name;
+    bool        (*write)(void* ctx, const uint8_t* data, size_t size);
+    bool        (*read)(void* ctx, uint8_t* data, size_t size);
+    void*       ctx;
+} sim_i2c_device_t;
+
+/** Traffic of a bus or of one device on it */
+typedef struct
+{
+    uint32_t    transactions;   /**< Transfers started, including NACKed ones */
+    uint32_t    nacks;          /**< Transfers NACKed by the device */
+    uint32_t    bytes_written;  /**< Bytes written, including register addresses */
+    uint32_t    bytes_read;     /**< Bytes read */
+    uint64_t    busy_us;        /**< Time the bus was busy */
+} sim_bus_stats_t;
+
+/** Source of the microphone samples */
+typedef void (*sim_pdm_source_t)(int16_t* samples, size_t count, void* arg);
+
+
+
+/******************************************************************************
+* Function Name: sim_reset
+******************************************************************************
+* Summary: Returns the simulation to its power-on state: the clock restarts at
+*          zero, pending events are dropped, all pins and buses are released,
+*          the statistics are cleared and the sensor models are powered up
+*          again with their default settings.
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void sim_reset(void);
+
+
+
+/******************************************************************************
+* Function Name: sim_now_us
+******************************************************************************
+* Summary: Reads the simulated time.
+*
+* Parameters: None
+*
+* Return:
+*  Microseconds since the last sim_reset()
+*
+******************************************************************************/
+uint64_t sim_now_us(void);
+
+
+
+/******************************************************************************
+* Function Name: sim_advance_us
+******************************************************************************
+* Summary: Lets time pass, running the events which fall into the period in
+*          order. Inside an event, time passes without running further events,
+*          like an interrupt which is not preempted.
+*
+* Parameters:
+*  us                Microseconds to pass
+*
+* Return: None
+*
+******************************************************************************/
+void sim_advance_us(uint64_t us);
+
+
+
+/******************************************************************************
+* Function Name: sim_step
+******************************************************************************
+* Summary: Advances the clock to the next pending event and runs it.
+*
+* Parameters:
+*  limit_us          Time which is not passed if the next event is later
+*
+* Return:
+*  false if no event was due until limit_us, in which case the clock is at
+*  limit_us
+*
+******************************************************************************/
+bool sim_step(uint64_t limit_us);
+
+
+
+/******************************************************************************
+* Function Name: sim_schedule
+******************************************************************************
+* Summary: Schedules an event.
+*
+* Parameters:
+*  time_us           Time of the event, events in the past run next
+*  event             The function to run
+*  arg               Argument passed to the function
+*
+* Return: None
+*
+******************************************************************************/
+void sim_schedule(uint64_t time_us, sim_event_t event, void* arg);
+
+
+
+/******************************************************************************
+* Function Name: sim_cancel
+******************************************************************************
+* Summary: Drops the pending events with the function and argument.
+*
+* Parameters:
+*  event             The function of the events
+*  arg               The argument of the events
+*
+* Return: None
+*
+******************************************************************************/
+void sim_cancel(sim_event_t event, void* arg);
+
+
+
+/******************************************************************************
+* Function Name: sim_gpio_drive
+******************************************************************************
+* Summary: Drives a pin from outside, e.g. the interrupt output of a sensor,
+*          running the callback registered by the library if the edge is
+*          enabled.
+*
+* Parameters:
+*  pin               The pin
+*  level             The new level
+*
+* Return: None
+*
+******************************************************************************/
+void sim_gpio_drive(cyhal_gpio_t pin, bool level);
+
+
+
+/******************************************************************************
+* Function Name: sim_gpio_level
+******************************************************************************
+* Summary: Reads the level of a pin.
+*
+* Parameters:
+*  pin               The pin
+*
+* Return:
+*  The level of the pin
+*
+******************************************************************************/
+bool sim_gpio_level(cyhal_gpio_t pin);
+
+
+
+/******************************************************************************
+* Function Name: sim_gpio_watch
+******************************************************************************
+* Summary: Connects a device model to a pin driven by the library.
+*
+* Parameters:
+*  pin               The pin
+*  watch             Function called when the library writes the pin, NULL to
+*                    disconnect
+*  arg               Argument passed to the function
+*
+* Return: None
+*
+******************************************************************************/
+void sim_gpio_watch(cyhal_gpio_t pin, sim_gpio_watch_t watch, void* arg);
+
+
+
+/******************************************************************************
+* Function Name: sim_i2c_attach
+******************************************************************************
+* Summary: Connects a device to the I2C bus.
+*
+* Parameters:
+*  address           7-bit address of the device
+*  device            The device, must stay valid
+*
+* Return: None
+*
+******************************************************************************/
+void sim_i2c_attach(uint8_t address, const sim_i2c_device_t* device);
+
+
+
+/******************************************************************************
+* Function Name: sim_i2c_device_name
+******************************************************************************
+* Summary: Names the device at an address for reports.
+*
+* Parameters:
+*  address           7-bit address
+*
+* Return:
+*  The name of the device, NULL if there is none
+*
+******************************************************************************/
+const char* sim_i2c_device_name(uint8_t address);
+
+
+
+/******************************************************************************
+* Function Name: sim_stats_reset
+******************************************************************************
+* Summary: Clears the traffic statistics of all buses.
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void sim_stats_reset(void);
+
+
+
+/******************************************************************************
+* Function Name: sim_i2c_stats
+******************************************************************************
+* Summary: Reads the traffic with one device on the I2C bus.
+*
+* Parameters:
+*  address           7-bit address of the device
+*
+* Return:
+*  The statistics since the last sim_stats_reset()
+*
+******************************************************************************/
+sim_bus_stats_t sim_i2c_stats(uint8_t address);
+
+
+
+/******************************************************************************
+* Function Name: sim_i2c_total
+******************************************************************************
+* Summary: Reads the traffic of the I2C bus.
+*
+* Parameters: None
+*
+* Return:
+*  The statistics since the last sim_stats_reset()
+*
+******************************************************************************/
+sim_bus_stats_t sim_i2c_total(void);
+
+
+
+/******************************************************************************
+* Function Name: sim_spi_total
+******************************************************************************
+* Summary: Reads the traffic of the SPI bus.
+*
+* Parameters: None
+*
+* Return:
+*  The statistics since the last sim_stats_reset()
+*
+******************************************************************************/
+sim_bus_stats_t sim_spi_total(void);
+
+
+
+/******************************************************************************
+* Function Name: sim_pdm_set_source
+******************************************************************************
+* Summary: Selects the samples delivered by the microphone, silence by
+*          default.
+*
+* Parameters:
+*  source            Function filling the samples of each completed read, NULL
+*                    for silence
+*  arg               Argument passed to the function
+*
+* Return: None
+*
+******************************************************************************/
+void sim_pdm_set_source(sim_pdm_source_t source, void* arg);
+
+
+
+/******************************************************************************
+* Function Name: sim_cycles
+******************************************************************************
+* Summary: Reads a free running counter of the host for the benchmarks, the
+*          time stamp counter on x86 and a nanosecond clock elsewhere.
+*
+* Parameters: None
+*
+* Return:
+*  The counter, in the unit named by sim_cycles_unit()
+*
+******************************************************************************/
+uint64_t sim_cycles(void);
+
+
+
+/******************************************************************************
+* Function Name: sim_cycles_unit
+******************************************************************************
+* Summary: Names the unit of sim_cycles().
+*
+* Parameters: None
+*
+* Return:
+*  "cycles" or "ns"
+*
+******************************************************************************/
+const char* sim_cycles_unit(void);
+
+
+
+/******************************************************************************
+* Function Name: sim_devices_reset
+******************************************************************************
+* Summary: Attaches the register models of the sensors on the shield to the
+*          I2C bus in their power-on state. Called by sim_reset().
+*
+* Parameters: None
+*
+* Return: None
+*
+******************************************************************************/
+void sim_devices_reset(void);
+
+
+
+/******************************************************************************
+* Function Name: sim_co2_set_ready_ms
+******************************************************************************
+* Summary: Sets how long the CO2 sensor takes after power-on until it answers
+*          on the I2C bus, 1000 ms by default. Applies from the next power-on.
+*
+* Parameters:
+*  ready_ms          Milliseconds after power-on, SIM_NEVER for never
+*
+* Return: None
+*
+******************************************************************************/
+void sim_co2_set_ready_ms(uint32_t ready_ms);
+
+
+
+/******************************************************************************
+* Function Name: sim_bmi270_sample_us
+******************************************************************************
+* Summary: Reads the time at which the BMI270 produced its latest sample.
+*
+* Parameters: None
+*
+* Return:
+*  The time of the sample, 0 if there is none yet
+*
+******************************************************************************/
+uint64_t sim_bmi270_sample_us(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,1078 @@
+/******************************************************************************
+ * \file sim_devices.c
+ *
+ * Description: This file implements the register models of the sensors on the
+ *              I2C bus of the SHIELD_XENSIV_A shield board. The models cover
+ *              the registers and the timing the drivers rely on: identification,
+ *              reset and initialization sequences, measurements at the
+ *              configured rates with their data ready interrupts, and the
+ *              power switch and warm-up of the CO2 sensor.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <string.h>
+#include "sim.h"
+#include "shield_xensiv_a_pins.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define SHT35_ADDRESS               (0x44U)
+#define SHT35_CMD_SOFT_RESET        (0x30A2U)
+#define SHT35_CMD_BREAK             (0x3093U)
+#define SHT35_CMD_FETCH             (0xE000U)
+#define SHT35_CMD_STATUS            (0xF32DU)
+/* Single shot measurements without clock stretching */
+#define SHT35_CMD_SINGLE_MSB        (0x24U)
+/* Periodic measurements, the MSB selects the rate */
+#define SHT35_CMD_PERIODIC_MIN      (0x20U)
+#define SHT35_CMD_PERIODIC_MAX      (0x27U)
+#define SHT35_MEAS_US               (15500U)
+#define SHT35_RESET_US              (1500U)
+#define SHT35_TEMPERATURE_C         (23.5f)
+#define SHT35_HUMIDITY_RH           (45.0f)
+
+#define BMI270_ADDRESS              (0x69U)
+#define BMI270_CHIP_ID              (0x24U)
+#define BMI270_REG_CHIP_ID          (0x00U)
+#define BMI270_REG_STATUS           (0x03U)
+#define BMI270_REG_DATA_ACC         (0x0CU)
+#define BMI270_REG_DATA_GYR         (0x12U)
+#define BMI270_REG_SENSORTIME       (0x18U)
+#define BMI270_REG_INT_STATUS_1     (0x1DU)
+#define BMI270_REG_INTERNAL_STATUS  (0x21U)
+#define BMI270_REG_FIFO_LENGTH_0    (0x24U)
+#define BMI270_REG_FIFO_LENGTH_1    (0x25U)
+#define BMI270_REG_FIFO_DATA        (0x26U)
+#define BMI270_REG_ACC_CONF         (0x40U)
+#define BMI270_REG_FIFO_WTM_0       (0x46U)
+#define BMI270_REG_FIFO_WTM_1       (0x47U)
+#define BMI270_REG_FIFO_CONFIG_1    (0x49U)
+#define BMI270_REG_INT1_IO_CTRL     (0x53U)
+#define BMI270_REG_INT2_IO_CTRL     (0x54U)
+#define BMI270_REG_INT_MAP_DATA     (0x58U)
+#define BMI270_REG_INIT_CTRL        (0x59U)
+#define BMI270_REG_INIT_DATA        (0x5EU)
+#define BMI270_REG_PWR_CONF         (0x7CU)
+#define BMI270_REG_PWR_CTRL         (0x7DU)
+#define BMI270_REG_CMD              (0x7EU)
+#define BMI270_CMD_SOFT_RESET       (0xB6U)
+#define BMI270_CMD_FIFO_FLUSH       (0xB0U)
+#define BMI270_STATUS_DRDY          (0xC0U)
+#define BMI270_INT_STATUS_FWM       (0x02U)
+#define BMI270_PWR_CTRL_ACC_EN      (0x04U)
+#define BMI270_FIFO_ACC_EN          (0x40U)
+#define BMI270_FIFO_GYR_EN          (0x80U)
+#define BMI270_IO_OUTPUT_EN         (0x08U)
+#define BMI270_MAP_FWM_INT1         (0x02U)
+#define BMI270_MAP_DRDY_INT1        (0x04U)
+#define BMI270_MAP_FWM_INT2         (0x20U)
+#define BMI270_MAP_DRDY_INT2        (0x40U)
+#define BMI270_INIT_OK              (0x01U)
+#define BMI270_INIT_ERR             (0x02U)
+#define BMI270_CONFIG_SIZE          (8192U)
+#define BMI270_FIFO_SIZE            (2048U)
+#define BMI270_FIFO_FRAME_BYTES     (12U)
+/* 1 g at the default range of +-2 g */
+#define BMI270_ONE_G_LSB            (16384)
+#define BMI270_INT_PULSE_US         (10U)
+
+#define BMM350_ADDRESS              (0x14U)
+#define BMM350_CHIP_ID              (0x33U)
+#define BMM350_DUMMY_BYTES          (2U)
+#define BMM350_REG_PMU_CMD_AGGR_SET (0x04U)
+#define BMM350_REG_PMU_CMD          (0x06U)
+#define BMM350_REG_INT_CTRL         (0x2EU)
+#define BMM350_REG_MAG_X            (0x31U)
+#define BMM350_REG_OTP_CMD          (0x50U)
+#define BMM350_REG_OTP_DATA_MSB     (0x52U)
+#define BMM350_REG_OTP_DATA_LSB     (0x53U)
+#define BMM350_REG_OTP_STATUS       (0x55U)
+#define BMM350_REG_CMD              (0x7EU)
+#define BMM350_CMD_SOFT_RESET       (0xB6U)
+#define BMM350_PMU_NORMAL           (0x01U)
+#define BMM350_OTP_WORD_MASK        (0x1FU)
+#define BMM350_INT_OUTPUT_EN        (0x08U)
+#define BMM350_INT_DRDY_EN          (0x80U)
+#define BMM350_INT_PULSE_US         (10U)
+/* Raw values are in units of 0.01 uT and 0.01 degrees Celsius */
+#define BMM350_FIELD_X              (2000)
+#define BMM350_FIELD_Y              (-500)
+#define BMM350_FIELD_Z              (4000)
+#define BMM350_TEMPERATURE          (2500)
+
+#define DPS368_ADDRESS              (0x76U)
+#define DPS368_REG_PSR_B2           (0x00U)
+#define DPS368_REG_PSR_B0           (0x02U)
+#define DPS368_REG_TMP_B0           (0x05U)
+#define DPS368_REG_PRS_CFG          (0x06U)
+#define DPS368_REG_MEAS_CFG         (0x08U)
+#define DPS368_REG_CFG              (0x09U)
+#define DPS368_REG_INT_STS          (0x0AU)
+#define DPS368_REG_RESET            (0x0CU)
+#define DPS368_REG_PROD_ID          (0x0DU)
+#define DPS368_REG_COEF             (0x10U)
+#define DPS368_REG_COEF_SRCE        (0x28U)
+#define DPS368_PROD_ID              (0x10U)
+#define DPS368_SOFT_RESET           (0x09U)
+#define DPS368_MEAS_COEF_RDY        (0x80U)
+#define DPS368_MEAS_SENSOR_RDY      (0x40U)
+#define DPS368_MEAS_TMP_RDY         (0x20U)
+#define DPS368_MEAS_PRS_RDY         (0x10U)
+#define DPS368_MEAS_CTRL_MASK       (0x07U)
+#define DPS368_MEAS_BACKGROUND      (0x04U)
+#define DPS368_CFG_INT_HL           (0x80U)
+#define DPS368_CFG_INT_PRS          (0x10U)
+#define DPS368_INT_PRS              (0x01U)
+#define DPS368_READY_US             (40000U)
+#define DPS368_MEAS_US              (28000U)
+
+#define PASCO2_ADDRESS              (0x28U)
+#define PASCO2_REG_PROD_ID          (0x00U)
+#define PASCO2_REG_SENS_STS         (0x01U)
+#define PASCO2_REG_MEAS_RATE_H      (0x02U)
+#define PASCO2_REG_MEAS_RATE_L      (0x03U)
+#define PASCO2_REG_MEAS_CFG         (0x04U)
+#define PASCO2_REG_CO2PPM_H         (0x05U)
+#define PASCO2_REG_CO2PPM_L         (0x06U)
+#define PASCO2_REG_MEAS_STS         (0x07U)
+#define PASCO2_REG_SENS_RST         (0x10U)
+#define PASCO2_PROD_ID              (0x42U)
+#define PASCO2_SENS_RDY             (0x80U)
+#define PASCO2_MEAS_DRDY            (0x10U)
+#define PASCO2_OP_MODE_MASK         (0x03U)
+#define PASCO2_OP_MODE_SINGLE       (0x01U)
+#define PASCO2_OP_MODE_CONTINUOUS   (0x02U)
+#define PASCO2_SOFT_RESET           (0xA3U)
+#define PASCO2_DEFAULT_READY_MS     (1000U)
+#define PASCO2_MEAS_US              (1100000U)
+#define PASCO2_PPM                  (420U)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+/* A device with auto-incremented registers behind a register pointer, which
+   is set by the first byte written */
+typedef struct _sim_regs_s
+{
+    uint8_t     regs[256];
+    uint8_t     pointer;
+    /* Bytes sent by the device before the data of a read */
+    uint8_t     dummy_bytes;
+    /* Registers the pointer does not advance from on reads and on writes,
+       0 for none */
+    uint8_t     read_fifo_reg;
+    uint8_t     write_fifo_reg;
+    bool        (*present)(struct _sim_regs_s* model);
+    uint8_t     (*read_reg)(struct _sim_regs_s* model, uint8_t reg);
+    void        (*write_reg)(struct _sim_regs_s* model, uint8_t reg, uint8_t value);
+} _sim_regs_t;
+
+typedef struct
+{
+    _sim_regs_t regs;
+    uint32_t    config_bytes;
+    uint32_t    samples;
+    uint64_t    sample_us;
+    uint8_t     fifo[BMI270_FIFO_SIZE];
+    uint32_t    fifo_fill;
+    uint32_t    fifo_read;
+} _sim_bmi270_t;
+
+typedef struct
+{
+    _sim_regs_t regs;
+} _sim_bmm350_t;
+
+typedef struct
+{
+    _sim_regs_t regs;
+    uint64_t    ready_us;
+} _sim_dps368_t;
+
+typedef struct
+{
+    _sim_regs_t regs;
+    bool        powered;
+    uint64_t    power_on_us;
+    uint32_t    ready_ms;
+} _sim_pasco2_t;
+
+typedef struct
+{
+    uint16_t    command;
+    bool        periodic;
+    uint32_t    period_us;
+    uint64_t    busy_until_us;
+    /* Time of the next result, UINT64_MAX for none */
+    uint64_t    result_us;
+    bool        result_ready;
+} _sim_sht35_t;
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static _sim_sht35_t     _sim_sht35;
+static _sim_bmi270_t    _sim_bmi270;
+static _sim_bmm350_t    _sim_bmm350;
+static _sim_dps368_t    _sim_dps368;
+static _sim_pasco2_t    _sim_pasco2;
+static uint32_t         _sim_co2_ready_ms = PASCO2_DEFAULT_READY_MS;
+
+
+/******************************************************************************
+* _sim_regs_write
+******************************************************************************/
+static bool _sim_regs_write(void* ctx, const uint8_t* data, size_t size)
+{
+    _sim_regs_t* model = ctx;
+    bool ack = (NULL == model->present) || model->present(model);
+
+    if (ack)
+    {
+        model->pointer = data[0];
+        for (size_t i = 1; i < size; i++)
+        {
+            if (NULL != model->write_reg)
+            {
+                model->write_reg(model, model->pointer, data[i]);
+            }
+            else
+            {
+                model->regs[model->pointer] = data[i];
+            }
+            if ((0U == model->write_fifo_reg) || (model->pointer != model->write_fifo_reg))
+            {
+                model->pointer++;
+            }
+        }
+    }
+    return ack;
+}
+
+
+/******************************************************************************
+* _sim_regs_read
+******************************************************************************/
+static bool _sim_regs_read(void* ctx, uint8_t* data, size_t size)
+{
+    _sim_regs_t* model = ctx;
+    bool ack = (NULL == model->present) || model->present(model);
+
+    for (size_t i = 0; ack && (i < size); i++)
+    {
+        if (i < model->dummy_bytes)
+        {
+            data[i] = 0;
+        }
+        else
+        {
+            data[i] = (NULL != model->read_reg)
+                ? model->read_reg(model, model->pointer)
+                : model->regs[model->pointer];
+            if ((0U == model->read_fifo_reg) || (model->pointer != model->read_fifo_reg))
+            {
+                model->pointer++;
+            }
+        }
+    }
+    return ack;
+}
+
+
+/******************************************************************************
+* _sim_put16
+******************************************************************************/
+static void _sim_put16(uint8_t* regs, int16_t value)
+{
+    regs[0] = (uint8_t)((uint16_t)value & 0xFFU);
+    regs[1] = (uint8_t)((uint16_t)value >> 8);
+}
+
+
+/******************************************************************************
+* _sim_put24
+******************************************************************************/
+static void _sim_put24(uint8_t* regs, int32_t value)
+{
+    regs[0] = (uint8_t)((uint32_t)value & 0xFFU);
+    regs[1] = (uint8_t)(((uint32_t)value >> 8) & 0xFFU);
+    regs[2] = (uint8_t)(((uint32_t)value >> 16) & 0xFFU);
+}
+
+
+/******************************************************************************
+* _sim_sht35_crc
+******************************************************************************/
+static uint8_t _sim_sht35_crc(const uint8_t* data)
+{
+    uint8_t crc = 0xFFU;
+    for (uint32_t i = 0; i < 2U; i++)
+    {
+        crc ^= data[i];
+        for (uint32_t bit = 0; bit < 8U; bit++)
+        {
+            crc = (uint8_t)((crc & 0x80U) ? ((uint32_t)(crc << 1) ^ 0x31U) : (uint32_t)(crc << 1));
+        }
+    }
+    return crc;
+}
+
+
+/******************************************************************************
+* _sim_sht35_word
+******************************************************************************/
+static void _sim_sht35_word(uint8_t* data, uint16_t word)
+{
+    data[0] = (uint8_t)(word >> 8);
+    data[1] = (uint8_t)word;
+    data[2] = _sim_sht35_crc(data);
+}
+
+
+/******************************************************************************
+* _sim_sht35_update
+******************************************************************************/
+/* Completes the measurements due by now */
+static void _sim_sht35_update(_sim_sht35_t* model)
+{
+    uint64_t now_us = sim_now_us();
+
+    if ((UINT64_MAX != model->result_us) && (now_us >= model->result_us))
+    {
+        model->result_ready = true;
+        if (model->periodic)
+        {
+            model->result_us += (((now_us - model->result_us) / model->period_us) + 1U) *
+                                model->period_us;
+        }
+        else
+        {
+            model->result_us = UINT64_MAX;
+        }
+    }
+}
+
+
+/******************************************************************************
+* _sim_sht35_write
+******************************************************************************/
+static bool _sim_sht35_write(void* ctx, const uint8_t* data, size_t size)
+{
+    _sim_sht35_t* model = ctx;
+    bool ack = (sim_now_us() >= model->busy_until_us);
+
+    _sim_sht35_update(model);
+    if (ack && (size >= 2U))
+    {
+        uint16_t command = (uint16_t)((data[0] << 8) | data[1]);
+        uint8_t msb = data[0];
+
+        model->command = command;
+        if ((SHT35_CMD_SOFT_RESET == command) || (SHT35_CMD_BREAK == command))
+        {
+            model->periodic = false;
+            model->result_us = UINT64_MAX;
+            model->result_ready = false;
+            if (SHT35_CMD_SOFT_RESET == command)
+            {
+                model->busy_until_us = sim_now_us() + SHT35_RESET_US;
+            }
+        }
+        else if (!model->periodic && (SHT35_CMD_SINGLE_MSB == msb))
+        {
+            model->result_us = sim_now_us() + SHT35_MEAS_US;
+            model->result_ready = false;
+        }
+        else if (!model->periodic && (msb >= SHT35_CMD_PERIODIC_MIN) &&
+                 (msb <= SHT35_CMD_PERIODIC_MAX))
+        {
+            /* 0.5, 1, 2, 4 and 10 measurements per second */
+            static const uint32_t period_ms[] = { 2000, 1000, 500, 250, 0, 0, 0, 100 };
+            model->periodic = (0U != period_ms[msb - SHT35_CMD_PERIODIC_MIN]);
+            model->period_us = period_ms[msb - SHT35_CMD_PERIODIC_MIN] * 1000U;
+            model->result_us = sim_now_us() + SHT35_MEAS_US;
+            model->result_ready = false;
+        }
+    }
+    return ack;
+}
+
+
+/******************************************************************************
+* _sim_sht35_read
+******************************************************************************/
+/* A result is read once, without a new one the read is NACKed */
+static bool _sim_sht35_read(void* ctx, uint8_t* data, size_t size)
+{
+    _sim_sht35_t* model = ctx;
+    uint8_t frame[6];
+    bool ack = false;
+
+    _sim_sht35_update(model);
+    if (SHT35_CMD_STATUS == model->command)
+    {
+        _sim_sht35_word(frame, 0x0000U);
+        ack = true;
+    }
+    else if (model->result_ready &&
+             ((model->periodic && (SHT35_CMD_FETCH == model->command)) ||
+              (!model->periodic && ((model->command >> 8) == SHT35_CMD_SINGLE_MSB))))
+    {
+        _sim_sht35_word(&frame[0], (uint16_t)(((SHT35_TEMPERATURE_C + 45.0f) / 175.0f) *
+                                              65535.0f));
+        _sim_sht35_word(&frame[3], (uint16_t)((SHT35_HUMIDITY_RH / 100.0f) * 65535.0f));
+        model->result_ready = false;
+        ack = true;
+    }
+
+    for (size_t i = 0; ack && (i < size); i++)
+    {
+        data[i] = (i < sizeof(frame)) ? frame[i] : 0xFFU;
+    }
+    return ack;
+}
+
+
+/******************************************************************************
+* _sim_bmi270_period_us
+******************************************************************************/
+/* ODR setting 8 is 100 Hz, every step doubles the rate */
+static uint32_t _sim_bmi270_period_us(const _sim_bmi270_t* model)
+{
+    uint32_t odr = model->regs.regs[BMI270_REG_ACC_CONF] & 0x0FU;
+    if (0U == odr)
+    {
+        odr = 8U;
+    }
+    return (odr <= 8U) ? (10000UL << (8U - odr)) : (10000UL >> (odr - 8U));
+}
+
+
+/******************************************************************************
+* _sim_bmi270_interrupt
+******************************************************************************/
+/* Pulses the interrupt pins an interrupt is mapped to */
+static void _sim_bmi270_release(void* arg);
+static void _sim_bmi270_interrupt(_sim_bmi270_t* model, uint8_t int1_map, uint8_t int2_map)
+{
+    const uint8_t* regs = model->regs.regs;
+
+    if (((regs[BMI270_REG_INT_MAP_DATA] & int1_map) != 0) &&
+        ((regs[BMI270_REG_INT1_IO_CTRL] & BMI270_IO_OUTPUT_EN) != 0))
+    {
+        sim_gpio_drive(SHIELD_XENSIV_A_PIN_IMU_INT_1, true);
+    }
+    if (((regs[BMI270_REG_INT_MAP_DATA] & int2_map) != 0) &&
+        ((regs[BMI270_REG_INT2_IO_CTRL] & BMI270_IO_OUTPUT_EN) != 0))
+    {
+        sim_gpio_drive(SHIELD_XENSIV_A_PIN_IMU_INT_2, true);
+    }
+    sim_cancel(_sim_bmi270_release, model);
+    sim_schedule(sim_now_us() + BMI270_INT_PULSE_US, _sim_bmi270_release, model);
+}
+
+
+/******************************************************************************
+* _sim_bmi270_release
+******************************************************************************/
+static void _sim_bmi270_release(void* arg)
+{
+    (void)arg;
+    sim_gpio_drive(SHIELD_XENSIV_A_PIN_IMU_INT_1, false);
+    sim_gpio_drive(SHIELD_XENSIV_A_PIN_IMU_INT_2, false);
+}
+
+
+/******************************************************************************
+* _sim_bmi270_sample
+******************************************************************************/
+static void _sim_bmi270_sample(void* arg)
+{
+    _sim_bmi270_t* model = arg;
+    uint8_t* regs = model->regs.regs;
+    uint8_t frame[BMI270_FIFO_FRAME_BYTES];
+    int16_t wobble = (int16_t)((model->samples % 16U) - 8);
+    uint32_t sensortime = (uint32_t)(sim_now_us() * 10U / 390U);
+
+    sim_schedule(sim_now_us() + _sim_bmi270_period_us(model), _sim_bmi270_sample, model);
+    model->samples++;
+    model->sample_us = sim_now_us();
+
+    _sim_put16(&regs[BMI270_REG_DATA_ACC + 0U], wobble);
+    _sim_put16(&regs[BMI270_REG_DATA_ACC + 2U], (int16_t)-wobble);
+    _sim_put16(&regs[BMI270_REG_DATA_ACC + 4U], BMI270_ONE_G_LSB);
+    _sim_put16(&regs[BMI270_REG_DATA_GYR + 0U], (int16_t)(wobble * 2));
+    _sim_put16(&regs[BMI270_REG_DATA_GYR + 2U], 0);
+    _sim_put16(&regs[BMI270_REG_DATA_GYR + 4U], (int16_t)(-wobble * 2));
+    _sim_put24(&regs[BMI270_REG_SENSORTIME], (int32_t)(sensortime & 0xFFFFFFU));
+    regs[BMI270_REG_STATUS] |= BMI270_STATUS_DRDY;
+    regs[BMI270_REG_INT_STATUS_1] |= BMI270_STATUS_DRDY;
+
+    /* Headerless frames hold the gyroscope data before the accelerometer data */
+    if ((regs[BMI270_REG_FIFO_CONFIG_1] & (BMI270_FIFO_ACC_EN | BMI270_FIFO_GYR_EN)) ==
+        (BMI270_FIFO_ACC_EN | BMI270_FIFO_GYR_EN))
+    {
+        uint32_t watermark = regs[BMI270_REG_FIFO_WTM_0] |
+                             ((uint32_t)(regs[BMI270_REG_FIFO_WTM_1] & 0x1FU) << 8);
+        uint32_t before = model->fifo_fill - model->fifo_read;
+
+        memcpy(&frame[0], &regs[BMI270_REG_DATA_GYR], 6);
+        memcpy(&frame[6], &regs[BMI270_REG_DATA_ACC], 6);
+        if ((before + sizeof(frame)) <= BMI270_FIFO_SIZE)
+        {
+            for (uint32_t i = 0; i < sizeof(frame); i++)
+            {
+                model->fifo[(model->fifo_fill + i) % BMI270_FIFO_SIZE] = frame[i];
+            }
+            model->fifo_fill += sizeof(frame);
+        }
+        if ((0U != watermark) && (before < watermark) &&
+            ((model->fifo_fill - model->fifo_read) >= watermark))
+        {
+            regs[BMI270_REG_INT_STATUS_1] |= BMI270_INT_STATUS_FWM;
+            _sim_bmi270_interrupt(model, BMI270_MAP_FWM_INT1, BMI270_MAP_FWM_INT2);
+        }
+    }
+
+    _sim_bmi270_interrupt(model, BMI270_MAP_DRDY_INT1, BMI270_MAP_DRDY_INT2);
+}
+
+
+/******************************************************************************
+* _sim_bmi270_power_on
+******************************************************************************/
+static void _sim_bmi270_power_on(_sim_bmi270_t* model)
+{
+    sim_cancel(_sim_bmi270_sample, model);
+    sim_cancel(_sim_bmi270_release, model);
+    memset(model->regs.regs, 0, sizeof(model->regs.regs));
+    model->regs.regs[BMI270_REG_CHIP_ID]  = BMI270_CHIP_ID;
+    model->regs.regs[BMI270_REG_ACC_CONF] = 0xA8U;
+    model->regs.regs[BMI270_REG_PWR_CONF] = 0x03U;
+    model->regs.regs[BMI270_REG_FIFO_CONFIG_1] = 0x10U;
+    model->config_bytes = 0;
+    model->fifo_fill = 0;
+    model->fifo_read = 0;
+}
+
+
+/******************************************************************************
+* _sim_bmi270_schedule
+******************************************************************************/
+static void _sim_bmi270_schedule(_sim_bmi270_t* model)
+{
+    sim_cancel(_sim_bmi270_sample, model);
+    if ((model->regs.regs[BMI270_REG_PWR_CTRL] & BMI270_PWR_CTRL_ACC_EN) != 0)
+    {
+        sim_schedule(sim_now_us() + _sim_bmi270_period_us(model), _sim_bmi270_sample, model);
+    }
+}
+
+
+/******************************************************************************
+* _sim_bmi270_read_reg
+******************************************************************************/
+static uint8_t _sim_bmi270_read_reg(_sim_regs_t* regs_model, uint8_t reg)
+{
+    _sim_bmi270_t* model = (_sim_bmi270_t*)regs_model;
+    uint8_t* regs = regs_model->regs;
+    uint32_t fifo_length = model->fifo_fill - model->fifo_read;
+    uint8_t value = regs[reg];
+
+    if (BMI270_REG_FIFO_DATA == reg)
+    {
+        value = 0x80U;
+        if (fifo_length > 0)
+        {
+            value = model->fifo[model->fifo_read % BMI270_FIFO_SIZE];
+            model->fifo_read++;
+        }
+    }
+    else if (BMI270_REG_FIFO_LENGTH_0 == reg)
+    {
+        value = (uint8_t)(fifo_length & 0xFFU);
+    }
+    else if (BMI270_REG_FIFO_LENGTH_1 == reg)
+    {
+        value = (uint8_t)((fifo_length >> 8) & 0x3FU);
+    }
+    else if (BMI270_REG_INT_STATUS_1 == reg)
+    {
+        regs[reg] = 0;
+    }
+    else if (BMI270_REG_DATA_ACC == reg)
+    {
+        regs[BMI270_REG_STATUS] &= (uint8_t)~0x80U;
+    }
+    else if (BMI270_REG_DATA_GYR == reg)
+    {
+        regs[BMI270_REG_STATUS] &= (uint8_t)~0x40U;
+    }
+    return value;
+}
+
+
+/******************************************************************************
+* _sim_bmi270_write_reg
+******************************************************************************/
+static void _sim_bmi270_write_reg(_sim_regs_t* regs_model, uint8_t reg, uint8_t value)
+{
+    _sim_bmi270_t* model = (_sim_bmi270_t*)regs_model;
+    uint8_t* regs = regs_model->regs;
+
+    if (BMI270_REG_CMD == reg)
+    {
+        if (BMI270_CMD_SOFT_RESET == value)
+        {
+            _sim_bmi270_power_on(model);
+        }
+        else if (BMI270_CMD_FIFO_FLUSH == value)
+        {
+            model->fifo_read = model->fifo_fill;
+        }
+    }
+    else if (BMI270_REG_INIT_DATA == reg)
+    {
+        model->config_bytes++;
+    }
+    else if (BMI270_REG_INIT_CTRL == reg)
+    {
+        regs[reg] = value;
+        if (0U != value)
+        {
+            regs[BMI270_REG_INTERNAL_STATUS] = (model->config_bytes >= BMI270_CONFIG_SIZE)
+                ? BMI270_INIT_OK : BMI270_INIT_ERR;
+        }
+    }
+    else if ((BMI270_REG_CHIP_ID != reg) && (BMI270_REG_INTERNAL_STATUS != reg))
+    {
+        regs[reg] = value;
+        if ((BMI270_REG_PWR_CTRL == reg) || (BMI270_REG_ACC_CONF == reg))
+        {
+            _sim_bmi270_schedule(model);
+        }
+    }
+}
+
+
+/******************************************************************************
+* _sim_bmm350_sample
+******************************************************************************/
+static void _sim_bmm350_release(void* arg)
+{
+    (void)arg;
+    sim_gpio_drive(SHIELD_XENSIV_A_PIN_MAG_INT, false);
+}
+
+
+static void _sim_bmm350_sample(void* arg)
+{
+    _sim_bmm350_t* model = arg;
+    uint8_t* regs = model->regs.regs;
+    /* ODR setting 4 is 100 Hz, every step halves the rate */
+    uint32_t odr = regs[BMM350_REG_PMU_CMD_AGGR_SET] & 0x0FU;
+    uint32_t period_us = (odr >= 4U) ? (10000UL << (odr - 4U)) : (10000UL >> (4U - odr));
+
+    sim_schedule(sim_now_us() + period_us, _sim_bmm350_sample, model);
+    _sim_put24(&regs[BMM350_REG_MAG_X + 0U], BMM350_FIELD_X);
+    _sim_put24(&regs[BMM350_REG_MAG_X + 3U], BMM350_FIELD_Y);
+    _sim_put24(&regs[BMM350_REG_MAG_X + 6U], BMM350_FIELD_Z);
+    _sim_put24(&regs[BMM350_REG_MAG_X + 9U], BMM350_TEMPERATURE);
+
+    if ((regs[BMM350_REG_INT_CTRL] & (BMM350_INT_OUTPUT_EN | BMM350_INT_DRDY_EN)) ==
+        (BMM350_INT_OUTPUT_EN | BMM350_INT_DRDY_EN))
+    {
+        sim_gpio_drive(SHIELD_XENSIV_A_PIN_MAG_INT, true);
+        sim_schedule(sim_now_us() + BMM350_INT_PULSE_US, _sim_bmm350_release, model);
+    }
+}
+
+
+/******************************************************************************
+* _sim_bmm350_power_on
+******************************************************************************/
+static void _sim_bmm350_power_on(_sim_bmm350_t* model)
+{
+    sim_cancel(_sim_bmm350_sample, model);
+    memset(model->regs.regs, 0, sizeof(model->regs.regs));
+    model->regs.regs[0x00] = BMM350_CHIP_ID;
+    model->regs.regs[BMM350_REG_PMU_CMD_AGGR_SET] = 0x14U;
+}
+
+
+/******************************************************************************
+* _sim_bmm350_write_reg
+******************************************************************************/
+static void _sim_bmm350_write_reg(_sim_regs_t* regs_model, uint8_t reg, uint8_t value)
+{
+    _sim_bmm350_t* model = (_sim_bmm350_t*)regs_model;
+    uint8_t* regs = regs_model->regs;
+
+    if ((BMM350_REG_CMD == reg) && (BMM350_CMD_SOFT_RESET == value))
+    {
+        _sim_bmm350_power_on(model);
+    }
+    else if (BMM350_REG_OTP_CMD == reg)
+    {
+        /* The compensation words are small non-zero numbers */
+        uint8_t word = value & BMM350_OTP_WORD_MASK;
+        regs[reg] = value;
+        regs[BMM350_REG_OTP_DATA_MSB] = 0;
+        regs[BMM350_REG_OTP_DATA_LSB] = (uint8_t)(word + 1U);
+        regs[BMM350_REG_OTP_STATUS] = 0x01U;
+    }
+    else if (0x00U != reg)
+    {
+        regs[reg] = value;
+        if (BMM350_REG_PMU_CMD == reg)
+        {
+            sim_cancel(_sim_bmm350_sample, model);
+            if (BMM350_PMU_NORMAL == value)
+            {
+                sim_schedule(sim_now_us(), _sim_bmm350_sample, model);
+            }
+        }
+    }
+}
+
+
+/******************************************************************************
+* _sim_dps368_measure
+******************************************************************************/
+static void _sim_dps368_measure(void* arg)
+{
+    _sim_dps368_t* model = arg;
+    uint8_t* regs = model->regs.regs;
+    uint8_t ctrl = regs[DPS368_REG_MEAS_CFG] & DPS368_MEAS_CTRL_MASK;
+
+    /* The raw values are zero, which the coefficients map to 1013.25 hPa and
+       25 degrees Celsius */
+    memset(&regs[DPS368_REG_PSR_B2], 0, 6);
+    regs[DPS368_REG_MEAS_CFG] |= (uint8_t)(DPS368_MEAS_PRS_RDY | DPS368_MEAS_TMP_RDY);
+    if ((ctrl & DPS368_MEAS_BACKGROUND) != 0)
+    {
+        /* Bits 6:4 of PRS_CFG select 1 to 128 measurements per second */
+        uint32_t rate_hz = 1UL << ((regs[DPS368_REG_PRS_CFG] >> 4) & 0x07U);
+        sim_schedule(sim_now_us() + (1000000UL / rate_hz), _sim_dps368_measure, model);
+    }
+    else
+    {
+        regs[DPS368_REG_MEAS_CFG] &= (uint8_t)~DPS368_MEAS_CTRL_MASK;
+    }
+
+    if ((regs[DPS368_REG_CFG] & DPS368_CFG_INT_PRS) != 0)
+    {
+        regs[DPS368_REG_INT_STS] |= DPS368_INT_PRS;
+        sim_gpio_drive(SHIELD_XENSIV_A_PIN_SEN_INT,
+                       (regs[DPS368_REG_CFG] & DPS368_CFG_INT_HL) != 0);
+    }
+}
+
+
+/******************************************************************************
+* _sim_dps368_power_on
+******************************************************************************/
+static void _sim_dps368_power_on(_sim_dps368_t* model)
+{
+    static const uint8_t coefficients[18] =
+    {
+        /* c0 = 50, c1 = 0, c00 = 101325, all others 0 */
+        0x03U, 0x20U, 0x00U, 0x18U, 0xBCU, 0xD0U
+    };
+    uint8_t* regs = model->regs.regs;
+
+    sim_cancel(_sim_dps368_measure, model);
+    memset(regs, 0, sizeof(model->regs.regs));
+    regs[DPS368_REG_PROD_ID] = DPS368_PROD_ID;
+    memcpy(&regs[DPS368_REG_COEF], coefficients, sizeof(coefficients));
+    regs[DPS368_REG_COEF_SRCE] = 0x80U;
+    model->ready_us = sim_now_us() + DPS368_READY_US;
+}
+
+
+/******************************************************************************
+* _sim_dps368_read_reg
+******************************************************************************/
+static uint8_t _sim_dps368_read_reg(_sim_regs_t* regs_model, uint8_t reg)
+{
+    _sim_dps368_t* model = (_sim_dps368_t*)regs_model;
+    uint8_t* regs = regs_model->regs;
+    uint8_t value = regs[reg];
+
+    if (DPS368_REG_MEAS_CFG == reg)
+    {
+        if (sim_now_us() >= model->ready_us)
+        {
+            value |= (uint8_t)(DPS368_MEAS_COEF_RDY | DPS368_MEAS_SENSOR_RDY);
+        }
+    }
+    else if (DPS368_REG_PSR_B0 == reg)
+    {
+        regs[DPS368_REG_MEAS_CFG] &= (uint8_t)~DPS368_MEAS_PRS_RDY;
+    }
+    else if (DPS368_REG_TMP_B0 == reg)
+    {
+        regs[DPS368_REG_MEAS_CFG] &= (uint8_t)~DPS368_MEAS_TMP_RDY;
+    }
+    else if (DPS368_REG_INT_STS == reg)
+    {
+        regs[reg] = 0;
+        sim_gpio_drive(SHIELD_XENSIV_A_PIN_SEN_INT,
+                       (regs[DPS368_REG_CFG] & DPS368_CFG_INT_HL) == 0);
+    }
+    return value;
+}
+
+
+/******************************************************************************
+* _sim_dps368_write_reg
+******************************************************************************/
+static void _sim_dps368_write_reg(_sim_regs_t* regs_model, uint8_t reg, uint8_t value)
+{
+    _sim_dps368_t* model = (_sim_dps368_t*)regs_model;
+    uint8_t* regs = regs_model->regs;
+
+    if (DPS368_REG_RESET == reg)
+    {
+        if ((value & 0x0FU) == DPS368_SOFT_RESET)
+        {
+            _sim_dps368_power_on(model);
+        }
+    }
+    else if (DPS368_REG_MEAS_CFG == reg)
+    {
+        uint8_t ctrl = value & DPS368_MEAS_CTRL_MASK;
+        regs[reg] = (uint8_t)((regs[reg] & (DPS368_MEAS_PRS_RDY | DPS368_MEAS_TMP_RDY)) | ctrl);
+        sim_cancel(_sim_dps368_measure, model);
+        if (0U != ctrl)
+        {
+            sim_schedule(sim_now_us() + DPS368_MEAS_US, _sim_dps368_measure, model);
+        }
+    }
+    else if ((DPS368_REG_PROD_ID != reg) && (reg < DPS368_REG_COEF))
+    {
+        regs[reg] = value;
+    }
+}
+
+
+/******************************************************************************
+* _sim_pasco2_measure
+******************************************************************************/
+static void _sim_pasco2_measure(void* arg)
+{
+    _sim_pasco2_t* model = arg;
+    uint8_t* regs = model->regs.regs;
+
+    regs[PASCO2_REG_CO2PPM_H] = (uint8_t)(PASCO2_PPM >> 8);
+    regs[PASCO2_REG_CO2PPM_L] = (uint8_t)(PASCO2_PPM & 0xFFU);
+    regs[PASCO2_REG_MEAS_STS] |= PASCO2_MEAS_DRDY;
+    if ((regs[PASCO2_REG_MEAS_CFG] & PASCO2_OP_MODE_MASK) == PASCO2_OP_MODE_CONTINUOUS)
+    {
+        uint32_t rate_s = ((uint32_t)regs[PASCO2_REG_MEAS_RATE_H] << 8) |
+                          regs[PASCO2_REG_MEAS_RATE_L];
+        sim_schedule(sim_now_us() + ((uint64_t)rate_s * 1000000U), _sim_pasco2_measure, model);
+    }
+    else
+    {
+        regs[PASCO2_REG_MEAS_CFG] &= (uint8_t)~PASCO2_OP_MODE_MASK;
+    }
+}
+
+
+/******************************************************************************
+* _sim_pasco2_reset
+******************************************************************************/
+static void _sim_pasco2_reset(_sim_pasco2_t* model)
+{
+    uint8_t* regs = model->regs.regs;
+
+    sim_cancel(_sim_pasco2_measure, model);
+    memset(regs, 0, sizeof(model->regs.regs));
+    regs[PASCO2_REG_PROD_ID]     = PASCO2_PROD_ID;
+    regs[PASCO2_REG_SENS_STS]    = PASCO2_SENS_RDY;
+    regs[PASCO2_REG_MEAS_RATE_L] = 60U;
+    regs[PASCO2_REG_MEAS_CFG]    = 0x24U;
+}
+
+
+/******************************************************************************
+* _sim_pasco2_power
+******************************************************************************/
+static void _sim_pasco2_power(cyhal_gpio_t pin, bool level, void* arg)
+{
+    _sim_pasco2_t* model = arg;
+
+    (void)pin;
+    if (level && !model->powered)
+    {
+        model->power_on_us = sim_now_us();
+        model->ready_ms = _sim_co2_ready_ms;
+        _sim_pasco2_reset(model);
+    }
+    else if (!level)
+    {
+        sim_cancel(_sim_pasco2_measure, model);
+    }
+    model->powered = level;
+}
+
+
+/******************************************************************************
+* _sim_pasco2_present
+******************************************************************************/
+/* The sensor does not answer before it has started up */
+static bool _sim_pasco2_present(_sim_regs_t* regs_model)
+{
+    _sim_pasco2_t* model = (_sim_pasco2_t*)regs_model;
+
+    return model->powered && (SIM_NEVER != model->ready_ms) &&
+           (sim_now_us() >= (model->power_on_us + ((uint64_t)model->ready_ms * 1000U)));
+}
+
+
+/******************************************************************************
+* _sim_pasco2_read_reg
+******************************************************************************/
+static uint8_t _sim_pasco2_read_reg(_sim_regs_t* regs_model, uint8_t reg)
+{
+    uint8_t value = regs_model->regs[reg];
+
+    if (PASCO2_REG_CO2PPM_L == reg)
+    {
+        regs_model->regs[PASCO2_REG_MEAS_STS] &= (uint8_t)~PASCO2_MEAS_DRDY;
+    }
+    return value;
+}
+
+
+/******************************************************************************
+* _sim_pasco2_write_reg
+******************************************************************************/
+static void _sim_pasco2_write_reg(_sim_regs_t* regs_model, uint8_t reg, uint8_t value)
+{
+    _sim_pasco2_t* model = (_sim_pasco2_t*)regs_model;
+    uint8_t* regs = regs_model->regs;
+
+    if (PASCO2_REG_SENS_RST == reg)
+    {
+        if (PASCO2_SOFT_RESET == value)
+        {
+            _sim_pasco2_reset(model);
+        }
+    }
+    else if (PASCO2_REG_MEAS_CFG == reg)
+    {
+        uint8_t mode = value & PASCO2_OP_MODE_MASK;
+        regs[reg] = value;
+        sim_cancel(_sim_pasco2_measure, model);
+        if ((PASCO2_OP_MODE_SINGLE == mode) || (PASCO2_OP_MODE_CONTINUOUS == mode))
+        {
+            sim_schedule(sim_now_us() + PASCO2_MEAS_US, _sim_pasco2_measure, model);
+        }
+    }
+    else if ((PASCO2_REG_PROD_ID != reg) && (PASCO2_REG_SENS_STS != reg))
+    {
+        regs[reg] = value;
+    }
+}
+
+
+/******************************************************************************
+* sim_devices_reset
+******************************************************************************/
+void sim_devices_reset(void)
+{
+    static const sim_i2c_device_t sht35 =
+    {
+        "SHT35", _sim_sht35_write, _sim_sht35_read, &_sim_sht35
+    };
+    static const sim_i2c_device_t bmi270 =
+    {
+        "BMI270", _sim_regs_write, _sim_regs_read, &_sim_bmi270
+    };
+    static const sim_i2c_device_t bmm350 =
+    {
+        "BMM350", _sim_regs_write, _sim_regs_read, &_sim_bmm350
+    };
+    static const sim_i2c_device_t dps368 =
+    {
+        "DPS368", _sim_regs_write, _sim_regs_read, &_sim_dps368
+    };
+    static const sim_i2c_device_t pasco2 =
+    {
+        "PAS CO2", _sim_regs_write, _sim_regs_read, &_sim_pasco2
+    };
+
+    memset(&_sim_sht35, 0, sizeof(_sim_sht35));
+    _sim_sht35.result_us = UINT64_MAX;
+    sim_i2c_attach(SHT35_ADDRESS, &sht35);
+
+    memset(&_sim_bmi270, 0, sizeof(_sim_bmi270));
+    _sim_bmi270.regs.read_fifo_reg  = BMI270_REG_FIFO_DATA;
+    _sim_bmi270.regs.write_fifo_reg = BMI270_REG_INIT_DATA;
+    _sim_bmi270.regs.read_reg  = _sim_bmi270_read_reg;
+    _sim_bmi270.regs.write_reg = _sim_bmi270_write_reg;
+    _sim_bmi270_power_on(&_sim_bmi270);
+    sim_i2c_attach(BMI270_ADDRESS, &bmi270);
+
+    memset(&_sim_bmm350, 0, sizeof(_sim_bmm350));
+    _sim_bmm350.regs.dummy_bytes = BMM350_DUMMY_BYTES;
+    _sim_bmm350.regs.write_reg   = _sim_bmm350_write_reg;
+    _sim_bmm350_power_on(&_sim_bmm350);
+    sim_i2c_attach(BMM350_ADDRESS, &bmm350);
+
+    memset(&_sim_dps368, 0, sizeof(_sim_dps368));
+    _sim_dps368.regs.read_reg  = _sim_dps368_read_reg;
+    _sim_dps368.regs.write_reg = _sim_dps368_write_reg;
+    _sim_dps368_power_on(&_sim_dps368);
+    _sim_dps368.ready_us = 0;
+    sim_i2c_attach(DPS368_ADDRESS, &dps368);
+
+    _sim_co2_ready_ms = PASCO2_DEFAULT_READY_MS;
+    memset(&_sim_pasco2, 0, sizeof(_sim_pasco2));
+    _sim_pasco2.regs.present   = _sim_pasco2_present;
+    _sim_pasco2.regs.read_reg  = _sim_pasco2_read_reg;
+    _sim_pasco2.regs.write_reg = _sim_pasco2_write_reg;
+    sim_gpio_watch(SHIELD_XENSIV_A_PIN_CO2_PWR_EN, _sim_pasco2_power, &_sim_pasco2);
+    sim_i2c_attach(PASCO2_ADDRESS, &pasco2);
+}
+
+
+/******************************************************************************
+* sim_co2_set_ready_ms
+******************************************************************************/
+void sim_co2_set_ready_ms(uint32_t ready_ms)
+{
+    _sim_co2_ready_ms = ready_ms;
+}
+
+
+/******************************************************************************
+* sim_bmi270_sample_us
+******************************************************************************/
+uint64_t sim_bmi270_sample_us(void)
+{
+    return _sim_bmi270.sample_us;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,1648 @@
+/******************************************************************************
+ * \file sim_drivers.c
+ *
+ * Description: This file implements the host stand-ins of the sensor and
+ *              display drivers the library is built against. They follow the
+ *              register sequences of the drivers closely enough that the
+ *              traffic on the simulated buses and the waiting times of the
+ *              initialization match the hardware, but drop the features the
+ *              library does not use.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <string.h>
+#include "sim.h"
+#include "mtb_sht3x.h"
+#include "mtb_bmi270.h"
+#include "mtb_bmm350.h"
+#include "xensiv_dps3xx_mtb.h"
+#include "xensiv_pasco2_mtb.h"
+#include "mtb_st7735s.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define I2C_TIMEOUT_MS              (10U)
+
+#define SHT3X_CMD_SOFT_RESET        (0x30A2U)
+#define SHT3X_CMD_BREAK             (0x3093U)
+#define SHT3X_CMD_FETCH             (0xE000U)
+/* Periodic measurements at 1 per second with high repeatability */
+#define SHT3X_CMD_PERIODIC_1MPS     (0x2130U)
+#define SHT3X_RESET_US              (2000U)
+
+#define BMI2_CHIP_ID                (0x24U)
+#define BMI2_REG_CHIP_ID            (0x00U)
+#define BMI2_REG_STATUS             (0x03U)
+#define BMI2_REG_INT_STATUS_0       (0x1CU)
+#define BMI2_REG_INTERNAL_STATUS    (0x21U)
+#define BMI2_REG_FIFO_LENGTH_0      (0x24U)
+#define BMI2_REG_FIFO_DATA          (0x26U)
+#define BMI2_REG_FEAT_PAGE          (0x2FU)
+#define BMI2_REG_FEATURES           (0x30U)
+#define BMI2_REG_ACC_CONF           (0x40U)
+#define BMI2_REG_GYR_CONF           (0x42U)
+#define BMI2_REG_FIFO_WTM_0         (0x46U)
+#define BMI2_REG_FIFO_CONFIG_0      (0x48U)
+#define BMI2_REG_INT1_IO_CTRL       (0x53U)
+#define BMI2_REG_INT1_MAP_FEAT      (0x56U)
+#define BMI2_REG_INT_MAP_DATA       (0x58U)
+#define BMI2_REG_INIT_CTRL          (0x59U)
+#define BMI2_REG_INIT_ADDR_0        (0x5BU)
+#define BMI2_REG_INIT_DATA          (0x5EU)
+#define BMI2_REG_PWR_CONF           (0x7CU)
+#define BMI2_REG_PWR_CTRL           (0x7DU)
+#define BMI2_REG_CMD                (0x7EU)
+#define BMI2_SENSOR_DATA_BYTES      (24U)
+#define BMI2_CONFIG_SIZE            (8192U)
+#define BMI2_SOFT_RESET_US          (2000U)
+#define BMI2_POWER_SAVE_US          (450U)
+#define BMI2_CONFIG_LOAD_US         (20000U)
+#define BMI2_PWR_CTRL_GYR_EN        (0x02U)
+#define BMI2_PWR_CTRL_ACC_EN        (0x04U)
+#define BMI2_FIFO_FRAME_BYTES       (12U)
+#define BMI2_INIT_OK                (0x01U)
+/* Feature page holding the any-motion, no-motion and sig-motion settings */
+#define BMI2_FEAT_PAGE_MOTION       (1U)
+#define BMI2_FEAT_PAGE_ENABLE       (2U)
+
+#define BMM350_CHIP_ID              (0x33U)
+#define BMM350_DUMMY_BYTES          (2U)
+#define BMM350_REG_CHIP_ID          (0x00U)
+#define BMM350_REG_AGGR_SET         (0x04U)
+#define BMM350_REG_AXIS_EN          (0x05U)
+#define BMM350_REG_PMU_CMD          (0x06U)
+#define BMM350_REG_INT_CTRL         (0x2EU)
+#define BMM350_REG_INT_CTRL_IBI     (0x2FU)
+#define BMM350_REG_MAG_X            (0x31U)
+#define BMM350_REG_OTP_CMD          (0x50U)
+#define BMM350_REG_OTP_DATA_MSB     (0x52U)
+#define BMM350_REG_OTP_STATUS       (0x55U)
+#define BMM350_REG_CMD              (0x7EU)
+#define BMM350_CMD_SOFT_RESET       (0xB6U)
+#define BMM350_OTP_READ             (0x20U)
+#define BMM350_OTP_POWER_OFF        (0x80U)
+#define BMM350_PMU_SUSPEND          (0x00U)
+#define BMM350_PMU_NORMAL           (0x01U)
+#define BMM350_PMU_UPD_OAE          (0x02U)
+#define BMM350_PMU_FORCED           (0x03U)
+#define BMM350_PMU_FORCED_FAST      (0x04U)
+#define BMM350_PMU_BR               (0x07U)
+#define BMM350_PMU_FGR              (0x05U)
+#define BMM350_SOFT_RESET_US        (24000U)
+#define BMM350_OTP_US               (300U)
+#define BMM350_BR_US                (14000U)
+#define BMM350_FGR_US               (18000U)
+#define BMM350_SUSPEND_US           (6000U)
+#define BMM350_UPD_OAE_US           (1000U)
+#define BMM350_MAG_BYTES            (12U)
+/* Raw values are in units of 0.01 uT and 0.01 degrees Celsius */
+#define BMM350_LSB_SCALE            (0.01f)
+
+#define DPS3XX_PRODUCT_ID           (0x10U)
+#define DPS3XX_REG_PSR_B2           (0x00U)
+#define DPS3XX_REG_PRS_CFG          (0x06U)
+#define DPS3XX_REG_TMP_CFG          (0x07U)
+#define DPS3XX_REG_MEAS_CFG         (0x08U)
+#define DPS3XX_REG_RESET            (0x0CU)
+#define DPS3XX_REG_PROD_ID          (0x0DU)
+#define DPS3XX_REG_COEF             (0x10U)
+#define DPS3XX_REG_COEF_SRCE        (0x28U)
+#define DPS3XX_SOFT_RESET           (0x09U)
+#define DPS3XX_COEF_BYTES           (18U)
+#define DPS3XX_MEAS_READY           (0xC0U)
+#define DPS3XX_MEAS_TMP_RDY         (0x20U)
+#define DPS3XX_MEAS_PRS_RDY         (0x10U)
+#define DPS3XX_READY_POLL_US        (5000U)
+#define DPS3XX_READY_TIMEOUT_US     (100000U)
+/* Scale factor of a single measurement */
+#define DPS3XX_SCALE_1              (524288.0f)
+#define DPS3XX_PA_PER_HPA           (100.0f)
+/* 4 measurements per second without oversampling */
+#define DPS3XX_RATE_DEFAULT         (0x02U)
+
+#define PASCO2_REG_SENS_STS         (0x01U)
+#define PASCO2_REG_MEAS_RATE_H      (0x02U)
+#define PASCO2_REG_MEAS_CFG         (0x04U)
+#define PASCO2_REG_CO2PPM_H         (0x05U)
+#define PASCO2_REG_MEAS_STS         (0x07U)
+#define PASCO2_REG_PRESS_REF_H      (0x0BU)
+#define PASCO2_REG_SCRATCH_PAD      (0x0FU)
+#define PASCO2_SCRATCH_TEST         (0xA5U)
+#define PASCO2_SENS_RDY             (0x80U)
+#define PASCO2_SENS_ICCER           (0x08U)
+#define PASCO2_SENS_STS_CLEAR       (0x1EU)
+#define PASCO2_MEAS_DRDY            (0x10U)
+#define PASCO2_MEAS_STS_CLEAR       (0x04U)
+#define PASCO2_OP_MODE_IDLE         (0x00U)
+#define PASCO2_OP_MODE_SINGLE       (0x01U)
+#define PASCO2_OP_MODE_CONTINUOUS   (0x02U)
+/* Rate of the continuous measurements started by xensiv_pasco2_mtb_init_i2c() */
+#define PASCO2_MEAS_RATE_S          (10U)
+
+#define ST7735S_SWRESET             (0x01U)
+#define ST7735S_SLPOUT              (0x11U)
+#define ST7735S_DISPON              (0x29U)
+#define ST7735S_RESET_US            (10000U)
+#define ST7735S_SLEEP_OUT_MS        (120U)
+#define ST7735S_SPI_FREQ_HZ         (20000000UL)
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static uint8_t          _sht3x_address;
+static cyhal_spi_t*     _st7735s_spi;
+static mtb_st7735s_pins_t _st7735s_pins;
+
+
+/******************************************************************************
+* _sim_delay_us
+******************************************************************************/
+static void _sim_delay_us(uint32_t us)
+{
+    while (us > UINT16_MAX)
+    {
+        cyhal_system_delay_us(UINT16_MAX);
+        us -= UINT16_MAX;
+    }
+    cyhal_system_delay_us((uint16_t)us);
+}
+
+
+/******************************************************************************
+* _sim_i2c_command
+******************************************************************************/
+static cy_rslt_t _sim_i2c_command(cyhal_i2c_t* i2c, uint8_t address, uint16_t command)
+{
+    uint8_t data[2] = { (uint8_t)(command >> 8), (uint8_t)command };
+    return cyhal_i2c_master_write(i2c, address, data, sizeof(data), I2C_TIMEOUT_MS, true);
+}
+
+
+/******************************************************************************
+* _sim_i2c_read_regs
+******************************************************************************/
+static cy_rslt_t _sim_i2c_read_regs(cyhal_i2c_t* i2c, uint8_t address, uint8_t reg,
+                                    uint8_t* data, uint16_t size)
+{
+    return cyhal_i2c_master_mem_read(i2c, address, reg, 1, data, size, I2C_TIMEOUT_MS);
+}
+
+
+/******************************************************************************
+* _sim_i2c_write_reg
+******************************************************************************/
+static cy_rslt_t _sim_i2c_write_reg(cyhal_i2c_t* i2c, uint8_t address, uint8_t reg,
+                                    uint8_t value)
+{
+    return cyhal_i2c_master_mem_write(i2c, address, reg, 1, &value, 1, I2C_TIMEOUT_MS);
+}
+
+
+/******************************************************************************
+* _sht3x_crc
+******************************************************************************/
+static uint8_t _sht3x_crc(const uint8_t* data)
+{
+    uint8_t crc = 0xFFU;
+    for (uint32_t i = 0; i < 2U; i++)
+    {
+        crc ^= data[i];
+        for (uint32_t bit = 0; bit < 8U; bit++)
+        {
+            crc = (uint8_t)((crc & 0x80U) ? ((uint32_t)(crc << 1) ^ 0x31U) : (uint32_t)(crc << 1));
+        }
+    }
+    return crc;
+}
+
+
+/******************************************************************************
+* mtb_sht3x_init
+******************************************************************************/
+cy_rslt_t mtb_sht3x_init(cyhal_i2c_t* i2c_instance, mtb_sht3x_address_t address)
+{
+    cy_rslt_t result;
+
+    _sht3x_address = (uint8_t)address;
+    result = _sim_i2c_command(i2c_instance, _sht3x_address, SHT3X_CMD_SOFT_RESET);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        _sim_delay_us(SHT3X_RESET_US);
+        result = _sim_i2c_command(i2c_instance, _sht3x_address, SHT3X_CMD_PERIODIC_1MPS);
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* mtb_sht3x_read
+******************************************************************************/
+cy_rslt_t mtb_sht3x_read(cyhal_i2c_t* i2c_instance, mtb_sht3x_value_t* value)
+{
+    uint8_t data[6];
+    cy_rslt_t result = _sim_i2c_command(i2c_instance, _sht3x_address, SHT3X_CMD_FETCH);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cyhal_i2c_master_read(i2c_instance, _sht3x_address, data, sizeof(data),
+                                       I2C_TIMEOUT_MS, true);
+    }
+    if ((CY_RSLT_SUCCESS == result) &&
+        ((_sht3x_crc(&data[0]) != data[2]) || (_sht3x_crc(&data[3]) != data[5])))
+    {
+        result = CYHAL_RSLT_ERR_HOST;
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        uint16_t raw_temperature = (uint16_t)((data[0] << 8) | data[1]);
+        uint16_t raw_humidity    = (uint16_t)((data[3] << 8) | data[4]);
+        value->temperature = -45.0f + ((175.0f * raw_temperature) / 65535.0f);
+        value->humidity    = (100.0f * raw_humidity) / 65535.0f;
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* mtb_sht3x_free
+******************************************************************************/
+void mtb_sht3x_free(cyhal_i2c_t* i2c_instance)
+{
+    (void)_sim_i2c_command(i2c_instance, _sht3x_address, SHT3X_CMD_BREAK);
+}
+
+
+/******************************************************************************
+* bmi2_get_regs
+******************************************************************************/
+int8_t bmi2_get_regs(uint8_t reg_addr, uint8_t* data, uint16_t len, struct bmi2_dev* dev)
+{
+    int8_t rslt = BMI2_E_NULL_PTR;
+    if ((NULL != dev) && (NULL != dev->read) && (NULL != data))
+    {
+        rslt = (0 == dev->read(reg_addr, data, len, dev->intf_ptr)) ? BMI2_OK : BMI2_E_COM_FAIL;
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmi2_set_regs
+******************************************************************************/
+int8_t bmi2_set_regs(uint8_t reg_addr, const uint8_t* data, uint16_t len, struct bmi2_dev* dev)
+{
+    int8_t rslt = BMI2_E_NULL_PTR;
+    if ((NULL != dev) && (NULL != dev->write) && (NULL != data))
+    {
+        rslt = (0 == dev->write(reg_addr, data, len, dev->intf_ptr)) ? BMI2_OK : BMI2_E_COM_FAIL;
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* _bmi2_set_reg
+******************************************************************************/
+static int8_t _bmi2_set_reg(uint8_t reg_addr, uint8_t value, struct bmi2_dev* dev)
+{
+    return bmi2_set_regs(reg_addr, &value, 1, dev);
+}
+
+
+/******************************************************************************
+* _bmi2_update_reg
+******************************************************************************/
+/* Read-modify-write of the bits of a register */
+static int8_t _bmi2_update_reg(uint8_t reg_addr, uint8_t mask, uint8_t value,
+                               struct bmi2_dev* dev)
+{
+    uint8_t reg = 0;
+    int8_t rslt = bmi2_get_regs(reg_addr, &reg, 1, dev);
+    if (BMI2_OK == rslt)
+    {
+        rslt = _bmi2_set_reg(reg_addr, (uint8_t)((reg & ~mask) | (value & mask)), dev);
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmi2_set_command_register
+******************************************************************************/
+int8_t bmi2_set_command_register(uint8_t command, struct bmi2_dev* dev)
+{
+    return _bmi2_set_reg(BMI2_REG_CMD, command, dev);
+}
+
+
+/******************************************************************************
+* bmi2_set_adv_power_save
+******************************************************************************/
+int8_t bmi2_set_adv_power_save(uint8_t enable, struct bmi2_dev* dev)
+{
+    int8_t rslt = _bmi2_update_reg(BMI2_REG_PWR_CONF, 0x01U, enable, dev);
+    if ((BMI2_OK == rslt) && (BMI2_DISABLE == enable))
+    {
+        dev->delay_us(BMI2_POWER_SAVE_US, dev->intf_ptr);
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* _bmi2_upload_config
+******************************************************************************/
+/* Uploads the feature configuration in bursts of read_write_len bytes, each
+   preceded by its word address */
+static int8_t _bmi2_upload_config(struct bmi2_dev* dev)
+{
+    static const uint8_t config[BMI2_CONFIG_SIZE] = { 0xC8U, 0x2EU };
+    uint16_t burst = (uint16_t)(dev->read_write_len & ~1U);
+    int8_t rslt = (burst > 0U) ? BMI2_OK : BMI2_E_CONFIG_LOAD;
+
+    for (uint32_t index = 0; (BMI2_OK == rslt) && (index < sizeof(config)); index += burst)
+    {
+        uint16_t size = ((sizeof(config) - index) < burst)
+            ? (uint16_t)(sizeof(config) - index)
+            : burst;
+        uint8_t addr[2] = { (uint8_t)((index / 2U) & 0x0FU), (uint8_t)((index / 2U) >> 4) };
+        rslt = bmi2_set_regs(BMI2_REG_INIT_ADDR_0, addr, sizeof(addr), dev);
+        if (BMI2_OK == rslt)
+        {
+            rslt = bmi2_set_regs(BMI2_REG_INIT_DATA, &config[index], size, dev);
+        }
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmi270_init
+******************************************************************************/
+int8_t bmi270_init(struct bmi2_dev* dev)
+{
+    uint8_t chip_id = 0;
+    uint8_t status  = 0;
+    int8_t rslt = bmi2_set_command_register(BMI2_SOFT_RESET_CMD, dev);
+
+    if (BMI2_OK == rslt)
+    {
+        dev->delay_us(BMI2_SOFT_RESET_US, dev->intf_ptr);
+        rslt = bmi2_get_regs(BMI2_REG_CHIP_ID, &chip_id, 1, dev);
+    }
+    if ((BMI2_OK == rslt) && (BMI2_CHIP_ID != chip_id))
+    {
+        rslt = BMI2_E_DEV_NOT_FOUND;
+    }
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi2_set_adv_power_save(BMI2_DISABLE, dev);
+    }
+    if (BMI2_OK == rslt)
+    {
+        rslt = _bmi2_set_reg(BMI2_REG_INIT_CTRL, 0, dev);
+    }
+    if (BMI2_OK == rslt)
+    {
+        rslt = _bmi2_upload_config(dev);
+    }
+    if (BMI2_OK == rslt)
+    {
+        rslt = _bmi2_set_reg(BMI2_REG_INIT_CTRL, 1, dev);
+    }
+    if (BMI2_OK == rslt)
+    {
+        dev->delay_us(BMI2_CONFIG_LOAD_US, dev->intf_ptr);
+        rslt = bmi2_get_regs(BMI2_REG_INTERNAL_STATUS, &status, 1, dev);
+    }
+    if ((BMI2_OK == rslt) && ((status & 0x0FU) != BMI2_INIT_OK))
+    {
+        rslt = BMI2_E_CONFIG_LOAD;
+    }
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi2_set_adv_power_save(BMI2_ENABLE, dev);
+        dev->chip_id = chip_id;
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* _bmi2_read_feature_page
+******************************************************************************/
+static int8_t _bmi2_read_feature_page(uint8_t page, uint8_t* data, struct bmi2_dev* dev)
+{
+    int8_t rslt = _bmi2_set_reg(BMI2_REG_FEAT_PAGE, page, dev);
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi2_get_regs(BMI2_REG_FEATURES, data, 16, dev);
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* _bmi2_write_feature_page
+******************************************************************************/
+static int8_t _bmi2_write_feature_page(uint8_t page, const uint8_t* data, struct bmi2_dev* dev)
+{
+    int8_t rslt = _bmi2_set_reg(BMI2_REG_FEAT_PAGE, page, dev);
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi2_set_regs(BMI2_REG_FEATURES, data, 16, dev);
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* _bmi2_feature_offset
+******************************************************************************/
+/* Offset of the settings of a feature in its page */
+static uint8_t _bmi2_feature_offset(uint8_t type)
+{
+    return (BMI2_ANY_MOTION == type) ? 0U : ((BMI2_NO_MOTION == type) ? 4U : 8U);
+}
+
+
+/******************************************************************************
+* bmi270_get_sensor_config
+******************************************************************************/
+int8_t bmi270_get_sensor_config(struct bmi2_sens_config* sens_cfg, uint8_t n_sens,
+                                struct bmi2_dev* dev)
+{
+    int8_t rslt = BMI2_OK;
+
+    for (uint8_t i = 0; (BMI2_OK == rslt) && (i < n_sens); i++)
+    {
+        uint8_t data[16];
+        if (BMI2_ACCEL == sens_cfg[i].type)
+        {
+            rslt = bmi2_get_regs(BMI2_REG_ACC_CONF, data, 2, dev);
+            sens_cfg[i].cfg.acc.odr         = data[0] & 0x0FU;
+            sens_cfg[i].cfg.acc.bwp         = (data[0] >> 4) & 0x07U;
+            sens_cfg[i].cfg.acc.filter_perf = data[0] >> 7;
+            sens_cfg[i].cfg.acc.range       = data[1] & 0x03U;
+        }
+        else if (BMI2_GYRO == sens_cfg[i].type)
+        {
+            rslt = bmi2_get_regs(BMI2_REG_GYR_CONF, data, 2, dev);
+            sens_cfg[i].cfg.gyr.odr         = data[0] & 0x0FU;
+            sens_cfg[i].cfg.gyr.bwp         = (data[0] >> 4) & 0x03U;
+            sens_cfg[i].cfg.gyr.noise_perf  = (data[0] >> 6) & 0x01U;
+            sens_cfg[i].cfg.gyr.filter_perf = data[0] >> 7;
+            sens_cfg[i].cfg.gyr.range       = data[1] & 0x07U;
+            sens_cfg[i].cfg.gyr.ois_range   = (data[1] >> 3) & 0x01U;
+        }
+        else
+        {
+            uint8_t offset = _bmi2_feature_offset(sens_cfg[i].type);
+            rslt = _bmi2_read_feature_page(BMI2_FEAT_PAGE_MOTION, data, dev);
+            if (BMI2_SIG_MOTION == sens_cfg[i].type)
+            {
+                sens_cfg[i].cfg.sig_motion.block_size =
+                    (uint16_t)(data[offset] | (data[offset + 1U] << 8));
+            }
+            else
+            {
+                /* Any-motion and no-motion share their layout */
+                sens_cfg[i].cfg.any_motion.duration =
+                    (uint16_t)((data[offset] | (data[offset + 1U] << 8)) & 0x1FFFU);
+                sens_cfg[i].cfg.any_motion.select_x = (data[offset + 1U] >> 5) & 0x01U;
+                sens_cfg[i].cfg.any_motion.select_y = (data[offset + 1U] >> 6) & 0x01U;
+                sens_cfg[i].cfg.any_motion.select_z = data[offset + 1U] >> 7;
+                sens_cfg[i].cfg.any_motion.threshold =
+                    (uint16_t)((data[offset + 2U] | (data[offset + 3U] << 8)) & 0x07FFU);
+            }
+        }
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmi270_set_sensor_config
+******************************************************************************/
+int8_t bmi270_set_sensor_config(struct bmi2_sens_config* sens_cfg, uint8_t n_sens,
+                                struct bmi2_dev* dev)
+{
+    int8_t rslt = BMI2_OK;
+
+    for (uint8_t i = 0; (BMI2_OK == rslt) && (i < n_sens); i++)
+    {
+        uint8_t data[16];
+        if (BMI2_ACCEL == sens_cfg[i].type)
+        {
+            const struct bmi2_accel_config* acc = &sens_cfg[i].cfg.acc;
+            data[0] = (uint8_t)((acc->odr & 0x0FU) | ((acc->bwp & 0x07U) << 4) |
+                                ((acc->filter_perf & 0x01U) << 7));
+            data[1] = acc->range & 0x03U;
+            rslt = bmi2_set_regs(BMI2_REG_ACC_CONF, data, 2, dev);
+        }
+        else if (BMI2_GYRO == sens_cfg[i].type)
+        {
+            const struct bmi2_gyro_config* gyr = &sens_cfg[i].cfg.gyr;
+            data[0] = (uint8_t)((gyr->odr & 0x0FU) | ((gyr->bwp & 0x03U) << 4) |
+                                ((gyr->noise_perf & 0x01U) << 6) |
+                                ((gyr->filter_perf & 0x01U) << 7));
+            data[1] = (uint8_t)((gyr->range & 0x07U) | ((gyr->ois_range & 0x01U) << 3));
+            rslt = bmi2_set_regs(BMI2_REG_GYR_CONF, data, 2, dev);
+        }
+        else
+        {
+            uint8_t offset = _bmi2_feature_offset(sens_cfg[i].type);
+            rslt = _bmi2_read_feature_page(BMI2_FEAT_PAGE_MOTION, data, dev);
+            if (BMI2_SIG_MOTION == sens_cfg[i].type)
+            {
+                data[offset]      = (uint8_t)sens_cfg[i].cfg.sig_motion.block_size;
+                data[offset + 1U] = (uint8_t)(sens_cfg[i].cfg.sig_motion.block_size >> 8);
+            }
+            else
+            {
+                const struct bmi2_any_motion_config* motion = &sens_cfg[i].cfg.any_motion;
+                data[offset]      = (uint8_t)motion->duration;
+                data[offset + 1U] = (uint8_t)(((motion->duration >> 8) & 0x1FU) |
+                                              ((motion->select_x & 0x01U) << 5) |
+                                              ((motion->select_y & 0x01U) << 6) |
+                                              ((motion->select_z & 0x01U) << 7));
+                data[offset + 2U] = (uint8_t)motion->threshold;
+                data[offset + 3U] = (uint8_t)((motion->threshold >> 8) & 0x07U);
+            }
+            if (BMI2_OK == rslt)
+            {
+                rslt = _bmi2_write_feature_page(BMI2_FEAT_PAGE_MOTION, data, dev);
+            }
+        }
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* _bmi2_enable
+******************************************************************************/
+static int8_t _bmi2_enable(const uint8_t* sens_list, uint8_t n_sens, uint8_t enable,
+                           struct bmi2_dev* dev)
+{
+    uint8_t power = 0;
+    uint8_t features = 0;
+
+    for (uint8_t i = 0; i < n_sens; i++)
+    {
+        if (BMI2_ACCEL == sens_list[i])
+        {
+            power |= BMI2_PWR_CTRL_ACC_EN;
+        }
+        else if (BMI2_GYRO == sens_list[i])
+        {
+            power |= BMI2_PWR_CTRL_GYR_EN;
+        }
+        else
+        {
+            features |= (uint8_t)(1U << sens_list[i]);
+        }
+    }
+
+    int8_t rslt = BMI2_OK;
+    if (0U != power)
+    {
+        rslt = _bmi2_update_reg(BMI2_REG_PWR_CTRL, power, enable ? power : 0U, dev);
+    }
+    if ((BMI2_OK == rslt) && (0U != features))
+    {
+        uint8_t data[16];
+        rslt = _bmi2_read_feature_page(BMI2_FEAT_PAGE_ENABLE, data, dev);
+        if (BMI2_OK == rslt)
+        {
+            data[0] = enable ? (uint8_t)(data[0] | features) : (uint8_t)(data[0] & ~features);
+            rslt = _bmi2_write_feature_page(BMI2_FEAT_PAGE_ENABLE, data, dev);
+        }
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmi270_sensor_enable
+******************************************************************************/
+int8_t bmi270_sensor_enable(const uint8_t* sens_list, uint8_t n_sens, struct bmi2_dev* dev)
+{
+    return _bmi2_enable(sens_list, n_sens, BMI2_ENABLE, dev);
+}
+
+
+/******************************************************************************
+* bmi270_sensor_disable
+******************************************************************************/
+int8_t bmi270_sensor_disable(const uint8_t* sens_list, uint8_t n_sens, struct bmi2_dev* dev)
+{
+    return _bmi2_enable(sens_list, n_sens, BMI2_DISABLE, dev);
+}
+
+
+/******************************************************************************
+* bmi2_sensor_enable
+******************************************************************************/
+int8_t bmi2_sensor_enable(const uint8_t* sens_list, uint8_t n_sens, struct bmi2_dev* dev)
+{
+    return _bmi2_enable(sens_list, n_sens, BMI2_ENABLE, dev);
+}
+
+
+/******************************************************************************
+* bmi2_sensor_disable
+******************************************************************************/
+int8_t bmi2_sensor_disable(const uint8_t* sens_list, uint8_t n_sens, struct bmi2_dev* dev)
+{
+    return _bmi2_enable(sens_list, n_sens, BMI2_DISABLE, dev);
+}
+
+
+/******************************************************************************
+* bmi270_map_feat_int
+******************************************************************************/
+int8_t bmi270_map_feat_int(const struct bmi2_sens_int_config* sens_int, uint8_t n_sens,
+                           struct bmi2_dev* dev)
+{
+    uint8_t map[2];
+    int8_t rslt = bmi2_get_regs(BMI2_REG_INT1_MAP_FEAT, map, sizeof(map), dev);
+
+    for (uint8_t i = 0; (BMI2_OK == rslt) && (i < n_sens); i++)
+    {
+        uint8_t mask = (BMI2_ANY_MOTION == sens_int[i].type) ? BMI270_ANY_MOT_STATUS_MASK
+            : ((BMI2_NO_MOTION == sens_int[i].type) ? BMI270_NO_MOT_STATUS_MASK
+               : BMI270_SIG_MOT_STATUS_MASK);
+        map[0] &= (uint8_t)~mask;
+        map[1] &= (uint8_t)~mask;
+        if ((BMI2_INT1 == sens_int[i].hw_int_pin) || (BMI2_INT_BOTH == sens_int[i].hw_int_pin))
+        {
+            map[0] |= mask;
+        }
+        if ((BMI2_INT2 == sens_int[i].hw_int_pin) || (BMI2_INT_BOTH == sens_int[i].hw_int_pin))
+        {
+            map[1] |= mask;
+        }
+    }
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi2_set_regs(BMI2_REG_INT1_MAP_FEAT, map, sizeof(map), dev);
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmi2_map_data_int
+******************************************************************************/
+int8_t bmi2_map_data_int(uint8_t data_int, enum bmi2_hw_int_pin int_pin, struct bmi2_dev* dev)
+{
+    /* INT1 uses the low nibble of the register, INT2 the high one */
+    uint8_t mask = (uint8_t)(data_int | (data_int << 4));
+    uint8_t value = 0;
+
+    if ((BMI2_INT1 == int_pin) || (BMI2_INT_BOTH == int_pin))
+    {
+        value |= data_int;
+    }
+    if ((BMI2_INT2 == int_pin) || (BMI2_INT_BOTH == int_pin))
+    {
+        value |= (uint8_t)(data_int << 4);
+    }
+    return _bmi2_update_reg(BMI2_REG_INT_MAP_DATA, mask, value, dev);
+}
+
+
+/******************************************************************************
+* bmi2_get_int_pin_config
+******************************************************************************/
+int8_t bmi2_get_int_pin_config(struct bmi2_int_pin_config* int_cfg, struct bmi2_dev* dev)
+{
+    uint8_t data[3];
+    int8_t rslt = bmi2_get_regs(BMI2_REG_INT1_IO_CTRL, data, sizeof(data), dev);
+
+    if (BMI2_OK == rslt)
+    {
+        for (uint32_t i = 0; i < 2U; i++)
+        {
+            int_cfg->pin_cfg[i].lvl       = (data[i] >> 1) & 0x01U;
+            int_cfg->pin_cfg[i].od        = (data[i] >> 2) & 0x01U;
+            int_cfg->pin_cfg[i].output_en = (data[i] >> 3) & 0x01U;
+            int_cfg->pin_cfg[i].input_en  = (data[i] >> 4) & 0x01U;
+        }
+        int_cfg->int_latch = data[2] & 0x01U;
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmi2_set_int_pin_config
+******************************************************************************/
+int8_t bmi2_set_int_pin_config(const struct bmi2_int_pin_config* int_cfg, struct bmi2_dev* dev)
+{
+    uint8_t data[3];
+
+    for (uint32_t i = 0; i < 2U; i++)
+    {
+        data[i] = (uint8_t)(((int_cfg->pin_cfg[i].lvl & 0x01U) << 1) |
+                            ((int_cfg->pin_cfg[i].od & 0x01U) << 2) |
+                            ((int_cfg->pin_cfg[i].output_en & 0x01U) << 3) |
+                            ((int_cfg->pin_cfg[i].input_en & 0x01U) << 4));
+    }
+    data[2] = int_cfg->int_latch & 0x01U;
+    return bmi2_set_regs(BMI2_REG_INT1_IO_CTRL, data, sizeof(data), dev);
+}
+
+
+/******************************************************************************
+* bmi2_get_int_status
+******************************************************************************/
+int8_t bmi2_get_int_status(uint16_t* int_status, struct bmi2_dev* dev)
+{
+    uint8_t data[2];
+    int8_t rslt = bmi2_get_regs(BMI2_REG_INT_STATUS_0, data, sizeof(data), dev);
+
+    if (BMI2_OK == rslt)
+    {
+        *int_status = (uint16_t)(data[0] | (data[1] << 8));
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmi2_get_sensor_data
+******************************************************************************/
+/* Reads the status, auxiliary, accelerometer, gyroscope and sensor time
+   registers in one burst */
+int8_t bmi2_get_sensor_data(struct bmi2_sens_data* data, struct bmi2_dev* dev)
+{
+    uint8_t regs[BMI2_SENSOR_DATA_BYTES];
+    int8_t rslt = bmi2_get_regs(BMI2_REG_STATUS, regs, sizeof(regs), dev);
+
+    if (BMI2_OK == rslt)
+    {
+        const uint8_t* acc = &regs[9];
+        const uint8_t* gyr = &regs[15];
+        data->acc.x = (int16_t)(acc[0] | (acc[1] << 8));
+        data->acc.y = (int16_t)(acc[2] | (acc[3] << 8));
+        data->acc.z = (int16_t)(acc[4] | (acc[5] << 8));
+        data->gyr.x = (int16_t)(gyr[0] | (gyr[1] << 8));
+        data->gyr.y = (int16_t)(gyr[2] | (gyr[3] << 8));
+        data->gyr.z = (int16_t)(gyr[4] | (gyr[5] << 8));
+        data->sens_time = (uint32_t)regs[21] | ((uint32_t)regs[22] << 8) |
+                          ((uint32_t)regs[23] << 16);
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmi2_set_fifo_config
+******************************************************************************/
+int8_t bmi2_set_fifo_config(uint16_t config, uint8_t enable, struct bmi2_dev* dev)
+{
+    uint8_t data[2];
+    int8_t rslt = bmi2_get_regs(BMI2_REG_FIFO_CONFIG_0, data, sizeof(data), dev);
+
+    if (BMI2_OK == rslt)
+    {
+        uint8_t low  = (uint8_t)(config & 0x03U);
+        uint8_t high = (uint8_t)(config >> 8);
+        data[0] = enable ? (uint8_t)(data[0] | low) : (uint8_t)(data[0] & ~low);
+        data[1] = enable ? (uint8_t)(data[1] | high) : (uint8_t)(data[1] & ~high);
+        rslt = bmi2_set_regs(BMI2_REG_FIFO_CONFIG_0, data, sizeof(data), dev);
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmi2_set_fifo_wm
+******************************************************************************/
+int8_t bmi2_set_fifo_wm(uint16_t fifo_wm, struct bmi2_dev* dev)
+{
+    uint8_t data[2] = { (uint8_t)fifo_wm, (uint8_t)((fifo_wm >> 8) & 0x1FU) };
+    return bmi2_set_regs(BMI2_REG_FIFO_WTM_0, data, sizeof(data), dev);
+}
+
+
+/******************************************************************************
+* bmi2_get_fifo_length
+******************************************************************************/
+int8_t bmi2_get_fifo_length(uint16_t* fifo_length, struct bmi2_dev* dev)
+{
+    uint8_t data[2];
+    int8_t rslt = bmi2_get_regs(BMI2_REG_FIFO_LENGTH_0, data, sizeof(data), dev);
+
+    if (BMI2_OK == rslt)
+    {
+        *fifo_length = (uint16_t)(data[0] | ((data[1] & 0x3FU) << 8));
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmi2_read_fifo_data
+******************************************************************************/
+/* Reads fifo->length bytes in bursts of read_write_len bytes */
+int8_t bmi2_read_fifo_data(struct bmi2_fifo_frame* fifo, struct bmi2_dev* dev)
+{
+    int8_t rslt = BMI2_OK;
+    uint16_t burst = (0U != dev->read_write_len) ? dev->read_write_len : fifo->length;
+
+    fifo->acc_byte_start_idx = 0;
+    fifo->gyr_byte_start_idx = 0;
+    for (uint16_t index = 0; (BMI2_OK == rslt) && (index < fifo->length); index += burst)
+    {
+        uint16_t size = ((fifo->length - index) < burst) ? (uint16_t)(fifo->length - index) : burst;
+        rslt = bmi2_get_regs(BMI2_REG_FIFO_DATA, &fifo->data[index], size, dev);
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* _bmi2_extract
+******************************************************************************/
+/* Parses headerless frames of gyroscope and accelerometer data */
+static void _bmi2_extract(struct bmi2_sens_axes_data* out, uint16_t* length,
+                          const struct bmi2_fifo_frame* fifo, uint16_t* index, uint32_t offset)
+{
+    uint16_t count = 0;
+
+    while ((count < *length) && ((*index + BMI2_FIFO_FRAME_BYTES) <= fifo->length))
+    {
+        const uint8_t* axes = &fifo->data[*index + offset];
+        out[count].x = (int16_t)(axes[0] | (axes[1] << 8));
+        out[count].y = (int16_t)(axes[2] | (axes[3] << 8));
+        out[count].z = (int16_t)(axes[4] | (axes[5] << 8));
+        out[count].virt_sens_time = 0;
+        count++;
+        *index = (uint16_t)(*index + BMI2_FIFO_FRAME_BYTES);
+    }
+    *length = count;
+}
+
+
+/******************************************************************************
+* bmi2_extract_accel
+******************************************************************************/
+int8_t bmi2_extract_accel(struct bmi2_sens_axes_data* accel_data, uint16_t* accel_length,
+                          struct bmi2_fifo_frame* fifo, const struct bmi2_dev* dev)
+{
+    (void)dev;
+    _bmi2_extract(accel_data, accel_length, fifo, &fifo->acc_byte_start_idx, 6U);
+    return BMI2_OK;
+}
+
+
+/******************************************************************************
+* bmi2_extract_gyro
+******************************************************************************/
+int8_t bmi2_extract_gyro(struct bmi2_sens_axes_data* gyro_data, uint16_t* gyro_length,
+                         struct bmi2_fifo_frame* fifo, const struct bmi2_dev* dev)
+{
+    (void)dev;
+    _bmi2_extract(gyro_data, gyro_length, fifo, &fifo->gyr_byte_start_idx, 0U);
+    return BMI2_OK;
+}
+
+
+/******************************************************************************
+* mtb_bmi270_config_default
+******************************************************************************/
+/* Accelerometer and gyroscope at 100 Hz in performance mode */
+cy_rslt_t mtb_bmi270_config_default(mtb_bmi270_t* dev)
+{
+    struct bmi2_sens_config config[2] = { { .type = BMI2_ACCEL }, { .type = BMI2_GYRO } };
+    uint8_t sensors[2] = { BMI2_ACCEL, BMI2_GYRO };
+
+    config[0].cfg.acc.odr         = BMI2_ACC_ODR_100HZ;
+    config[0].cfg.acc.range       = BMI2_ACC_RANGE_2G;
+    config[0].cfg.acc.bwp         = BMI2_ACC_NORMAL_AVG4;
+    config[0].cfg.acc.filter_perf = BMI2_PERF_OPT_MODE;
+    config[1].cfg.gyr.odr         = BMI2_GYR_ODR_100HZ;
+    config[1].cfg.gyr.range       = BMI2_GYR_RANGE_2000;
+    config[1].cfg.gyr.bwp         = BMI2_GYR_NORMAL_MODE;
+    config[1].cfg.gyr.noise_perf  = BMI2_POWER_OPT_MODE;
+    config[1].cfg.gyr.filter_perf = BMI2_PERF_OPT_MODE;
+
+    int8_t rslt = bmi270_set_sensor_config(config, 2, &dev->sensor);
+    if (BMI2_OK == rslt)
+    {
+        rslt = bmi270_sensor_enable(sensors, 2, &dev->sensor);
+    }
+    return (BMI2_OK == rslt) ? CY_RSLT_SUCCESS : CYHAL_RSLT_ERR_HOST;
+}
+
+
+/******************************************************************************
+* mtb_bmi270_read
+******************************************************************************/
+cy_rslt_t mtb_bmi270_read(mtb_bmi270_t* dev, mtb_bmi270_data_t* data)
+{
+    return (BMI2_OK == bmi2_get_sensor_data(&data->sensor_data, &dev->sensor))
+        ? CY_RSLT_SUCCESS
+        : CYHAL_RSLT_ERR_HOST;
+}
+
+
+/******************************************************************************
+* mtb_bmi270_free_pin
+******************************************************************************/
+void mtb_bmi270_free_pin(mtb_bmi270_t* dev)
+{
+    (void)dev;
+}
+
+
+/******************************************************************************
+* bmm350_get_regs
+******************************************************************************/
+/* Every read starts with two dummy bytes */
+int8_t bmm350_get_regs(uint8_t reg_addr, uint8_t* reg_data, uint32_t len, struct bmm350_dev* dev)
+{
+    uint8_t data[BMM350_DUMMY_BYTES + BMM350_MAG_BYTES];
+    int8_t rslt = BMM350_E_NULL_PTR;
+
+    if ((NULL != dev) && (NULL != dev->read) && (len <= BMM350_MAG_BYTES))
+    {
+        rslt = (0 == dev->read(reg_addr, data, len + BMM350_DUMMY_BYTES, dev->intf_ptr))
+            ? BMM350_OK
+            : BMM350_E_COM_FAIL;
+    }
+    if (BMM350_OK == rslt)
+    {
+        memcpy(reg_data, &data[BMM350_DUMMY_BYTES], len);
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmm350_set_regs
+******************************************************************************/
+int8_t bmm350_set_regs(uint8_t reg_addr, const uint8_t* reg_data, uint32_t len,
+                       struct bmm350_dev* dev)
+{
+    int8_t rslt = BMM350_E_NULL_PTR;
+    if ((NULL != dev) && (NULL != dev->write))
+    {
+        rslt = (0 == dev->write(reg_addr, reg_data, len, dev->intf_ptr))
+            ? BMM350_OK
+            : BMM350_E_COM_FAIL;
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* _bmm350_set_reg
+******************************************************************************/
+static int8_t _bmm350_set_reg(uint8_t reg_addr, uint8_t value, struct bmm350_dev* dev)
+{
+    return bmm350_set_regs(reg_addr, &value, 1, dev);
+}
+
+
+/******************************************************************************
+* _bmm350_pmu_command
+******************************************************************************/
+static int8_t _bmm350_pmu_command(uint8_t command, uint32_t delay_us, struct bmm350_dev* dev)
+{
+    int8_t rslt = _bmm350_set_reg(BMM350_REG_PMU_CMD, command, dev);
+    if (BMM350_OK == rslt)
+    {
+        dev->delay_us(delay_us, dev->intf_ptr);
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmm350_init
+******************************************************************************/
+/* Resets the sensor, reads its compensation data from the OTP memory and
+   runs the bit reset and flux guide reset */
+int8_t bmm350_init(struct bmm350_dev* dev)
+{
+    uint8_t chip_id = 0;
+    int8_t rslt = _bmm350_set_reg(BMM350_REG_CMD, BMM350_CMD_SOFT_RESET, dev);
+
+    if (BMM350_OK == rslt)
+    {
+        dev->delay_us(BMM350_SOFT_RESET_US, dev->intf_ptr);
+        rslt = bmm350_get_regs(BMM350_REG_CHIP_ID, &chip_id, 1, dev);
+    }
+    if ((BMM350_OK == rslt) && (BMM350_CHIP_ID != chip_id))
+    {
+        rslt = BMM350_E_DEV_NOT_FOUND;
+    }
+    for (uint8_t word = 0; (BMM350_OK == rslt) && (word < 32U); word++)
+    {
+        uint8_t status = 0;
+        uint8_t data[2];
+        rslt = _bmm350_set_reg(BMM350_REG_OTP_CMD, (uint8_t)(BMM350_OTP_READ | word), dev);
+        if (BMM350_OK == rslt)
+        {
+            dev->delay_us(BMM350_OTP_US, dev->intf_ptr);
+            rslt = bmm350_get_regs(BMM350_REG_OTP_STATUS, &status, 1, dev);
+        }
+        if (BMM350_OK == rslt)
+        {
+            rslt = bmm350_get_regs(BMM350_REG_OTP_DATA_MSB, data, sizeof(data), dev);
+            dev->otp_data[word] = (uint16_t)((data[0] << 8) | data[1]);
+        }
+    }
+    if (BMM350_OK == rslt)
+    {
+        rslt = _bmm350_set_reg(BMM350_REG_OTP_CMD, BMM350_OTP_POWER_OFF, dev);
+    }
+    if (BMM350_OK == rslt)
+    {
+        rslt = _bmm350_pmu_command(BMM350_PMU_BR, BMM350_BR_US, dev);
+    }
+    if (BMM350_OK == rslt)
+    {
+        rslt = _bmm350_pmu_command(BMM350_PMU_FGR, BMM350_FGR_US, dev);
+    }
+    if (BMM350_OK == rslt)
+    {
+        rslt = _bmm350_pmu_command(BMM350_PMU_SUSPEND, BMM350_SUSPEND_US, dev);
+        dev->chip_id = chip_id;
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmm350_set_odr_performance
+******************************************************************************/
+int8_t bmm350_set_odr_performance(enum bmm350_data_rates odr,
+                                  enum bmm350_performance_parameters performance,
+                                  struct bmm350_dev* dev)
+{
+    int8_t rslt = _bmm350_set_reg(BMM350_REG_AGGR_SET,
+                                  (uint8_t)((odr & 0x0FU) | ((performance & 0x03U) << 4)), dev);
+    if (BMM350_OK == rslt)
+    {
+        rslt = _bmm350_pmu_command(BMM350_PMU_UPD_OAE, BMM350_UPD_OAE_US, dev);
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmm350_enable_axes
+******************************************************************************/
+int8_t bmm350_enable_axes(enum bmm350_x_axis_en_dis en_x, enum bmm350_y_axis_en_dis en_y,
+                          enum bmm350_z_axis_en_dis en_z, struct bmm350_dev* dev)
+{
+    return _bmm350_set_reg(BMM350_REG_AXIS_EN,
+                           (uint8_t)(en_x | (en_y << 1) | (en_z << 2)), dev);
+}
+
+
+/******************************************************************************
+* bmm350_set_powermode
+******************************************************************************/
+int8_t bmm350_set_powermode(enum bmm350_power_modes powermode, struct bmm350_dev* dev)
+{
+    static const uint8_t commands[] =
+    {
+        BMM350_PMU_SUSPEND, BMM350_PMU_NORMAL, BMM350_PMU_FORCED, BMM350_PMU_FORCED_FAST
+    };
+    return _bmm350_pmu_command(commands[powermode], BMM350_SUSPEND_US, dev);
+}
+
+
+/******************************************************************************
+* bmm350_configure_interrupt
+******************************************************************************/
+int8_t bmm350_configure_interrupt(enum bmm350_intr_latch latching,
+                                  enum bmm350_intr_polarity polarity,
+                                  enum bmm350_intr_drive drivertype,
+                                  enum bmm350_intr_map map_int, struct bmm350_dev* dev)
+{
+    uint8_t reg = 0;
+    int8_t rslt = bmm350_get_regs(BMM350_REG_INT_CTRL, &reg, 1, dev);
+
+    if (BMM350_OK == rslt)
+    {
+        reg = (uint8_t)((reg & 0x80U) | latching | (polarity << 1) | (drivertype << 2) |
+                        (map_int << 3));
+        rslt = _bmm350_set_reg(BMM350_REG_INT_CTRL, reg, dev);
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* bmm350_enable_interrupt
+******************************************************************************/
+int8_t bmm350_enable_interrupt(enum bmm350_interrupt_enable_disable enable_disable,
+                               struct bmm350_dev* dev)
+{
+    uint8_t reg = 0;
+    int8_t rslt = bmm350_get_regs(BMM350_REG_INT_CTRL, &reg, 1, dev);
+
+    if (BMM350_OK == rslt)
+    {
+        reg = (uint8_t)((reg & 0x7FU) | (enable_disable << 7));
+        rslt = _bmm350_set_reg(BMM350_REG_INT_CTRL, reg, dev);
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* _bmm350_raw
+******************************************************************************/
+static float _bmm350_raw(const uint8_t* data)
+{
+    int32_t raw = (int32_t)((uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+                            ((uint32_t)data[2] << 16));
+    if ((raw & 0x800000L) != 0)
+    {
+        raw -= 0x1000000L;
+    }
+    return (float)raw * BMM350_LSB_SCALE;
+}
+
+
+/******************************************************************************
+* bmm350_get_compensated_mag_xyz_temp_data
+******************************************************************************/
+/* The stand-in applies the fixed scale of the model in place of the OTP
+   compensation */
+int8_t bmm350_get_compensated_mag_xyz_temp_data(struct bmm350_mag_temp_data* mag_temp_data,
+                                                struct bmm350_dev* dev)
+{
+    uint8_t data[BMM350_MAG_BYTES];
+    int8_t rslt = bmm350_get_regs(BMM350_REG_MAG_X, data, sizeof(data), dev);
+
+    if (BMM350_OK == rslt)
+    {
+        mag_temp_data->x           = _bmm350_raw(&data[0]);
+        mag_temp_data->y           = _bmm350_raw(&data[3]);
+        mag_temp_data->z           = _bmm350_raw(&data[6]);
+        mag_temp_data->temperature = _bmm350_raw(&data[9]);
+    }
+    return rslt;
+}
+
+
+/******************************************************************************
+* mtb_bmm350_read
+******************************************************************************/
+cy_rslt_t mtb_bmm350_read(mtb_bmm350_t* dev, mtb_bmm350_data_t* data)
+{
+    return (BMM350_OK == bmm350_get_compensated_mag_xyz_temp_data(&data->sensor_data,
+                                                                  &dev->sensor))
+        ? CY_RSLT_SUCCESS
+        : CYHAL_RSLT_ERR_HOST;
+}
+
+
+/******************************************************************************
+* mtb_bmm350_free_pin
+******************************************************************************/
+void mtb_bmm350_free_pin(mtb_bmm350_t* dev)
+{
+    (void)dev;
+}
+
+
+/******************************************************************************
+* _dps3xx_signed
+******************************************************************************/
+static int32_t _dps3xx_signed(uint32_t value, uint32_t bits)
+{
+    return ((value & (1UL << (bits - 1U))) != 0) ? (int32_t)(value - (1UL << bits))
+                                                 : (int32_t)value;
+}
+
+
+/******************************************************************************
+* xensiv_dps3xx_set_config
+******************************************************************************/
+cy_rslt_t xensiv_dps3xx_set_config(xensiv_dps3xx_t* dev, xensiv_dps3xx_config_t* config)
+{
+    uint8_t data[3] =
+    {
+        (uint8_t)(((config->pressure_rate & 0x07U) << 4) | (config->pressure_oversample & 0x0FU)),
+        (uint8_t)(0x80U | ((config->temperature_rate & 0x07U) << 4) |
+                  (config->temperature_oversample & 0x0FU)),
+        (uint8_t)config->dev_mode
+    };
+    cy_rslt_t result = cyhal_i2c_master_mem_write(dev->i2c, dev->address, DPS3XX_REG_PRS_CFG, 1,
+                                                  data, sizeof(data), I2C_TIMEOUT_MS);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        dev->config = *config;
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* xensiv_dps3xx_get_config
+******************************************************************************/
+cy_rslt_t xensiv_dps3xx_get_config(xensiv_dps3xx_t* dev, xensiv_dps3xx_config_t* config)
+{
+    *config = dev->config;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* xensiv_dps3xx_mtb_init_i2c
+******************************************************************************/
+cy_rslt_t xensiv_dps3xx_mtb_init_i2c(xensiv_dps3xx_t* dev, cyhal_i2c_t* i2c_inst,
+                                     xensiv_dps3xx_i2c_addr_t i2c_addr)
+{
+    uint8_t value = 0;
+    uint8_t coef[DPS3XX_COEF_BYTES];
+    uint32_t waited_us = 0;
+    cy_rslt_t result;
+
+    dev->i2c = i2c_inst;
+    dev->address = (uint8_t)i2c_addr;
+    result = _sim_i2c_read_regs(i2c_inst, dev->address, DPS3XX_REG_PROD_ID, &value, 1);
+    if ((CY_RSLT_SUCCESS == result) && (DPS3XX_PRODUCT_ID != value))
+    {
+        result = XENSIV_DPS3XX_RSLT_ERR_WRONG_PRODUCT;
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = _sim_i2c_write_reg(i2c_inst, dev->address, DPS3XX_REG_RESET, DPS3XX_SOFT_RESET);
+    }
+    /* Wait for the sensor and its coefficients to be ready */
+    while ((CY_RSLT_SUCCESS == result) && ((value & DPS3XX_MEAS_READY) != DPS3XX_MEAS_READY))
+    {
+        _sim_delay_us(DPS3XX_READY_POLL_US);
+        waited_us += DPS3XX_READY_POLL_US;
+        result = _sim_i2c_read_regs(i2c_inst, dev->address, DPS3XX_REG_MEAS_CFG, &value, 1);
+        if ((CY_RSLT_SUCCESS == result) && (waited_us >= DPS3XX_READY_TIMEOUT_US) &&
+            ((value & DPS3XX_MEAS_READY) != DPS3XX_MEAS_READY))
+        {
+            result = XENSIV_DPS3XX_RSLT_ERR_DATA_NOT_READY;
+        }
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = _sim_i2c_read_regs(i2c_inst, dev->address, DPS3XX_REG_COEF, coef, sizeof(coef));
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        dev->c0  = _dps3xx_signed(((uint32_t)coef[0] << 4) | (coef[1] >> 4), 12);
+        dev->c1  = _dps3xx_signed((((uint32_t)coef[1] & 0x0FU) << 8) | coef[2], 12);
+        dev->c00 = _dps3xx_signed(((uint32_t)coef[3] << 12) | ((uint32_t)coef[4] << 4) |
+                                  (coef[5] >> 4), 20);
+        dev->c10 = _dps3xx_signed((((uint32_t)coef[5] & 0x0FU) << 16) |
+                                  ((uint32_t)coef[6] << 8) | coef[7], 20);
+        result = _sim_i2c_read_regs(i2c_inst, dev->address, DPS3XX_REG_COEF_SRCE, &value, 1);
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        xensiv_dps3xx_config_t config =
+        {
+            .dev_mode               = XENSIV_DPS3XX_MODE_BACKGROUND_ALL,
+            .pressure_rate          = DPS3XX_RATE_DEFAULT,
+            .temperature_rate       = DPS3XX_RATE_DEFAULT,
+            .pressure_oversample    = 0,
+            .temperature_oversample = 0
+        };
+        result = xensiv_dps3xx_set_config(dev, &config);
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* xensiv_dps3xx_check_ready
+******************************************************************************/
+cy_rslt_t xensiv_dps3xx_check_ready(xensiv_dps3xx_t* dev, bool* pressure_ready,
+                                    bool* temperature_ready)
+{
+    uint8_t value = 0;
+    cy_rslt_t result = _sim_i2c_read_regs(dev->i2c, dev->address, DPS3XX_REG_MEAS_CFG, &value, 1);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        *pressure_ready    = (value & DPS3XX_MEAS_PRS_RDY) != 0;
+        *temperature_ready = (value & DPS3XX_MEAS_TMP_RDY) != 0;
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* xensiv_dps3xx_read
+******************************************************************************/
+/* Reads the latest results and compensates them with the first order
+   coefficients of the model */
+cy_rslt_t xensiv_dps3xx_read(xensiv_dps3xx_t* dev, float* pressure, float* temperature)
+{
+    uint8_t data[6];
+    cy_rslt_t result = _sim_i2c_read_regs(dev->i2c, dev->address, DPS3XX_REG_PSR_B2, data,
+                                          sizeof(data));
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        float raw_pressure = (float)_dps3xx_signed(((uint32_t)data[0] << 16) |
+                                                   ((uint32_t)data[1] << 8) | data[2], 24) /
+                             DPS3XX_SCALE_1;
+        float raw_temperature = (float)_dps3xx_signed(((uint32_t)data[3] << 16) |
+                                                      ((uint32_t)data[4] << 8) | data[5], 24) /
+                                DPS3XX_SCALE_1;
+        *pressure = ((float)dev->c00 + (raw_pressure * (float)dev->c10)) / DPS3XX_PA_PER_HPA;
+        *temperature = ((float)dev->c0 * 0.5f) + ((float)dev->c1 * raw_temperature);
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* xensiv_dps3xx_free
+******************************************************************************/
+void xensiv_dps3xx_free(xensiv_dps3xx_t* dev)
+{
+    (void)dev;
+}
+
+
+/******************************************************************************
+* xensiv_pasco2_mtb_init_i2c
+******************************************************************************/
+/* Checks the communication through the scratch pad and the sensor status,
+   then starts continuous measurements */
+cy_rslt_t xensiv_pasco2_mtb_init_i2c(xensiv_pasco2_t* dev, cyhal_i2c_t* i2c)
+{
+    uint8_t value = 0;
+    cy_rslt_t result;
+
+    dev->i2c = i2c;
+    result = _sim_i2c_write_reg(i2c, XENSIV_PASCO2_I2C_ADDR, PASCO2_REG_SCRATCH_PAD,
+                                PASCO2_SCRATCH_TEST);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = _sim_i2c_read_regs(i2c, XENSIV_PASCO2_I2C_ADDR, PASCO2_REG_SCRATCH_PAD,
+                                    &value, 1);
+    }
+    if ((CY_RSLT_SUCCESS == result) && (PASCO2_SCRATCH_TEST != value))
+    {
+        result = XENSIV_PASCO2_ERR_COMM;
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = _sim_i2c_read_regs(i2c, XENSIV_PASCO2_I2C_ADDR, PASCO2_REG_SENS_STS, &value, 1);
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        if ((value & PASCO2_SENS_RDY) == 0)
+        {
+            result = XENSIV_PASCO2_ERR_NOT_READY;
+        }
+        else if ((value & PASCO2_SENS_ICCER) != 0)
+        {
+            result = XENSIV_PASCO2_ICCERR;
+        }
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = _sim_i2c_write_reg(i2c, XENSIV_PASCO2_I2C_ADDR, PASCO2_REG_SENS_STS,
+                                    PASCO2_SENS_STS_CLEAR);
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        uint8_t data[3] = { 0, PASCO2_MEAS_RATE_S, PASCO2_OP_MODE_CONTINUOUS };
+        result = cyhal_i2c_master_mem_write(i2c, XENSIV_PASCO2_I2C_ADDR, PASCO2_REG_MEAS_RATE_H,
+                                            1, data, sizeof(data), I2C_TIMEOUT_MS);
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* xensiv_pasco2_start_single_mode
+******************************************************************************/
+cy_rslt_t xensiv_pasco2_start_single_mode(const xensiv_pasco2_t* dev)
+{
+    cy_rslt_t result = _sim_i2c_write_reg(dev->i2c, XENSIV_PASCO2_I2C_ADDR, PASCO2_REG_MEAS_CFG,
+                                          PASCO2_OP_MODE_IDLE);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = _sim_i2c_write_reg(dev->i2c, XENSIV_PASCO2_I2C_ADDR, PASCO2_REG_MEAS_CFG,
+                                    PASCO2_OP_MODE_SINGLE);
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* xensiv_pasco2_get_result
+******************************************************************************/
+cy_rslt_t xensiv_pasco2_get_result(const xensiv_pasco2_t* dev, uint16_t* val)
+{
+    uint8_t status = 0;
+    cy_rslt_t result = _sim_i2c_read_regs(dev->i2c, XENSIV_PASCO2_I2C_ADDR, PASCO2_REG_MEAS_STS,
+                                          &status, 1);
+
+    if ((CY_RSLT_SUCCESS == result) && ((status & PASCO2_MEAS_DRDY) == 0))
+    {
+        result = XENSIV_PASCO2_READ_NRDY;
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        uint8_t data[2];
+        result = _sim_i2c_read_regs(dev->i2c, XENSIV_PASCO2_I2C_ADDR, PASCO2_REG_CO2PPM_H, data,
+                                    sizeof(data));
+        *val = (uint16_t)((data[0] << 8) | data[1]);
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = _sim_i2c_write_reg(dev->i2c, XENSIV_PASCO2_I2C_ADDR, PASCO2_REG_MEAS_STS,
+                                    PASCO2_MEAS_STS_CLEAR);
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* xensiv_pasco2_mtb_read
+******************************************************************************/
+cy_rslt_t xensiv_pasco2_mtb_read(xensiv_pasco2_t* dev, uint16_t press_ref, uint16_t* co2_ppm_val)
+{
+    uint8_t data[2] = { (uint8_t)(press_ref >> 8), (uint8_t)press_ref };
+    cy_rslt_t result = cyhal_i2c_master_mem_write(dev->i2c, XENSIV_PASCO2_I2C_ADDR,
+                                                  PASCO2_REG_PRESS_REF_H, 1, data, sizeof(data),
+                                                  I2C_TIMEOUT_MS);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = xensiv_pasco2_get_result(dev, co2_ppm_val);
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* _st7735s_write
+******************************************************************************/
+static void _st7735s_write(bool data_mode, const uint8_t* data, size_t size)
+{
+    cyhal_gpio_write(_st7735s_pins.dc, data_mode);
+    (void)cyhal_spi_transfer(_st7735s_spi, data, size, NULL, 0, 0);
+}
+
+
+/******************************************************************************
+* mtb_st7735s_init_spi
+******************************************************************************/
+/* Resets the controller and sends the initialization sequence of the
+   128x160 panel */
+cy_rslt_t mtb_st7735s_init_spi(cyhal_spi_t* spi_inst, const mtb_st7735s_pins_t* pin_data)
+{
+    /* Command, number of parameters, parameters */
+    static const uint8_t sequence[] =
+    {
+        0xB1, 3, 0x01, 0x2C, 0x2D,
+        0xB2, 3, 0x01, 0x2C, 0x2D,
+        0xB3, 6, 0x01, 0x2C, 0x2D, 0x01, 0x2C, 0x2D,
+        0xB4, 1, 0x07,
+        0xC0, 3, 0xA2, 0x02, 0x84,
+        0xC1, 1, 0xC5,
+        0xC2, 2, 0x0A, 0x00,
+        0xC3, 2, 0x8A, 0x2A,
+        0xC4, 2, 0x8A, 0xEE,
+        0xC5, 1, 0x0E,
+        0x20, 0,
+        0x36, 1, 0xC8,
+        0x3A, 1, 0x05,
+        0x2A, 4, 0x00, 0x00, 0x00, 0x7F,
+        0x2B, 4, 0x00, 0x00, 0x00, 0x9F,
+        0xE0, 16, 0x02, 0x1C, 0x07, 0x12, 0x37, 0x32, 0x29, 0x2D, 0x29, 0x25, 0x2B, 0x39,
+        0x00, 0x01, 0x03, 0x10,
+        0xE1, 16, 0x03, 0x1D, 0x07, 0x06, 0x2E, 0x2C, 0x29, 0x2D, 0x2E, 0x2E, 0x37, 0x3F,
+        0x00, 0x00, 0x02, 0x10,
+        0x13, 0
+    };
+    cy_rslt_t result;
+
+    _st7735s_spi  = spi_inst;
+    _st7735s_pins = *pin_data;
+    result = cyhal_gpio_init(_st7735s_pins.dc, CYHAL_GPIO_DIR_OUTPUT, CYHAL_GPIO_DRIVE_STRONG,
+                             false);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cyhal_gpio_init(_st7735s_pins.rst, CYHAL_GPIO_DIR_OUTPUT,
+                                 CYHAL_GPIO_DRIVE_STRONG, true);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cyhal_gpio_free(_st7735s_pins.dc);
+        }
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cyhal_spi_set_frequency(spi_inst, ST7735S_SPI_FREQ_HZ);
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        uint8_t command = ST7735S_SWRESET;
+
+        cyhal_gpio_write(_st7735s_pins.rst, false);
+        _sim_delay_us(ST7735S_RESET_US);
+        cyhal_gpio_write(_st7735s_pins.rst, true);
+        _sim_delay_us(ST7735S_RESET_US);
+        _st7735s_write(false, &command, 1);
+        cyhal_system_delay_ms(ST7735S_SLEEP_OUT_MS);
+        command = ST7735S_SLPOUT;
+        _st7735s_write(false, &command, 1);
+        cyhal_system_delay_ms(ST7735S_SLEEP_OUT_MS);
+
+        for (size_t i = 0; i < sizeof(sequence); i += 2U + sequence[i + 1U])
+        {
+            _st7735s_write(false, &sequence[i], 1);
+            if (0U != sequence[i + 1U])
+            {
+                _st7735s_write(true, &sequence[i + 2U], sequence[i + 1U]);
+            }
+        }
+        command = ST7735S_DISPON;
+        _st7735s_write(false, &command, 1);
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* mtb_st7735s_write_command
+******************************************************************************/
+void mtb_st7735s_write_command(uint8_t data)
+{
+    _st7735s_write(false, &data, 1);
+}
+
+
+/******************************************************************************
+* mtb_st7735s_write_data
+******************************************************************************/
+void mtb_st7735s_write_data(uint8_t data)
+{
+    _st7735s_write(true, &data, 1);
+}
+
+
+/******************************************************************************
+* mtb_st7735s_write_command_stream
+******************************************************************************/
+void mtb_st7735s_write_command_stream(uint8_t* data, int num)
+{
+    for (int i = 0; i < num; i++)
+    {
+        mtb_st7735s_write_command(data[i]);
+    }
+}
+
+
+/******************************************************************************
+* mtb_st7735s_write_data_stream
+******************************************************************************/
+void mtb_st7735s_write_data_stream(uint8_t* data, int num)
+{
+    _st7735s_write(true, data, (size_t)num);
+}
+
+
+/******************************************************************************
+* mtb_st7735s_free
+******************************************************************************/
+void mtb_st7735s_free(void)
+{
+    cyhal_gpio_free(_st7735s_pins.dc);
+    cyhal_gpio_free(_st7735s_pins.rst);
+}
+
+
+/* [] END OF FILE */
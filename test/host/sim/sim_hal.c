@@ -0,0 +1,1503 @@
+/******************************************************************************
+ * \file sim_hal.c
+ *
+ * Description: This file implements the HAL of the host simulation: the
+ *              virtual clock with its event queue, GPIO with edge callbacks,
+ *              I2C and SPI transfers which take the time of the bytes on the
+ *              wire, the timers, the microphone and the ADC.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <string.h>
+#include <time.h>
+#include "sim.h"
+#include "cyabs_rtos.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define US_PER_S                            (1000000ULL)
+/* Events pending at the same time */
+#define EVENT_CAPACITY                      (64U)
+/* Bits per I2C byte, with the acknowledge */
+#define I2C_BITS_PER_BYTE                   (9U)
+/* START and STOP conditions, about one bit each */
+#define I2C_FRAME_BITS                      (2U)
+#define I2C_DEFAULT_HZ                      (100000UL)
+#define SPI_DEFAULT_HZ                      (1000000UL)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+typedef struct
+{
+    uint64_t    time_us;
+    uint64_t    order;
+    sim_event_t event;
+    void*       arg;
+} _sim_event_t;
+
+typedef struct
+{
+    bool                        used;
+    bool                        level;
+    uint32_t                    events;
+    cyhal_gpio_callback_data_t* callback_data;
+    sim_gpio_watch_t            watch;
+    void*                       watch_arg;
+} _sim_gpio_t;
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static uint64_t                 _sim_now_us;
+static uint64_t                 _sim_event_order;
+static _sim_event_t             _sim_events[EVENT_CAPACITY];
+static uint32_t                 _sim_event_count;
+static uint32_t                 _sim_isr_depth;
+static _sim_gpio_t              _sim_gpio[SIM_GPIO_COUNT];
+static const sim_i2c_device_t*  _sim_i2c_devices[128];
+static sim_bus_stats_t          _sim_i2c_stats[128];
+static sim_bus_stats_t          _sim_i2c_all;
+static sim_bus_stats_t          _sim_spi_all;
+static sim_pdm_source_t         _sim_pdm_source;
+static void*                    _sim_pdm_source_arg;
+
+
+/******************************************************************************
+* _sim_run_event
+******************************************************************************/
+/* Removes the earliest event due at limit_us and runs it */
+static bool _sim_run_event(uint64_t limit_us)
+{
+    uint32_t next = EVENT_CAPACITY;
+
+    for (uint32_t i = 0; i < _sim_event_count; i++)
+    {
+        if ((next == EVENT_CAPACITY) ||
+            (_sim_events[i].time_us < _sim_events[next].time_us) ||
+            ((_sim_events[i].time_us == _sim_events[next].time_us) &&
+             (_sim_events[i].order < _sim_events[next].order)))
+        {
+            next = i;
+        }
+    }
+
+    bool due = (next != EVENT_CAPACITY) && (_sim_events[next].time_us <= limit_us);
+    if (due)
+    {
+        _sim_event_t event = _sim_events[next];
+        _sim_events[next] = _sim_events[--_sim_event_count];
+        if (event.time_us > _sim_now_us)
+        {
+            _sim_now_us = event.time_us;
+        }
+        _sim_isr_depth++;
+        event.event(event.arg);
+        _sim_isr_depth--;
+    }
+    return due;
+}
+
+
+/******************************************************************************
+* sim_reset
+******************************************************************************/
+void sim_reset(void)
+{
+    _sim_now_us = 0;
+    _sim_event_order = 0;
+    _sim_event_count = 0;
+    _sim_isr_depth = 0;
+    memset(_sim_gpio, 0, sizeof(_sim_gpio));
+    memset(_sim_i2c_devices, 0, sizeof(_sim_i2c_devices));
+    _sim_pdm_source = NULL;
+    _sim_pdm_source_arg = NULL;
+    sim_stats_reset();
+    sim_devices_reset();
+}
+
+
+/******************************************************************************
+* sim_now_us
+******************************************************************************/
+uint64_t sim_now_us(void)
+{
+    return _sim_now_us;
+}
+
+
+/******************************************************************************
+* sim_advance_us
+******************************************************************************/
+void sim_advance_us(uint64_t us)
+{
+    uint64_t target_us = _sim_now_us + us;
+
+    if (0U == _sim_isr_depth)
+    {
+        while (_sim_run_event(target_us))
+        {
+        }
+    }
+    if (target_us > _sim_now_us)
+    {
+        _sim_now_us = target_us;
+    }
+}
+
+
+/******************************************************************************
+* sim_step
+******************************************************************************/
+bool sim_step(uint64_t limit_us)
+{
+    bool ran = _sim_run_event(limit_us);
+    if (!ran && (limit_us > _sim_now_us))
+    {
+        _sim_now_us = limit_us;
+    }
+    return ran;
+}
+
+
+/******************************************************************************
+* sim_schedule
+******************************************************************************/
+void sim_schedule(uint64_t time_us, sim_event_t event, void* arg)
+{
+    if (_sim_event_count < EVENT_CAPACITY)
+    {
+        _sim_events[_sim_event_count].time_us = time_us;
+        _sim_events[_sim_event_count].order   = _sim_event_order++;
+        _sim_events[_sim_event_count].event   = event;
+        _sim_events[_sim_event_count].arg     = arg;
+        _sim_event_count++;
+    }
+}
+
+
+/******************************************************************************
+* sim_cancel
+******************************************************************************/
+void sim_cancel(sim_event_t event, void* arg)
+{
+    uint32_t i = 0;
+    while (i < _sim_event_count)
+    {
+        if ((_sim_events[i].event == event) && (_sim_events[i].arg == arg))
+        {
+            _sim_events[i] = _sim_events[--_sim_event_count];
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+
+/******************************************************************************
+* sim_cycles
+******************************************************************************/
+uint64_t sim_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    uint32_t low, high;
+    __asm__ __volatile__ ("rdtsc" : "=a" (low), "=d" (high));
+    return ((uint64_t)high << 32) | low;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+#endif
+}
+
+
+/******************************************************************************
+* sim_cycles_unit
+******************************************************************************/
+const char* sim_cycles_unit(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return "cycles";
+#else
+    return "ns";
+#endif
+}
+
+
+/******************************************************************************
+* cyhal_system_delay_ms
+******************************************************************************/
+void cyhal_system_delay_ms(uint32_t milliseconds)
+{
+    sim_advance_us((uint64_t)milliseconds * 1000U);
+}
+
+
+/******************************************************************************
+* cyhal_system_delay_us
+******************************************************************************/
+void cyhal_system_delay_us(uint16_t microseconds)
+{
+    sim_advance_us(microseconds);
+}
+
+
+/******************************************************************************
+* cyhal_system_critical_section_enter
+******************************************************************************/
+/* Events only run between the statements of the library, so there is nothing
+   to mask */
+uint32_t cyhal_system_critical_section_enter(void)
+{
+    return 0;
+}
+
+
+/******************************************************************************
+* cyhal_system_critical_section_exit
+******************************************************************************/
+void cyhal_system_critical_section_exit(uint32_t old_state)
+{
+    (void)old_state;
+}
+
+
+/******************************************************************************
+* _sim_gpio_valid
+******************************************************************************/
+static inline bool _sim_gpio_valid(cyhal_gpio_t pin)
+{
+    return (pin >= 0) && ((uint32_t)pin < SIM_GPIO_COUNT);
+}
+
+
+/******************************************************************************
+* cyhal_gpio_init
+******************************************************************************/
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction,
+                          cyhal_gpio_drive_mode_t drive_mode, bool init_val)
+{
+    cy_rslt_t result = CYHAL_RSLT_ERR_HOST;
+
+    (void)drive_mode;
+    if (_sim_gpio_valid(pin) && !_sim_gpio[pin].used)
+    {
+        _sim_gpio[pin].used = true;
+        _sim_gpio[pin].events = 0;
+        _sim_gpio[pin].callback_data = NULL;
+        if (CYHAL_GPIO_DIR_INPUT != direction)
+        {
+            cyhal_gpio_write(pin, init_val);
+        }
+        result = CY_RSLT_SUCCESS;
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* cyhal_gpio_free
+******************************************************************************/
+void cyhal_gpio_free(cyhal_gpio_t pin)
+{
+    if (_sim_gpio_valid(pin))
+    {
+        _sim_gpio[pin].used = false;
+        _sim_gpio[pin].events = 0;
+        _sim_gpio[pin].callback_data = NULL;
+    }
+}
+
+
+/******************************************************************************
+* cyhal_gpio_write
+******************************************************************************/
+void cyhal_gpio_write(cyhal_gpio_t pin, bool value)
+{
+    if (_sim_gpio_valid(pin))
+    {
+        _sim_gpio[pin].level = value;
+        if (NULL != _sim_gpio[pin].watch)
+        {
+            _sim_gpio[pin].watch(pin, value, _sim_gpio[pin].watch_arg);
+        }
+    }
+}
+
+
+/******************************************************************************
+* cyhal_gpio_read
+******************************************************************************/
+bool cyhal_gpio_read(cyhal_gpio_t pin)
+{
+    return _sim_gpio_valid(pin) && _sim_gpio[pin].level;
+}
+
+
+/******************************************************************************
+* cyhal_gpio_register_callback
+******************************************************************************/
+void cyhal_gpio_register_callback(cyhal_gpio_t pin, cyhal_gpio_callback_data_t* callback_data)
+{
+    if (_sim_gpio_valid(pin))
+    {
+        _sim_gpio[pin].callback_data = callback_data;
+    }
+}
+
+
+/******************************************************************************
+* cyhal_gpio_enable_event
+******************************************************************************/
+void cyhal_gpio_enable_event(cyhal_gpio_t pin, cyhal_gpio_event_t event, uint8_t intr_priority,
+                             bool enable)
+{
+    (void)intr_priority;
+    if (_sim_gpio_valid(pin))
+    {
+        if (enable)
+        {
+            _sim_gpio[pin].events |= (uint32_t)event;
+        }
+        else
+        {
+            _sim_gpio[pin].events &= ~(uint32_t)event;
+        }
+    }
+}
+
+
+/******************************************************************************
+* sim_gpio_drive
+******************************************************************************/
+void sim_gpio_drive(cyhal_gpio_t pin, bool level)
+{
+    if (_sim_gpio_valid(pin) && (_sim_gpio[pin].level != level))
+    {
+        _sim_gpio_t* gpio = &_sim_gpio[pin];
+        cyhal_gpio_event_t edge = level ? CYHAL_GPIO_IRQ_RISE : CYHAL_GPIO_IRQ_FALL;
+
+        gpio->level = level;
+        if (((gpio->events & (uint32_t)edge) != 0) && (NULL != gpio->callback_data) &&
+            (NULL != gpio->callback_data->callback))
+        {
+            _sim_isr_depth++;
+            gpio->callback_data->callback(gpio->callback_data->callback_arg, edge);
+            _sim_isr_depth--;
+        }
+    }
+}
+
+
+/******************************************************************************
+* sim_gpio_level
+******************************************************************************/
+bool sim_gpio_level(cyhal_gpio_t pin)
+{
+    return cyhal_gpio_read(pin);
+}
+
+
+/******************************************************************************
+* sim_gpio_watch
+******************************************************************************/
+void sim_gpio_watch(cyhal_gpio_t pin, sim_gpio_watch_t watch, void* arg)
+{
+    if (_sim_gpio_valid(pin))
+    {
+        _sim_gpio[pin].watch = watch;
+        _sim_gpio[pin].watch_arg = arg;
+    }
+}
+
+
+/******************************************************************************
+* sim_i2c_attach
+******************************************************************************/
+void sim_i2c_attach(uint8_t address, const sim_i2c_device_t* device)
+{
+    _sim_i2c_devices[address & 0x7FU] = device;
+}
+
+
+/******************************************************************************
+* sim_i2c_device_name
+******************************************************************************/
+const char* sim_i2c_device_name(uint8_t address)
+{
+    const sim_i2c_device_t* device = _sim_i2c_devices[address & 0x7FU];
+    return (NULL != device) ? device->name : NULL;
+}
+
+
+/******************************************************************************
+* sim_stats_reset
+******************************************************************************/
+void sim_stats_reset(void)
+{
+    memset(_sim_i2c_stats, 0, sizeof(_sim_i2c_stats));
+    memset(&_sim_i2c_all, 0, sizeof(_sim_i2c_all));
+    memset(&_sim_spi_all, 0, sizeof(_sim_spi_all));
+}
+
+
+/******************************************************************************
+* sim_i2c_stats
+******************************************************************************/
+sim_bus_stats_t sim_i2c_stats(uint8_t address)
+{
+    return _sim_i2c_stats[address & 0x7FU];
+}
+
+
+/******************************************************************************
+* sim_i2c_total
+******************************************************************************/
+sim_bus_stats_t sim_i2c_total(void)
+{
+    return _sim_i2c_all;
+}
+
+
+/******************************************************************************
+* sim_spi_total
+******************************************************************************/
+sim_bus_stats_t sim_spi_total(void)
+{
+    return _sim_spi_all;
+}
+
+
+/******************************************************************************
+* _sim_stats_add
+******************************************************************************/
+static void _sim_stats_add(sim_bus_stats_t* stats, bool ack, size_t written, size_t read,
+                           uint64_t busy_us)
+{
+    stats->transactions++;
+    stats->nacks         += ack ? 0U : 1U;
+    stats->bytes_written += (uint32_t)written;
+    stats->bytes_read    += (uint32_t)read;
+    stats->busy_us       += busy_us;
+}
+
+
+/******************************************************************************
+* _sim_i2c_us
+******************************************************************************/
+/* Time on the wire of messages with the given number of bytes, each preceded
+   by the address byte */
+static uint64_t _sim_i2c_us(const cyhal_i2c_t* obj, uint32_t messages, size_t bytes)
+{
+    uint32_t frequency_hz = (0U != obj->frequency_hz) ? obj->frequency_hz : I2C_DEFAULT_HZ;
+    uint64_t bits = ((uint64_t)(bytes + messages) * I2C_BITS_PER_BYTE) +
+                    ((uint64_t)messages * I2C_FRAME_BITS);
+    return ((bits * US_PER_S) + frequency_hz - 1U) / frequency_hz;
+}
+
+
+/******************************************************************************
+* _sim_i2c_transfer
+******************************************************************************/
+/* Performs a write, a read or a write followed by a repeated start read. The
+   transfer stops at the first NACKed message. Returns whether all messages
+   were acknowledged and the time the transfer took. */
+static bool _sim_i2c_transfer(const cyhal_i2c_t* obj, uint16_t address, const uint8_t* tx,
+                              size_t tx_size, uint8_t* rx, size_t rx_size, uint64_t* busy_us)
+{
+    const sim_i2c_device_t* device = _sim_i2c_devices[address & 0x7FU];
+    uint32_t messages = 0;
+    size_t written = 0;
+    size_t read = 0;
+    bool ack = (NULL != device);
+
+    if (ack && (tx_size > 0))
+    {
+        messages++;
+        ack = device->write(device->ctx, tx, tx_size);
+        written = ack ? tx_size : 0;
+    }
+    if (ack && (rx_size > 0))
+    {
+        messages++;
+        ack = device->read(device->ctx, rx, rx_size);
+        read = ack ? rx_size : 0;
+    }
+    if (0U == messages)
+    {
+        messages = 1;
+    }
+
+    *busy_us = SIM_I2C_SETUP_US + _sim_i2c_us(obj, messages, written + read);
+    _sim_stats_add(&_sim_i2c_stats[address & 0x7FU], ack, written, read, *busy_us);
+    _sim_stats_add(&_sim_i2c_all, ack, written, read, *busy_us);
+    return ack;
+}
+
+
+/******************************************************************************
+* _sim_i2c_blocking
+******************************************************************************/
+static cy_rslt_t _sim_i2c_blocking(cyhal_i2c_t* obj, uint16_t address, const uint8_t* tx,
+                                   size_t tx_size, uint8_t* rx, size_t rx_size)
+{
+    cy_rslt_t result = CYHAL_RSLT_ERR_BUSY;
+
+    if (!obj->busy)
+    {
+        uint64_t busy_us;
+        bool ack = _sim_i2c_transfer(obj, address, tx, tx_size, rx, rx_size, &busy_us);
+        sim_advance_us(busy_us);
+        result = ack ? CY_RSLT_SUCCESS : CYHAL_RSLT_ERR_NACK;
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* cyhal_i2c_init
+******************************************************************************/
+cy_rslt_t cyhal_i2c_init(cyhal_i2c_t* obj, cyhal_gpio_t sda, cyhal_gpio_t scl,
+                         const cyhal_clock_t* clk)
+{
+    (void)sda;
+    (void)scl;
+    (void)clk;
+    memset(obj, 0, sizeof(*obj));
+    obj->frequency_hz = I2C_DEFAULT_HZ;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_i2c_configure
+******************************************************************************/
+cy_rslt_t cyhal_i2c_configure(cyhal_i2c_t* obj, const cyhal_i2c_cfg_t* cfg)
+{
+    obj->frequency_hz = cfg->frequencyhal_hz;
+    return cfg->is_slave ? CYHAL_RSLT_ERR_HOST : CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_i2c_free
+******************************************************************************/
+void cyhal_i2c_free(cyhal_i2c_t* obj)
+{
+    (void)cyhal_i2c_abort_async(obj);
+    obj->callback = NULL;
+    obj->events = 0;
+}
+
+
+/******************************************************************************
+* cyhal_i2c_master_write
+******************************************************************************/
+cy_rslt_t cyhal_i2c_master_write(cyhal_i2c_t* obj, uint16_t dev_addr, const uint8_t* data,
+                                 uint16_t size, uint32_t timeout, bool send_stop)
+{
+    (void)timeout;
+    (void)send_stop;
+    return _sim_i2c_blocking(obj, dev_addr, data, size, NULL, 0);
+}
+
+
+/******************************************************************************
+* cyhal_i2c_master_read
+******************************************************************************/
+cy_rslt_t cyhal_i2c_master_read(cyhal_i2c_t* obj, uint16_t dev_addr, uint8_t* data,
+                                uint16_t size, uint32_t timeout, bool send_stop)
+{
+    (void)timeout;
+    (void)send_stop;
+    return _sim_i2c_blocking(obj, dev_addr, NULL, 0, data, size);
+}
+
+
+/******************************************************************************
+* cyhal_i2c_master_mem_write
+******************************************************************************/
+cy_rslt_t cyhal_i2c_master_mem_write(cyhal_i2c_t* obj, uint16_t address, uint16_t mem_addr,
+                                     uint16_t mem_addr_size, const uint8_t* data,
+                                     uint16_t size, uint32_t timeout)
+{
+    uint8_t buffer[2U + UINT16_MAX];
+    size_t index = 0;
+
+    (void)timeout;
+    if (2U == mem_addr_size)
+    {
+        buffer[index++] = (uint8_t)(mem_addr >> 8);
+    }
+    buffer[index++] = (uint8_t)mem_addr;
+    if (size > 0)
+    {
+        memcpy(&buffer[index], data, size);
+    }
+    return _sim_i2c_blocking(obj, address, buffer, index + size, NULL, 0);
+}
+
+
+/******************************************************************************
+* cyhal_i2c_master_mem_read
+******************************************************************************/
+cy_rslt_t cyhal_i2c_master_mem_read(cyhal_i2c_t* obj, uint16_t address, uint16_t mem_addr,
+                                    uint16_t mem_addr_size, uint8_t* data, uint16_t size,
+                                    uint32_t timeout)
+{
+    uint8_t buffer[2];
+    size_t index = 0;
+
+    (void)timeout;
+    if (2U == mem_addr_size)
+    {
+        buffer[index++] = (uint8_t)(mem_addr >> 8);
+    }
+    buffer[index++] = (uint8_t)mem_addr;
+    return _sim_i2c_blocking(obj, address, buffer, index, data, size);
+}
+
+
+/******************************************************************************
+* _sim_i2c_complete
+******************************************************************************/
+static void _sim_i2c_complete(void* arg)
+{
+    cyhal_i2c_t* obj = arg;
+    uint64_t busy_us;
+    bool ack = _sim_i2c_transfer(obj, obj->address, obj->tx, obj->tx_size, obj->rx,
+                                 obj->rx_size, &busy_us);
+    cyhal_i2c_event_t event = !ack
+        ? CYHAL_I2C_MASTER_ERR_EVENT
+        : ((obj->rx_size > 0) ? CYHAL_I2C_MASTER_RD_CMPLT_EVENT : CYHAL_I2C_MASTER_WR_CMPLT_EVENT);
+
+    obj->busy = false;
+    if (((obj->events & (uint32_t)event) != 0) && (NULL != obj->callback))
+    {
+        obj->callback(obj->callback_arg, event);
+    }
+}
+
+
+/******************************************************************************
+* cyhal_i2c_master_transfer_async
+******************************************************************************/
+/* The device sees the transfer when it completes, after the time it takes on
+   the wire */
+cy_rslt_t cyhal_i2c_master_transfer_async(cyhal_i2c_t* obj, uint16_t address, const void* tx,
+                                          size_t tx_size, void* rx, size_t rx_size)
+{
+    cy_rslt_t result = CYHAL_RSLT_ERR_BUSY;
+
+    if (!obj->busy)
+    {
+        uint32_t messages = ((tx_size > 0) ? 1U : 0U) + ((rx_size > 0) ? 1U : 0U);
+        obj->busy    = true;
+        obj->address = address;
+        obj->tx      = tx;
+        obj->tx_size = tx_size;
+        obj->rx      = rx;
+        obj->rx_size = rx_size;
+        sim_schedule(_sim_now_us + SIM_I2C_SETUP_US +
+                     _sim_i2c_us(obj, (messages > 0) ? messages : 1U, tx_size + rx_size),
+                     _sim_i2c_complete, obj);
+        result = CY_RSLT_SUCCESS;
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* cyhal_i2c_abort_async
+******************************************************************************/
+cy_rslt_t cyhal_i2c_abort_async(cyhal_i2c_t* obj)
+{
+    sim_cancel(_sim_i2c_complete, obj);
+    obj->busy = false;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_i2c_register_callback
+******************************************************************************/
+void cyhal_i2c_register_callback(cyhal_i2c_t* obj, cyhal_i2c_event_callback_t callback,
+                                 void* callback_arg)
+{
+    obj->callback     = callback;
+    obj->callback_arg = callback_arg;
+}
+
+
+/******************************************************************************
+* cyhal_i2c_enable_event
+******************************************************************************/
+void cyhal_i2c_enable_event(cyhal_i2c_t* obj, cyhal_i2c_event_t event, uint8_t intr_priority,
+                            bool enable)
+{
+    (void)intr_priority;
+    if (enable)
+    {
+        obj->events |= (uint32_t)event;
+    }
+    else
+    {
+        obj->events &= ~(uint32_t)event;
+    }
+}
+
+
+/******************************************************************************
+* _sim_spi_us
+******************************************************************************/
+static uint64_t _sim_spi_us(const cyhal_spi_t* obj, size_t bytes)
+{
+    uint32_t frequency_hz = (0U != obj->frequency_hz) ? obj->frequency_hz : SPI_DEFAULT_HZ;
+    return SIM_SPI_SETUP_US + ((((uint64_t)bytes * 8U * US_PER_S) + frequency_hz - 1U) /
+                               frequency_hz);
+}
+
+
+/******************************************************************************
+* _sim_spi_account
+******************************************************************************/
+/* Records a transfer, the bytes are clocked in both directions at once */
+static uint64_t _sim_spi_account(const cyhal_spi_t* obj, size_t tx_length, uint8_t* rx,
+                                 size_t rx_length, uint8_t write_fill)
+{
+    size_t bytes = (tx_length > rx_length) ? tx_length : rx_length;
+    uint64_t busy_us = _sim_spi_us(obj, bytes);
+
+    (void)write_fill;
+    if ((NULL != rx) && (rx_length > 0))
+    {
+        memset(rx, 0, rx_length);
+    }
+    _sim_stats_add(&_sim_spi_all, true, tx_length, rx_length, busy_us);
+    return busy_us;
+}
+
+
+/******************************************************************************
+* cyhal_spi_init
+******************************************************************************/
+cy_rslt_t cyhal_spi_init(cyhal_spi_t* obj, cyhal_gpio_t mosi, cyhal_gpio_t miso,
+                         cyhal_gpio_t sclk, cyhal_gpio_t ssel, const cyhal_clock_t* clk,
+                         uint8_t bits, cyhal_spi_mode_t mode, bool is_slave)
+{
+    (void)mosi;
+    (void)miso;
+    (void)sclk;
+    (void)ssel;
+    (void)clk;
+    (void)mode;
+    memset(obj, 0, sizeof(*obj));
+    obj->frequency_hz = SPI_DEFAULT_HZ;
+    return ((8U == bits) && !is_slave) ? CY_RSLT_SUCCESS : CYHAL_RSLT_ERR_HOST;
+}
+
+
+/******************************************************************************
+* cyhal_spi_set_frequency
+******************************************************************************/
+cy_rslt_t cyhal_spi_set_frequency(cyhal_spi_t* obj, uint32_t hz)
+{
+    obj->frequency_hz = hz;
+    return (0U != hz) ? CY_RSLT_SUCCESS : CYHAL_RSLT_ERR_HOST;
+}
+
+
+/******************************************************************************
+* cyhal_spi_free
+******************************************************************************/
+void cyhal_spi_free(cyhal_spi_t* obj)
+{
+    (void)cyhal_spi_abort_async(obj);
+    obj->callback = NULL;
+    obj->events = 0;
+}
+
+
+/******************************************************************************
+* cyhal_spi_transfer
+******************************************************************************/
+cy_rslt_t cyhal_spi_transfer(cyhal_spi_t* obj, const uint8_t* tx, size_t tx_length, uint8_t* rx,
+                             size_t rx_length, uint8_t write_fill)
+{
+    cy_rslt_t result = CYHAL_RSLT_ERR_BUSY;
+
+    (void)tx;
+    if (!obj->busy)
+    {
+        sim_advance_us(_sim_spi_account(obj, tx_length, rx, rx_length, write_fill));
+        result = CY_RSLT_SUCCESS;
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* _sim_spi_complete
+******************************************************************************/
+static void _sim_spi_complete(void* arg)
+{
+    cyhal_spi_t* obj = arg;
+
+    obj->busy = false;
+    if (((obj->events & (uint32_t)CYHAL_SPI_IRQ_DONE) != 0) && (NULL != obj->callback))
+    {
+        obj->callback(obj->callback_arg, CYHAL_SPI_IRQ_DONE);
+    }
+}
+
+
+/******************************************************************************
+* cyhal_spi_transfer_async
+******************************************************************************/
+cy_rslt_t cyhal_spi_transfer_async(cyhal_spi_t* obj, const uint8_t* tx, size_t tx_length,
+                                   uint8_t* rx, size_t rx_length)
+{
+    cy_rslt_t result = CYHAL_RSLT_ERR_BUSY;
+
+    (void)tx;
+    if (!obj->busy)
+    {
+        obj->busy = true;
+        sim_schedule(_sim_now_us + _sim_spi_account(obj, tx_length, rx, rx_length, 0),
+                     _sim_spi_complete, obj);
+        result = CY_RSLT_SUCCESS;
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* cyhal_spi_abort_async
+******************************************************************************/
+cy_rslt_t cyhal_spi_abort_async(cyhal_spi_t* obj)
+{
+    sim_cancel(_sim_spi_complete, obj);
+    obj->busy = false;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_spi_set_async_mode
+******************************************************************************/
+cy_rslt_t cyhal_spi_set_async_mode(cyhal_spi_t* obj, cyhal_async_mode_t mode,
+                                   uint8_t dma_priority)
+{
+    (void)obj;
+    (void)mode;
+    (void)dma_priority;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_spi_register_callback
+******************************************************************************/
+void cyhal_spi_register_callback(cyhal_spi_t* obj, cyhal_spi_event_callback_t callback,
+                                 void* callback_arg)
+{
+    obj->callback     = callback;
+    obj->callback_arg = callback_arg;
+}
+
+
+/******************************************************************************
+* cyhal_spi_enable_event
+******************************************************************************/
+void cyhal_spi_enable_event(cyhal_spi_t* obj, cyhal_spi_event_t event, uint8_t intr_priority,
+                            bool enable)
+{
+    (void)intr_priority;
+    if (enable)
+    {
+        obj->events |= (uint32_t)event;
+    }
+    else
+    {
+        obj->events &= ~(uint32_t)event;
+    }
+}
+
+
+/******************************************************************************
+* _sim_timer_ticks
+******************************************************************************/
+/* Ticks since the counter was last zero, without the wrap at the period */
+static uint64_t _sim_timer_ticks(const cyhal_timer_t* obj)
+{
+    return ((_sim_now_us - obj->start_us) * obj->frequency_hz) / US_PER_S;
+}
+
+
+/******************************************************************************
+* _sim_timer_period_us
+******************************************************************************/
+static uint64_t _sim_timer_period_us(const cyhal_timer_t* obj)
+{
+    return (((uint64_t)obj->cfg.period + 1U) * US_PER_S) / obj->frequency_hz;
+}
+
+
+/******************************************************************************
+* _sim_timer_terminal_count
+******************************************************************************/
+static void _sim_timer_terminal_count(void* arg)
+{
+    cyhal_timer_t* obj = arg;
+    uint64_t period_us = _sim_timer_period_us(obj);
+    uint64_t elapsed_us = _sim_now_us - obj->start_us;
+
+    sim_schedule(obj->start_us + (((elapsed_us / period_us) + 1U) * period_us),
+                 _sim_timer_terminal_count, obj);
+    if (NULL != obj->callback)
+    {
+        obj->callback(obj->callback_arg, CYHAL_TIMER_IRQ_TERMINAL_COUNT);
+    }
+}
+
+
+/******************************************************************************
+* _sim_timer_arm
+******************************************************************************/
+/* Schedules the next terminal count if it is enabled */
+static void _sim_timer_arm(cyhal_timer_t* obj)
+{
+    sim_cancel(_sim_timer_terminal_count, obj);
+    if (obj->running && (0U != obj->frequency_hz) &&
+        ((obj->events & (uint32_t)CYHAL_TIMER_IRQ_TERMINAL_COUNT) != 0))
+    {
+        uint64_t period_us = _sim_timer_period_us(obj);
+        uint64_t elapsed_us = _sim_now_us - obj->start_us;
+        sim_schedule(obj->start_us + (((elapsed_us / period_us) + 1U) * period_us),
+                     _sim_timer_terminal_count, obj);
+    }
+}
+
+
+/******************************************************************************
+* cyhal_timer_init
+******************************************************************************/
+cy_rslt_t cyhal_timer_init(cyhal_timer_t* obj, cyhal_gpio_t pin, const cyhal_clock_t* clk)
+{
+    (void)pin;
+    (void)clk;
+    memset(obj, 0, sizeof(*obj));
+    obj->frequency_hz = 1000000UL;
+    obj->cfg.period   = UINT32_MAX;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_timer_configure
+******************************************************************************/
+cy_rslt_t cyhal_timer_configure(cyhal_timer_t* obj, const cyhal_timer_cfg_t* cfg)
+{
+    obj->cfg = *cfg;
+    obj->start_us = _sim_now_us;
+    _sim_timer_arm(obj);
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_timer_set_frequency
+******************************************************************************/
+cy_rslt_t cyhal_timer_set_frequency(cyhal_timer_t* obj, uint32_t hz)
+{
+    cy_rslt_t result = CYHAL_RSLT_ERR_HOST;
+
+    /* Ticks must be whole microseconds on the simulated clock */
+    if ((0U != hz) && ((US_PER_S % hz) == 0U))
+    {
+        obj->frequency_hz = hz;
+        _sim_timer_arm(obj);
+        result = CY_RSLT_SUCCESS;
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* cyhal_timer_start
+******************************************************************************/
+cy_rslt_t cyhal_timer_start(cyhal_timer_t* obj)
+{
+    if (!obj->running)
+    {
+        obj->running = true;
+        obj->start_us = _sim_now_us - (((uint64_t)obj->cfg.value * US_PER_S) / obj->frequency_hz);
+        _sim_timer_arm(obj);
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_timer_stop
+******************************************************************************/
+cy_rslt_t cyhal_timer_stop(cyhal_timer_t* obj)
+{
+    if (obj->running)
+    {
+        obj->cfg.value = cyhal_timer_read(obj);
+        obj->running = false;
+        _sim_timer_arm(obj);
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_timer_read
+******************************************************************************/
+uint32_t cyhal_timer_read(const cyhal_timer_t* obj)
+{
+    uint64_t ticks = obj->running ? _sim_timer_ticks(obj) : obj->cfg.value;
+    return (uint32_t)(ticks % ((uint64_t)obj->cfg.period + 1U));
+}
+
+
+/******************************************************************************
+* cyhal_timer_free
+******************************************************************************/
+void cyhal_timer_free(cyhal_timer_t* obj)
+{
+    sim_cancel(_sim_timer_terminal_count, obj);
+    obj->running = false;
+    obj->callback = NULL;
+    obj->events = 0;
+}
+
+
+/******************************************************************************
+* cyhal_timer_register_callback
+******************************************************************************/
+void cyhal_timer_register_callback(cyhal_timer_t* obj, cyhal_timer_event_callback_t callback,
+                                   void* callback_arg)
+{
+    obj->callback     = callback;
+    obj->callback_arg = callback_arg;
+}
+
+
+/******************************************************************************
+* cyhal_timer_enable_event
+******************************************************************************/
+void cyhal_timer_enable_event(cyhal_timer_t* obj, cyhal_timer_event_t event,
+                              uint8_t intr_priority, bool enable)
+{
+    (void)intr_priority;
+    if (enable)
+    {
+        obj->events |= (uint32_t)event;
+    }
+    else
+    {
+        obj->events &= ~(uint32_t)event;
+    }
+    _sim_timer_arm(obj);
+}
+
+
+/******************************************************************************
+* sim_pdm_set_source
+******************************************************************************/
+void sim_pdm_set_source(sim_pdm_source_t source, void* arg)
+{
+    _sim_pdm_source = source;
+    _sim_pdm_source_arg = arg;
+}
+
+
+/******************************************************************************
+* cyhal_pdm_pcm_init
+******************************************************************************/
+cy_rslt_t cyhal_pdm_pcm_init(cyhal_pdm_pcm_t* obj, cyhal_gpio_t pin_data, cyhal_gpio_t pin_clk,
+                             const cyhal_clock_t* clk_source, const cyhal_pdm_pcm_cfg_t* cfg)
+{
+    (void)pin_data;
+    (void)pin_clk;
+    (void)clk_source;
+    memset(obj, 0, sizeof(*obj));
+    obj->cfg = *cfg;
+    return (0U != cfg->sample_rate) ? CY_RSLT_SUCCESS : CYHAL_RSLT_ERR_HOST;
+}
+
+
+/******************************************************************************
+* cyhal_pdm_pcm_free
+******************************************************************************/
+void cyhal_pdm_pcm_free(cyhal_pdm_pcm_t* obj)
+{
+    (void)cyhal_pdm_pcm_abort_async(obj);
+    obj->running = false;
+    obj->callback = NULL;
+    obj->events = 0;
+}
+
+
+/******************************************************************************
+* cyhal_pdm_pcm_start
+******************************************************************************/
+cy_rslt_t cyhal_pdm_pcm_start(cyhal_pdm_pcm_t* obj)
+{
+    obj->running = true;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_pdm_pcm_stop
+******************************************************************************/
+cy_rslt_t cyhal_pdm_pcm_stop(cyhal_pdm_pcm_t* obj)
+{
+    obj->running = false;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_pdm_pcm_clear
+******************************************************************************/
+cy_rslt_t cyhal_pdm_pcm_clear(cyhal_pdm_pcm_t* obj)
+{
+    (void)obj;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* _sim_pdm_complete
+******************************************************************************/
+static void _sim_pdm_complete(void* arg)
+{
+    cyhal_pdm_pcm_t* obj = arg;
+
+    if (NULL != _sim_pdm_source)
+    {
+        _sim_pdm_source(obj->data, obj->length, _sim_pdm_source_arg);
+    }
+    else
+    {
+        memset(obj->data, 0, obj->length * sizeof(int16_t));
+    }
+    obj->busy = false;
+    if (((obj->events & (uint32_t)CYHAL_PDM_PCM_ASYNC_COMPLETE) != 0) && (NULL != obj->callback))
+    {
+        obj->callback(obj->callback_arg, CYHAL_PDM_PCM_ASYNC_COMPLETE);
+    }
+}
+
+
+/******************************************************************************
+* cyhal_pdm_pcm_read_async
+******************************************************************************/
+/* The read completes when the last of the samples has arrived. Samples are
+   16 bit, as configured by the library. */
+cy_rslt_t cyhal_pdm_pcm_read_async(cyhal_pdm_pcm_t* obj, void* data, size_t length)
+{
+    cy_rslt_t result = CYHAL_RSLT_ERR_BUSY;
+
+    if (!obj->busy && obj->running)
+    {
+        uint32_t channels = (CYHAL_PDM_PCM_MODE_STEREO == obj->cfg.mode) ? 2U : 1U;
+        obj->busy   = true;
+        obj->data   = data;
+        obj->length = length;
+        sim_schedule(_sim_now_us + ((length * US_PER_S) / (channels * obj->cfg.sample_rate)),
+                     _sim_pdm_complete, obj);
+        result = CY_RSLT_SUCCESS;
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* cyhal_pdm_pcm_abort_async
+******************************************************************************/
+cy_rslt_t cyhal_pdm_pcm_abort_async(cyhal_pdm_pcm_t* obj)
+{
+    sim_cancel(_sim_pdm_complete, obj);
+    obj->busy = false;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_pdm_pcm_set_async_mode
+******************************************************************************/
+cy_rslt_t cyhal_pdm_pcm_set_async_mode(cyhal_pdm_pcm_t* obj, cyhal_async_mode_t mode,
+                                       uint8_t dma_priority)
+{
+    (void)obj;
+    (void)mode;
+    (void)dma_priority;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_pdm_pcm_register_callback
+******************************************************************************/
+void cyhal_pdm_pcm_register_callback(cyhal_pdm_pcm_t* obj, cyhal_pdm_pcm_event_callback_t callback,
+                                     void* callback_arg)
+{
+    obj->callback     = callback;
+    obj->callback_arg = callback_arg;
+}
+
+
+/******************************************************************************
+* cyhal_pdm_pcm_enable_event
+******************************************************************************/
+void cyhal_pdm_pcm_enable_event(cyhal_pdm_pcm_t* obj, cyhal_pdm_pcm_event_t event,
+                                uint8_t intr_priority, bool enable)
+{
+    (void)intr_priority;
+    if (enable)
+    {
+        obj->events |= (uint32_t)event;
+    }
+    else
+    {
+        obj->events &= ~(uint32_t)event;
+    }
+}
+
+
+/******************************************************************************
+* cyhal_adc_init
+******************************************************************************/
+cy_rslt_t cyhal_adc_init(cyhal_adc_t* obj, cyhal_gpio_t pin, const cyhal_clock_t* clk)
+{
+    (void)pin;
+    (void)clk;
+    memset(obj, 0, sizeof(*obj));
+    obj->sample_rate_hz = 1000UL;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_adc_configure
+******************************************************************************/
+cy_rslt_t cyhal_adc_configure(cyhal_adc_t* obj, const cyhal_adc_config_t* config)
+{
+    (void)obj;
+    (void)config;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_adc_set_sample_rate
+******************************************************************************/
+cy_rslt_t cyhal_adc_set_sample_rate(cyhal_adc_t* obj, uint32_t desired_sample_rate_hz,
+                                    uint32_t* achieved_sample_rate_hz)
+{
+    obj->sample_rate_hz = desired_sample_rate_hz;
+    if (NULL != achieved_sample_rate_hz)
+    {
+        *achieved_sample_rate_hz = desired_sample_rate_hz;
+    }
+    return (0U != desired_sample_rate_hz) ? CY_RSLT_SUCCESS : CYHAL_RSLT_ERR_HOST;
+}
+
+
+/******************************************************************************
+* _sim_adc_complete
+******************************************************************************/
+static void _sim_adc_complete(void* arg)
+{
+    cyhal_adc_t* obj = arg;
+
+    memset(obj->result_list, 0, obj->num_scan * obj->channels * sizeof(int32_t));
+    obj->busy = false;
+    if (((obj->events & (uint32_t)CYHAL_ADC_ASYNC_READ_COMPLETE) != 0) && (NULL != obj->callback))
+    {
+        obj->callback(obj->callback_arg, CYHAL_ADC_ASYNC_READ_COMPLETE);
+    }
+}
+
+
+/******************************************************************************
+* cyhal_adc_free
+******************************************************************************/
+void cyhal_adc_free(cyhal_adc_t* obj)
+{
+    sim_cancel(_sim_adc_complete, obj);
+    obj->busy = false;
+    obj->callback = NULL;
+    obj->events = 0;
+}
+
+
+/******************************************************************************
+* cyhal_adc_channel_init_diff
+******************************************************************************/
+cy_rslt_t cyhal_adc_channel_init_diff(cyhal_adc_channel_t* obj, cyhal_adc_t* adc,
+                                      cyhal_gpio_t vplus, cyhal_gpio_t vminus,
+                                      const cyhal_adc_channel_config_t* cfg)
+{
+    (void)vplus;
+    (void)vminus;
+    (void)cfg;
+    obj->adc = adc;
+    adc->channels++;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_adc_channel_free
+******************************************************************************/
+void cyhal_adc_channel_free(cyhal_adc_channel_t* obj)
+{
+    if ((NULL != obj->adc) && (obj->adc->channels > 0))
+    {
+        obj->adc->channels--;
+    }
+    obj->adc = NULL;
+}
+
+
+/******************************************************************************
+* cyhal_adc_read_async_uv
+******************************************************************************/
+/* The simulated radar front end delivers a flat intermediate frequency signal */
+cy_rslt_t cyhal_adc_read_async_uv(cyhal_adc_t* obj, size_t num_scan, int32_t* result_list)
+{
+    cy_rslt_t result = CYHAL_RSLT_ERR_BUSY;
+
+    if (!obj->busy)
+    {
+        obj->busy        = true;
+        obj->num_scan    = num_scan;
+        obj->result_list = result_list;
+        sim_schedule(_sim_now_us + ((num_scan * US_PER_S) / obj->sample_rate_hz),
+                     _sim_adc_complete, obj);
+        result = CY_RSLT_SUCCESS;
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* cyhal_adc_set_async_mode
+******************************************************************************/
+cy_rslt_t cyhal_adc_set_async_mode(cyhal_adc_t* obj, cyhal_async_mode_t mode,
+                                   uint8_t dma_priority)
+{
+    (void)obj;
+    (void)mode;
+    (void)dma_priority;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cyhal_adc_register_callback
+******************************************************************************/
+void cyhal_adc_register_callback(cyhal_adc_t* obj, cyhal_adc_event_callback_t callback,
+                                 void* callback_arg)
+{
+    obj->callback     = callback;
+    obj->callback_arg = callback_arg;
+}
+
+
+/******************************************************************************
+* cyhal_adc_enable_event
+******************************************************************************/
+void cyhal_adc_enable_event(cyhal_adc_t* obj, cyhal_adc_event_t event, uint8_t intr_priority,
+                            bool enable)
+{
+    (void)intr_priority;
+    if (enable)
+    {
+        obj->events |= (uint32_t)event;
+    }
+    else
+    {
+        obj->events &= ~(uint32_t)event;
+    }
+}
+
+
+/******************************************************************************
+* cy_rtos_init_mutex
+******************************************************************************/
+cy_rslt_t cy_rtos_init_mutex(cy_mutex_t* mutex)
+{
+    mutex->locked = false;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cy_rtos_get_mutex
+******************************************************************************/
+/* A single thread cannot wait for itself, so a taken mutex is an error */
+cy_rslt_t cy_rtos_get_mutex(cy_mutex_t* mutex, cy_time_t timeout_ms)
+{
+    cy_rslt_t result = CYHAL_RSLT_ERR_BUSY;
+
+    (void)timeout_ms;
+    if (!mutex->locked)
+    {
+        mutex->locked = true;
+        result = CY_RSLT_SUCCESS;
+    }
+    return result;
+}
+
+
+/******************************************************************************
+* cy_rtos_set_mutex
+******************************************************************************/
+cy_rslt_t cy_rtos_set_mutex(cy_mutex_t* mutex)
+{
+    mutex->locked = false;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/******************************************************************************
+* cy_rtos_deinit_mutex
+******************************************************************************/
+cy_rslt_t cy_rtos_deinit_mutex(cy_mutex_t* mutex)
+{
+    mutex->locked = false;
+    return CY_RSLT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
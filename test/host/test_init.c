@@ -0,0 +1,166 @@
+/******************************************************************************
+ * \file test_init.c
+ *
+ * Description: Host test of the staged initialization. The motion sensor has
+ *              to be ready and deliver its first sample at the same time
+ *              whether the CO2 sensor answers after its usual warm-up, only
+ *              at the end of the ready timeout or never, and before the warm-up
+ *              of the CO2 sensor has ended.
+ *
+ ******************************************************************************
+ ******************************************************************************
+ * \copyright
+ * Copyright 2024 Cypress Semiconductor Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "sim.h"
+#include "shield_xensiv_a.h"
+#include "shield_xensiv_a_irq.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define CHECK(cond)                                                          \
+    do                                                                       \
+    {                                                                        \
+        if (!(cond))                                                         \
+        {                                                                    \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);  \
+            exit(EXIT_FAILURE);                                              \
+        }                                                                    \
+    } while (0)
+
+#if SHIELD_XENSIV_A_USE_MOTION
+/* Limit of the simulated time waited for the first motion sample */
+#define SAMPLE_TIMEOUT_US           (100000U)
+#define INIT_POLL_INTERVAL_MS       (10U)
+#define US_PER_MS                   (1000U)
+
+/******************************************************************************
+* Types
+******************************************************************************/
+typedef struct
+{
+    uint64_t    ready_us;       /* staged initialization returned */
+    uint64_t    sample_us;      /* first motion sample captured */
+    uint64_t    co2_done_us;    /* staged initialization completed */
+    cy_rslt_t   co2_result;     /* final result of the staged initialization */
+} test_run_t;
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+static volatile bool _test_irq;
+
+
+/******************************************************************************
+* _test_irq_callback
+******************************************************************************/
+static void _test_irq_callback(shield_xensiv_a_irq_source_t source, uint32_t timestamp_us,
+                               void* callback_arg)
+{
+    (void)source;
+    (void)timestamp_us;
+    (void)callback_arg;
+    _test_irq = true;
+}
+
+
+/******************************************************************************
+* _test_run
+******************************************************************************/
+/* Initializes the shield with the CO2 sensor answering after co2_ready_ms and
+   records when the motion sensor delivers its first sample */
+static test_run_t _test_run(uint32_t co2_ready_ms)
+{
+    shield_xensiv_a_cfg_t cfg = SHIELD_XENSIV_A_CFG_DEFAULT;
+    mtb_bmi270_data_t data;
+    test_run_t run;
+
+    sim_reset();
+    sim_co2_set_ready_ms(co2_ready_ms);
+    CHECK(CY_RSLT_SUCCESS == shield_xensiv_a_init_start_cfg(&cfg));
+    run.ready_us = sim_now_us();
+    CHECK((shield_xensiv_a_get_ready_mask() & SHIELD_XENSIV_A_READY_MOTION) != 0);
+    CHECK((shield_xensiv_a_get_ready_mask() & SHIELD_XENSIV_A_READY_CO2) == 0);
+
+    /* The first sample, without polling the staged initialization */
+    _test_irq = false;
+    CHECK(CY_RSLT_SUCCESS ==
+          shield_xensiv_a_irq_enable(SHIELD_XENSIV_A_IRQ_MOTION, _test_irq_callback, NULL, 0));
+    uint64_t limit_us = sim_now_us() + SAMPLE_TIMEOUT_US;
+    while (!_test_irq && sim_step(limit_us))
+    {
+    }
+    CHECK(_test_irq);
+    CHECK(CY_RSLT_SUCCESS == mtb_bmi270_read(shield_xensiv_a_get_motion_sensor(), &data));
+    CHECK(data.sensor_data.acc.z > 0);
+    run.sample_us = sim_now_us();
+    shield_xensiv_a_irq_disable(SHIELD_XENSIV_A_IRQ_MOTION);
+
+    do
+    {
+        cyhal_system_delay_ms(INIT_POLL_INTERVAL_MS);
+        run.co2_result = shield_xensiv_a_init_poll();
+    } while (SHIELD_XENSIV_A_RSLT_PENDING == run.co2_result);
+    run.co2_done_us = sim_now_us();
+
+    shield_xensiv_a_free();
+    return run;
+}
+#endif /* SHIELD_XENSIV_A_USE_MOTION */
+
+
+/******************************************************************************
+* main
+******************************************************************************/
+int main(void)
+{
+#if SHIELD_XENSIV_A_USE_MOTION
+    test_run_t usual   = _test_run(SHIELD_XENSIV_A_CO2_WARMUP_MS);
+    test_run_t late    = _test_run(SHIELD_XENSIV_A_CO2_READY_TIMEOUT_MS);
+    test_run_t missing = _test_run(SIM_NEVER);
+
+    /* The motion sensor does not wait for the CO2 sensor */
+    CHECK(usual.ready_us == late.ready_us);
+    CHECK(usual.ready_us == missing.ready_us);
+    CHECK(usual.sample_us == late.sample_us);
+    CHECK(usual.sample_us == missing.sample_us);
+
+#if SHIELD_XENSIV_A_USE_CO2
+    /* Only the CO2 sensor differs */
+    CHECK(CY_RSLT_SUCCESS == usual.co2_result);
+    CHECK(CY_RSLT_SUCCESS != missing.co2_result);
+    CHECK(usual.co2_done_us >= ((uint64_t)SHIELD_XENSIV_A_CO2_WARMUP_MS * US_PER_MS));
+    CHECK(missing.co2_done_us >= ((uint64_t)SHIELD_XENSIV_A_CO2_READY_TIMEOUT_MS * US_PER_MS));
+#endif
+    /* The first sample arrives while the CO2 sensor still warms up */
+    CHECK(usual.sample_us < ((uint64_t)SHIELD_XENSIV_A_CO2_WARMUP_MS * US_PER_MS));
+
+    printf("first motion sample after %llu us, CO2 ready after %llu us, "
+           "CO2 timeout after %llu us\n", (unsigned long long)usual.sample_us,
+           (unsigned long long)usual.co2_done_us, (unsigned long long)missing.co2_done_us);
+    return EXIT_SUCCESS;
+#else
+    printf("skipped, the motion sensor is compiled out\n");
+    return EXIT_SUCCESS;
+#endif
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 Cypress Semiconductor Corporation
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Converts a binary log written with shield_xensiv_a_log_encode() to CSV.
+
+The format is described in shield_xensiv_a_log.h. Data between blocks which
+does not start with a valid header, e.g. the erased remainder of a flash page,
+is skipped.
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+VERSION = 1
+HEADER = struct.Struct("<2sBBHHI")
+CHANNELS = 3
+
+TAG_SENSOR_MASK = 0x0F
+TAG_NEXT_SEQUENCE = 0x10
+TAG_SAME_VALUES = 0x20
+TAG_RESERVED = 0xC0
+
+# Name, channel names and divisor to the driver unit of every sensor id,
+# matching shield_xensiv_a_sensor_id_t
+SENSORS = [
+    ("humidity", ("temperature_c", "humidity_pct"), 1000.0),
+    ("accel", ("x", "y", "z"), 1.0),
+    ("gyro", ("x", "y", "z"), 1.0),
+    ("magnetometer", ("x_ut", "y_ut", "z_ut"), 1000.0),
+    ("pressure", ("pressure_hpa", "temperature_c"), 1000.0),
+    ("co2", ("ppm",), 1.0),
+]
+
+
+class FormatError(Exception):
+    pass
+
+
+def read_varint(data, offset, end):
+    value = 0
+    shift = 0
+    while True:
+        if offset >= end or shift >= 35:
+            raise FormatError("truncated varint")
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value & 0xFFFFFFFF, offset
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def decode_block(data, start):
+    """Yields (sensor, sequence, timestamp_us, values) of the block at start."""
+    if len(data) - start < HEADER.size:
+        raise FormatError("truncated header")
+    magic, version, _, length, records, timestamp = HEADER.unpack_from(data, start)
+    if magic != b"SX" or version != VERSION or length < HEADER.size:
+        raise FormatError("no block header")
+    end = start + length
+    if end > len(data):
+        raise FormatError("truncated block")
+
+    offset = start + HEADER.size
+    resolution = []
+    for _ in SENSORS:
+        row = []
+        for _ in range(CHANNELS):
+            step, offset = read_varint(data, offset, end)
+            row.append(step)
+        resolution.append(row)
+
+    sequence = [0] * len(SENSORS)
+    values = [[0] * CHANNELS for _ in SENSORS]
+    samples = []
+    for _ in range(records):
+        if offset >= end:
+            raise FormatError("truncated record")
+        tag = data[offset]
+        offset += 1
+        sensor = tag & TAG_SENSOR_MASK
+        if sensor >= len(SENSORS) or tag & TAG_RESERVED:
+            raise FormatError("invalid record tag")
+
+        delta = 1
+        if not tag & TAG_NEXT_SEQUENCE:
+            delta, offset = read_varint(data, offset, end)
+        sequence[sensor] = (sequence[sensor] + delta) & 0xFFFF
+
+        delta, offset = read_varint(data, offset, end)
+        timestamp = (timestamp + delta) & 0xFFFFFFFF
+
+        count = len(SENSORS[sensor][1])
+        if not tag & TAG_SAME_VALUES:
+            for channel in range(count):
+                delta, offset = read_varint(data, offset, end)
+                values[sensor][channel] += unzigzag(delta)
+
+        scaled = [values[sensor][c] * resolution[sensor][c] for c in range(count)]
+        samples.append((sensor, sequence[sensor], timestamp, scaled))
+
+    return samples, end
+
+
+def decode(data):
+    """Yields the samples of all blocks in data, skipping invalid data."""
+    offset = 0
+    skipped = 0
+    while offset < len(data):
+        try:
+            samples, offset = decode_block(data, offset)
+        except FormatError:
+            offset += 1
+            skipped += 1
+            continue
+        yield from samples
+    if skipped:
+        print("skipped %d bytes of invalid data" % skipped, file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="binary log file")
+    parser.add_argument("-o", "--output", help="CSV file, standard output if omitted")
+    parser.add_argument("--raw", action="store_true",
+                        help="write the integer sample values instead of driver units")
+    args = parser.parse_args()
+
+    with open(args.log, "rb") as file:
+        data = file.read()
+
+    output = open(args.output, "w", newline="") if args.output else sys.stdout
+    try:
+        writer = csv.writer(output)
+        writer.writerow(["timestamp_us", "sensor", "sequence", "channel", "value"])
+        for sensor, sequence, timestamp, values in decode(data):
+            name, channels, divisor = SENSORS[sensor]
+            for channel, value in zip(channels, values):
+                writer.writerow([timestamp, name, sequence, channel,
+                                 value if args.raw else value / divisor])
+    finally:
+        if output is not sys.stdout:
+            output.close()
+
+
+if __name__ == "__main__":
+    main()